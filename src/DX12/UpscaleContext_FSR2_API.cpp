@@ -78,6 +78,7 @@ void UpscaleContext_FSR2_API::OnCreate(const FfxUpscaleInitParams& initParams)
 
 void UpscaleContext_FSR2_API::OnDestroy()
 {
+    DestroyContext();
     UpscaleContext::OnDestroy();
 }
 
@@ -105,6 +106,22 @@ void UpscaleContext_FSR2_API::OnCreateWindowSizeDependentResources(
 {
     UpscaleContext::OnCreateWindowSizeDependentResources(input, output, renderWidth, renderHeight, displayWidth, displayHeight, hdr);
 
+    // A live context is resized in place, it keeps its shaders and pipelines.
+    if (initializationParameters.callbacks.scratchBuffer != nullptr)
+    {
+        const FfxDimensions2D maxRenderSize = { renderWidth, renderHeight };
+        const FfxDimensions2D displaySize = { displayWidth, displayHeight };
+        if (ffxFsr2ContextResize(&context, maxRenderSize, displaySize, 0) == FFX_OK)
+        {
+            initializationParameters.maxRenderSize = maxRenderSize;
+            initializationParameters.displaySize = displaySize;
+            return;
+        }
+
+        // a context whose resize failed can only be destroyed
+        DestroyContext();
+    }
+
     // Setup DX12 interface.
     const size_t scratchBufferSize = ffxFsr2GetScratchMemorySizeDX12();
     void* scratchBuffer = malloc(scratchBufferSize);
@@ -151,6 +168,11 @@ void UpscaleContext_FSR2_API::OnCreateWindowSizeDependentResources(
 void UpscaleContext_FSR2_API::OnDestroyWindowSizeDependentResources()
 {
     UpscaleContext::OnDestroyWindowSizeDependentResources();
+    // the context stays alive, OnCreateWindowSizeDependentResources resizes it
+}
+
+void UpscaleContext_FSR2_API::DestroyContext()
+{
     // only destroy contexts which are live
     if (initializationParameters.callbacks.scratchBuffer != nullptr)
     {
@@ -171,7 +193,7 @@ void UpscaleContext_FSR2_API::BuildDevUI(UIState* pState)
 void UpscaleContext_FSR2_API::ReloadPipelines()
 {
     m_pDevice->GPUFlush();
-    OnDestroyWindowSizeDependentResources();
+    DestroyContext();
     OnCreateWindowSizeDependentResources(m_input, m_output, m_renderWidth, m_renderHeight, m_displayWidth, m_displayHeight, m_hdr);
 }
 
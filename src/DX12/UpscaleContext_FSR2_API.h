@@ -56,6 +56,7 @@ public:
 
 private:
     void ReloadPipelines();
+    void DestroyContext();
 
     FfxFsr2ContextDescription    initializationParameters = {};
     FfxFsr2Context              context;
@@ -0,0 +1,346 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "CaptureFile.h"
+#include "SurfaceFormat.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // #ifdef _WIN32
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+void CaptureStoreParameters(const FfxFsr2DispatchDescription& dispatchDescription, Fsr2CaptureParameters& parameters)
+{
+    parameters = {};
+    parameters.jitterOffset[0]         = dispatchDescription.jitterOffset.x;
+    parameters.jitterOffset[1]         = dispatchDescription.jitterOffset.y;
+    parameters.motionVectorScale[0]    = dispatchDescription.motionVectorScale.x;
+    parameters.motionVectorScale[1]    = dispatchDescription.motionVectorScale.y;
+    parameters.renderWidth             = dispatchDescription.renderSize.width;
+    parameters.renderHeight            = dispatchDescription.renderSize.height;
+    parameters.frameTimeDelta          = dispatchDescription.frameTimeDelta;
+    parameters.preExposure             = dispatchDescription.preExposure;
+    parameters.sharpness               = dispatchDescription.sharpness;
+    parameters.cameraNear              = dispatchDescription.cameraNear;
+    parameters.cameraFar               = dispatchDescription.cameraFar;
+    parameters.cameraFovAngleVertical  = dispatchDescription.cameraFovAngleVertical;
+    parameters.viewSpaceToMetersFactor = dispatchDescription.viewSpaceToMetersFactor;
+    parameters.enableSharpening        = dispatchDescription.enableSharpening ? 1 : 0;
+    parameters.reset                   = dispatchDescription.reset ? 1 : 0;
+}
+
+void CaptureLoadParameters(const Fsr2CaptureParameters& parameters, FfxFsr2DispatchDescription& dispatchDescription)
+{
+    dispatchDescription.jitterOffset.x          = parameters.jitterOffset[0];
+    dispatchDescription.jitterOffset.y          = parameters.jitterOffset[1];
+    dispatchDescription.motionVectorScale.x     = parameters.motionVectorScale[0];
+    dispatchDescription.motionVectorScale.y     = parameters.motionVectorScale[1];
+    dispatchDescription.renderSize.width        = parameters.renderWidth;
+    dispatchDescription.renderSize.height       = parameters.renderHeight;
+    dispatchDescription.frameTimeDelta          = parameters.frameTimeDelta;
+    dispatchDescription.preExposure             = parameters.preExposure;
+    dispatchDescription.sharpness               = parameters.sharpness;
+    dispatchDescription.cameraNear              = parameters.cameraNear;
+    dispatchDescription.cameraFar               = parameters.cameraFar;
+    dispatchDescription.cameraFovAngleVertical  = parameters.cameraFovAngleVertical;
+    dispatchDescription.viewSpaceToMetersFactor = parameters.viewSpaceToMetersFactor;
+    dispatchDescription.enableSharpening        = parameters.enableSharpening != 0;
+    dispatchDescription.reset                   = parameters.reset != 0;
+}
+
+bool CaptureWriter::Open(const std::string& path, uint32_t flags, FfxDimensions2D maxRenderSize, FfxDimensions2D displaySize)
+{
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        return false;
+    }
+
+    m_header                 = {};
+    m_header.magic           = FSR2_CAPTURE_MAGIC;
+    m_header.version         = FSR2_CAPTURE_VERSION;
+    m_header.flags           = flags;
+    m_header.maxRenderWidth  = maxRenderSize.width;
+    m_header.maxRenderHeight = maxRenderSize.height;
+    m_header.displayWidth    = displaySize.width;
+    m_header.displayHeight   = displaySize.height;
+    m_frameOffsets.clear();
+
+    // the header is rewritten with the frame count once the capture is closed
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_offset = sizeof(m_header);
+
+    return Pad(FSR2_CAPTURE_FRAME_ALIGNMENT);
+}
+
+bool CaptureWriter::Pad(uint64_t alignment)
+{
+    static const char zeros[FSR2_CAPTURE_FRAME_ALIGNMENT] = {};
+
+    const uint64_t padding = alignUp(m_offset, alignment) - m_offset;
+    m_file.write(zeros, std::streamsize(padding));
+    m_offset += padding;
+
+    return bool(m_file);
+}
+
+bool CaptureWriter::AppendFrame(const Fsr2CaptureParameters& parameters, const CaptureSurface* surfaces)
+{
+    FFX_ASSERT(m_offset % FSR2_CAPTURE_FRAME_ALIGNMENT == 0);
+
+    Fsr2CaptureFrame frame = {};
+    frame.parameters = parameters;
+
+    // lay the surfaces out after the frame record before writing anything
+    uint64_t offset = alignUp(m_offset + sizeof(Fsr2CaptureFrame), FSR2_CAPTURE_SURFACE_ALIGNMENT);
+    for (uint32_t surface = 0; surface < FSR2_CAPTURE_SURFACE_COUNT; ++surface) {
+
+        const CaptureSurface& source = surfaces[surface];
+        if (source.data == nullptr) {
+            continue;
+        }
+        if (GetSurfaceFormatSize(source.format) == 0 || source.rowPitch < uint64_t(source.width) * GetSurfaceFormatSize(source.format)) {
+            return false;
+        }
+
+        Fsr2CaptureSurfaceRecord& record = frame.surfaces[surface];
+        record.offset   = offset;
+        record.format   = uint32_t(source.format);
+        record.width    = source.width;
+        record.height   = source.height;
+        record.rowPitch = source.rowPitch;
+
+        offset = alignUp(offset + uint64_t(source.rowPitch) * source.height, FSR2_CAPTURE_SURFACE_ALIGNMENT);
+    }
+
+    m_frameOffsets.push_back(m_offset);
+    m_file.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+    m_offset += sizeof(frame);
+
+    for (uint32_t surface = 0; surface < FSR2_CAPTURE_SURFACE_COUNT; ++surface) {
+
+        const Fsr2CaptureSurfaceRecord& record = frame.surfaces[surface];
+        if (record.offset == 0) {
+            continue;
+        }
+
+        Pad(FSR2_CAPTURE_SURFACE_ALIGNMENT);
+        FFX_ASSERT(m_offset == record.offset);
+
+        const uint64_t size = uint64_t(record.rowPitch) * record.height;
+        m_file.write(static_cast<const char*>(surfaces[surface].data), std::streamsize(size));
+        m_offset += size;
+    }
+
+    return Pad(FSR2_CAPTURE_FRAME_ALIGNMENT);
+}
+
+bool CaptureWriter::Close()
+{
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    m_header.frameCount       = m_frameOffsets.size();
+    m_header.frameTableOffset = m_offset;
+    m_file.write(reinterpret_cast<const char*>(m_frameOffsets.data()), std::streamsize(m_frameOffsets.size() * sizeof(uint64_t)));
+
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_file.close();
+
+    return !m_file.fail();
+}
+
+bool CaptureReader::Open(const std::string& path, std::string& error)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "cannot open " + path;
+        return false;
+    }
+    m_file = file;
+
+    LARGE_INTEGER size = {};
+    HANDLE mapping = GetFileSizeEx(file, &size) && size.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    if (mapping == nullptr) {
+        error = "cannot map " + path;
+        Close();
+        return false;
+    }
+    m_mapping = mapping;
+    m_size    = uint64_t(size.QuadPart);
+    m_data    = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    struct stat status = {};
+    void* data = (fstat(file, &status) == 0 && status.st_size > 0) ? mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    close(file);
+
+    m_size = uint64_t(status.st_size);
+    m_data = (data != MAP_FAILED) ? static_cast<const uint8_t*>(data) : nullptr;
+#endif // #ifdef _WIN32
+
+    if (m_data == nullptr) {
+        error = "cannot map " + path;
+        Close();
+        return false;
+    }
+
+    // validate everything up front, reading frames does not check anything
+    m_header = reinterpret_cast<const Fsr2CaptureHeader*>(m_data);
+    if (m_size < FSR2_CAPTURE_FRAME_ALIGNMENT || m_header->magic != FSR2_CAPTURE_MAGIC || m_header->version != FSR2_CAPTURE_VERSION) {
+        error = path + " is not a FSR2 capture";
+        Close();
+        return false;
+    }
+
+    const uint64_t frameCount = m_header->frameCount;
+    if (m_header->frameTableOffset % sizeof(uint64_t) != 0 || m_header->frameTableOffset > m_size ||
+        frameCount > (m_size - m_header->frameTableOffset) / sizeof(uint64_t)) {
+        error = path + " is truncated";
+        Close();
+        return false;
+    }
+    m_frameTable = reinterpret_cast<const uint64_t*>(m_data + m_header->frameTableOffset);
+
+    for (uint64_t frame = 0; frame < frameCount; ++frame) {
+
+        const uint64_t frameOffset = m_frameTable[frame];
+        bool           valid       = frameOffset % FSR2_CAPTURE_FRAME_ALIGNMENT == 0 && frameOffset >= FSR2_CAPTURE_FRAME_ALIGNMENT &&
+                                     frameOffset <= m_size - sizeof(Fsr2CaptureFrame);
+
+        for (uint32_t surface = 0; valid && surface < FSR2_CAPTURE_SURFACE_COUNT; ++surface) {
+
+            const Fsr2CaptureSurfaceRecord& record = Frame(frame).surfaces[surface];
+            if (record.offset == 0) {
+                continue;
+            }
+
+            const uint64_t size = uint64_t(record.rowPitch) * record.height;
+            valid = record.offset % FSR2_CAPTURE_SURFACE_ALIGNMENT == 0 && record.offset <= m_size && size <= m_size - record.offset &&
+                    GetSurfaceFormatSize(record.format) != 0 && record.rowPitch >= uint64_t(record.width) * GetSurfaceFormatSize(record.format);
+        }
+
+        if (!valid) {
+            error = path + ": frame " + std::to_string(frame) + " is corrupted";
+            Close();
+            return false;
+        }
+    }
+
+#ifndef _WIN32
+    // frames are mostly read in order
+    madvise(const_cast<uint8_t*>(m_data), size_t(m_size), MADV_SEQUENTIAL);
+#endif // #ifndef _WIN32
+
+    return true;
+}
+
+void CaptureReader::Close()
+{
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file) {
+        CloseHandle(m_file);
+    }
+    m_file    = nullptr;
+    m_mapping = nullptr;
+#else
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), size_t(m_size));
+    }
+#endif // #ifdef _WIN32
+
+    m_data       = nullptr;
+    m_size       = 0;
+    m_header     = nullptr;
+    m_frameTable = nullptr;
+}
+
+const Fsr2CaptureFrame& CaptureReader::Frame(uint64_t frame) const
+{
+    FFX_ASSERT(frame < FrameCount());
+
+    return *reinterpret_cast<const Fsr2CaptureFrame*>(m_data + m_frameTable[frame]);
+}
+
+CaptureSurface CaptureReader::Surface(uint64_t frame, Fsr2CaptureSurfaceIdentifier surface) const
+{
+    const Fsr2CaptureSurfaceRecord& record = Frame(frame).surfaces[surface];
+
+    CaptureSurface result;
+    if (record.offset != 0) {
+        result.data     = m_data + record.offset;
+        result.format   = FfxSurfaceFormat(record.format);
+        result.width    = record.width;
+        result.height   = record.height;
+        result.rowPitch = record.rowPitch;
+    }
+
+    return result;
+}
+
+void CaptureReader::Prefetch(uint64_t frame) const
+{
+    const uint64_t begin = m_frameTable[frame];
+    const uint64_t end   = (frame + 1 < FrameCount()) ? m_frameTable[frame + 1] : m_header->frameTableOffset;
+    if (end <= begin) {
+        return;
+    }
+
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range = { const_cast<uint8_t*>(m_data + begin), SIZE_T(end - begin) };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    madvise(const_cast<uint8_t*>(m_data + begin), size_t(end - begin), MADV_WILLNEED);
+#endif // #ifdef _WIN32
+}
@@ -0,0 +1,188 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ffx_fsr2.h"
+
+// FSR2 capture files store a sequence of frames ready to be dispatched: the scalars of each
+// FfxFsr2DispatchDescription together with the raw texels of its input surfaces, exactly as they were
+// handed to the backend. The file is meant to be mapped in memory, so readers can hand surface
+// pointers straight to ffxGetResourceCPU without copying or converting anything.
+//
+// Layout, all integers little endian:
+//
+//   Fsr2CaptureHeader          offset 0, padded to FSR2_CAPTURE_FRAME_ALIGNMENT
+//   frame 0                    Fsr2CaptureFrame followed by its surfaces
+//   ...
+//   frame n - 1
+//   frame table                header.frameCount offsets of the Fsr2CaptureFrame records, at header.frameTableOffset
+//
+// Every frame starts on a FSR2_CAPTURE_FRAME_ALIGNMENT boundary so the pages of a frame are never
+// shared with its neighbours, and every surface starts on a FSR2_CAPTURE_SURFACE_ALIGNMENT boundary
+// so rows can be read with aligned vector loads.
+
+static const uint64_t FSR2_CAPTURE_MAGIC             = 0x0031504143325346ull;   // "FS2CAP1\0"
+static const uint32_t FSR2_CAPTURE_VERSION           = 1;
+static const uint64_t FSR2_CAPTURE_FRAME_ALIGNMENT   = 4096;
+static const uint64_t FSR2_CAPTURE_SURFACE_ALIGNMENT = 64;
+
+typedef enum Fsr2CaptureSurfaceIdentifier {
+
+    FSR2_CAPTURE_SURFACE_COLOR,
+    FSR2_CAPTURE_SURFACE_DEPTH,
+    FSR2_CAPTURE_SURFACE_MOTION_VECTORS,
+    FSR2_CAPTURE_SURFACE_EXPOSURE,
+    FSR2_CAPTURE_SURFACE_REACTIVE,
+    FSR2_CAPTURE_SURFACE_TRANSPARENCY_AND_COMPOSITION,
+
+    FSR2_CAPTURE_SURFACE_COUNT
+} Fsr2CaptureSurfaceIdentifier;
+
+typedef struct Fsr2CaptureHeader {
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t flags;                         // FfxFsr2InitializationFlagBits of the captured context
+    uint32_t maxRenderWidth;
+    uint32_t maxRenderHeight;
+    uint32_t displayWidth;
+    uint32_t displayHeight;
+    uint64_t frameCount;
+    uint64_t frameTableOffset;
+} Fsr2CaptureHeader;
+
+// The scalars of a FfxFsr2DispatchDescription.
+typedef struct Fsr2CaptureParameters {
+
+    float    jitterOffset[2];
+    float    motionVectorScale[2];
+    uint32_t renderWidth;
+    uint32_t renderHeight;
+    float    frameTimeDelta;
+    float    preExposure;
+    float    sharpness;
+    float    cameraNear;
+    float    cameraFar;
+    float    cameraFovAngleVertical;
+    float    viewSpaceToMetersFactor;
+    uint32_t enableSharpening;
+    uint32_t reset;
+    uint32_t reserved;
+} Fsr2CaptureParameters;
+
+// A surface of a frame, absent when offset is 0. Texels are stored as height rows of rowPitch bytes.
+typedef struct Fsr2CaptureSurfaceRecord {
+
+    uint64_t offset;                        // from the start of the file
+    uint32_t format;                        // FfxSurfaceFormat
+    uint32_t width;
+    uint32_t height;
+    uint32_t rowPitch;
+} Fsr2CaptureSurfaceRecord;
+
+typedef struct Fsr2CaptureFrame {
+
+    Fsr2CaptureParameters    parameters;
+    Fsr2CaptureSurfaceRecord surfaces[FSR2_CAPTURE_SURFACE_COUNT];
+} Fsr2CaptureFrame;
+
+// The layout is part of the format, make sure no compiler pads it differently.
+static_assert(sizeof(Fsr2CaptureHeader) == 48, "Fsr2CaptureHeader layout changed");
+static_assert(sizeof(Fsr2CaptureParameters) == 64, "Fsr2CaptureParameters layout changed");
+static_assert(sizeof(Fsr2CaptureSurfaceRecord) == 24, "Fsr2CaptureSurfaceRecord layout changed");
+static_assert(sizeof(Fsr2CaptureFrame) == 208, "Fsr2CaptureFrame layout changed");
+
+// A surface in memory, handed to CaptureWriter::AppendFrame or returned by CaptureReader::Surface.
+struct CaptureSurface
+{
+    const void*      data     = nullptr;
+    FfxSurfaceFormat format   = FFX_SURFACE_FORMAT_UNKNOWN;
+    uint32_t         width    = 0;
+    uint32_t         height   = 0;
+    uint32_t         rowPitch = 0;
+};
+
+// Copy the scalars of a dispatch into parameters, and back.
+void CaptureStoreParameters(const FfxFsr2DispatchDescription& dispatchDescription, Fsr2CaptureParameters& parameters);
+void CaptureLoadParameters(const Fsr2CaptureParameters& parameters, FfxFsr2DispatchDescription& dispatchDescription);
+
+// Appends frames to a new capture file. The header and the frame table are written by Close, a
+// capture that was not closed has no frames.
+class CaptureWriter
+{
+public:
+    bool Open(const std::string& path, uint32_t flags, FfxDimensions2D maxRenderSize, FfxDimensions2D displaySize);
+
+    // Append a frame, surfaces holds FSR2_CAPTURE_SURFACE_COUNT entries, absent ones without data.
+    bool AppendFrame(const Fsr2CaptureParameters& parameters, const CaptureSurface* surfaces);
+
+    bool Close();
+
+private:
+    bool Pad(uint64_t alignment);
+
+    std::ofstream         m_file;
+    Fsr2CaptureHeader     m_header = {};
+    std::vector<uint64_t> m_frameOffsets;
+    uint64_t              m_offset = 0;
+};
+
+// Maps a capture file in memory for reading. Frames and surfaces point into the mapping and stay
+// valid until the reader is closed or destroyed.
+class CaptureReader
+{
+public:
+    CaptureReader() = default;
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+    ~CaptureReader() { Close(); }
+
+    // Map path and validate every record of it, so frames can be read without further checks.
+    bool Open(const std::string& path, std::string& error);
+    void Close();
+
+    const Fsr2CaptureHeader& Header() const { return *m_header; }
+    uint64_t FrameCount() const { return m_header ? m_header->frameCount : 0; }
+
+    const Fsr2CaptureFrame& Frame(uint64_t frame) const;
+    CaptureSurface Surface(uint64_t frame, Fsr2CaptureSurfaceIdentifier surface) const;
+
+    // Ask the OS to read the pages of a frame ahead of its use.
+    void Prefetch(uint64_t frame) const;
+
+private:
+    const uint8_t*           m_data       = nullptr;
+    uint64_t                 m_size       = 0;
+    const Fsr2CaptureHeader* m_header     = nullptr;
+    const uint64_t*          m_frameTable = nullptr;
+#ifdef _WIN32
+    void*                    m_file       = nullptr;
+    void*                    m_mapping    = nullptr;
+#endif // #ifdef _WIN32
+};
@@ -0,0 +1,751 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// fsr2_offline upscales an image sequence on disk with the CPU backend of FSR2. Frames are streamed
+// through a three stage pipeline: a decode thread reads the inputs of upcoming frames, the main
+// thread dispatches FSR2 in frame order and an encode thread writes the upscaled frames. The stages
+// share a fixed ring of preallocated frame slots, so memory use does not depend on the length of
+// the sequence and decoding or encoding a frame overlaps with upscaling its neighbours.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ffx_fsr2.h"
+#include "ffx_fsr2_trace.h"
+#include "cpu/ffx_fsr2_cpu.h"
+#include "record/ffx_fsr2_record.h"
+
+#include "CaptureFile.h"
+#include "FrameRing.h"
+#include "PfmImage.h"
+
+namespace {
+
+struct Options
+{
+    std::string      colorPattern;
+    std::string      depthPattern;
+    std::string      motionPattern;
+    std::string      reactivePattern;
+    std::string      outputPattern;
+    std::string      capturePath;
+    std::string      writeCapturePath;
+    std::string      recordPath;
+    std::string      tracePath;
+    uint64_t         recordCapacity         = 64;
+    FfxDimensions2D  displaySize            = { 0, 0 };
+    uint64_t         firstFrame             = 0;
+    uint64_t         frameCount             = 0;
+    uint32_t         ringSize               = 3;
+    uint32_t         batchSize              = 1;
+    uint32_t         threadCount            = 0;
+    uint64_t         resizeCount            = 0;
+    float            frameRate              = 60.0f;
+    float            cameraNear             = 0.1f;
+    float            cameraFar              = 1000.0f;
+    float            cameraFovAngleVertical = 1.0471976f;
+    FfxFloatCoords2D motionVectorScale      = { 1.0f, 1.0f };
+    float            sharpness              = 0.0f;
+    bool             enableSharpening       = false;
+    bool             hdr                    = false;
+    bool             invertedDepth          = false;
+    bool             deterministic          = false;
+};
+
+// The inputs and the output of a single frame in flight. The inputs either point at the decoded
+// images of the slot or straight into a mapped capture.
+struct FrameSlot
+{
+    Fsr2CaptureParameters parameters;
+    CaptureSurface        inputs[FSR2_CAPTURE_SURFACE_COUNT];
+    std::vector<float>    color;
+    std::vector<float>    depth;
+    std::vector<float>    motionVectors;
+    std::vector<float>    reactive;
+    std::vector<float>    output;
+};
+
+struct Sequence
+{
+    const Options&         options;
+    FfxDimensions2D        renderSize;
+    const CaptureReader*   capture;
+    CaptureWriter*         captureWriter;
+    FrameRing              ring;
+    std::vector<FrameSlot> slots;
+
+    Sequence(const Options& options, FfxDimensions2D renderSize, const CaptureReader* capture, CaptureWriter* captureWriter)
+        : options(options)
+        , renderSize(renderSize)
+        , capture(capture)
+        , captureWriter(captureWriter)
+        , ring(options.ringSize)
+        , slots(options.ringSize)
+    {
+        const size_t renderTexels  = size_t(renderSize.width) * renderSize.height;
+        const size_t displayTexels = size_t(options.displaySize.width) * options.displaySize.height;
+
+        for (FrameSlot& slot : slots) {
+            if (capture == nullptr) {
+                slot.color.resize(renderTexels * 4);
+                slot.depth.resize(renderTexels);
+                slot.motionVectors.resize(renderTexels * 2);
+                slot.reactive.resize(options.reactivePattern.empty() ? 0 : renderTexels);
+            }
+            slot.output.resize(displayTexels * 4);
+        }
+    }
+
+    void Fail(uint64_t frame, const std::string& error)
+    {
+        fprintf(stderr, "fsr2_offline: frame %llu: %s\n", (unsigned long long)(options.firstFrame + frame), error.c_str());
+        ring.Abort();
+    }
+};
+
+void PrintUsage()
+{
+    fprintf(stderr,
+        "usage: fsr2_offline --color <pattern> --depth <pattern> --motion <pattern> --output <pattern> [options]\n"
+        "       fsr2_offline --capture <file> --output <pattern> [options]\n"
+        "\n"
+        "Patterns are file paths holding a printf style frame number such as frame_%%05d.pfm. Inputs and\n"
+        "outputs are PFM images: color in PF, depth in Pf, motion vectors in the first two channels of PF\n"
+        "and the reactive mask in Pf. The render size is the size of the first color frame. Frames are\n"
+        "expected to be rendered with the jitter sequence of ffxFsr2GetJitterOffset, indexed by frame number.\n"
+        "\n"
+        "A capture file holds the inputs and the dispatch parameters of every frame and replaces the\n"
+        "image inputs and the camera options. Its surfaces are mapped, not read.\n"
+        "\n"
+        "options:\n"
+        "  --reactive <pattern>     reactive mask of each frame\n"
+        "  --write-capture <file>   store the inputs of every frame in a capture, --output becomes optional\n"
+        "  --record <file>          log the callbacks made into the CPU backend\n"
+        "  --record-capacity <MiB>  size of the callback log, 64 by default, it holds the inputs of every frame\n"
+        "  --trace <file>           write a Chrome trace of the FSR2 API calls, passes and jobs\n"
+        "  --display-size <WxH>     size of the output frames, twice the render size by default\n"
+        "  --first <n>              number of the first frame, 0 by default\n"
+        "  --count <n>              number of frames, by default up to the first missing color frame\n"
+        "  --ring <n>               number of frames in flight, 3 by default\n"
+        "  --batch <n>              frames upscaled per dispatch, at most --ring, 1 by default\n"
+        "  --threads <n>            host threads used by FSR2, all hardware threads by default\n"
+        "  --resizes <n>            resize the context to half its sizes and back n times before the first frame\n"
+        "  --fps <f>                frame rate of the sequence, 60 by default\n"
+        "  --near <f> --far <f>     camera planes, 0.1 and 1000 by default\n"
+        "  --fov <radians>          vertical field of view, 1.047 by default\n"
+        "  --mv-scale <x,y>         scale applied to the motion vectors, 1,1 by default\n"
+        "  --sharpness <f>          enable RCAS with a sharpness in [0..1]\n"
+        "  --hdr                    color holds HDR values\n"
+        "  --inverted-depth         depth is reversed, 1 at the near plane\n"
+        "  --deterministic          produce bit-identical output on every host\n");
+}
+
+bool ParseUnsigned(const char* text, uint64_t& value)
+{
+    char* end = nullptr;
+    value     = strtoull(text, &end, 10);
+    return end != text && *end == '\0';
+}
+
+bool ParseFloat(const char* text, float& value)
+{
+    char* end = nullptr;
+    value     = strtof(text, &end);
+    return end != text && *end == '\0';
+}
+
+bool ParsePair(const char* text, char separator, std::string& first, std::string& second)
+{
+    const char* split = strchr(text, separator);
+    if (split == nullptr) {
+        return false;
+    }
+
+    first.assign(text, split);
+    second.assign(split + 1);
+    return true;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+
+        const std::string name  = argv[i];
+        const char*       value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        uint64_t          number = 0;
+        std::string       first, second;
+        bool              valid = true;
+
+        if (name == "--hdr") {
+            options.hdr = true;
+            continue;
+        } else if (name == "--inverted-depth") {
+            options.invertedDepth = true;
+            continue;
+        } else if (name == "--deterministic") {
+            options.deterministic = true;
+            continue;
+        } else if (value == nullptr) {
+            fprintf(stderr, "fsr2_offline: %s needs a value\n", name.c_str());
+            return false;
+        }
+
+        if (name == "--color") {
+            options.colorPattern = value;
+        } else if (name == "--depth") {
+            options.depthPattern = value;
+        } else if (name == "--motion") {
+            options.motionPattern = value;
+        } else if (name == "--reactive") {
+            options.reactivePattern = value;
+        } else if (name == "--output") {
+            options.outputPattern = value;
+        } else if (name == "--capture") {
+            options.capturePath = value;
+        } else if (name == "--write-capture") {
+            options.writeCapturePath = value;
+        } else if (name == "--record") {
+            options.recordPath = value;
+        } else if (name == "--trace") {
+            options.tracePath = value;
+        } else if (name == "--record-capacity") {
+            valid = ParseUnsigned(value, options.recordCapacity) && options.recordCapacity >= 1 && options.recordCapacity <= 65536;
+        } else if (name == "--display-size") {
+            uint64_t width = 0, height = 0;
+            valid = ParsePair(value, 'x', first, second) && ParseUnsigned(first.c_str(), width) && ParseUnsigned(second.c_str(), height) &&
+                    width > 0 && height > 0 && width <= 16384 && height <= 16384;
+            options.displaySize = { uint32_t(width), uint32_t(height) };
+        } else if (name == "--first") {
+            valid = ParseUnsigned(value, options.firstFrame);
+        } else if (name == "--count") {
+            valid = ParseUnsigned(value, options.frameCount);
+        } else if (name == "--ring") {
+            valid = ParseUnsigned(value, number) && number >= 1 && number <= 64;
+            options.ringSize = uint32_t(number);
+        } else if (name == "--batch") {
+            valid = ParseUnsigned(value, number) && number >= 1 && number <= 64;
+            options.batchSize = uint32_t(number);
+        } else if (name == "--threads") {
+            valid = ParseUnsigned(value, number) && number <= 1024;
+            options.threadCount = uint32_t(number);
+        } else if (name == "--resizes") {
+            valid = ParseUnsigned(value, options.resizeCount);
+        } else if (name == "--fps") {
+            valid = ParseFloat(value, options.frameRate) && options.frameRate > 0.0f;
+        } else if (name == "--near") {
+            valid = ParseFloat(value, options.cameraNear);
+        } else if (name == "--far") {
+            valid = ParseFloat(value, options.cameraFar);
+        } else if (name == "--fov") {
+            valid = ParseFloat(value, options.cameraFovAngleVertical);
+        } else if (name == "--mv-scale") {
+            valid = ParsePair(value, ',', first, second) && ParseFloat(first.c_str(), options.motionVectorScale.x) &&
+                    ParseFloat(second.c_str(), options.motionVectorScale.y);
+        } else if (name == "--sharpness") {
+            valid = ParseFloat(value, options.sharpness) && options.sharpness >= 0.0f && options.sharpness <= 1.0f;
+            options.enableSharpening = true;
+        } else {
+            fprintf(stderr, "fsr2_offline: unknown option %s\n", name.c_str());
+            return false;
+        }
+
+        if (!valid) {
+            fprintf(stderr, "fsr2_offline: invalid value %s for %s\n", value, name.c_str());
+            return false;
+        }
+        ++i;
+    }
+
+    if (options.capturePath.empty() && (options.colorPattern.empty() || options.depthPattern.empty() || options.motionPattern.empty())) {
+        fprintf(stderr, "fsr2_offline: --color, --depth and --motion are required without --capture\n");
+        return false;
+    }
+    if (options.outputPattern.empty() && options.writeCapturePath.empty()) {
+        fprintf(stderr, "fsr2_offline: --output is required\n");
+        return false;
+    }
+    if (options.batchSize > options.ringSize) {
+        fprintf(stderr, "fsr2_offline: --batch cannot exceed --ring\n");
+        return false;
+    }
+
+    return true;
+}
+
+// Substitute the frame number for the single %d, %u or %0<width>d of pattern. The pattern is not
+// handed to printf, so paths cannot smuggle other conversions in.
+bool FormatFramePath(const std::string& pattern, uint64_t frame, std::string& path)
+{
+    path.clear();
+
+    bool substituted = false;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+
+        if (pattern[i] != '%') {
+            path += pattern[i];
+            continue;
+        }
+        if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+            path += '%';
+            ++i;
+            continue;
+        }
+
+        size_t   end   = i + 1;
+        uint32_t width = 0;
+        while (end < pattern.size() && pattern[end] >= '0' && pattern[end] <= '9' && width < 20) {
+            width = width * 10 + uint32_t(pattern[end++] - '0');
+        }
+        if (substituted || end >= pattern.size() || (pattern[end] != 'd' && pattern[end] != 'u')) {
+            return false;
+        }
+
+        const std::string digits = std::to_string(frame);
+        if (digits.size() < width) {
+            path.append(width - digits.size(), '0');
+        }
+        path += digits;
+
+        substituted = true;
+        i           = end;
+    }
+
+    return substituted;
+}
+
+bool FileExists(const std::string& path)
+{
+    return std::ifstream(path, std::ios::binary).good();
+}
+
+// Fill the slot of a frame read from the capture, which only points at the mapped surfaces.
+void MapCaptureFrame(const CaptureReader& capture, uint64_t number, FrameSlot& slot)
+{
+    capture.Prefetch(number);
+
+    slot.parameters = capture.Frame(number).parameters;
+    for (uint32_t surface = 0; surface < FSR2_CAPTURE_SURFACE_COUNT; ++surface) {
+        slot.inputs[surface] = capture.Surface(number, Fsr2CaptureSurfaceIdentifier(surface));
+    }
+}
+
+// Fill the slot of a frame decoded from images, with the parameters given on the command line.
+void SetImageFrame(const Sequence& sequence, uint64_t number, FrameSlot& slot)
+{
+    const Options& options    = sequence.options;
+    const int32_t  phaseCount = ffxFsr2GetJitterPhaseCount(sequence.renderSize.width, options.displaySize.width);
+
+    FfxFsr2DispatchDescription dispatchParameters = {};
+    ffxFsr2GetJitterOffset(&dispatchParameters.jitterOffset.x, &dispatchParameters.jitterOffset.y, int32_t(number % uint64_t(phaseCount)), phaseCount);
+
+    dispatchParameters.motionVectorScale       = options.motionVectorScale;
+    dispatchParameters.renderSize              = sequence.renderSize;
+    dispatchParameters.enableSharpening        = options.enableSharpening;
+    dispatchParameters.sharpness               = options.sharpness;
+    dispatchParameters.frameTimeDelta          = 1000.0f / options.frameRate;
+    dispatchParameters.preExposure             = 1.0f;
+    dispatchParameters.cameraNear              = options.cameraNear;
+    dispatchParameters.cameraFar               = options.cameraFar;
+    dispatchParameters.cameraFovAngleVertical  = options.cameraFovAngleVertical;
+    dispatchParameters.viewSpaceToMetersFactor = 1.0f;
+    CaptureStoreParameters(dispatchParameters, slot.parameters);
+
+    const uint32_t width  = sequence.renderSize.width;
+    const uint32_t height = sequence.renderSize.height;
+
+    slot.inputs[FSR2_CAPTURE_SURFACE_COLOR]          = { slot.color.data(), FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT, width, height, width * 16 };
+    slot.inputs[FSR2_CAPTURE_SURFACE_DEPTH]          = { slot.depth.data(), FFX_SURFACE_FORMAT_R32_FLOAT, width, height, width * 4 };
+    slot.inputs[FSR2_CAPTURE_SURFACE_MOTION_VECTORS] = { slot.motionVectors.data(), FFX_SURFACE_FORMAT_R32G32_FLOAT, width, height, width * 8 };
+    if (!slot.reactive.empty()) {
+        slot.inputs[FSR2_CAPTURE_SURFACE_REACTIVE] = { slot.reactive.data(), FFX_SURFACE_FORMAT_R32_FLOAT, width, height, width * 4 };
+    }
+}
+
+void DecodeStage(Sequence& sequence)
+{
+    const Options&     options = sequence.options;
+    const uint32_t     width   = sequence.renderSize.width;
+    const uint32_t     height  = sequence.renderSize.height;
+    std::vector<float> row;
+    std::string        path, error;
+
+    for (uint64_t frame = 0;; ++frame) {
+
+        const int32_t slotIndex = sequence.ring.Acquire(FrameRing::STAGE_DECODE, frame);
+        if (slotIndex < 0) {
+            return;
+        }
+
+        FrameSlot&     slot   = sequence.slots[slotIndex];
+        const uint64_t number = options.firstFrame + frame;
+
+        if (sequence.capture) {
+            MapCaptureFrame(*sequence.capture, number, slot);
+            sequence.ring.Release(FrameRing::STAGE_DECODE, frame);
+            continue;
+        }
+
+        FormatFramePath(options.colorPattern, number, path);
+        if (options.frameCount == 0 && !FileExists(path)) {
+            sequence.ring.End(frame);
+            return;
+        }
+
+        bool decoded = PfmRead(path, width, height, 4, 1.0f, slot.color.data(), row, error);
+        decoded      = decoded && FormatFramePath(options.depthPattern, number, path) && PfmRead(path, width, height, 1, 0.0f, slot.depth.data(), row, error);
+        decoded      = decoded && FormatFramePath(options.motionPattern, number, path) && PfmRead(path, width, height, 2, 0.0f, slot.motionVectors.data(), row, error);
+        if (decoded && !options.reactivePattern.empty()) {
+            decoded = FormatFramePath(options.reactivePattern, number, path) && PfmRead(path, width, height, 1, 0.0f, slot.reactive.data(), row, error);
+        }
+
+        if (!decoded) {
+            sequence.Fail(frame, error);
+            return;
+        }
+
+        SetImageFrame(sequence, number, slot);
+        sequence.ring.Release(FrameRing::STAGE_DECODE, frame);
+    }
+}
+
+void EncodeStage(Sequence& sequence)
+{
+    const Options&     options = sequence.options;
+    std::vector<float> row;
+    std::string        path, error;
+
+    for (uint64_t frame = 0;; ++frame) {
+
+        const int32_t slotIndex = sequence.ring.Acquire(FrameRing::STAGE_ENCODE, frame);
+        if (slotIndex < 0) {
+            return;
+        }
+
+        const FrameSlot& slot = sequence.slots[slotIndex];
+
+        if (!options.outputPattern.empty()) {
+            FormatFramePath(options.outputPattern, options.firstFrame + frame, path);
+            if (!PfmWrite(path, options.displaySize.width, options.displaySize.height, 4, slot.output.data(), row, error)) {
+                sequence.Fail(frame, error);
+                return;
+            }
+        }
+
+        if (sequence.captureWriter && !sequence.captureWriter->AppendFrame(slot.parameters, slot.inputs)) {
+            sequence.Fail(frame, "cannot write " + options.writeCapturePath);
+            return;
+        }
+
+        sequence.ring.Release(FrameRing::STAGE_ENCODE, frame);
+    }
+}
+
+// Dispatch FSR2 on every frame in order, on the calling thread. Returns the number of frames upscaled.
+uint64_t UpscaleStage(Sequence& sequence, FfxFsr2Context* context)
+{
+    static const wchar_t* inputNames[FSR2_CAPTURE_SURFACE_COUNT] = {
+        L"FSR2_InputColor",
+        L"FSR2_InputDepth",
+        L"FSR2_InputMotionVectors",
+        L"FSR2_InputExposure",
+        L"FSR2_InputReactiveMap",
+        L"FSR2_TransparencyAndCompositionMap",
+    };
+
+    const Options& options = sequence.options;
+
+    const FfxResourceDescription outputDescription = { FFX_RESOURCE_TYPE_TEXTURE2D, FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT, options.displaySize.width, options.displaySize.height, 1, 1, FFX_RESOURCE_FLAGS_NONE };
+
+    std::vector<FfxFsr2DispatchDescription> batch(options.batchSize);
+
+    uint64_t frame = 0;
+    for (;;) {
+
+        // gather up to batchSize decoded frames, fewer at the end of the sequence
+        uint32_t batchCount = 0;
+        for (; batchCount < options.batchSize; ++batchCount) {
+
+            const int32_t slotIndex = sequence.ring.Acquire(FrameRing::STAGE_UPSCALE, frame + batchCount);
+            if (slotIndex < 0) {
+                break;
+            }
+
+            FrameSlot& slot = sequence.slots[slotIndex];
+
+            FfxResource inputs[FSR2_CAPTURE_SURFACE_COUNT] = {};
+            for (uint32_t surface = 0; surface < FSR2_CAPTURE_SURFACE_COUNT; ++surface) {
+
+                const CaptureSurface& input = slot.inputs[surface];
+                if (input.data) {
+                    const FfxResourceDescription description = { FFX_RESOURCE_TYPE_TEXTURE2D, input.format, input.width, input.height, 1, 1, FFX_RESOURCE_FLAGS_NONE };
+                    inputs[surface] = ffxGetResourceCPU(context, const_cast<void*>(input.data), description, input.rowPitch, inputNames[surface]);
+                }
+            }
+
+            FfxFsr2DispatchDescription& dispatchParameters = batch[batchCount];
+            dispatchParameters = {};
+            CaptureLoadParameters(slot.parameters, dispatchParameters);
+
+            dispatchParameters.commandList                = ffxGetCommandListCPU();
+            dispatchParameters.color                      = inputs[FSR2_CAPTURE_SURFACE_COLOR];
+            dispatchParameters.depth                      = inputs[FSR2_CAPTURE_SURFACE_DEPTH];
+            dispatchParameters.motionVectors              = inputs[FSR2_CAPTURE_SURFACE_MOTION_VECTORS];
+            dispatchParameters.exposure                   = inputs[FSR2_CAPTURE_SURFACE_EXPOSURE];
+            dispatchParameters.reactive                   = inputs[FSR2_CAPTURE_SURFACE_REACTIVE];
+            dispatchParameters.transparencyAndComposition = inputs[FSR2_CAPTURE_SURFACE_TRANSPARENCY_AND_COMPOSITION];
+            dispatchParameters.output                     = ffxGetResourceCPU(context, slot.output.data(), outputDescription, 0, L"FSR2_OutputUpscaledColor", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+
+            // the history starts with the first frame upscaled, wherever it is in the sequence
+            dispatchParameters.reset = dispatchParameters.reset || (frame + batchCount == 0);
+            slot.parameters.reset    = dispatchParameters.reset ? 1 : 0;
+        }
+
+        if (batchCount == 0) {
+            break;
+        }
+
+        const FfxErrorCode errorCode = ffxFsr2ContextDispatchBatch(context, batch.data(), batchCount);
+        if (errorCode != FFX_OK) {
+            sequence.Fail(frame, "ffxFsr2ContextDispatchBatch failed with error " + std::to_string(errorCode));
+            break;
+        }
+
+        for (uint32_t i = 0; i < batchCount; ++i) {
+            sequence.ring.Release(FrameRing::STAGE_UPSCALE, frame + i);
+        }
+
+        const uint64_t previousFrame = frame;
+        frame += batchCount;
+        if (frame / 100 != previousFrame / 100) {
+            printf("fsr2_offline: upscaled %llu frames\n", (unsigned long long)(frame / 100 * 100));
+            fflush(stdout);
+        }
+
+        if (batchCount < options.batchSize) {
+            break;
+        }
+    }
+
+    return frame;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string firstColor;
+    for (const std::string* pattern : { &options.colorPattern, &options.depthPattern, &options.motionPattern, &options.reactivePattern, &options.outputPattern }) {
+        if (!pattern->empty() && !FormatFramePath(*pattern, options.firstFrame, firstColor)) {
+            fprintf(stderr, "fsr2_offline: %s needs a single %%d frame number\n", pattern->c_str());
+            return 1;
+        }
+    }
+
+    uint32_t        flags = FFX_FSR2_ENABLE_AUTO_EXPOSURE;
+    FfxDimensions2D renderSize = {};
+    CaptureReader   capture;
+    std::string     error;
+
+    flags |= options.hdr ? FFX_FSR2_ENABLE_HIGH_DYNAMIC_RANGE : 0;
+    flags |= options.invertedDepth ? FFX_FSR2_ENABLE_DEPTH_INVERTED : 0;
+
+    if (!options.capturePath.empty()) {
+        if (!capture.Open(options.capturePath, error)) {
+            fprintf(stderr, "fsr2_offline: %s\n", error.c_str());
+            return 1;
+        }
+        if (options.firstFrame >= capture.FrameCount()) {
+            fprintf(stderr, "fsr2_offline: %s holds %llu frames\n", options.capturePath.c_str(), (unsigned long long)capture.FrameCount());
+            return 1;
+        }
+
+        const uint64_t available = capture.FrameCount() - options.firstFrame;
+        options.frameCount = (options.frameCount == 0 || options.frameCount > available) ? available : options.frameCount;
+
+        flags      = capture.Header().flags;
+        renderSize = { capture.Header().maxRenderWidth, capture.Header().maxRenderHeight };
+        if (options.displaySize.width == 0) {
+            options.displaySize = { capture.Header().displayWidth, capture.Header().displayHeight };
+        }
+    } else {
+        FormatFramePath(options.colorPattern, options.firstFrame, firstColor);
+        if (!PfmReadSize(firstColor, renderSize.width, renderSize.height)) {
+            fprintf(stderr, "fsr2_offline: cannot read %s\n", firstColor.c_str());
+            return 1;
+        }
+    }
+
+    if (options.displaySize.width == 0) {
+        options.displaySize = { renderSize.width * 2, renderSize.height * 2 };
+    }
+    if (options.displaySize.width < renderSize.width || options.displaySize.height < renderSize.height) {
+        fprintf(stderr, "fsr2_offline: the display size is smaller than the render size\n");
+        return 1;
+    }
+
+    std::vector<uint8_t>      scratchBuffer(ffxFsr2GetScratchMemorySizeCPU());
+    FfxFsr2Interface          backendInterface = {};
+    FfxFsr2ContextDescription contextDescription = {};
+    FfxErrorCode              errorCode = ffxFsr2GetInterfaceCPU(&backendInterface, options.threadCount, scratchBuffer.data(), scratchBuffer.size());
+    if (errorCode == FFX_OK) {
+        errorCode = ffxFsr2SetDeterministicCPU(&backendInterface, options.deterministic);
+    }
+    if (errorCode != FFX_OK) {
+        fprintf(stderr, "fsr2_offline: cannot create the CPU backend, error %d\n", errorCode);
+        return 1;
+    }
+
+    // the recording backend forwards every callback to the CPU backend
+    std::vector<uint8_t> recordScratchBuffer;
+    contextDescription.callbacks = backendInterface;
+    if (!options.recordPath.empty()) {
+        recordScratchBuffer.resize(ffxFsr2GetScratchMemorySizeRecord(size_t(options.recordCapacity) << 20));
+        errorCode = ffxFsr2GetInterfaceRecord(&contextDescription.callbacks, &backendInterface, recordScratchBuffer.data(), recordScratchBuffer.size());
+        if (errorCode != FFX_OK) {
+            fprintf(stderr, "fsr2_offline: cannot create the recording backend, error %d\n", errorCode);
+            return 1;
+        }
+    }
+
+    contextDescription.flags         = flags;
+    contextDescription.maxRenderSize = renderSize;
+    contextDescription.displaySize   = options.displaySize;
+    contextDescription.device        = ffxGetDeviceCPU();
+
+    std::unique_ptr<FfxFsr2Context> context(new FfxFsr2Context);
+    errorCode = ffxFsr2ContextCreate(context.get(), &contextDescription);
+    if (errorCode != FFX_OK) {
+        fprintf(stderr, "fsr2_offline: ffxFsr2ContextCreate failed with error %d\n", errorCode);
+        return 1;
+    }
+
+    // every resize resets the history, so the frames come out as they do without resizing
+    for (uint64_t resize = 0; resize < options.resizeCount * 2; ++resize) {
+        const FfxDimensions2D halfRenderSize  = { FFX_MAXIMUM(renderSize.width / 2, 1u), FFX_MAXIMUM(renderSize.height / 2, 1u) };
+        const FfxDimensions2D halfDisplaySize = { FFX_MAXIMUM(options.displaySize.width / 2, 1u), FFX_MAXIMUM(options.displaySize.height / 2, 1u) };
+        const bool            half            = (resize % 2) == 0;
+        const FfxDimensions2D maxRenderSize   = half ? halfRenderSize : renderSize;
+        const FfxDimensions2D displaySize     = half ? halfDisplaySize : options.displaySize;
+
+        errorCode = ffxFsr2ContextResize(context.get(), maxRenderSize, displaySize, 0);
+        if (errorCode != FFX_OK) {
+            fprintf(stderr, "fsr2_offline: resize %llu failed with error %d\n", (unsigned long long)(resize / 2 + 1), errorCode);
+            ffxFsr2ContextDestroy(context.get());
+            return 1;
+        }
+    }
+
+    CaptureWriter captureWriter;
+    if (!options.writeCapturePath.empty() && !captureWriter.Open(options.writeCapturePath, flags, renderSize, options.displaySize)) {
+        fprintf(stderr, "fsr2_offline: cannot create %s\n", options.writeCapturePath.c_str());
+        ffxFsr2ContextDestroy(context.get());
+        return 1;
+    }
+
+    printf("fsr2_offline: %ux%u -> %ux%u, %u frames in flight\n", renderSize.width, renderSize.height, options.displaySize.width, options.displaySize.height, options.ringSize);
+
+    ffxFsr2TraceSetEnabled(!options.tracePath.empty());
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    uint64_t frameCount = 0;
+    bool     succeeded  = false;
+    {
+        Sequence sequence(options, renderSize, options.capturePath.empty() ? nullptr : &capture, options.writeCapturePath.empty() ? nullptr : &captureWriter);
+        if (options.frameCount != 0) {
+            sequence.ring.End(options.frameCount);
+        }
+
+        std::thread decoder(DecodeStage, std::ref(sequence));
+        std::thread encoder(EncodeStage, std::ref(sequence));
+
+        frameCount = UpscaleStage(sequence, context.get());
+
+        decoder.join();
+        encoder.join();
+        succeeded = !sequence.ring.Aborted();
+    }
+
+    ffxFsr2ContextDestroy(context.get());
+
+    // keep the frames captured before an error
+    if (!options.writeCapturePath.empty() && !captureWriter.Close()) {
+        fprintf(stderr, "fsr2_offline: cannot write %s\n", options.writeCapturePath.c_str());
+        succeeded = false;
+    }
+
+    if (!options.recordPath.empty()) {
+        const void* log                = nullptr;
+        size_t      logSize            = 0;
+        uint64_t    droppedRecordCount = 0;
+        ffxFsr2GetRecordLog(&contextDescription.callbacks, &log, &logSize, &droppedRecordCount);
+
+        std::ofstream file(options.recordPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(static_cast<const char*>(log), std::streamsize(logSize))) {
+            fprintf(stderr, "fsr2_offline: cannot write %s\n", options.recordPath.c_str());
+            succeeded = false;
+        }
+        if (droppedRecordCount) {
+            fprintf(stderr, "fsr2_offline: the callback log is full, %llu records were dropped\n", (unsigned long long)droppedRecordCount);
+        }
+    }
+
+    if (!options.tracePath.empty()) {
+        ffxFsr2TraceSetEnabled(false);
+
+        std::ofstream file(options.tracePath, std::ios::trunc);
+        uint64_t      droppedEventCount = 0;
+        ffxFsr2TraceFlush([](const char* text, size_t textLength, void* userData) {
+            static_cast<std::ofstream*>(userData)->write(text, std::streamsize(textLength));
+        }, &file, &droppedEventCount);
+
+        if (!file.flush()) {
+            fprintf(stderr, "fsr2_offline: cannot write %s\n", options.tracePath.c_str());
+            succeeded = false;
+        }
+        if (droppedEventCount) {
+            fprintf(stderr, "fsr2_offline: the trace is full, %llu events were dropped\n", (unsigned long long)droppedEventCount);
+        }
+    }
+
+    if (!succeeded) {
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    printf("fsr2_offline: upscaled %llu frames in %.2fs, %.2f frames per second\n", (unsigned long long)frameCount, seconds, seconds > 0.0 ? double(frameCount) / seconds : 0.0);
+
+    return 0;
+}
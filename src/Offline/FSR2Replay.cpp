@@ -0,0 +1,224 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// fsr2_replay executes the job stream of a log written with fsr2_offline --record, or by any
+// application wrapping its backend with ffxFsr2GetInterfaceRecord, against the CPU backend and
+// reports where the time goes pass by pass.
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ffx_fsr2.h"
+#include "cpu/ffx_fsr2_cpu.h"
+
+#include "ReplayLog.h"
+
+namespace {
+
+struct Options
+{
+    std::string logPath;
+    uint64_t    skipFrameCount = 1;
+    uint64_t    repeatCount    = 1;
+    uint32_t    threadCount    = 0;
+    ReplayMode  mode           = REPLAY_MODE_PASS;
+    bool        deterministic  = false;
+};
+
+void PrintUsage()
+{
+    fprintf(stderr,
+        "usage: fsr2_replay <log> [options]\n"
+        "\n"
+        "Replays the callbacks of a log written by the recording backend into the CPU backend and prints\n"
+        "the wall time, the jobs per second and the bytes bound of every pass. The inputs registered by the\n"
+        "application are replayed with their recorded contents when the log holds them, which it does when\n"
+        "the recorded backend can read its resources from the host, as the CPU backend does. The outputs\n"
+        "and the inputs of logs without contents are replayed zeroed.\n"
+        "\n"
+        "options:\n"
+        "  --skip <n>               frames left out of the statistics, 1 by default\n"
+        "  --repeat <n>             number of times the log is replayed, 1 by default\n"
+        "  --threads <n>            host threads used by the CPU backend, all hardware threads by default\n"
+        "  --frames                 execute the jobs of a frame at once, as recorded, and only time frames\n"
+        "  --deterministic          run the deterministic mode of the CPU backend\n");
+}
+
+bool ParseUnsigned(const char* text, uint64_t& value)
+{
+    char* end = nullptr;
+    value     = strtoull(text, &end, 10);
+    return end != text && *end == '\0';
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+
+        const std::string name  = argv[i];
+        const char*       value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        uint64_t          number = 0;
+        bool              valid = true;
+
+        if (name == "--frames") {
+            options.mode = REPLAY_MODE_FRAME;
+            continue;
+        } else if (name == "--deterministic") {
+            options.deterministic = true;
+            continue;
+        } else if (name.compare(0, 2, "--") != 0) {
+            if (!options.logPath.empty()) {
+                fprintf(stderr, "fsr2_replay: more than one log\n");
+                return false;
+            }
+            options.logPath = name;
+            continue;
+        } else if (value == nullptr) {
+            fprintf(stderr, "fsr2_replay: %s needs a value\n", name.c_str());
+            return false;
+        }
+
+        if (name == "--skip") {
+            valid = ParseUnsigned(value, options.skipFrameCount);
+        } else if (name == "--repeat") {
+            valid = ParseUnsigned(value, options.repeatCount) && options.repeatCount >= 1;
+        } else if (name == "--threads") {
+            valid = ParseUnsigned(value, number) && number <= 1024;
+            options.threadCount = uint32_t(number);
+        } else {
+            fprintf(stderr, "fsr2_replay: unknown option %s\n", name.c_str());
+            return false;
+        }
+
+        if (!valid) {
+            fprintf(stderr, "fsr2_replay: invalid value %s for %s\n", value, name.c_str());
+            return false;
+        }
+        ++i;
+    }
+
+    if (options.logPath.empty()) {
+        fprintf(stderr, "fsr2_replay: no log\n");
+        return false;
+    }
+
+    return true;
+}
+
+void Accumulate(ReplayStatistics& total, const ReplayStatistics& statistics)
+{
+    for (uint32_t pass = 0; pass < REPLAY_PASS_COUNT; ++pass) {
+        total.passes[pass].jobCount    += statistics.passes[pass].jobCount;
+        total.passes[pass].groupCount  += statistics.passes[pass].groupCount;
+        total.passes[pass].bytes       += statistics.passes[pass].bytes;
+        total.passes[pass].nanoseconds += statistics.passes[pass].nanoseconds;
+    }
+    total.frameCount  += statistics.frameCount;
+    total.nanoseconds += statistics.nanoseconds;
+}
+
+void PrintStatistics(const ReplayStatistics& statistics, ReplayMode mode)
+{
+    const double frameCount = double(FFX_MAXIMUM(statistics.frameCount, uint64_t(1)));
+
+    printf("%-28s %8s %10s %12s %10s %12s %10s\n", "pass", "jobs", "ms/frame", "jobs/s", "groups", "MiB/frame", "GiB/s");
+    for (uint32_t pass = 0; pass < REPLAY_PASS_COUNT; ++pass) {
+
+        const ReplayPassStatistics& passStatistics = statistics.passes[pass];
+        if (passStatistics.jobCount == 0) {
+            continue;
+        }
+
+        const double seconds = double(passStatistics.nanoseconds) * 1e-9;
+        const double mebibytes = double(passStatistics.bytes) / double(1 << 20) / frameCount;
+        if (mode == REPLAY_MODE_PASS) {
+            printf("%-28s %8llu %10.3f %12.0f %10llu %12.2f %10.2f\n", GetReplayPassName(pass), (unsigned long long)passStatistics.jobCount,
+                seconds * 1e3 / frameCount, seconds > 0.0 ? double(passStatistics.jobCount) / seconds : 0.0,
+                (unsigned long long)passStatistics.groupCount, mebibytes,
+                seconds > 0.0 ? double(passStatistics.bytes) / double(1 << 30) / seconds : 0.0);
+        } else {
+            printf("%-28s %8llu %10s %12s %10llu %12.2f %10s\n", GetReplayPassName(pass), (unsigned long long)passStatistics.jobCount,
+                "-", "-", (unsigned long long)passStatistics.groupCount, mebibytes, "-");
+        }
+    }
+
+    uint64_t jobCount = 0;
+    for (const ReplayPassStatistics& passStatistics : statistics.passes) {
+        jobCount += passStatistics.jobCount;
+    }
+
+    const double seconds = double(statistics.nanoseconds) * 1e-9;
+    printf("%llu frames, %.3f ms/frame, %.0f jobs/s\n", (unsigned long long)statistics.frameCount, seconds * 1e3 / frameCount,
+        seconds > 0.0 ? double(jobCount) / seconds : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    ReplayLog   log;
+    std::string error;
+    if (!log.Load(options.logPath, error)) {
+        fprintf(stderr, "fsr2_replay: %s\n", error.c_str());
+        return 1;
+    }
+    if (log.FrameCount() <= options.skipFrameCount) {
+        fprintf(stderr, "fsr2_replay: %s holds %u frames\n", options.logPath.c_str(), log.FrameCount());
+        return 1;
+    }
+
+    std::vector<uint8_t> scratchBuffer(ffxFsr2GetScratchMemorySizeCPU());
+    FfxFsr2Interface     backendInterface = {};
+    FfxErrorCode         errorCode = ffxFsr2GetInterfaceCPU(&backendInterface, options.threadCount, scratchBuffer.data(), scratchBuffer.size());
+    if (errorCode == FFX_OK) {
+        errorCode = ffxFsr2SetDeterministicCPU(&backendInterface, options.deterministic);
+    }
+    if (errorCode != FFX_OK) {
+        fprintf(stderr, "fsr2_replay: cannot create the CPU backend, error %d\n", errorCode);
+        return 1;
+    }
+
+    ReplayStatistics total = {};
+    for (uint64_t repeat = 0; repeat < options.repeatCount; ++repeat) {
+
+        // a replay leaves the backend context of the log destroyed, so each repeat starts over
+        std::unique_ptr<Replayer> replayer(new Replayer(log, &backendInterface, ffxGetDeviceCPU(), ffxGetCommandListCPU()));
+        ReplayStatistics statistics;
+        if (!replayer->Run(options.mode, uint32_t(FFX_MINIMUM(options.skipFrameCount, uint64_t(UINT32_MAX))), statistics, error)) {
+            fprintf(stderr, "fsr2_replay: %s\n", error.c_str());
+            return 1;
+        }
+        Accumulate(total, statistics);
+    }
+
+    PrintStatistics(total, options.mode);
+    return 0;
+}
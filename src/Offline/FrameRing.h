@@ -0,0 +1,127 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Hands a fixed number of frame slots through the decode, upscale and encode stages of
+// fsr2_offline. Frame n always lives in slot n % slotCount, and every stage processes frames in
+// order, so a slot only moves on to frame n + slotCount once the encoder released frame n. The
+// slots themselves are owned by the caller; the ring only tracks which stage each one belongs to.
+class FrameRing
+{
+public:
+    enum Stage
+    {
+        STAGE_DECODE,
+        STAGE_UPSCALE,
+        STAGE_ENCODE,
+
+        STAGE_COUNT
+    };
+
+    static const uint64_t UNBOUNDED = ~0ull;
+
+    explicit FrameRing(uint32_t slotCount)
+        : m_slots(slotCount)
+    {
+        for (uint32_t i = 0; i < slotCount; ++i) {
+            m_slots[i].frame = i;
+            m_slots[i].stage = STAGE_DECODE;
+        }
+    }
+
+    uint32_t SlotCount() const { return uint32_t(m_slots.size()); }
+
+    // Block until frame is ready for stage. Returns the slot holding it, or -1 once the sequence
+    // ended before frame or the ring was aborted.
+    int32_t Acquire(Stage stage, uint64_t frame)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        const uint32_t slot = uint32_t(frame % m_slots.size());
+        m_condition.wait(lock, [&]() { return m_aborted || frame >= m_frameCount || (m_slots[slot].frame == frame && m_slots[slot].stage == stage); });
+
+        return (m_aborted || frame >= m_frameCount) ? -1 : int32_t(slot);
+    }
+
+    // Pass frame, acquired by stage, on to the next stage.
+    void Release(Stage stage, uint64_t frame)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            Slot& slot = m_slots[frame % m_slots.size()];
+            if (stage == STAGE_ENCODE) {
+                slot.frame += m_slots.size();
+                slot.stage = STAGE_DECODE;
+            } else {
+                slot.stage = Stage(stage + 1);
+            }
+        }
+        m_condition.notify_all();
+    }
+
+    // Mark the end of the sequence, frameCount frames long, which the decoder only learns when it
+    // fails to find the next frame.
+    void End(uint64_t frameCount)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_frameCount = frameCount;
+        }
+        m_condition.notify_all();
+    }
+
+    // Wake every stage after an error, making any pending and future Acquire fail.
+    void Abort()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_aborted = true;
+        }
+        m_condition.notify_all();
+    }
+
+    bool Aborted()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_aborted;
+    }
+
+private:
+    struct Slot
+    {
+        uint64_t frame;
+        Stage    stage;
+    };
+
+    std::mutex              m_mutex;
+    std::condition_variable m_condition;
+    std::vector<Slot>       m_slots;
+    uint64_t                m_frameCount = UNBOUNDED;
+    bool                    m_aborted    = false;
+};
@@ -0,0 +1,166 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "PfmImage.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+struct PfmHeader
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    bool     bigEndian;
+};
+
+bool readHeader(std::ifstream& file, PfmHeader& header)
+{
+    std::string magic;
+    float       scale = 0.0f;
+    file >> magic >> header.width >> header.height >> scale;
+
+    // a single whitespace character separates the header from the texels
+    file.get();
+    if (!file || (magic != "PF" && magic != "Pf") || header.width == 0 || header.height == 0 || scale == 0.0f) {
+        return false;
+    }
+
+    header.channels  = (magic == "PF") ? 3 : 1;
+    header.bigEndian = scale > 0.0f;
+    return true;
+}
+
+void swapBytes(float* values, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        bits = (bits >> 24) | ((bits >> 8) & 0xff00u) | ((bits << 8) & 0xff0000u) | (bits << 24);
+        memcpy(&values[i], &bits, sizeof(bits));
+    }
+}
+
+} // namespace
+
+bool PfmReadSize(const std::string& path, uint32_t& width, uint32_t& height)
+{
+    std::ifstream file(path, std::ios::binary);
+    PfmHeader     header;
+    if (!file || !readHeader(file, header)) {
+        return false;
+    }
+
+    width  = header.width;
+    height = header.height;
+    return true;
+}
+
+bool PfmRead(const std::string& path, uint32_t width, uint32_t height, uint32_t dstChannels, float fill, float* dst, std::vector<float>& row, std::string& error)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    PfmHeader header;
+    if (!readHeader(file, header)) {
+        error = path + " is not a PFM image";
+        return false;
+    }
+    if (header.width != width || header.height != height) {
+        error = path + " is " + std::to_string(header.width) + "x" + std::to_string(header.height) + ", expected " + std::to_string(width) + "x" + std::to_string(height);
+        return false;
+    }
+
+    const size_t rowValues = size_t(width) * header.channels;
+    if (row.size() < rowValues) {
+        row.resize(rowValues);
+    }
+
+    const uint32_t copyChannels = (header.channels < dstChannels) ? header.channels : dstChannels;
+    for (uint32_t fileRow = 0; fileRow < height; ++fileRow) {
+
+        if (!file.read(reinterpret_cast<char*>(row.data()), std::streamsize(rowValues * sizeof(float)))) {
+            error = path + " is truncated";
+            return false;
+        }
+        if (header.bigEndian) {
+            swapBytes(row.data(), rowValues);
+        }
+
+        // rows are stored bottom to top
+        float*       texel  = dst + size_t(height - 1 - fileRow) * width * dstChannels;
+        const float* source = row.data();
+        for (uint32_t x = 0; x < width; ++x, texel += dstChannels, source += header.channels) {
+            uint32_t channel = 0;
+            for (; channel < copyChannels; ++channel) {
+                texel[channel] = source[channel];
+            }
+            for (; channel < dstChannels; ++channel) {
+                texel[channel] = fill;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool PfmWrite(const std::string& path, uint32_t width, uint32_t height, uint32_t srcChannels, const float* src, std::vector<float>& row, std::string& error)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    // a negative scale marks little endian texels
+    file << "PF\n" << width << " " << height << "\n-1.0\n";
+
+    const size_t rowValues = size_t(width) * 3;
+    if (row.size() < rowValues) {
+        row.resize(rowValues);
+    }
+
+    for (uint32_t fileRow = 0; fileRow < height; ++fileRow) {
+
+        const float* texel = src + size_t(height - 1 - fileRow) * width * srcChannels;
+        float*       dest  = row.data();
+        for (uint32_t x = 0; x < width; ++x, texel += srcChannels, dest += 3) {
+            dest[0] = texel[0];
+            dest[1] = texel[1];
+            dest[2] = texel[2];
+        }
+
+        file.write(reinterpret_cast<const char*>(row.data()), std::streamsize(rowValues * sizeof(float)));
+    }
+
+    if (!file.flush()) {
+        error = "cannot write " + path;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,45 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Portable Float Map (.pfm) images, the uncompressed float format fsr2_offline streams frames in.
+// "PF" files hold 3 channels and "Pf" files a single one, stored bottom row first. Both functions
+// go through a caller owned row buffer, so decoding or encoding a frame never allocates once the
+// row buffer has grown to the widest image.
+
+// Read the size of a PFM image without decoding it. Returns false when the file cannot be opened
+// or is not a PFM image.
+bool PfmReadSize(const std::string& path, uint32_t& width, uint32_t& height);
+
+// Decode a width x height PFM image into dst, top row first, with dstChannels floats per texel.
+// Channels missing from the file are set to fill, surplus channels of the file are dropped.
+// Returns false and sets error when the file cannot be read or its size does not match.
+bool PfmRead(const std::string& path, uint32_t width, uint32_t height, uint32_t dstChannels, float fill, float* dst, std::vector<float>& row, std::string& error);
+
+// Encode the first 3 channels of a width x height image held top row first in src, with
+// srcChannels floats per texel, as a little endian "PF" image.
+bool PfmWrite(const std::string& path, uint32_t width, uint32_t height, uint32_t srcChannels, const float* src, std::vector<float>& row, std::string& error);
@@ -0,0 +1,693 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "ReplayLog.h"
+#include "SurfaceFormat.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// Recorded internal indices and pipeline indices are small, anything larger is a corrupted log.
+const uint32_t REPLAY_MAX_INDEX = 1 << 16;
+
+// Upper bound of the samplers of a pipeline description, the passes use at most two.
+const uint32_t REPLAY_MAX_SAMPLER_COUNT = 16;
+
+template <typename Payload>
+const Payload& payloadAs(const ReplayRecord& record)
+{
+    return *reinterpret_cast<const Payload*>(record.payload);
+}
+
+FfxResourceDescription toResourceDescription(const FfxFsr2RecordResourceDescription& description)
+{
+    FfxResourceDescription result;
+    result.type     = FfxResourceType(description.type);
+    result.format   = FfxSurfaceFormat(description.format);
+    result.width    = description.width;
+    result.height   = description.height;
+    result.depth    = description.depth;
+    result.mipCount = description.mipCount;
+    result.flags    = FfxResourceFlags(description.flags);
+    return result;
+}
+
+bool sameDescription(const FfxResourceDescription& a, const FfxResourceDescription& b)
+{
+    return a.type == b.type && a.format == b.format && a.width == b.width && a.height == b.height &&
+           a.depth == b.depth && a.mipCount == b.mipCount;
+}
+
+uint64_t getResourceSize(const FfxResourceDescription& description, uint32_t mip)
+{
+    const uint64_t width  = FFX_MAXIMUM(1u, description.width >> mip);
+    const uint64_t height = FFX_MAXIMUM(1u, description.height >> mip);
+    const uint64_t depth  = FFX_MAXIMUM(1u, description.depth);
+    return width * height * depth * GetSurfaceFormatSize(description.format);
+}
+
+const size_t INVALID_PAYLOAD_SIZE = ~size_t(0);
+
+// Minimum payload size of a record, or INVALID_PAYLOAD_SIZE when its counts are out of range.
+size_t getPayloadSize(const ReplayRecord& record)
+{
+    switch (record.type) {
+
+    case FFX_FSR2_RECORD_TYPE_BEGIN_LOG:
+        return sizeof(FfxFsr2RecordBeginLog);
+
+    case FFX_FSR2_RECORD_TYPE_CREATE_RESOURCE:
+        if (record.payloadSize < sizeof(FfxFsr2RecordCreateResource)) {
+            return INVALID_PAYLOAD_SIZE;
+        }
+        return sizeof(FfxFsr2RecordCreateResource) + size_t(payloadAs<FfxFsr2RecordCreateResource>(record).initDataSize);
+
+    case FFX_FSR2_RECORD_TYPE_REGISTER_RESOURCE:
+        if (record.payloadSize < sizeof(FfxFsr2RecordRegisterResource)) {
+            return INVALID_PAYLOAD_SIZE;
+        }
+        return sizeof(FfxFsr2RecordRegisterResource) + size_t(payloadAs<FfxFsr2RecordRegisterResource>(record).dataSize);
+
+    case FFX_FSR2_RECORD_TYPE_DESTROY_RESOURCE:
+        return sizeof(FfxFsr2RecordDestroyResource);
+
+    case FFX_FSR2_RECORD_TYPE_CREATE_PIPELINE: {
+        if (record.payloadSize < sizeof(FfxFsr2RecordCreatePipeline)) {
+            return INVALID_PAYLOAD_SIZE;
+        }
+        const FfxFsr2RecordCreatePipeline& pipeline = payloadAs<FfxFsr2RecordCreatePipeline>(record);
+        if (pipeline.pass >= FFX_FSR2_PASS_COUNT || pipeline.samplerCount > REPLAY_MAX_SAMPLER_COUNT || pipeline.rootConstantBufferCount > FFX_MAX_NUM_CONST_BUFFERS) {
+            return INVALID_PAYLOAD_SIZE;
+        }
+        return sizeof(FfxFsr2RecordCreatePipeline) + (pipeline.samplerCount + pipeline.rootConstantBufferCount) * sizeof(uint32_t);
+    }
+
+    case FFX_FSR2_RECORD_TYPE_DESTROY_PIPELINE:
+        return sizeof(FfxFsr2RecordDestroyPipeline);
+
+    case FFX_FSR2_RECORD_TYPE_SCHEDULE_JOB: {
+        if (record.payloadSize < sizeof(FfxFsr2RecordScheduleJob)) {
+            return INVALID_PAYLOAD_SIZE;
+        }
+        const FfxFsr2RecordScheduleJob& job = payloadAs<FfxFsr2RecordScheduleJob>(record);
+        if (job.jobType != FFX_GPU_JOB_COMPUTE) {
+            return (job.jobType == FFX_GPU_JOB_CLEAR_FLOAT || job.jobType == FFX_GPU_JOB_COPY) ? sizeof(FfxFsr2RecordScheduleJob) : INVALID_PAYLOAD_SIZE;
+        }
+        if (job.compute.srvCount > FFX_MAX_NUM_SRVS || job.compute.uavCount > FFX_MAX_NUM_UAVS || job.compute.cbCount > FFX_MAX_NUM_CONST_BUFFERS) {
+            return INVALID_PAYLOAD_SIZE;
+        }
+
+        // the constant buffers are variable sized, walk them
+        size_t size = sizeof(FfxFsr2RecordScheduleJob) + (job.compute.srvCount + 2 * job.compute.uavCount) * sizeof(uint32_t);
+        for (uint32_t i = 0; i < job.compute.cbCount; ++i) {
+            if (size + 2 * sizeof(uint32_t) > record.payloadSize) {
+                return INVALID_PAYLOAD_SIZE;
+            }
+            const uint32_t cbSize = *reinterpret_cast<const uint32_t*>(record.payload + size + sizeof(uint32_t));
+            if (cbSize > FFX_MAX_CONST_SIZE) {
+                return INVALID_PAYLOAD_SIZE;
+            }
+            size += (2 + cbSize) * sizeof(uint32_t);
+        }
+        return size;
+    }
+
+    case FFX_FSR2_RECORD_TYPE_EXECUTE_JOBS:
+        return sizeof(FfxFsr2RecordExecuteJobs);
+
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
+const char* GetReplayPassName(uint32_t pass)
+{
+    switch (pass) {
+
+    case FFX_FSR2_PASS_DEPTH_CLIP:                  return "depth clip";
+    case FFX_FSR2_PASS_RECONSTRUCT_PREVIOUS_DEPTH:  return "reconstruct previous depth";
+    case FFX_FSR2_PASS_LOCK:                        return "lock";
+    case FFX_FSR2_PASS_ACCUMULATE:                  return "accumulate";
+    case FFX_FSR2_PASS_ACCUMULATE_SHARPEN:          return "accumulate sharpen";
+    case FFX_FSR2_PASS_RCAS:                        return "rcas";
+    case FFX_FSR2_PASS_COMPUTE_LUMINANCE_PYRAMID:   return "luminance pyramid";
+    case FFX_FSR2_PASS_GENERATE_REACTIVE:           return "generate reactive";
+    case FFX_FSR2_PASS_TCR_AUTOGENERATE:            return "tcr autogenerate";
+    case REPLAY_PASS_CLEAR:                         return "clear";
+    case REPLAY_PASS_COPY:                          return "copy";
+    default:                                        return "unknown";
+    }
+}
+
+bool ReplayLog::Load(const std::string& path, std::string& error)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    m_size = size_t(file.tellg());
+    m_data.assign((m_size + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(m_data.data()), std::streamsize(m_size))) {
+        error = "cannot read " + path;
+        return false;
+    }
+
+    if (!Parse(error)) {
+        error = path + ": " + error;
+        return false;
+    }
+
+    return true;
+}
+
+bool ReplayLog::Parse(std::string& error)
+{
+    m_records.clear();
+    m_frameCount = 0;
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(m_data.data());
+    size_t offset = 0;
+
+    while (offset < m_size) {
+
+        if (m_size - offset < sizeof(FfxFsr2RecordHeader)) {
+            error = "truncated record header";
+            return false;
+        }
+
+        const FfxFsr2RecordHeader* header = reinterpret_cast<const FfxFsr2RecordHeader*>(data + offset);
+        if (header->size < sizeof(FfxFsr2RecordHeader) || header->size % FFX_FSR2_RECORD_ALIGNMENT || header->size > m_size - offset) {
+            error = "invalid record size at offset " + std::to_string(offset);
+            return false;
+        }
+        if (header->type >= FFX_FSR2_RECORD_TYPE_COUNT) {
+            error = "unknown record type at offset " + std::to_string(offset);
+            return false;
+        }
+
+        ReplayRecord record;
+        record.type        = header->type;
+        record.payloadSize = header->size - uint32_t(sizeof(FfxFsr2RecordHeader));
+        record.timestamp   = header->timestamp;
+        record.payload     = data + offset + sizeof(FfxFsr2RecordHeader);
+
+        const size_t payloadSize = getPayloadSize(record);
+        if (payloadSize > record.payloadSize) {
+            error = "invalid record payload at offset " + std::to_string(offset);
+            return false;
+        }
+
+        if (m_records.empty()) {
+            if (record.type != FFX_FSR2_RECORD_TYPE_BEGIN_LOG ||
+                payloadAs<FfxFsr2RecordBeginLog>(record).magic != FFX_FSR2_RECORD_MAGIC) {
+                error = "not a FSR2 record log";
+                return false;
+            }
+            if (payloadAs<FfxFsr2RecordBeginLog>(record).version != FFX_FSR2_RECORD_VERSION) {
+                error = "unsupported record log version";
+                return false;
+            }
+        }
+
+        if (record.type == FFX_FSR2_RECORD_TYPE_EXECUTE_JOBS) {
+            ++m_frameCount;
+        }
+
+        m_records.push_back(record);
+        offset += header->size;
+    }
+
+    if (m_records.empty()) {
+        error = "empty log";
+        return false;
+    }
+
+    return true;
+}
+
+Replayer::Replayer(const ReplayLog& log, FfxFsr2Interface* backendInterface, FfxDevice device, FfxCommandList commandList)
+    : m_log(log)
+    , m_interface(backendInterface)
+    , m_device(device)
+    , m_commandList(commandList)
+{
+}
+
+Replayer::~Replayer()
+{
+    Destroy();
+}
+
+bool Replayer::Fail(std::string& error, const char* message, FfxErrorCode errorCode)
+{
+    error = message;
+    if (errorCode != FFX_OK) {
+        error += ", error " + std::to_string(errorCode);
+    }
+    return false;
+}
+
+void Replayer::Destroy()
+{
+    if (!m_contextCreated) {
+        return;
+    }
+
+    for (Pipeline& pipeline : m_pipelines) {
+        if (pipeline.valid) {
+            m_interface->fpDestroyPipeline(m_interface, &pipeline.state);
+        }
+    }
+    m_interface->fpUnregisterResources(m_interface);
+    for (PooledResource& pooled : m_registered) {
+        m_interface->fpDestroyResource(m_interface, pooled.internal);
+    }
+    for (const Resource& resource : m_resources) {
+        if (resource.valid && resource.created) {
+            m_interface->fpDestroyResource(m_interface, resource.internal);
+        }
+    }
+    m_interface->fpDestroyBackendContext(m_interface);
+
+    m_pipelines.clear();
+    m_registered.clear();
+    m_resources.clear();
+    m_registeredCount = 0;
+    m_contextCreated = false;
+}
+
+bool Replayer::MapResource(int32_t recordedIndex, FfxResourceInternal& internal, uint64_t* bytes, uint32_t mip)
+{
+    // the null resource maps to itself in every backend
+    if (recordedIndex == FFX_FSR2_RESOURCE_IDENTIFIER_NULL) {
+        internal.internalIndex = FFX_FSR2_RESOURCE_IDENTIFIER_NULL;
+        return true;
+    }
+
+    if (recordedIndex < 0 || uint32_t(recordedIndex) >= m_resources.size() || !m_resources[recordedIndex].valid) {
+        return false;
+    }
+
+    const Resource& resource = m_resources[recordedIndex];
+    internal = resource.internal;
+    if (bytes) {
+        *bytes += getResourceSize(resource.description, mip);
+    }
+    return true;
+}
+
+bool Replayer::CreateResource(const ReplayRecord& record, std::string& error)
+{
+    const FfxFsr2RecordCreateResource& created = payloadAs<FfxFsr2RecordCreateResource>(record);
+    if (created.internalIndex < 0 || uint32_t(created.internalIndex) >= REPLAY_MAX_INDEX) {
+        return Fail(error, "invalid resource index");
+    }
+
+    FfxCreateResourceDescription description = {};
+    description.heapType            = FfxHeapType(created.heapType);
+    description.resourceDescription = toResourceDescription(created.description);
+    description.initalState         = FfxResourceStates(created.initialState);
+    description.initDataSize        = created.initDataSize;
+    description.initData            = created.initDataSize ? const_cast<uint8_t*>(record.payload + sizeof(FfxFsr2RecordCreateResource)) : nullptr;
+    description.name                = L"";
+    description.usage               = FfxResourceUsage(created.usage);
+    description.id                  = created.id;
+
+    // the log does not hold the transient heap, every resource is created on its own
+    description.resourceDescription.flags = FfxResourceFlags(description.resourceDescription.flags & ~FFX_RESOURCE_FLAGS_ALIASABLE);
+
+    Resource resource = {};
+    resource.description = description.resourceDescription;
+    resource.created     = true;
+    resource.valid       = true;
+
+    const FfxErrorCode errorCode = m_interface->fpCreateResource(m_interface, &description, &resource.internal);
+    if (errorCode != FFX_OK) {
+        return Fail(error, "cannot create resource", errorCode);
+    }
+
+    if (uint32_t(created.internalIndex) >= m_resources.size()) {
+        m_resources.resize(created.internalIndex + 1);
+    }
+    m_resources[created.internalIndex] = resource;
+    return true;
+}
+
+bool Replayer::RegisterResource(const ReplayRecord& record, std::string& error)
+{
+    const FfxFsr2RecordRegisterResource& registered = payloadAs<FfxFsr2RecordRegisterResource>(record);
+    if (registered.internalIndex < 0 || uint32_t(registered.internalIndex) >= REPLAY_MAX_INDEX) {
+        return Fail(error, "invalid resource index");
+    }
+
+    const FfxResourceDescription description = toResourceDescription(registered.description);
+    const uint32_t ordinal = m_registeredCount++;
+
+    Resource resource = {};
+    resource.description = description;
+    resource.valid       = true;
+
+    if (registered.internalIndex == FFX_FSR2_RESOURCE_IDENTIFIER_NULL || description.width == 0 || GetSurfaceFormatSize(description.format) == 0) {
+
+        // optional inputs the application left empty
+        FfxResource empty = {};
+        const FfxErrorCode errorCode = m_interface->fpRegisterResource(m_interface, &empty, &resource.internal);
+        if (errorCode != FFX_OK) {
+            return Fail(error, "cannot register resource", errorCode);
+        }
+    } else {
+
+        // stand in for the application resource with an internal one
+        if (ordinal >= m_registered.size()) {
+            m_registered.resize(ordinal + 1, PooledResource{ { FFX_FSR2_RESOURCE_IDENTIFIER_NULL }, {} });
+        }
+
+        PooledResource& pooled = m_registered[ordinal];
+        if (pooled.internal.internalIndex == FFX_FSR2_RESOURCE_IDENTIFIER_NULL || !sameDescription(pooled.description, description)) {
+
+            if (pooled.internal.internalIndex != FFX_FSR2_RESOURCE_IDENTIFIER_NULL) {
+                m_interface->fpDestroyResource(m_interface, pooled.internal);
+            }
+
+            FfxCreateResourceDescription createDescription = {};
+            createDescription.heapType            = FFX_HEAP_TYPE_DEFAULT;
+            createDescription.resourceDescription = description;
+            createDescription.initalState         = FfxResourceStates(registered.state);
+            createDescription.name                = L"";
+            createDescription.usage               = FFX_RESOURCE_USAGE_UAV;
+            createDescription.id                  = FFX_FSR2_RESOURCE_IDENTIFIER_NULL;
+
+            const FfxErrorCode errorCode = m_interface->fpCreateResource(m_interface, &createDescription, &pooled.internal);
+            if (errorCode != FFX_OK) {
+                return Fail(error, "cannot create a stand-in for a registered resource", errorCode);
+            }
+            pooled.description = description;
+        }
+
+        resource.internal = pooled.internal;
+
+        // inputs come with their recorded contents, anything else is replayed with whatever the stand-in holds
+        if (registered.dataSize) {
+            if (registered.dataSize != getResourceSize(description, 0)) {
+                return Fail(error, "invalid size of the contents of a registered resource");
+            }
+            if (!m_interface->fpWriteResource) {
+                return Fail(error, "the backend cannot write the contents of a registered resource");
+            }
+
+            const FfxErrorCode errorCode = m_interface->fpWriteResource(m_interface, pooled.internal, description.format, record.payload + sizeof(FfxFsr2RecordRegisterResource), registered.dataSize);
+            if (errorCode != FFX_OK) {
+                return Fail(error, "cannot write the contents of a registered resource", errorCode);
+            }
+        }
+    }
+
+    if (uint32_t(registered.internalIndex) >= m_resources.size()) {
+        m_resources.resize(registered.internalIndex + 1);
+    }
+    if (registered.internalIndex != FFX_FSR2_RESOURCE_IDENTIFIER_NULL) {
+        m_resources[registered.internalIndex] = resource;
+    }
+    return true;
+}
+
+bool Replayer::CreatePipeline(const ReplayRecord& record, std::string& error)
+{
+    const FfxFsr2RecordCreatePipeline& created = payloadAs<FfxFsr2RecordCreatePipeline>(record);
+    if (created.pipelineIndex >= REPLAY_MAX_INDEX) {
+        return Fail(error, "invalid pipeline index");
+    }
+
+    const uint32_t* values = reinterpret_cast<const uint32_t*>(record.payload + sizeof(FfxFsr2RecordCreatePipeline));
+    FfxFilterType samplers[REPLAY_MAX_SAMPLER_COUNT];
+    for (uint32_t i = 0; i < created.samplerCount; ++i) {
+        samplers[i] = FfxFilterType(values[i]);
+    }
+
+    FfxPipelineDescription description = {};
+    description.contextFlags            = created.contextFlags;
+    description.samplers                = samplers;
+    description.samplerCount            = created.samplerCount;
+    description.rootConstantBufferSizes = values + created.samplerCount;
+    description.rootConstantBufferCount = created.rootConstantBufferCount;
+
+    Pipeline pipeline = {};
+    pipeline.pass  = created.pass;
+    pipeline.valid = true;
+
+    const FfxErrorCode errorCode = m_interface->fpCreatePipeline(m_interface, FfxFsr2Pass(created.pass), &description, &pipeline.state);
+    if (errorCode != FFX_OK) {
+        return Fail(error, "cannot create pipeline", errorCode);
+    }
+
+    if (created.pipelineIndex >= m_pipelines.size()) {
+        m_pipelines.resize(created.pipelineIndex + 1);
+    }
+    m_pipelines[created.pipelineIndex] = pipeline;
+    return true;
+}
+
+bool Replayer::ScheduleJob(const ReplayRecord& record, bool measured, ReplayStatistics& statistics, std::string& error)
+{
+    const FfxFsr2RecordScheduleJob& scheduled = payloadAs<FfxFsr2RecordScheduleJob>(record);
+
+    FfxGpuJobDescription& job = m_job;
+    memset(&job, 0, sizeof(job));
+    job.jobType = FfxGpuJobType(scheduled.jobType);
+
+    uint32_t pass = REPLAY_PASS_CLEAR;
+    uint64_t groupCount = 0;
+    uint64_t bytes = 0;
+
+    switch (scheduled.jobType) {
+
+    case FFX_GPU_JOB_CLEAR_FLOAT:
+        memcpy(job.clearJobDescriptor.color, scheduled.clear.color, sizeof(job.clearJobDescriptor.color));
+        if (!MapResource(scheduled.clear.target, job.clearJobDescriptor.target, &bytes, 0)) {
+            return Fail(error, "clear of an unknown resource");
+        }
+        break;
+
+    case FFX_GPU_JOB_COPY:
+        pass = REPLAY_PASS_COPY;
+        if (!MapResource(scheduled.copy.src, job.copyJobDescriptor.src, &bytes, 0) ||
+            !MapResource(scheduled.copy.dst, job.copyJobDescriptor.dst, &bytes, 0)) {
+            return Fail(error, "copy of an unknown resource");
+        }
+        break;
+
+    case FFX_GPU_JOB_COMPUTE: {
+
+        if (scheduled.compute.pipelineIndex >= m_pipelines.size() || !m_pipelines[scheduled.compute.pipelineIndex].valid) {
+            return Fail(error, "dispatch of an unknown pipeline");
+        }
+
+        const Pipeline& pipeline = m_pipelines[scheduled.compute.pipelineIndex];
+        if (pipeline.state.srvCount != scheduled.compute.srvCount || pipeline.state.uavCount != scheduled.compute.uavCount ||
+            pipeline.state.constCount != scheduled.compute.cbCount) {
+            return Fail(error, "the bindings of a pipeline differ from the recording backend");
+        }
+
+        pass = pipeline.pass;
+        groupCount = uint64_t(scheduled.compute.dimensions[0]) * scheduled.compute.dimensions[1] * scheduled.compute.dimensions[2];
+
+        FfxComputeJobDescription& compute = job.computeJobDescriptor;
+        compute.pipeline = pipeline.state;
+        memcpy(compute.dimensions, scheduled.compute.dimensions, sizeof(compute.dimensions));
+
+        const uint32_t* values = reinterpret_cast<const uint32_t*>(record.payload + sizeof(FfxFsr2RecordScheduleJob));
+        const uint32_t* uavMips = values + scheduled.compute.srvCount + scheduled.compute.uavCount;
+        for (uint32_t i = 0; i < scheduled.compute.srvCount; ++i) {
+            if (!MapResource(int32_t(values[i]), compute.srvs[i], &bytes, 0)) {
+                return Fail(error, "dispatch of an unknown resource");
+            }
+            wcscpy_s(compute.srvNames[i], pipeline.state.srvResourceBindings[i].name);
+        }
+        for (uint32_t i = 0; i < scheduled.compute.uavCount; ++i) {
+            if (!MapResource(int32_t(values[scheduled.compute.srvCount + i]), compute.uavs[i], &bytes, uavMips[i])) {
+                return Fail(error, "dispatch of an unknown resource");
+            }
+            compute.uavMip[i] = uavMips[i];
+            wcscpy_s(compute.uavNames[i], pipeline.state.uavResourceBindings[i].name);
+        }
+
+        values = uavMips + scheduled.compute.uavCount;
+        for (uint32_t i = 0; i < scheduled.compute.cbCount; ++i) {
+            compute.cbSlotIndex[i]    = values[0];
+            compute.cbs[i].uint32Size = values[1];
+            memcpy(compute.cbs[i].data, values + 2, values[1] * sizeof(uint32_t));
+            wcscpy_s(compute.cbNames[i], pipeline.state.cbResourceBindings[i].name);
+            values += 2 + values[1];
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    const FfxErrorCode errorCode = m_interface->fpScheduleGpuJob(m_interface, &job);
+    if (errorCode != FFX_OK) {
+        return Fail(error, "cannot schedule job", errorCode);
+    }
+
+    if (measured) {
+        ReplayPassStatistics& passStatistics = statistics.passes[pass];
+        passStatistics.jobCount   += 1;
+        passStatistics.groupCount += groupCount;
+        passStatistics.bytes      += bytes;
+    }
+    m_scheduledPasses.push_back(pass);
+
+    return true;
+}
+
+bool Replayer::Execute(uint32_t pass, bool measured, ReplayStatistics& statistics, std::string& error)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const FfxErrorCode errorCode = m_interface->fpExecuteGpuJobs(m_interface, m_commandList);
+    const uint64_t nanoseconds = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+    if (errorCode != FFX_OK) {
+        return Fail(error, "cannot execute jobs", errorCode);
+    }
+
+    if (measured) {
+        if (pass < REPLAY_PASS_COUNT) {
+            statistics.passes[pass].nanoseconds += nanoseconds;
+        }
+        statistics.nanoseconds += nanoseconds;
+    }
+    m_scheduledPasses.clear();
+
+    return true;
+}
+
+bool Replayer::Run(ReplayMode mode, uint32_t skipFrameCount, ReplayStatistics& statistics, std::string& error)
+{
+    statistics = {};
+    uint32_t frameIndex = 0;
+
+    for (const ReplayRecord& record : m_log.Records()) {
+
+        const bool measured = frameIndex >= skipFrameCount;
+        bool result = true;
+
+        if (!m_contextCreated && record.type != FFX_FSR2_RECORD_TYPE_BEGIN_LOG && record.type != FFX_FSR2_RECORD_TYPE_CREATE_BACKEND_CONTEXT) {
+            return Fail(error, "record outside of a backend context");
+        }
+
+        switch (record.type) {
+
+        case FFX_FSR2_RECORD_TYPE_CREATE_BACKEND_CONTEXT: {
+            Destroy();
+            const FfxErrorCode errorCode = m_interface->fpCreateBackendContext(m_interface, m_device);
+            if (errorCode != FFX_OK) {
+                return Fail(error, "cannot create backend context", errorCode);
+            }
+            m_contextCreated = true;
+            break;
+        }
+
+        case FFX_FSR2_RECORD_TYPE_DESTROY_BACKEND_CONTEXT:
+            Destroy();
+            break;
+
+        case FFX_FSR2_RECORD_TYPE_CREATE_RESOURCE:
+            result = CreateResource(record, error);
+            break;
+
+        case FFX_FSR2_RECORD_TYPE_REGISTER_RESOURCE:
+            result = RegisterResource(record, error);
+            break;
+
+        case FFX_FSR2_RECORD_TYPE_UNREGISTER_RESOURCES: {
+            for (Resource& resource : m_resources) {
+                resource.valid = resource.valid && resource.created;
+            }
+            m_registeredCount = 0;
+            const FfxErrorCode errorCode = m_interface->fpUnregisterResources(m_interface);
+            if (errorCode != FFX_OK) {
+                return Fail(error, "cannot unregister resources", errorCode);
+            }
+            break;
+        }
+
+        case FFX_FSR2_RECORD_TYPE_DESTROY_RESOURCE: {
+            FfxResourceInternal internal;
+            const int32_t internalIndex = payloadAs<FfxFsr2RecordDestroyResource>(record).internalIndex;
+            if (MapResource(internalIndex, internal, nullptr, 0) && internalIndex != FFX_FSR2_RESOURCE_IDENTIFIER_NULL) {
+                m_interface->fpDestroyResource(m_interface, internal);
+                m_resources[internalIndex].valid = false;
+            }
+            break;
+        }
+
+        case FFX_FSR2_RECORD_TYPE_CREATE_PIPELINE:
+            result = CreatePipeline(record, error);
+            break;
+
+        case FFX_FSR2_RECORD_TYPE_DESTROY_PIPELINE: {
+            const uint32_t pipelineIndex = payloadAs<FfxFsr2RecordDestroyPipeline>(record).pipelineIndex;
+            if (pipelineIndex < m_pipelines.size() && m_pipelines[pipelineIndex].valid) {
+                m_interface->fpDestroyPipeline(m_interface, &m_pipelines[pipelineIndex].state);
+                m_pipelines[pipelineIndex].valid = false;
+            }
+            break;
+        }
+
+        case FFX_FSR2_RECORD_TYPE_SCHEDULE_JOB:
+            result = ScheduleJob(record, measured, statistics, error);
+
+            // executing the jobs one by one times each of them, at the cost of any fusion done by the backend
+            if (result && mode == REPLAY_MODE_PASS) {
+                result = Execute(m_scheduledPasses.back(), measured, statistics, error);
+            }
+            break;
+
+        case FFX_FSR2_RECORD_TYPE_EXECUTE_JOBS:
+            if (mode == REPLAY_MODE_FRAME) {
+                result = Execute(REPLAY_PASS_COUNT, measured, statistics, error);
+            }
+            statistics.frameCount += measured ? 1 : 0;
+            ++frameIndex;
+            break;
+
+        default:
+            break;
+        }
+
+        if (!result) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,160 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Parser and replayer of the logs written by the recording backend, see record/ffx_fsr2_record.h.
+// A log holds the resource descriptions, the initial contents of the internal resources, the pipelines
+// and the ordered job stream of every frame, which is enough to execute the same work again against
+// any backend and time it pass by pass.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ffx_fsr2.h"
+#include "ffx_util.h"
+#include "record/ffx_fsr2_record.h"
+
+// A record of a log, pointing into the log data.
+struct ReplayRecord
+{
+    uint32_t                    type;               // A FfxFsr2RecordType.
+    uint32_t                    payloadSize;
+    uint64_t                    timestamp;
+    const uint8_t*              payload;
+};
+
+// A log loaded in memory. Every record is validated by Load, so replaying never reads past a record.
+class ReplayLog
+{
+public:
+    bool                        Load(const std::string& path, std::string& error);
+
+    const std::vector<ReplayRecord>& Records() const { return m_records; }
+
+    // Number of job executions, one per frame unless the frames were dispatched in batches.
+    uint32_t                    FrameCount() const { return m_frameCount; }
+
+private:
+    bool                        Parse(std::string& error);
+
+    std::vector<uint64_t>       m_data;             // uint64_t keeps the records 8 byte aligned
+    size_t                      m_size = 0;
+    std::vector<ReplayRecord>   m_records;
+    uint32_t                    m_frameCount = 0;
+};
+
+// The job statistics of a pass, clears and copies are counted as passes of their own.
+enum ReplayPass
+{
+    REPLAY_PASS_CLEAR = FFX_FSR2_PASS_COUNT,
+    REPLAY_PASS_COPY,
+
+    REPLAY_PASS_COUNT
+};
+
+struct ReplayPassStatistics
+{
+    uint64_t                    jobCount;
+    uint64_t                    groupCount;         // Thread groups dispatched.
+    uint64_t                    bytes;              // Bytes of the bound resources, see Replayer.
+    uint64_t                    nanoseconds;        // Wall time, only measured in REPLAY_MODE_PASS.
+};
+
+struct ReplayStatistics
+{
+    ReplayPassStatistics        passes[REPLAY_PASS_COUNT];
+    uint64_t                    frameCount;
+    uint64_t                    nanoseconds;        // Wall time of the measured executions.
+};
+
+enum ReplayMode
+{
+    REPLAY_MODE_FRAME,                              // Execute the jobs of a frame at once, as recorded.
+    REPLAY_MODE_PASS,                               // Execute and time every job on its own.
+};
+
+const char* GetReplayPassName(uint32_t pass);
+
+// Replays the callbacks of a log into a backend interface, creating a backend context of its own.
+//
+// Resources created by the context are created again with their recorded initial data. The resources
+// registered by the application are replaced by internal resources of the same description, written
+// with the recorded contents of the inputs when the log holds them and the backend implements
+// fpWriteResource, zeroed otherwise. The bytes of a job are the sizes of the resources it
+// binds, the bound mip for UAVs and mip 0 for SRVs, which is an upper bound of the memory it touches.
+class Replayer
+{
+public:
+    Replayer(const ReplayLog& log, FfxFsr2Interface* backendInterface, FfxDevice device, FfxCommandList commandList);
+    ~Replayer();
+
+    // Replay every frame of the log, accumulating the statistics of the frames after the first skipFrameCount.
+    bool                        Run(ReplayMode mode, uint32_t skipFrameCount, ReplayStatistics& statistics, std::string& error);
+
+private:
+    struct Resource
+    {
+        FfxResourceInternal     internal;
+        FfxResourceDescription  description;
+        bool                    created;            // false for the resources registered by the application
+        bool                    valid;
+    };
+
+    struct Pipeline
+    {
+        FfxPipelineState        state;
+        uint32_t                pass;
+        bool                    valid;
+    };
+
+    struct PooledResource
+    {
+        FfxResourceInternal     internal;
+        FfxResourceDescription  description;
+    };
+
+    bool                        Fail(std::string& error, const char* message, FfxErrorCode errorCode = FFX_OK);
+    void                        Destroy();
+
+    bool                        CreateResource(const ReplayRecord& record, std::string& error);
+    bool                        RegisterResource(const ReplayRecord& record, std::string& error);
+    bool                        CreatePipeline(const ReplayRecord& record, std::string& error);
+    bool                        ScheduleJob(const ReplayRecord& record, bool measured, ReplayStatistics& statistics, std::string& error);
+    bool                        Execute(uint32_t pass, bool measured, ReplayStatistics& statistics, std::string& error);
+
+    bool                        MapResource(int32_t recordedIndex, FfxResourceInternal& internal, uint64_t* bytes, uint32_t mip);
+
+    const ReplayLog&            m_log;
+    FfxFsr2Interface*           m_interface;
+    FfxDevice                   m_device;
+    FfxCommandList              m_commandList;
+    bool                        m_contextCreated = false;
+
+    std::vector<Resource>       m_resources;        // indexed by the recorded internalIndex
+    std::vector<Pipeline>       m_pipelines;        // indexed by the recorded pipelineIndex
+    std::vector<PooledResource> m_registered;       // stand-ins for registered resources, by registration order
+    uint32_t                    m_registeredCount = 0;
+    std::vector<uint32_t>       m_scheduledPasses;
+    FfxGpuJobDescription        m_job;              // over 10KB with the binding names, kept off the stack
+};
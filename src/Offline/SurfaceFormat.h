@@ -0,0 +1,61 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "ffx_types.h"
+
+// Size (in bytes) of a texel of format, or 0 when the format is unknown.
+inline uint32_t GetSurfaceFormatSize(uint32_t format)
+{
+    switch (format) {
+
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        return 16;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        return 8;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        return 4;
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16_UINT:
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        return 2;
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        return 1;
+    default:
+        return 0;
+    }
+}
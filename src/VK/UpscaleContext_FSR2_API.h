@@ -49,6 +49,7 @@ public:
 
 private:
     void ReloadPipelines();
+    void DestroyContext();
 
     FfxFsr2ContextDescription   initializationParameters = {};
     FfxFsr2Context              context;
@@ -0,0 +1,1517 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <stdlib.h>     // for malloc/free
+#include <string.h>     // for memset
+#include <chrono>
+#include <new>
+#include <thread>
+#include "../ffx_fsr2.h"
+#include "../ffx_fsr2_device_cache.h"
+#include "../ffx_fsr2_trace.h"
+#include "ffx_fsr2_cpu.h"
+#include "ffx_fsr2_cpu_executor.h"
+#include "ffx_fsr2_cpu_service.h"
+#include "ffx_fsr2_cpu_private.h"
+#include "ffx_fsr2_cpu_simd.h"
+
+// CPU prototypes for functions in the backend interface
+FfxErrorCode GetDeviceCapabilitiesCPU(FfxFsr2Interface* backendInterface, FfxDeviceCapabilities* deviceCapabilities, FfxDevice device);
+FfxErrorCode CreateBackendContextCPU(FfxFsr2Interface* backendInterface, FfxDevice device);
+FfxErrorCode DestroyBackendContextCPU(FfxFsr2Interface* backendInterface);
+FfxErrorCode CreateResourceCPU(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* desc, FfxResourceInternal* outTexture);
+FfxErrorCode RegisterResourceCPU(FfxFsr2Interface* backendInterface, const FfxResource* inResource, FfxResourceInternal* outResourceInternal);
+FfxErrorCode UnregisterResourcesCPU(FfxFsr2Interface* backendInterface);
+FfxResourceDescription GetResourceDescriptorCPU(FfxFsr2Interface* backendInterface, FfxResourceInternal resource);
+FfxErrorCode DestroyResourceCPU(FfxFsr2Interface* backendInterface, FfxResourceInternal resource);
+FfxErrorCode CreatePipelineCPU(FfxFsr2Interface* backendInterface, FfxFsr2Pass passId, const FfxPipelineDescription*  desc, FfxPipelineState* outPass);
+FfxErrorCode DestroyPipelineCPU(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline);
+FfxErrorCode ScheduleGpuJobCPU(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job);
+FfxErrorCode ExecuteGpuJobsCPU(FfxFsr2Interface* backendInterface, FfxCommandList commandList);
+FfxErrorCode ReadResourceCPU(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, void* data, size_t dataSize);
+FfxErrorCode WriteResourceCPU(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, const void* data, size_t dataSize);
+FfxErrorCode GetGpuJobStatisticsCPU(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount);
+FfxErrorCode GetResourceMemoryRequirementsCPU(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* desc, FfxResourceMemoryRequirements* outRequirements);
+FfxErrorCode CreateTransientHeapCPU(FfxFsr2Interface* backendInterface, uint64_t heapSize, bool shared);
+
+// Number of frames ffxFsr2ContextDispatchBatch may schedule before executing them. A frame registers
+// at most 10 resources and schedules at most 14 jobs.
+#define FSR2_MAX_BATCHED_FRAMES ( 4)
+#define FSR2_MAX_RESOURCE_COUNT (64 + FFX_FSR2_MAX_VIEW_RESOURCE_COUNT * (FFX_FSR2_MAX_VIEW_COUNT - 1) + 10 * FSR2_MAX_BATCHED_FRAMES)
+#define FSR2_MAX_GPU_JOBS       (16 * FSR2_MAX_BATCHED_FRAMES)
+
+typedef struct BackendContext_CPU {
+
+    // store for resources
+    typedef struct Resource
+    {
+#ifdef _DEBUG
+        wchar_t                 resourceName[64] = {};
+#endif
+        uint8_t*                data;
+        bool                    ownsData;
+
+        // data is shared with the other contexts through the resource cache
+        bool                    sharedData;
+
+        // data is placed in the transient heap
+        bool                    transientData;
+        FfxResourceDescription  resourceDescription;
+        FfxResourceStates       state;
+        FfxSurfaceFormat        storageFormat;
+        uint32_t                mipCount;
+        size_t                  rowPitch;
+        size_t                  mipOffsets[FSR2_CPU_MAX_MIP_COUNT];
+    } Resource;
+
+    uint32_t                threadCount;
+    bool                    deterministic;
+    Fsr2CpuScheduler*       executor;
+
+    // when set, executor is a stream of the service
+    FfxFsr2ServiceCPU*      service;
+    uint32_t                serviceWeight;
+    uint32_t                serviceFrameBudget;
+
+    FfxGpuJobDescription    gpuJobs[FSR2_MAX_GPU_JOBS];
+    uint32_t                gpuJobCount;
+
+    // host timings of the jobs of the last execute call
+    FfxGpuJobStatistics     jobStatistics[FSR2_MAX_GPU_JOBS];
+    uint32_t                jobStatisticsCount;
+
+    uint32_t                nextStaticResource;
+    uint32_t                nextDynamicResource;
+    Resource                resources[FSR2_MAX_RESOURCE_COUNT];
+
+    // memory of the resources flagged aliasable, when shared it comes from the transient heap cache
+    uint8_t*                transientHeap;
+    bool                    sharedTransientHeap;
+
+    Fsr2CpuPipeline         pipelines[FFX_FSR2_PASS_COUNT];
+
+#if FSR2_CPU_PIPELINE_JOBS
+    // [begin, end) of the host memory backing a resource
+    typedef struct MemoryRange
+    {
+        const uint8_t*          begin;
+        const uint8_t*          end;
+    } MemoryRange;
+
+    // A node of the job graph of an execute call: a clear, a copy, a compute job or the three jobs of
+    // a fused pre-pass, which runs one sweep per phase.
+    typedef struct JobNode
+    {
+        uint32_t                firstJob;
+        uint32_t                jobCount;
+        uint32_t                phaseCount;
+        uint32_t                phase;
+        Fsr2CpuFusedPrepass*    prepass;
+
+        // mask of the earlier nodes which have to complete before the node starts
+        uint64_t                dependencies;
+
+        MemoryRange             reads[FSR2_CPU_PREPASS_SWEEP_COUNT * FFX_MAX_NUM_SRVS];
+        uint32_t                readCount;
+        MemoryRange             writes[FSR2_CPU_PREPASS_SWEEP_COUNT * FFX_MAX_NUM_UAVS];
+        uint32_t                writeCount;
+    } JobNode;
+
+    JobNode                 jobNodes[FSR2_MAX_GPU_JOBS];
+    Fsr2CpuJob              cpuJobs[FSR2_MAX_GPU_JOBS];
+    Fsr2CpuFusedPrepass     prepasses[FSR2_MAX_GPU_JOBS / FSR2_CPU_PREPASS_SWEEP_COUNT];
+#endif // #if FSR2_CPU_PIPELINE_JOBS
+} BackendContext_CPU;
+
+// Names of the bindings of each pass, in the slot order the kernels expect (see ffx_fsr2_cpu_private.h).
+typedef struct PassBindings {
+
+    const wchar_t*          srvNames[FFX_MAX_NUM_SRVS];
+    uint32_t                srvCount;
+    const wchar_t*          uavNames[FFX_MAX_NUM_UAVS];
+    uint32_t                uavCount;
+    const wchar_t*          cbNames[FFX_MAX_NUM_CONST_BUFFERS];
+    uint32_t                cbCount;
+    Fsr2CpuKernelFunc       kernel;
+    Fsr2CpuResolveFunc      resolve;
+} PassBindings;
+
+static const PassBindings passBindings[FFX_FSR2_PASS_COUNT] = {
+
+    // FFX_FSR2_PASS_DEPTH_CLIP
+    {
+        { L"r_reconstructed_previous_nearest_depth", L"r_dilated_motion_vectors", L"r_dilatedDepth", L"r_reactive_mask", L"r_transparency_and_composition_mask",
+          L"r_previous_dilated_motion_vectors", L"r_input_motion_vectors", L"r_input_color_jittered", L"r_input_depth", L"r_input_exposure" },
+        FSR2_CPU_DEPTH_CLIP_SRV_COUNT,
+        { L"rw_dilated_reactive_masks", L"rw_prepared_input_color" },
+        FSR2_CPU_DEPTH_CLIP_UAV_COUNT,
+        { L"cbFSR2" }, 1,
+        fsr2CpuDepthClipKernel,
+        NULL
+    },
+
+    // FFX_FSR2_PASS_RECONSTRUCT_PREVIOUS_DEPTH
+    {
+        { L"r_input_motion_vectors", L"r_input_depth", L"r_input_color_jittered", L"r_input_exposure" },
+        FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_COUNT,
+        { L"rw_reconstructed_previous_nearest_depth", L"rw_dilated_motion_vectors", L"rw_dilatedDepth", L"rw_lock_input_luma" },
+        FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_COUNT,
+        { L"cbFSR2" }, 1,
+        fsr2CpuReconstructPreviousDepthKernel,
+        NULL
+    },
+
+    // FFX_FSR2_PASS_LOCK
+    {
+        { L"r_lock_input_luma" },
+        FSR2_CPU_LOCK_SRV_COUNT,
+        { L"rw_new_locks", L"rw_reconstructed_previous_nearest_depth" },
+        FSR2_CPU_LOCK_UAV_COUNT,
+        { L"cbFSR2" }, 1,
+        fsr2CpuLockKernel,
+        NULL
+    },
+
+    // FFX_FSR2_PASS_ACCUMULATE
+    {
+        { L"r_input_exposure", L"r_dilated_reactive_masks", L"r_dilated_motion_vectors", L"r_internal_upscaled_color", L"r_lock_status",
+          L"r_prepared_input_color", L"r_lanczos_lut", L"r_upsample_maximum_bias_lut", L"r_imgMips", L"r_auto_exposure", L"r_luma_history" },
+        FSR2_CPU_ACCUMULATE_SRV_COUNT,
+        { L"rw_internal_upscaled_color", L"rw_lock_status", L"rw_upscaled_output", L"rw_new_locks", L"rw_luma_history" },
+        FSR2_CPU_ACCUMULATE_UAV_COUNT,
+        { L"cbFSR2" }, 1,
+        fsr2CpuAccumulateKernel,
+        NULL
+    },
+
+    // FFX_FSR2_PASS_ACCUMULATE_SHARPEN
+    {
+        { L"r_input_exposure", L"r_dilated_reactive_masks", L"r_dilated_motion_vectors", L"r_internal_upscaled_color", L"r_lock_status",
+          L"r_prepared_input_color", L"r_lanczos_lut", L"r_upsample_maximum_bias_lut", L"r_imgMips", L"r_auto_exposure", L"r_luma_history" },
+        FSR2_CPU_ACCUMULATE_SRV_COUNT,
+        { L"rw_internal_upscaled_color", L"rw_lock_status", L"rw_upscaled_output", L"rw_new_locks", L"rw_luma_history" },
+        FSR2_CPU_ACCUMULATE_UAV_COUNT,
+        { L"cbFSR2" }, 1,
+        fsr2CpuAccumulateKernel,
+        NULL
+    },
+
+    // FFX_FSR2_PASS_RCAS
+    {
+        { L"r_input_exposure", L"r_rcas_input" },
+        FSR2_CPU_RCAS_SRV_COUNT,
+        { L"rw_upscaled_output" },
+        FSR2_CPU_RCAS_UAV_COUNT,
+        { L"cbFSR2", L"cbRCAS" }, 2,
+        fsr2CpuRcasKernel,
+        NULL
+    },
+
+    // FFX_FSR2_PASS_COMPUTE_LUMINANCE_PYRAMID
+    {
+        { L"r_input_color_jittered" },
+        FSR2_CPU_LUMINANCE_PYRAMID_SRV_COUNT,
+        { L"rw_img_mip_shading_change", L"rw_img_mip_5", L"rw_auto_exposure" },
+        FSR2_CPU_LUMINANCE_PYRAMID_UAV_COUNT,
+        { L"cbFSR2", L"cbSPD" }, 2,
+        fsr2CpuComputeLuminancePyramidKernel,
+        fsr2CpuComputeLuminancePyramidResolve
+    },
+
+    // FFX_FSR2_PASS_GENERATE_REACTIVE
+    {
+        { L"r_input_opaque_only", L"r_input_color_jittered" },
+        FSR2_CPU_AUTOGEN_REACTIVE_SRV_COUNT,
+        { L"rw_output_autoreactive" },
+        FSR2_CPU_AUTOGEN_REACTIVE_UAV_COUNT,
+        { L"cbGenerateReactive" }, 1,
+        fsr2CpuGenerateReactiveKernel,
+        NULL
+    },
+
+    // FFX_FSR2_PASS_TCR_AUTOGENERATE
+    {
+        { L"r_input_opaque_only", L"r_input_color_jittered", L"r_input_motion_vectors", L"r_input_prev_color_pre_alpha", L"r_input_prev_color_post_alpha",
+          L"r_reactive_mask", L"r_transparency_and_composition_mask" },
+        FSR2_CPU_TCR_AUTOGENERATE_SRV_COUNT,
+        { L"rw_output_autoreactive", L"rw_output_autocomposition", L"rw_output_prev_color_pre_alpha", L"rw_output_prev_color_post_alpha" },
+        FSR2_CPU_TCR_AUTOGENERATE_UAV_COUNT,
+        { L"cbFSR2", L"cbGenerateReactive" }, 2,
+        fsr2CpuTcrAutogenerateKernel,
+        NULL
+    },
+};
+
+FFX_API size_t ffxFsr2GetScratchMemorySizeCPU()
+{
+    return FFX_ALIGN_UP(sizeof(BackendContext_CPU), sizeof(uint64_t));
+}
+
+// populate interface with CPU pointers.
+FfxErrorCode ffxFsr2GetInterfaceCPU(
+    FfxFsr2Interface* outInterface,
+    uint32_t threadCount,
+    void* scratchBuffer,
+    size_t scratchBufferSize) {
+
+    FFX_RETURN_ON_ERROR(
+        outInterface,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        scratchBufferSize >= ffxFsr2GetScratchMemorySizeCPU(),
+        FFX_ERROR_INSUFFICIENT_MEMORY);
+
+    outInterface->fpGetDeviceCapabilities = GetDeviceCapabilitiesCPU;
+    outInterface->fpCreateBackendContext = CreateBackendContextCPU;
+    outInterface->fpDestroyBackendContext = DestroyBackendContextCPU;
+    outInterface->fpCreateResource = CreateResourceCPU;
+    outInterface->fpRegisterResource = RegisterResourceCPU;
+    outInterface->fpUnregisterResources = UnregisterResourcesCPU;
+    outInterface->fpGetResourceDescription = GetResourceDescriptorCPU;
+    outInterface->fpDestroyResource = DestroyResourceCPU;
+    outInterface->fpCreatePipeline = CreatePipelineCPU;
+    outInterface->fpDestroyPipeline = DestroyPipelineCPU;
+    outInterface->fpScheduleGpuJob = ScheduleGpuJobCPU;
+    outInterface->fpExecuteGpuJobs = ExecuteGpuJobsCPU;
+    outInterface->fpReadResource = ReadResourceCPU;
+    outInterface->fpWriteResource = WriteResourceCPU;
+    outInterface->fpGetGpuJobStatistics = GetGpuJobStatisticsCPU;
+    outInterface->fpGetResourceMemoryRequirements = GetResourceMemoryRequirementsCPU;
+    outInterface->fpCreateTransientHeap = CreateTransientHeapCPU;
+    outInterface->scratchBuffer = scratchBuffer;
+    outInterface->scratchBufferSize = scratchBufferSize;
+
+    // the thread count is the only state owned by the interface, everything else is set up in CreateBackendContextCPU
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)scratchBuffer;
+    memset(backendContext, 0, sizeof(BackendContext_CPU));
+    backendContext->threadCount = threadCount ? threadCount : FFX_MAXIMUM(1u, std::thread::hardware_concurrency());
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2SetDeterministicCPU(FfxFsr2Interface* fsr2Interface, bool deterministic)
+{
+    FFX_RETURN_ON_ERROR(
+        fsr2Interface && fsr2Interface->scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+
+    // the kernels are picked when the context creates its pipelines
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)fsr2Interface->scratchBuffer;
+    FFX_RETURN_ON_ERROR(
+        !backendContext->executor,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    backendContext->deterministic = deterministic;
+
+    return FFX_OK;
+}
+
+struct FfxFsr2ServiceCPU {
+
+    FfxFsr2ServiceCPU(uint32_t threadCount, uint32_t maximumActiveFrameCount)
+        : service(threadCount, maximumActiveFrameCount)
+    {
+    }
+
+    Fsr2CpuService          service;
+};
+
+FfxErrorCode ffxFsr2CreateServiceCPU(FfxFsr2ServiceCPU** outService, uint32_t threadCount, uint32_t maximumActiveFrameCount)
+{
+    FFX_RETURN_ON_ERROR(
+        outService,
+        FFX_ERROR_INVALID_POINTER);
+
+    *outService = new(std::nothrow) FfxFsr2ServiceCPU(threadCount ? threadCount : FFX_MAXIMUM(1u, std::thread::hardware_concurrency()), maximumActiveFrameCount);
+    FFX_RETURN_ON_ERROR(*outService, FFX_ERROR_OUT_OF_MEMORY);
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2DestroyServiceCPU(FfxFsr2ServiceCPU* service)
+{
+    FFX_RETURN_ON_ERROR(
+        service,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        service->service.getStreamCount() == 0,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    delete service;
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2SetServiceCPU(FfxFsr2Interface* fsr2Interface, FfxFsr2ServiceCPU* service, uint32_t weight, uint32_t frameBudgetMicroseconds)
+{
+    FFX_RETURN_ON_ERROR(
+        fsr2Interface && fsr2Interface->scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+
+    // the stream is created along with the backend context
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)fsr2Interface->scratchBuffer;
+    FFX_RETURN_ON_ERROR(
+        !backendContext->executor,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    backendContext->service = service;
+    backendContext->serviceWeight = FFX_MAXIMUM(1u, weight);
+    backendContext->serviceFrameBudget = frameBudgetMicroseconds;
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2GetServiceStatisticsCPU(FfxFsr2ServiceCPU* service, FfxFsr2ServiceStatisticsCPU* outStatistics)
+{
+    FFX_RETURN_ON_ERROR(
+        service && outStatistics,
+        FFX_ERROR_INVALID_POINTER);
+
+    service->service.getStatistics(outStatistics);
+
+    return FFX_OK;
+}
+
+// Both values are only used as non-null tokens by the FSR2 runtime.
+static uint32_t cpuDevice;
+static uint32_t cpuCommandList;
+
+FfxDevice ffxGetDeviceCPU()
+{
+    return reinterpret_cast<FfxDevice>(&cpuDevice);
+}
+
+FfxCommandList ffxGetCommandListCPU()
+{
+    return reinterpret_cast<FfxCommandList>(&cpuCommandList);
+}
+
+FfxResource ffxGetResourceCPU(FfxFsr2Context* context, void* data, FfxResourceDescription description, size_t rowPitch, const wchar_t* name, FfxResourceStates state)
+{
+    FFX_UNUSED(context);
+
+    FfxResource resource = {};
+    resource.resource = data;
+    resource.state = state;
+    resource.descriptorData = rowPitch ? uint64_t(rowPitch) : uint64_t(description.width) * fsr2CpuGetSurfaceFormatSize(description.format);
+    resource.description = description;
+    resource.description.height = FFX_MAXIMUM(1u, description.height);
+    resource.description.depth = FFX_MAXIMUM(1u, description.depth);
+    resource.description.mipCount = 1;
+
+#ifdef _DEBUG
+    if (name) {
+        wcscpy_s(resource.name, name);
+    }
+#else
+    FFX_UNUSED(name);
+#endif
+
+    return resource;
+}
+
+static const BackendContext_CPU::Resource* getCPUResource(FfxFsr2Context* context, uint32_t resId)
+{
+    FfxFsr2Context_Private* contextPrivate = (FfxFsr2Context_Private*)(context);
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)(contextPrivate->contextDescription.callbacks.scratchBuffer);
+
+    int32_t internalIndex = 0;
+    if (resId > FFX_FSR2_RESOURCE_IDENTIFIER_INPUT_TRANSPARENCY_AND_COMPOSITION_MASK) {
+        internalIndex = contextPrivate->uavResources[resId].internalIndex;
+    }
+    else {
+        internalIndex = contextPrivate->srvResources[resId].internalIndex;
+    }
+
+    return (internalIndex > 0) ? &backendContext->resources[internalIndex] : nullptr;
+}
+
+void* ffxGetCPUResourcePtr(FfxFsr2Context* context, uint32_t resId)
+{
+    const BackendContext_CPU::Resource* resource = getCPUResource(context, resId);
+    return resource ? resource->data : nullptr;
+}
+
+FfxSurfaceFormat ffxGetCPUResourceFormat(FfxFsr2Context* context, uint32_t resId)
+{
+    const BackendContext_CPU::Resource* resource = getCPUResource(context, resId);
+    return resource ? resource->storageFormat : FFX_SURFACE_FORMAT_UNKNOWN;
+}
+
+FfxErrorCode RegisterResourceCPU(
+    FfxFsr2Interface* backendInterface,
+    const FfxResource* inFfxResource,
+    FfxResourceInternal* outFfxResourceInternal
+)
+{
+    FFX_ASSERT(NULL != backendInterface);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)(backendInterface->scratchBuffer);
+
+    if (inFfxResource->resource == nullptr) {
+
+        outFfxResourceInternal->internalIndex = FFX_FSR2_RESOURCE_IDENTIFIER_NULL;
+        return FFX_OK;
+    }
+
+    FFX_ASSERT(backendContext->nextDynamicResource > backendContext->nextStaticResource);
+    outFfxResourceInternal->internalIndex = backendContext->nextDynamicResource--;
+
+    BackendContext_CPU::Resource* backendResource = &backendContext->resources[outFfxResourceInternal->internalIndex];
+    backendResource->data = reinterpret_cast<uint8_t*>(inFfxResource->resource);
+    backendResource->ownsData = false;
+    backendResource->sharedData = false;
+    backendResource->transientData = false;
+    backendResource->state = inFfxResource->state;
+    backendResource->resourceDescription = inFfxResource->description;
+    backendResource->storageFormat = inFfxResource->description.format;
+    backendResource->mipCount = 1;
+    backendResource->rowPitch = size_t(inFfxResource->descriptorData);
+    backendResource->mipOffsets[0] = 0;
+
+#ifdef _DEBUG
+    wcscpy_s(backendResource->resourceName, inFfxResource->name);
+#endif
+
+    return FFX_OK;
+}
+
+// dispose dynamic resources: This should be called at the end of the frame
+FfxErrorCode UnregisterResourcesCPU(FfxFsr2Interface* backendInterface)
+{
+    FFX_ASSERT(NULL != backendInterface);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)(backendInterface->scratchBuffer);
+
+    for (uint32_t currentResourceIndex = backendContext->nextDynamicResource + 1; currentResourceIndex < FSR2_MAX_RESOURCE_COUNT; ++currentResourceIndex) {
+
+        backendContext->resources[currentResourceIndex] = {};
+    }
+
+    backendContext->nextDynamicResource = FSR2_MAX_RESOURCE_COUNT - 1;
+
+    return FFX_OK;
+}
+
+FfxErrorCode GetDeviceCapabilitiesCPU(FfxFsr2Interface* backendInterface, FfxDeviceCapabilities* deviceCapabilities, FfxDevice device)
+{
+    FFX_UNUSED(backendInterface);
+    FFX_UNUSED(device);
+
+    // The host passes implement the full feature set in 32-bit floats and have no notion of waves.
+    deviceCapabilities->minimumSupportedShaderModel = FFX_SHADER_MODEL_6_6;
+    deviceCapabilities->waveLaneCountMin = 1;
+    deviceCapabilities->waveLaneCountMax = 1;
+    deviceCapabilities->fp16Supported = false;
+    deviceCapabilities->raytracingSupported = false;
+    deviceCapabilities->maximumBatchedFrameCount = FSR2_MAX_BATCHED_FRAMES;
+
+    return FFX_OK;
+}
+
+FfxErrorCode CreateBackendContextCPU(FfxFsr2Interface* backendInterface, FfxDevice device)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_RETURN_ON_ERROR(device, FFX_ERROR_NULL_DEVICE);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    const uint32_t threadCount = backendContext->threadCount;
+    const bool deterministic = backendContext->deterministic;
+    FfxFsr2ServiceCPU* service = backendContext->service;
+    const uint32_t serviceWeight = backendContext->serviceWeight;
+    const uint32_t serviceFrameBudget = backendContext->serviceFrameBudget;
+    memset(backendContext, 0, sizeof(*backendContext));
+    backendContext->threadCount = threadCount ? threadCount : 1;
+    backendContext->deterministic = deterministic;
+    backendContext->service = service;
+    backendContext->serviceWeight = serviceWeight;
+    backendContext->serviceFrameBudget = serviceFrameBudget;
+
+    // the worker threads live as long as the backend context, or the service
+    if (service) {
+        backendContext->executor = service->service.createStream(serviceWeight, serviceFrameBudget);
+    } else {
+        backendContext->executor = new(std::nothrow) Fsr2CpuExecutor(backendContext->threadCount);
+    }
+    FFX_RETURN_ON_ERROR(backendContext->executor, FFX_ERROR_OUT_OF_MEMORY);
+
+    // init resource store, index 0 is reserved for the NULL resource
+    backendContext->nextStaticResource = 1;
+    backendContext->nextDynamicResource = FSR2_MAX_RESOURCE_COUNT - 1;
+    backendContext->resources[0] = {};
+
+    return FFX_OK;
+}
+
+// key of the read-only resources the contexts share, all CPU contexts share the host memory
+struct SharedResourceKey {
+
+    FfxResourceDescription  description;
+    std::vector<uint8_t>    initData;
+
+    bool operator==(const SharedResourceKey& other) const
+    {
+        return description.type == other.description.type && description.format == other.description.format
+            && description.width == other.description.width && description.height == other.description.height
+            && description.depth == other.description.depth && description.mipCount == other.description.mipCount
+            && initData == other.initData;
+    }
+};
+
+static Fsr2DeviceCache<SharedResourceKey, uint8_t*> sharedResourceCache;
+
+// transient heaps of the contexts created with shared transient memory, keyed on their size
+static Fsr2DeviceCache<uint64_t, uint8_t*> transientHeapCache;
+
+// allocates the storage of a resource laid out by layoutResource and fills it with the initial data
+static uint8_t* allocateResourceData(const BackendContext_CPU::Resource* backendResource, size_t totalSize, const FfxCreateResourceDescription* createResourceDescription)
+{
+    uint8_t* data = (uint8_t*)malloc(totalSize);
+    if (!data) {
+        return nullptr;
+    }
+    memset(data, 0, totalSize);
+
+    // initial data is provided in the resource format, convert it into the storage format of mip 0
+    if (createResourceDescription->initData) {
+
+        const FfxResourceDescription* description = &backendResource->resourceDescription;
+        const uint32_t texelSize = fsr2CpuGetSurfaceFormatSize(backendResource->storageFormat);
+        const uint32_t initTexelSize = fsr2CpuGetSurfaceFormatSize(description->format);
+        const uint8_t* initData = (const uint8_t*)createResourceDescription->initData;
+        const uint32_t texelCount = FFX_MINIMUM(description->width * description->height, createResourceDescription->initDataSize / FFX_MAXIMUM(1u, initTexelSize));
+
+        for (uint32_t texel = 0; texel < texelCount; ++texel) {
+
+            float value[4];
+            fsr2CpuDecodeTexel(description->format, initData + size_t(texel) * initTexelSize, value);
+            if (backendResource->storageFormat == FFX_SURFACE_FORMAT_R32_UINT) {
+                *reinterpret_cast<uint32_t*>(data + size_t(texel) * texelSize) = uint32_t(value[0]);
+            } else {
+                fsr2CpuEncodeTexel(backendResource->storageFormat, value, data + size_t(texel) * texelSize);
+            }
+        }
+    }
+
+    return data;
+}
+
+static void releaseResourceData(BackendContext_CPU::Resource* backendResource)
+{
+    if (backendResource->sharedData) {
+
+        sharedResourceCache.release(backendResource->data, [](uint8_t* data) { free(data); });
+    } else if (backendResource->ownsData) {
+
+        free(backendResource->data);
+    }
+}
+
+FfxErrorCode DestroyBackendContextCPU(FfxFsr2Interface* backendInterface)
+{
+    FFX_ASSERT(NULL != backendInterface);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    for (uint32_t currentStaticResourceIndex = 0; currentStaticResourceIndex < backendContext->nextStaticResource; ++currentStaticResourceIndex) {
+
+        BackendContext_CPU::Resource* resource = &backendContext->resources[currentStaticResourceIndex];
+        releaseResourceData(resource);
+        *resource = {};
+    }
+
+    backendContext->nextStaticResource = 0;
+
+    CreateTransientHeapCPU(backendInterface, 0, false);
+
+    if (backendContext->service) {
+        backendContext->service->service.destroyStream(static_cast<Fsr2CpuService::Stream*>(backendContext->executor));
+    } else {
+        delete backendContext->executor;
+    }
+    backendContext->executor = nullptr;
+
+    return FFX_OK;
+}
+
+static uint32_t getMipCount(uint32_t width, uint32_t height)
+{
+    uint32_t mipCount = 1;
+    for (uint32_t size = FFX_MAXIMUM(width, height); size > 1; size >>= 1) {
+        ++mipCount;
+    }
+    return mipCount;
+}
+
+// lays out the mips of a resource in its storage format, returns the size of the storage
+static size_t layoutResource(BackendContext_CPU::Resource* backendResource)
+{
+    const FfxResourceDescription* description = &backendResource->resourceDescription;
+    const uint32_t fullMipCount = getMipCount(description->width, description->height);
+    backendResource->mipCount = description->mipCount ? FFX_MINIMUM(description->mipCount, fullMipCount) : fullMipCount;
+    backendResource->mipCount = FFX_MINIMUM(backendResource->mipCount, uint32_t(FSR2_CPU_MAX_MIP_COUNT));
+    backendResource->resourceDescription.mipCount = backendResource->mipCount;
+    backendResource->storageFormat = fsr2CpuGetInternalStorageFormat(description->format);
+
+    const uint32_t texelSize = fsr2CpuGetSurfaceFormatSize(backendResource->storageFormat);
+    backendResource->rowPitch = size_t(description->width) * texelSize;
+
+    size_t totalSize = 0;
+    for (uint32_t mip = 0; mip < backendResource->mipCount; ++mip) {
+
+        backendResource->mipOffsets[mip] = totalSize;
+        const size_t mipWidth = FFX_MAXIMUM(1u, description->width >> mip);
+        const size_t mipHeight = FFX_MAXIMUM(1u, description->height >> mip);
+        totalSize += FFX_ALIGN_UP(mipWidth * mipHeight * texelSize, size_t(64));
+    }
+
+    return totalSize;
+}
+
+// create a internal resource that will stay alive until effect gets shut off
+FfxErrorCode CreateResourceCPU(
+    FfxFsr2Interface* backendInterface,
+    const FfxCreateResourceDescription* createResourceDescription,
+    FfxResourceInternal* outTexture
+)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != createResourceDescription);
+    FFX_ASSERT(NULL != outTexture);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    // reuse the slot of a destroyed resource, so that resizing a context does not use up the store
+    outTexture->internalIndex = 1;
+    while (uint32_t(outTexture->internalIndex) < backendContext->nextStaticResource && backendContext->resources[outTexture->internalIndex].data) {
+        ++outTexture->internalIndex;
+    }
+    if (uint32_t(outTexture->internalIndex) == backendContext->nextStaticResource) {
+
+        FFX_ASSERT(backendContext->nextStaticResource + 1 < backendContext->nextDynamicResource);
+        backendContext->nextStaticResource++;
+    }
+
+    BackendContext_CPU::Resource* backendResource = &backendContext->resources[outTexture->internalIndex];
+    backendResource->resourceDescription = createResourceDescription->resourceDescription;
+    backendResource->resourceDescription.height = FFX_MAXIMUM(1u, backendResource->resourceDescription.height);
+    backendResource->resourceDescription.depth = FFX_MAXIMUM(1u, backendResource->resourceDescription.depth);
+    backendResource->state = createResourceDescription->initalState;
+    backendResource->ownsData = false;
+    backendResource->sharedData = false;
+    backendResource->transientData = false;
+
+#ifdef _DEBUG
+    wcscpy_s(backendResource->resourceName, createResourceDescription->name);
+#endif
+
+    const size_t totalSize = layoutResource(backendResource);
+
+    // resources flagged aliasable live in the transient heap, when there is one
+    if ((createResourceDescription->resourceDescription.flags & FFX_RESOURCE_FLAGS_ALIASABLE) && backendContext->transientHeap) {
+
+        backendResource->data = backendContext->transientHeap + createResourceDescription->heapOffset;
+        backendResource->transientData = true;
+        return FFX_OK;
+    }
+
+    // read-only resources with initial data never change, all contexts share one copy of them
+    if (createResourceDescription->usage == FFX_RESOURCE_USAGE_READ_ONLY && createResourceDescription->initData) {
+
+        const uint8_t* initData = (const uint8_t*)createResourceDescription->initData;
+        const SharedResourceKey key = { backendResource->resourceDescription, std::vector<uint8_t>(initData, initData + createResourceDescription->initDataSize) };
+
+        const FfxErrorCode errorCode = sharedResourceCache.acquire(key, &backendResource->data, [&](uint8_t** outData) {
+
+            *outData = allocateResourceData(backendResource, totalSize, createResourceDescription);
+            return *outData ? FFX_OK : FFX_ERROR_OUT_OF_MEMORY;
+        });
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+        backendResource->sharedData = true;
+        return FFX_OK;
+    }
+
+    backendResource->data = allocateResourceData(backendResource, totalSize, createResourceDescription);
+    FFX_RETURN_ON_ERROR(backendResource->data, FFX_ERROR_OUT_OF_MEMORY);
+    backendResource->ownsData = true;
+
+    return FFX_OK;
+}
+
+FfxResourceDescription GetResourceDescriptorCPU(FfxFsr2Interface* backendInterface, FfxResourceInternal resource)
+{
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    FfxResourceDescription resourceDescription = backendContext->resources[resource.internalIndex].resourceDescription;
+    return resourceDescription;
+}
+
+FfxErrorCode CreatePipelineCPU(FfxFsr2Interface* backendInterface, FfxFsr2Pass pass, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != pipelineDescription);
+    FFX_ASSERT(NULL != outPipeline);
+    FFX_RETURN_ON_ERROR(pass < FFX_FSR2_PASS_COUNT, FFX_ERROR_INVALID_ENUM);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    // map the context flags to the equivalent shader permutation
+    const uint32_t flags = pipelineDescription->contextFlags;
+    uint32_t permutationFlags = 0;
+    permutationFlags |= (flags & FFX_FSR2_ENABLE_HIGH_DYNAMIC_RANGE) ? FSR2_CPU_PERMUTATION_HDR_COLOR_INPUT : 0;
+    permutationFlags |= (flags & FFX_FSR2_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS) ? 0 : FSR2_CPU_PERMUTATION_LOW_RESOLUTION_MOTION_VECTORS;
+    permutationFlags |= (flags & FFX_FSR2_ENABLE_MOTION_VECTORS_JITTER_CANCELLATION) ? FSR2_CPU_PERMUTATION_JITTERED_MOTION_VECTORS : 0;
+    permutationFlags |= (flags & FFX_FSR2_ENABLE_DEPTH_INVERTED) ? FSR2_CPU_PERMUTATION_INVERTED_DEPTH : 0;
+    permutationFlags |= (pass == FFX_FSR2_PASS_ACCUMULATE_SHARPEN) ? FSR2_CPU_PERMUTATION_APPLY_SHARPENING : 0;
+
+    const PassBindings* bindings = &passBindings[pass];
+
+    Fsr2CpuPipeline* pipeline = &backendContext->pipelines[pass];
+    pipeline->pass = pass;
+    pipeline->permutationFlags = permutationFlags;
+    pipeline->kernel = backendContext->deterministic ? bindings->kernel : fsr2CpuSelectKernel(pass, bindings->kernel);
+    pipeline->resolve = bindings->resolve;
+    pipeline->deterministic = backendContext->deterministic;
+
+    outPipeline->pipeline = reinterpret_cast<FfxPipeline>(pipeline);
+    outPipeline->rootSignature = reinterpret_cast<FfxRootSignature>(pipeline);
+
+    outPipeline->srvCount = bindings->srvCount;
+    outPipeline->uavCount = bindings->uavCount;
+    outPipeline->constCount = bindings->cbCount;
+
+    for (uint32_t srvIndex = 0; srvIndex < outPipeline->srvCount; ++srvIndex)
+    {
+        const wchar_t* name = bindings->srvNames[srvIndex];
+
+        // the accumulate pass reads the unmodified motion vectors when they are provided at display resolution
+        if (srvIndex == FSR2_CPU_ACCUMULATE_SRV_MOTION_VECTORS && (pass == FFX_FSR2_PASS_ACCUMULATE || pass == FFX_FSR2_PASS_ACCUMULATE_SHARPEN)
+            && !(permutationFlags & FSR2_CPU_PERMUTATION_LOW_RESOLUTION_MOTION_VECTORS)) {
+            name = L"r_input_motion_vectors";
+        }
+
+        outPipeline->srvResourceBindings[srvIndex].slotIndex = srvIndex;
+        wcscpy_s(outPipeline->srvResourceBindings[srvIndex].name, name);
+    }
+
+    for (uint32_t uavIndex = 0; uavIndex < outPipeline->uavCount; ++uavIndex)
+    {
+        outPipeline->uavResourceBindings[uavIndex].slotIndex = uavIndex;
+        wcscpy_s(outPipeline->uavResourceBindings[uavIndex].name, bindings->uavNames[uavIndex]);
+    }
+
+    for (uint32_t cbIndex = 0; cbIndex < outPipeline->constCount; ++cbIndex)
+    {
+        outPipeline->cbResourceBindings[cbIndex].slotIndex = cbIndex;
+        wcscpy_s(outPipeline->cbResourceBindings[cbIndex].name, bindings->cbNames[cbIndex]);
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode ScheduleGpuJobCPU(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != job);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    FFX_ASSERT(backendContext->gpuJobCount < FSR2_MAX_GPU_JOBS);
+
+    // the job, including its constant buffers, is stored by value so it may live on the caller's stack
+    backendContext->gpuJobs[backendContext->gpuJobCount] = *job;
+    backendContext->gpuJobCount++;
+
+    return FFX_OK;
+}
+
+static void getSurface(BackendContext_CPU* backendContext, FfxResourceInternal resource, uint32_t firstMip, Fsr2CpuSurface* outSurface)
+{
+    memset(outSurface, 0, sizeof(*outSurface));
+
+    const BackendContext_CPU::Resource* backendResource = &backendContext->resources[resource.internalIndex];
+    if (resource.internalIndex <= 0 || !backendResource->data || firstMip >= backendResource->mipCount) {
+        return;
+    }
+
+    const uint32_t texelSize = fsr2CpuGetSurfaceFormatSize(backendResource->storageFormat);
+    outSurface->format = backendResource->storageFormat;
+    outSurface->mipCount = backendResource->mipCount - firstMip;
+
+    for (uint32_t mip = 0; mip < outSurface->mipCount; ++mip) {
+
+        const uint32_t resourceMip = firstMip + mip;
+        Fsr2CpuSurfaceMip* surfaceMip = &outSurface->mips[mip];
+        surfaceMip->data = backendResource->data + backendResource->mipOffsets[resourceMip];
+        surfaceMip->width = int32_t(FFX_MAXIMUM(1u, backendResource->resourceDescription.width >> resourceMip));
+        surfaceMip->height = int32_t(FFX_MAXIMUM(1u, backendResource->resourceDescription.height >> resourceMip));
+        surfaceMip->rowPitch = (backendResource->ownsData || backendResource->sharedData || backendResource->transientData) ? size_t(surfaceMip->width) * texelSize : backendResource->rowPitch;
+    }
+}
+
+static FfxErrorCode getComputeJob(BackendContext_CPU* backendContext, const FfxGpuJobDescription* job, Fsr2CpuJob* outJob)
+{
+    const FfxComputeJobDescription* computeJob = &job->computeJobDescriptor;
+    const Fsr2CpuPipeline* pipeline = reinterpret_cast<const Fsr2CpuPipeline*>(computeJob->pipeline.pipeline);
+    FFX_RETURN_ON_ERROR(pipeline && pipeline->kernel, FFX_ERROR_INVALID_ARGUMENT);
+
+    outJob->pipeline = pipeline;
+    memcpy(outJob->dimensions, computeJob->dimensions, sizeof(outJob->dimensions));
+
+    for (uint32_t srvIndex = 0; srvIndex < FFX_MAX_NUM_SRVS; ++srvIndex) {
+
+        getSurface(backendContext, computeJob->srvs[srvIndex], 0, &outJob->srvs[srvIndex]);
+    }
+
+    for (uint32_t uavIndex = 0; uavIndex < FFX_MAX_NUM_UAVS; ++uavIndex) {
+
+        getSurface(backendContext, computeJob->uavs[uavIndex], computeJob->uavMip[uavIndex], &outJob->uavs[uavIndex]);
+    }
+
+    for (uint32_t cbIndex = 0; cbIndex < FFX_MAX_NUM_CONST_BUFFERS; ++cbIndex) {
+
+        outJob->cbs[cbIndex] = computeJob->cbs[cbIndex].data;
+    }
+
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobCompute(BackendContext_CPU* backendContext, FfxGpuJobDescription* job)
+{
+    Fsr2CpuJob cpuJob;
+    FFX_VALIDATE(getComputeJob(backendContext, job, &cpuJob));
+
+    backendContext->executor->dispatch(&cpuJob);
+
+    if (cpuJob.pipeline->resolve) {
+        cpuJob.pipeline->resolve(&cpuJob);
+    }
+
+    return FFX_OK;
+}
+
+static bool isComputeJob(const BackendContext_CPU* backendContext, uint32_t jobIndex, FfxFsr2Pass pass)
+{
+    if (jobIndex >= backendContext->gpuJobCount || backendContext->gpuJobs[jobIndex].jobType != FFX_GPU_JOB_COMPUTE) {
+        return false;
+    }
+
+    const Fsr2CpuPipeline* pipeline = reinterpret_cast<const Fsr2CpuPipeline*>(backendContext->gpuJobs[jobIndex].computeJobDescriptor.pipeline.pipeline);
+    return pipeline && pipeline->pass == pass;
+}
+
+// Number of jobs starting at jobIndex that execute as the fused pre-pass, 0 if they do not form one.
+static uint32_t getFusedPrepassJobCount(const BackendContext_CPU* backendContext, uint32_t jobIndex)
+{
+#if FSR2_CPU_FUSE_PREPASS
+    if (isComputeJob(backendContext, jobIndex + 0, FFX_FSR2_PASS_RECONSTRUCT_PREVIOUS_DEPTH)
+        && isComputeJob(backendContext, jobIndex + 1, FFX_FSR2_PASS_DEPTH_CLIP)
+        && isComputeJob(backendContext, jobIndex + 2, FFX_FSR2_PASS_LOCK)) {
+        return 3;
+    }
+#else
+    FFX_UNUSED(backendContext);
+    FFX_UNUSED(jobIndex);
+#endif // #if FSR2_CPU_FUSE_PREPASS
+
+    return 0;
+}
+
+static FfxErrorCode executeFusedPrepass(BackendContext_CPU* backendContext, uint32_t jobIndex)
+{
+    Fsr2CpuJob jobs[3];
+    for (uint32_t passIndex = 0; passIndex < 3; ++passIndex) {
+
+        FFX_VALIDATE(getComputeJob(backendContext, &backendContext->gpuJobs[jobIndex + passIndex], &jobs[passIndex]));
+    }
+
+    fsr2CpuExecuteFusedPrepass(backendContext->executor, &jobs[0], &jobs[1], &jobs[2]);
+
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobCopy(BackendContext_CPU* backendContext, FfxGpuJobDescription* job)
+{
+    Fsr2CpuSurface src, dst;
+    getSurface(backendContext, job->copyJobDescriptor.src, 0, &src);
+    getSurface(backendContext, job->copyJobDescriptor.dst, 0, &dst);
+
+    const uint32_t mipCount = FFX_MINIMUM(src.mipCount, dst.mipCount);
+    for (uint32_t mip = 0; mip < mipCount; ++mip) {
+
+        const int32_t width = FFX_MINIMUM(src.mips[mip].width, dst.mips[mip].width);
+        const int32_t height = FFX_MINIMUM(src.mips[mip].height, dst.mips[mip].height);
+        const uint32_t srcTexelSize = fsr2CpuGetSurfaceFormatSize(src.format);
+        const uint32_t dstTexelSize = fsr2CpuGetSurfaceFormatSize(dst.format);
+
+        for (int32_t y = 0; y < height; ++y) {
+
+            if (src.format == dst.format) {
+
+                memcpy(fsr2CpuTexelAddress(dst.mips[mip], 0, y, dstTexelSize), fsr2CpuTexelAddress(src.mips[mip], 0, y, srcTexelSize), size_t(width) * srcTexelSize);
+                continue;
+            }
+
+            for (int32_t x = 0; x < width; ++x) {
+
+                fsr2CpuStore(dst, x, y, fsr2CpuLoad(src, x, y, mip), mip);
+            }
+        }
+    }
+
+    return FFX_OK;
+}
+
+static FfxErrorCode executeGpuJobClearFloat(BackendContext_CPU* backendContext, FfxGpuJobDescription* job)
+{
+    Fsr2CpuSurface surface;
+    getSurface(backendContext, job->clearJobDescriptor.target, 0, &surface);
+
+    const fsr2cpu::float4 color(job->clearJobDescriptor.color[0], job->clearJobDescriptor.color[1], job->clearJobDescriptor.color[2], job->clearJobDescriptor.color[3]);
+
+    // clear every mip so internal surfaces always start from a defined state
+    for (uint32_t mip = 0; mip < surface.mipCount; ++mip) {
+
+        for (int32_t y = 0; y < surface.mips[mip].height; ++y) {
+
+            for (int32_t x = 0; x < surface.mips[mip].width; ++x) {
+
+                fsr2CpuStore(surface, x, y, color, mip);
+            }
+        }
+    }
+
+    return FFX_OK;
+}
+
+static uint64_t getHostTime()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Attribute the time a run of jobs took to each of them, the passes of a fused pre-pass share it.
+static void addJobDuration(BackendContext_CPU* backendContext, uint32_t firstJob, uint32_t jobCount, uint64_t duration)
+{
+    for (uint32_t jobIndex = firstJob; jobIndex < firstJob + jobCount; ++jobIndex) {
+
+        backendContext->jobStatistics[jobIndex].duration += duration / jobCount;
+    }
+}
+
+// Store the execution of a job in the trace, jobs running together share the interval they ran in.
+static void traceJob(const BackendContext_CPU* backendContext, uint32_t jobIndex, uint64_t beginTime, uint64_t endTime)
+{
+    if (!ffxFsr2TraceIsEnabled()) {
+        return;
+    }
+
+    const FfxGpuJobDescription* job = &backendContext->gpuJobs[jobIndex];
+    const char* name = "Unknown";
+    switch (job->jobType) {
+
+        case FFX_GPU_JOB_CLEAR_FLOAT:
+            name = "Clear";
+            break;
+
+        case FFX_GPU_JOB_COPY:
+            name = "Copy";
+            break;
+
+        case FFX_GPU_JOB_COMPUTE:
+            name = ffxFsr2TraceGetPassName(reinterpret_cast<const Fsr2CpuPipeline*>(job->computeJobDescriptor.pipeline.pipeline)->pass);
+            break;
+
+        default:
+            break;
+    }
+
+    ffxFsr2TraceEvent(name, "execute", beginTime, endTime);
+}
+
+static FfxErrorCode executeGpuJob(BackendContext_CPU* backendContext, uint32_t jobIndex, uint32_t* outJobCount)
+{
+    FfxGpuJobDescription* GpuJob = &backendContext->gpuJobs[jobIndex];
+
+    *outJobCount = 1;
+
+    switch (GpuJob->jobType) {
+
+        case FFX_GPU_JOB_CLEAR_FLOAT:
+            return executeGpuJobClearFloat(backendContext, GpuJob);
+
+        case FFX_GPU_JOB_COPY:
+            return executeGpuJobCopy(backendContext, GpuJob);
+
+        case FFX_GPU_JOB_COMPUTE:
+            if (const uint32_t fusedJobCount = getFusedPrepassJobCount(backendContext, jobIndex)) {
+                *outJobCount = fusedJobCount;
+                return executeFusedPrepass(backendContext, jobIndex);
+            }
+            return executeGpuJobCompute(backendContext, GpuJob);
+
+        default:
+            return FFX_OK;
+    }
+}
+
+#if FSR2_CPU_PIPELINE_JOBS
+FFX_STATIC_ASSERT(FSR2_MAX_GPU_JOBS <= 64 && FSR2_MAX_GPU_JOBS <= FSR2_CPU_MAX_DISPATCHED_JOBS);
+
+// The host memory of every mip of a resource, empty for the NULL resource.
+static BackendContext_CPU::MemoryRange getResourceMemory(const BackendContext_CPU* backendContext, FfxResourceInternal resource)
+{
+    BackendContext_CPU::MemoryRange range = {};
+
+    const BackendContext_CPU::Resource* backendResource = &backendContext->resources[resource.internalIndex];
+    if (resource.internalIndex <= 0 || !backendResource->data) {
+        return range;
+    }
+
+    const uint32_t lastMip = backendResource->mipCount - 1;
+    const size_t texelSize = fsr2CpuGetSurfaceFormatSize(backendResource->storageFormat);
+    const size_t width = FFX_MAXIMUM(1u, backendResource->resourceDescription.width >> lastMip);
+    const size_t height = FFX_MAXIMUM(1u, backendResource->resourceDescription.height >> lastMip);
+    const size_t rowPitch = (backendResource->ownsData || backendResource->sharedData || backendResource->transientData) ? width * texelSize : backendResource->rowPitch;
+
+    range.begin = backendResource->data;
+    range.end = backendResource->data + backendResource->mipOffsets[lastMip] + (height - 1) * rowPitch + width * texelSize;
+    return range;
+}
+
+static void addMemoryRange(const BackendContext_CPU* backendContext, FfxResourceInternal resource, BackendContext_CPU::MemoryRange* ranges, uint32_t* rangeCount)
+{
+    const BackendContext_CPU::MemoryRange range = getResourceMemory(backendContext, resource);
+    if (range.begin != range.end) {
+        ranges[(*rangeCount)++] = range;
+    }
+}
+
+static bool overlaps(const BackendContext_CPU::MemoryRange* ranges, uint32_t rangeCount, const BackendContext_CPU::MemoryRange* otherRanges, uint32_t otherRangeCount)
+{
+    for (uint32_t rangeIndex = 0; rangeIndex < rangeCount; ++rangeIndex) {
+
+        for (uint32_t otherRangeIndex = 0; otherRangeIndex < otherRangeCount; ++otherRangeIndex) {
+
+            if (ranges[rangeIndex].begin < otherRanges[otherRangeIndex].end && otherRanges[otherRangeIndex].begin < ranges[rangeIndex].end) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Add the job starting at jobIndex to the job graph, along with the memory it reads and writes.
+static FfxErrorCode addJobNode(BackendContext_CPU* backendContext, uint32_t jobIndex, uint32_t nodeIndex, uint32_t* prepassCount)
+{
+    BackendContext_CPU::JobNode* node = &backendContext->jobNodes[nodeIndex];
+    const FfxGpuJobDescription* GpuJob = &backendContext->gpuJobs[jobIndex];
+
+    node->firstJob = jobIndex;
+    node->jobCount = 1;
+    node->phaseCount = 0;
+    node->phase = 0;
+    node->prepass = nullptr;
+    node->dependencies = 0;
+    node->readCount = 0;
+    node->writeCount = 0;
+
+    switch (GpuJob->jobType) {
+
+        case FFX_GPU_JOB_CLEAR_FLOAT:
+            addMemoryRange(backendContext, GpuJob->clearJobDescriptor.target, node->writes, &node->writeCount);
+            break;
+
+        case FFX_GPU_JOB_COPY:
+            addMemoryRange(backendContext, GpuJob->copyJobDescriptor.src, node->reads, &node->readCount);
+            addMemoryRange(backendContext, GpuJob->copyJobDescriptor.dst, node->writes, &node->writeCount);
+            break;
+
+        case FFX_GPU_JOB_COMPUTE:
+            node->jobCount = FFX_MAXIMUM(1u, getFusedPrepassJobCount(backendContext, jobIndex));
+            node->phaseCount = 1;
+
+            for (uint32_t passIndex = 0; passIndex < node->jobCount; ++passIndex) {
+
+                const FfxGpuJobDescription* passJob = &backendContext->gpuJobs[jobIndex + passIndex];
+                FFX_VALIDATE(getComputeJob(backendContext, passJob, &backendContext->cpuJobs[jobIndex + passIndex]));
+
+                for (uint32_t srvIndex = 0; srvIndex < FFX_MAX_NUM_SRVS; ++srvIndex) {
+
+                    addMemoryRange(backendContext, passJob->computeJobDescriptor.srvs[srvIndex], node->reads, &node->readCount);
+                }
+
+                // a UAV may start at any mip, so the whole resource is written as far as other jobs are concerned
+                for (uint32_t uavIndex = 0; uavIndex < FFX_MAX_NUM_UAVS; ++uavIndex) {
+
+                    addMemoryRange(backendContext, passJob->computeJobDescriptor.uavs[uavIndex], node->writes, &node->writeCount);
+                }
+            }
+
+            if (node->jobCount > 1) {
+
+                node->prepass = &backendContext->prepasses[(*prepassCount)++];
+                node->phaseCount = FSR2_CPU_PREPASS_SWEEP_COUNT;
+
+                const Fsr2CpuJob* cpuJobs = &backendContext->cpuJobs[jobIndex];
+                fsr2CpuSetupFusedPrepass(node->prepass, &cpuJobs[0], &cpuJobs[1], &cpuJobs[2]);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    // a node waits for every earlier node writing memory it accesses, and for every earlier node
+    // reading memory it writes
+    for (uint32_t otherNodeIndex = 0; otherNodeIndex < nodeIndex; ++otherNodeIndex) {
+
+        const BackendContext_CPU::JobNode* otherNode = &backendContext->jobNodes[otherNodeIndex];
+        if (overlaps(otherNode->writes, otherNode->writeCount, node->reads, node->readCount)
+            || overlaps(otherNode->writes, otherNode->writeCount, node->writes, node->writeCount)
+            || overlaps(otherNode->reads, otherNode->readCount, node->writes, node->writeCount)) {
+
+            node->dependencies |= uint64_t(1) << otherNodeIndex;
+        }
+    }
+
+    return FFX_OK;
+}
+
+static const Fsr2CpuJob* getJobNodePhase(const BackendContext_CPU* backendContext, const BackendContext_CPU::JobNode* node)
+{
+    return node->prepass ? &node->prepass->sweeps[node->phase] : &backendContext->cpuJobs[node->firstJob];
+}
+
+// Execute the scheduled jobs as a graph in which each job depends on the earlier jobs it has a
+// read after write, write after read or write after write hazard with. Each round dispatches the
+// jobs whose dependencies completed together, so the render resolution passes of a frame of a batch
+// run next to the sharpening of the previous frame, and the luminance pyramid next to the pre-pass
+// when the exposure is not computed. Jobs touching the same memory still run in submission order,
+// so the results do not change.
+static uint64_t getJobGroupCount(const Fsr2CpuJob* job)
+{
+    return uint64_t(FFX_MAXIMUM(1u, job->dimensions[0])) * FFX_MAXIMUM(1u, job->dimensions[1]) * FFX_MAXIMUM(1u, job->dimensions[2]);
+}
+
+static FfxErrorCode executeGpuJobsPipelined(BackendContext_CPU* backendContext)
+{
+    uint32_t nodeCount = 0;
+    uint32_t prepassCount = 0;
+    for (uint32_t currentGpuJobIndex = 0; currentGpuJobIndex < backendContext->gpuJobCount; currentGpuJobIndex += backendContext->jobNodes[nodeCount++].jobCount) {
+
+        FFX_VALIDATE(addJobNode(backendContext, currentGpuJobIndex, nodeCount, &prepassCount));
+    }
+
+    const uint64_t allNodes = (nodeCount < 64) ? (uint64_t(1) << nodeCount) - 1 : ~uint64_t(0);
+    uint64_t startedNodes = 0;
+    uint64_t completedNodes = 0;
+
+    while (completedNodes != allNodes) {
+
+        // start every node whose dependencies completed, clears and copies run right away on this
+        // thread and may in turn complete the dependencies of earlier nodes
+        for (bool startedHostNode = true; startedHostNode; ) {
+
+            startedHostNode = false;
+            for (uint32_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+
+                BackendContext_CPU::JobNode* node = &backendContext->jobNodes[nodeIndex];
+                const uint64_t nodeMask = uint64_t(1) << nodeIndex;
+                if ((startedNodes & nodeMask) || (node->dependencies & ~completedNodes)) {
+                    continue;
+                }
+
+                startedNodes |= nodeMask;
+                if (node->phaseCount == 0) {
+
+                    const uint64_t startTime = getHostTime();
+                    uint32_t jobCount = 0;
+                    FFX_VALIDATE(executeGpuJob(backendContext, node->firstJob, &jobCount));
+                    const uint64_t endTime = getHostTime();
+                    addJobDuration(backendContext, node->firstJob, jobCount, endTime - startTime);
+                    traceJob(backendContext, node->firstJob, startTime, endTime);
+                    completedNodes |= nodeMask;
+                    startedHostNode = true;
+                }
+            }
+        }
+
+        const Fsr2CpuJob* jobs[FSR2_MAX_GPU_JOBS];
+        uint32_t jobCount = 0;
+        uint64_t roundGroupCount = 0;
+        for (uint32_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+
+            if ((startedNodes & ~completedNodes) & (uint64_t(1) << nodeIndex)) {
+                jobs[jobCount] = getJobNodePhase(backendContext, &backendContext->jobNodes[nodeIndex]);
+                roundGroupCount += getJobGroupCount(jobs[jobCount++]);
+            }
+        }
+
+        FFX_ASSERT(jobCount > 0 || completedNodes == allNodes);
+        const uint64_t roundStartTime = getHostTime();
+        backendContext->executor->dispatch(jobs, jobCount);
+        const uint64_t roundEndTime = getHostTime();
+        const uint64_t roundDuration = roundEndTime - roundStartTime;
+
+        for (uint32_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+
+            BackendContext_CPU::JobNode* node = &backendContext->jobNodes[nodeIndex];
+            const uint64_t nodeMask = uint64_t(1) << nodeIndex;
+            if (!(startedNodes & ~completedNodes & nodeMask)) {
+                continue;
+            }
+
+            const Fsr2CpuJob* job = getJobNodePhase(backendContext, node);
+            if (job->pipeline->resolve) {
+                job->pipeline->resolve(job);
+            }
+
+            // jobs of a round run together, each takes the share of its thread groups
+            const uint32_t jobIndex = node->firstJob + (node->prepass ? node->phase : 0);
+            backendContext->jobStatistics[jobIndex].duration += roundGroupCount ? roundDuration * getJobGroupCount(job) / roundGroupCount : 0;
+            traceJob(backendContext, jobIndex, roundStartTime, roundEndTime);
+
+            if (++node->phase == node->phaseCount) {
+                completedNodes |= nodeMask;
+            }
+        }
+    }
+
+    return FFX_OK;
+}
+#endif // #if FSR2_CPU_PIPELINE_JOBS
+
+FfxErrorCode ExecuteGpuJobsCPU(
+    FfxFsr2Interface* backendInterface,
+    FfxCommandList commandList)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_UNUSED(commandList);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    const FfxFsr2TraceScope traceScope("ExecuteGpuJobsCPU", "backend");
+
+    FfxErrorCode errorCode = FFX_OK;
+
+    // the executor runs every thread group with the control state of this thread, pin it so the
+    // output does not depend on the one of the application either
+    const uint32_t callerFloatControl = fsr2CpuGetFloatControl();
+    if (backendContext->deterministic) {
+        fsr2CpuSetFloatControl(fsr2CpuGetDefaultFloatControl());
+    }
+
+    memset(backendContext->jobStatistics, 0, sizeof(backendContext->jobStatistics));
+    backendContext->jobStatisticsCount = backendContext->gpuJobCount;
+
+    backendContext->executor->beginFrame();
+
+#if FSR2_CPU_PIPELINE_JOBS
+    errorCode = executeGpuJobsPipelined(backendContext);
+#else
+    // execute all jobs in submission order, each job completes before the next one starts
+    for (uint32_t currentGpuJobIndex = 0, jobCount = 0; currentGpuJobIndex < backendContext->gpuJobCount && errorCode == FFX_OK; currentGpuJobIndex += jobCount) {
+
+        const uint64_t startTime = getHostTime();
+        errorCode = executeGpuJob(backendContext, currentGpuJobIndex, &jobCount);
+        const uint64_t endTime = getHostTime();
+        addJobDuration(backendContext, currentGpuJobIndex, jobCount, endTime - startTime);
+
+        for (uint32_t jobIndex = currentGpuJobIndex; jobIndex < currentGpuJobIndex + jobCount; ++jobIndex) {
+
+            traceJob(backendContext, jobIndex, startTime, endTime);
+        }
+    }
+#endif // #if FSR2_CPU_PIPELINE_JOBS
+
+    backendContext->executor->endFrame();
+
+    backendContext->gpuJobCount = 0;
+
+    fsr2CpuSetFloatControl(callerFloatControl);
+
+    // check the execute function returned cleanly.
+    FFX_RETURN_ON_ERROR(
+        errorCode == FFX_OK,
+        FFX_ERROR_BACKEND_API_ERROR);
+
+    return FFX_OK;
+}
+
+FfxErrorCode DestroyResourceCPU(
+    FfxFsr2Interface* backendInterface,
+    FfxResourceInternal resource)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    if (resource.internalIndex > 0) {
+
+        BackendContext_CPU::Resource* backendResource = &backendContext->resources[resource.internalIndex];
+        releaseResourceData(backendResource);
+        backendResource->data = nullptr;
+        backendResource->ownsData = false;
+        backendResource->sharedData = false;
+        backendResource->transientData = false;
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode DestroyPipelineCPU(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    if (!pipeline)
+        return FFX_OK;
+
+    // pipelines are owned by the backend context, only drop the references
+    pipeline->rootSignature = nullptr;
+    pipeline->pipeline = nullptr;
+
+    return FFX_OK;
+}
+
+// Copy mip 0 of a resource between its storage and tightly packed texels in format.
+static FfxErrorCode copyResourceTexels(BackendContext_CPU* backendContext, FfxResourceInternal resource, FfxSurfaceFormat format, uint8_t* data, size_t dataSize, bool toResource)
+{
+    Fsr2CpuSurface surface;
+    getSurface(backendContext, resource, 0, &surface);
+    FFX_RETURN_ON_ERROR(surface.mipCount > 0, FFX_ERROR_INVALID_ARGUMENT);
+
+    const Fsr2CpuSurfaceMip& mip = surface.mips[0];
+    const uint32_t storageTexelSize = fsr2CpuGetSurfaceFormatSize(surface.format);
+    const uint32_t texelSize = fsr2CpuGetSurfaceFormatSize(format);
+    const size_t rowSize = size_t(mip.width) * texelSize;
+    FFX_RETURN_ON_ERROR(texelSize && dataSize == rowSize * size_t(mip.height), FFX_ERROR_INVALID_SIZE);
+
+    for (int32_t y = 0; y < mip.height; ++y) {
+
+        uint8_t* row = data + size_t(y) * rowSize;
+        uint8_t* storageRow = fsr2CpuTexelAddress(mip, 0, y, storageTexelSize);
+
+        if (format == surface.format) {
+
+            memcpy(toResource ? storageRow : row, toResource ? row : storageRow, rowSize);
+            continue;
+        }
+
+        for (int32_t x = 0; x < mip.width; ++x) {
+
+            float value[4] = {};
+            if (toResource) {
+                fsr2CpuDecodeTexel(format, row + size_t(x) * texelSize, value);
+                fsr2CpuEncodeTexel(surface.format, value, storageRow + size_t(x) * storageTexelSize);
+            } else {
+                fsr2CpuDecodeTexel(surface.format, storageRow + size_t(x) * storageTexelSize, value);
+                fsr2CpuEncodeTexel(format, value, row + size_t(x) * texelSize);
+            }
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode ReadResourceCPU(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, void* data, size_t dataSize)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    FFX_RETURN_ON_ERROR(data, FFX_ERROR_INVALID_POINTER);
+
+    // jobs run synchronously, so every executed job is complete
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    return copyResourceTexels(backendContext, resource, format, static_cast<uint8_t*>(data), dataSize, false);
+}
+
+FfxErrorCode WriteResourceCPU(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, const void* data, size_t dataSize)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    FFX_RETURN_ON_ERROR(data, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    return copyResourceTexels(backendContext, resource, format, static_cast<uint8_t*>(const_cast<void*>(data)), dataSize, true);
+}
+
+FfxErrorCode GetGpuJobStatisticsCPU(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    FFX_RETURN_ON_ERROR(outStatistics && inoutJobCount, FFX_ERROR_INVALID_POINTER);
+
+    // jobs run synchronously and without barriers, the durations are host timings
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+    *inoutJobCount = FFX_MINIMUM(*inoutJobCount, backendContext->jobStatisticsCount);
+    memcpy(outStatistics, backendContext->jobStatistics, *inoutJobCount * sizeof(FfxGpuJobStatistics));
+
+    return FFX_OK;
+}
+
+FfxErrorCode GetResourceMemoryRequirementsCPU(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* desc, FfxResourceMemoryRequirements* outRequirements)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+    FFX_RETURN_ON_ERROR(desc && outRequirements, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_CPU::Resource resource = {};
+    resource.resourceDescription = desc->resourceDescription;
+    resource.resourceDescription.height = FFX_MAXIMUM(1u, resource.resourceDescription.height);
+    resource.resourceDescription.depth = FFX_MAXIMUM(1u, resource.resourceDescription.depth);
+
+    outRequirements->size = layoutResource(&resource);
+    outRequirements->alignment = 64;
+
+    return FFX_OK;
+}
+
+FfxErrorCode CreateTransientHeapCPU(FfxFsr2Interface* backendInterface, uint64_t heapSize, bool shared)
+{
+    FFX_ASSERT(backendInterface != nullptr);
+
+    BackendContext_CPU* backendContext = (BackendContext_CPU*)backendInterface->scratchBuffer;
+
+    if (backendContext->transientHeap) {
+
+        if (backendContext->sharedTransientHeap) {
+            transientHeapCache.release(backendContext->transientHeap, [](uint8_t* heap) { free(heap); });
+        } else {
+            free(backendContext->transientHeap);
+        }
+        backendContext->transientHeap = nullptr;
+    }
+
+    if (!heapSize) {
+        return FFX_OK;
+    }
+
+    const auto allocateHeap = [heapSize](uint8_t** outHeap) {
+
+        *outHeap = (uint8_t*)malloc(size_t(heapSize));
+        return *outHeap ? FFX_OK : FFX_ERROR_OUT_OF_MEMORY;
+    };
+
+    const FfxErrorCode errorCode = shared ? transientHeapCache.acquire(heapSize, &backendContext->transientHeap, allocateHeap) : allocateHeap(&backendContext->transientHeap);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    backendContext->sharedTransientHeap = shared;
+
+    return FFX_OK;
+}
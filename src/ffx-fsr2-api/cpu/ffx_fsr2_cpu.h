@@ -0,0 +1,318 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// This file contains function declarations to wrap host memory as API independent FFX resources
+// and to create the CPU backend, which runs the FSR2 passes on the host.
+
+// @defgroup CPU
+
+#pragma once
+
+#include "../ffx_fsr2_interface.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // #if defined(__cplusplus)
+
+/// Query how much memory is required for the CPU backend's scratch buffer.
+///
+/// @returns
+/// The size (in bytes) of the required scratch memory buffer for the CPU backend.
+FFX_API size_t ffxFsr2GetScratchMemorySizeCPU();
+
+/// Populate an interface with pointers for the CPU backend.
+///
+/// The CPU backend executes every FSR2 pass on the host over plain memory buffers. Work is
+/// scheduled exactly as for the GPU backends and executed synchronously when the FSR2 runtime
+/// calls <c><i>fpExecuteGpuJobs</i></c>, so the resources passed to a dispatch can be read back as
+/// soon as <c><i>ffxFsr2ContextDispatch</i></c> returns.
+///
+/// @param [out] fsr2Interface              A pointer to a <c><i>FfxFsr2Interface</i></c> structure to populate with pointers.
+/// @param [in] threadCount                 The number of host threads used to execute passes, or 0 to use all hardware threads.
+/// @param [in] scratchBuffer               A pointer to a buffer of memory which can be used by the CPU backend.
+/// @param [in] scratchBufferSize           The size (in bytes) of the buffer pointed to by <c><i>scratchBuffer</i></c>.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_CODE_INVALID_POINTER          The <c><i>interface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2GetInterfaceCPU(
+    FfxFsr2Interface* fsr2Interface,
+    uint32_t threadCount,
+    void* scratchBuffer,
+    size_t scratchBufferSize);
+
+/// Enable or disable the deterministic execution mode of the CPU backend.
+///
+/// In deterministic mode the output of the passes is bit-identical regardless of the thread count,
+/// the order the thread groups run in, the instruction sets of the host and the floating point
+/// control state (rounding mode, flush to zero) of the calling thread. Passes only run their scalar
+/// reference kernels, with the default floating point control state, which is slower. Scatters and
+/// reductions need nothing more, as they are either integer atomics or done in a fixed order.
+///
+/// Must be called after <c><i>ffxFsr2GetInterfaceCPU</i></c> and before the interface is used to create a context.
+///
+/// @param [in] fsr2Interface               A pointer to a <c><i>FfxFsr2Interface</i></c> structure populated by <c><i>ffxFsr2GetInterfaceCPU</i></c>.
+/// @param [in] deterministic               True to enable the deterministic mode, which is disabled by default.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>fsr2Interface</i></c> pointer or its scratch buffer was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              A context was already created with <c><i>fsr2Interface</i></c>.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2SetDeterministicCPU(FfxFsr2Interface* fsr2Interface, bool deterministic);
+
+/// A pool of host threads shared by the CPU backends of many contexts, see <c><i>ffxFsr2CreateServiceCPU</i></c>.
+///
+/// @ingroup FSR2 CPU
+typedef struct FfxFsr2ServiceCPU FfxFsr2ServiceCPU;
+
+/// The load of a <c><i>FfxFsr2ServiceCPU</i></c>, as returned by <c><i>ffxFsr2GetServiceStatisticsCPU</i></c>.
+///
+/// @ingroup FSR2 CPU
+typedef struct FfxFsr2ServiceStatisticsCPU {
+
+    uint32_t                    streamCount;                        ///< The number of backend contexts using the service.
+    uint32_t                    activeFrameCount;                   ///< The number of execute calls currently running.
+    uint32_t                    waitingFrameCount;                  ///< The number of execute calls waiting to be admitted.
+    uint64_t                    completedFrameCount;                ///< The number of execute calls completed since the service was created.
+    uint64_t                    missedDeadlineCount;                ///< The number of completed execute calls which took longer than the frame budget of their context.
+} FfxFsr2ServiceStatisticsCPU;
+
+/// Create a pool of host threads to share between the CPU backends of many contexts.
+///
+/// Each context attached with <c><i>ffxFsr2SetServiceCPU</i></c> submits its thread groups to the
+/// pool instead of running them on threads of its own, and the thread calling
+/// <c><i>ffxFsr2ContextDispatch</i></c> waits for them to complete. The execute calls of the
+/// contexts are admitted in arrival order, up to <c><i>maximumActiveFrameCount</i></c> at a time; the
+/// others block until an active one completes, so an oversubscribed host delays new frames instead
+/// of slowing down every frame in flight.
+///
+/// The thread groups of the admitted frames run by priority. A frame with less than a quarter of its
+/// budget left is urgent, and urgent frames run earliest deadline first. The other frames share the
+/// pool in proportion to the weights of their contexts by weighted fair queuing.
+///
+/// @param [out] outService                 A pointer to receive the service.
+/// @param [in] threadCount                 The number of host threads of the pool, or 0 to use all hardware threads.
+/// @param [in] maximumActiveFrameCount     The number of execute calls running at the same time, or 0 for no limit.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               <c><i>outService</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_OUT_OF_MEMORY                 The service could not be allocated.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2CreateServiceCPU(FfxFsr2ServiceCPU** outService, uint32_t threadCount, uint32_t maximumActiveFrameCount);
+
+/// Destroy a service created by <c><i>ffxFsr2CreateServiceCPU</i></c>.
+///
+/// @param [in] service                     The service to destroy.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               <c><i>service</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              A context using the service was not destroyed yet.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2DestroyServiceCPU(FfxFsr2ServiceCPU* service);
+
+/// Run the passes of the context created with <c><i>fsr2Interface</i></c> on a shared service.
+///
+/// The <c><i>threadCount</i></c> given to <c><i>ffxFsr2GetInterfaceCPU</i></c> is then ignored.
+/// Must be called after <c><i>ffxFsr2GetInterfaceCPU</i></c> and before the interface is used to
+/// create a context, and the context must be destroyed before the service.
+///
+/// @param [in] fsr2Interface               A pointer to a <c><i>FfxFsr2Interface</i></c> structure populated by <c><i>ffxFsr2GetInterfaceCPU</i></c>.
+/// @param [in] service                     The service to run on, or <c><i>NULL</i></c> to use threads owned by the context.
+/// @param [in] weight                      The share of the service the context receives relative to the other contexts, at least 1.
+/// @param [in] frameBudgetMicroseconds     The time from the start of an execute call to its deadline, or 0 for frames without a deadline.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>fsr2Interface</i></c> pointer or its scratch buffer was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              A context was already created with <c><i>fsr2Interface</i></c>.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2SetServiceCPU(FfxFsr2Interface* fsr2Interface, FfxFsr2ServiceCPU* service, uint32_t weight, uint32_t frameBudgetMicroseconds);
+
+/// Query the load of a service.
+///
+/// @param [in] service                     The service to query.
+/// @param [out] outStatistics              A pointer to a <c><i>FfxFsr2ServiceStatisticsCPU</i></c> structure to populate.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               <c><i>service</i></c> or <c><i>outStatistics</i></c> was <c><i>NULL</i></c>.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2GetServiceStatisticsCPU(FfxFsr2ServiceCPU* service, FfxFsr2ServiceStatisticsCPU* outStatistics);
+
+/// Retrieve the <c><i>FfxDevice</i></c> to pass to <c><i>ffxFsr2ContextCreate</i></c> when using the CPU backend.
+///
+/// @returns
+/// An abstract FidelityFX device.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxDevice ffxGetDeviceCPU();
+
+/// Retrieve the <c><i>FfxCommandList</i></c> to pass to the FSR2 dispatch functions when using the CPU backend.
+///
+/// @returns
+/// An abstract FidelityFX command list.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxCommandList ffxGetCommandListCPU();
+
+/// Create a <c><i>FfxResource</i></c> from a host memory buffer.
+///
+/// The buffer holds <c><i>description.height</i></c> rows of <c><i>description.width</i></c> texels
+/// in <c><i>description.format</i></c>, and must stay valid until the dispatch it is used in returns.
+///
+/// @param [in] context                     A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] data                        A pointer to the first texel of the buffer.
+/// @param [in] description                 The description of the surface stored in <c><i>data</i></c>.
+/// @param [in] rowPitch                    The distance (in bytes) between two rows, or 0 for tightly packed rows.
+/// @param [in] name                        (optional) A name string to identify the resource in debug mode.
+/// @param [in] state                       The state the resource is currently in.
+///
+/// @returns
+/// An abstract FidelityFX resources.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxResource ffxGetResourceCPU(
+    FfxFsr2Context* context,
+    void* data,
+    FfxResourceDescription description,
+    size_t rowPitch,
+    const wchar_t* name = nullptr,
+    FfxResourceStates state = FFX_RESOURCE_STATE_COMPUTE_READ);
+
+/// Retrieve the host memory associated with a RESOURCE_IDENTIFIER.
+/// Used for debug purposes when blitting internal surfaces.
+///
+/// Internal surfaces keep the format they were requested in, unless the backend is built with
+/// <c><i>FSR2_CPU_PACKED_STORAGE</i></c> set to 0, which promotes them to 32 bits per component.
+/// Callers must check the storage format with <c><i>ffxGetCPUResourceFormat</i></c>.
+///
+/// @param [in] context                     A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] resId                       A resourceID.
+///
+/// @returns
+/// A pointer to the first texel of mip 0 of the resource.
+///
+/// @ingroup FSR2 CPU
+FFX_API void* ffxGetCPUResourcePtr(FfxFsr2Context* context, uint32_t resId);
+
+/// Retrieve the format in which the memory returned by <c><i>ffxGetCPUResourcePtr</i></c> is stored.
+///
+/// @param [in] context                     A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] resId                       A resourceID.
+///
+/// @returns
+/// The storage format of the resource.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxSurfaceFormat ffxGetCPUResourceFormat(FfxFsr2Context* context, uint32_t resId);
+
+/// Sharpen a host image with RCAS, the filter FSR2 applies when <c><i>enableSharpening</i></c> is set.
+///
+/// The image holds <c><i>height</i></c> tightly packed rows of <c><i>width</i></c> RGBA texels with
+/// 32-bit float channels. Texels outside the image are clamped to its edges and alpha is copied
+/// unchanged. The filter runs on the calling thread, vectorized when the host supports AVX2.
+///
+/// @param [in] source                      A pointer to the first texel of the image to sharpen.
+/// @param [out] destination                A pointer to the first texel of the sharpened image, which may not alias <c><i>source</i></c>.
+/// @param [in] width                       The width (in texels) of the image.
+/// @param [in] height                      The height (in texels) of the image.
+/// @param [in] sharpness                   The sharpness in the range [0..1], as in <c><i>FfxFsr2DispatchDescription</i></c>.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               <c><i>source</i></c> or <c><i>destination</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              The image was empty, or <c><i>source</i></c> and <c><i>destination</i></c> were the same buffer.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2RcasCPU(const float* source, float* destination, uint32_t width, uint32_t height, float sharpness);
+
+/// Upscale a host image with EASU, the spatial upscaler of FSR1.
+///
+/// Both images hold rows of RGBA texels with 32-bit float channels, <c><i>sourcePitch</i></c> and
+/// <c><i>destinationPitch</i></c> bytes apart. Taps outside the source are clamped to its edges like
+/// the sampler of the shader does, and alpha is written as 1.
+///
+/// <c><i>constants</i></c> may point at the four <c><i>FfxUInt32x4</i></c> written by
+/// <c><i>ffxFsrPopulateEasuConstants</i></c> or <c><i>ffxFsrPopulateEasuConstantsOffset</i></c>, laid
+/// out back to back as in the constant buffer of the spatial upscale sample, which allows upscaling a
+/// viewport of the source. When it is <c><i>NULL</i></c> the whole source is scaled to the destination.
+///
+/// The output rows are split over <c><i>threadCount</i></c> host threads, which are started for the
+/// call. When upscaling many small images, prefer a <c><i>threadCount</i></c> of 1 and run several
+/// calls concurrently instead.
+///
+/// @param [in] source                      A pointer to the first texel of the image to upscale.
+/// @param [in] sourcePitch                 The distance in bytes between two rows of the source.
+/// @param [in] sourceWidth                 The width (in texels) of the source.
+/// @param [in] sourceHeight                The height (in texels) of the source.
+/// @param [out] destination                A pointer to the first texel of the upscaled image, which may not alias <c><i>source</i></c>.
+/// @param [in] destinationPitch            The distance in bytes between two rows of the destination.
+/// @param [in] destinationWidth            The width (in texels) of the destination.
+/// @param [in] destinationHeight           The height (in texels) of the destination.
+/// @param [in] constants                   A pointer to 16 values computed by <c><i>ffxFsrPopulateEasuConstants</i></c>, or <c><i>NULL</i></c>.
+/// @param [in] threadCount                 The number of host threads to use, 1 for the calling thread only, or 0 to use all hardware threads.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               <c><i>source</i></c> or <c><i>destination</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT              An image was empty or too wide, a pitch was smaller than a row, or <c><i>source</i></c> and <c><i>destination</i></c> were the same buffer.
+///
+/// @ingroup FSR2 CPU
+FFX_API FfxErrorCode ffxFsr2EasuCPU(
+    const void* source,
+    size_t sourcePitch,
+    uint32_t sourceWidth,
+    uint32_t sourceHeight,
+    void* destination,
+    size_t destinationPitch,
+    uint32_t destinationWidth,
+    uint32_t destinationHeight,
+    const uint32_t* constants,
+    uint32_t threadCount);
+
+#if defined(__cplusplus)
+}
+#endif // #if defined(__cplusplus)
@@ -0,0 +1,547 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_accumulate_pass.hlsl, covering the reprojection, upsampling and lock status
+// helpers it includes (ffx_fsr2_reproject.h, ffx_fsr2_upsample.h and ffx_fsr2_postprocess_lock_status.h).
+
+#include "ffx_fsr2_cpu_common.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+static const float FSR2_PI = 3.141592653589793f;
+
+float lanczos2(float x)
+{
+    x = min(fabsf(x), 2.0f);
+    return fabsf(x) < FSR2_EPSILON ? 1.0f : (sinf(FSR2_PI * x) / (FSR2_PI * x)) * (sinf(0.5f * FSR2_PI * x) / (0.5f * FSR2_PI * x));
+}
+
+float4 lanczos2(const float4& color0, const float4& color1, const float4& color2, const float4& color3, float t)
+{
+    const float weight0 = lanczos2(-1.0f - t);
+    const float weight1 = lanczos2(-0.0f - t);
+    const float weight2 = lanczos2(+1.0f - t);
+    const float weight3 = lanczos2(+2.0f - t);
+    return (color0 * weight0 + color1 * weight1 + color2 * weight2 + color3 * weight3) / (weight0 + weight1 + weight2 + weight3);
+}
+
+float lanczos2ApproxSq(float x2)
+{
+    x2 = min(x2, 4.0f);
+    const float a = (2.0f / 5.0f) * x2 - 1.0f;
+    const float b = (1.0f / 4.0f) * x2 - 1.0f;
+    return ((25.0f / 16.0f) * a * a - (25.0f / 16.0f - 1.0f)) * (b * b);
+}
+
+struct LockState {
+
+    bool newLock;
+    bool wasLockedPrevFrame;
+};
+
+struct AccumulationPassCommonParams {
+
+    int2   pxHrPos;
+    float2 hrUv;
+    float2 lrUvHwSampler;
+    float2 motionVector;
+    float2 reprojectedHrUv;
+    float  hrVelocity;
+    float  depthClipFactor;
+    float  dilatedReactiveFactor;
+    float  accumulationMask;
+    bool   isResetFrame;
+    bool   isExistingSample;
+    bool   isNewSample;
+};
+
+struct AccumulatePass : PassContext {
+
+    const Fsr2CpuSurface& inputExposure;
+    const Fsr2CpuSurface& dilatedReactiveMasks;
+    const Fsr2CpuSurface& motionVectors;
+    const Fsr2CpuSurface& internalUpscaledColor;
+    const Fsr2CpuSurface& lockStatus;
+    const Fsr2CpuSurface& preparedInputColor;
+    const Fsr2CpuSurface& imgMips;
+    const Fsr2CpuSurface& lumaHistory;
+    const Fsr2CpuSurface& rwInternalUpscaledColor;
+    const Fsr2CpuSurface& rwLockStatus;
+    const Fsr2CpuSurface& rwUpscaledOutput;
+    const Fsr2CpuSurface& rwNewLocks;
+    const Fsr2CpuSurface& rwLumaHistory;
+    float                 exposureValue;
+
+    explicit AccumulatePass(const Fsr2CpuJob* job)
+        : PassContext(job)
+        , inputExposure(job->srvs[FSR2_CPU_ACCUMULATE_SRV_INPUT_EXPOSURE])
+        , dilatedReactiveMasks(job->srvs[FSR2_CPU_ACCUMULATE_SRV_DILATED_REACTIVE_MASKS])
+        , motionVectors(job->srvs[FSR2_CPU_ACCUMULATE_SRV_MOTION_VECTORS])
+        , internalUpscaledColor(job->srvs[FSR2_CPU_ACCUMULATE_SRV_INTERNAL_UPSCALED_COLOR])
+        , lockStatus(job->srvs[FSR2_CPU_ACCUMULATE_SRV_LOCK_STATUS])
+        , preparedInputColor(job->srvs[FSR2_CPU_ACCUMULATE_SRV_PREPARED_INPUT_COLOR])
+        , imgMips(job->srvs[FSR2_CPU_ACCUMULATE_SRV_IMG_MIPS])
+        , lumaHistory(job->srvs[FSR2_CPU_ACCUMULATE_SRV_LUMA_HISTORY])
+        , rwInternalUpscaledColor(job->uavs[FSR2_CPU_ACCUMULATE_UAV_INTERNAL_UPSCALED_COLOR])
+        , rwLockStatus(job->uavs[FSR2_CPU_ACCUMULATE_UAV_LOCK_STATUS])
+        , rwUpscaledOutput(job->uavs[FSR2_CPU_ACCUMULATE_UAV_UPSCALED_OUTPUT])
+        , rwNewLocks(job->uavs[FSR2_CPU_ACCUMULATE_UAV_NEW_LOCKS])
+        , rwLumaHistory(job->uavs[FSR2_CPU_ACCUMULATE_UAV_LUMA_HISTORY])
+        , exposureValue(exposure(job->srvs[FSR2_CPU_ACCUMULATE_SRV_INPUT_EXPOSURE]))
+    {
+    }
+
+    // Lanczos2 reconstruction of the history over a 4x4 footprint, with deringing (HistorySample).
+    float4 historySample(float2 uvSample, int2 textureSize) const
+    {
+        float2 pxSample = uvSample * toFloat(textureSize) - float2(0.5f);
+        pxSample.x = max(0.0f, min(float(textureSize.x), pxSample.x));
+        pxSample.y = max(0.0f, min(float(textureSize.y), pxSample.y));
+
+        const int2 pxBase = toInt(floor(pxSample));
+        const float2 pxFrac = fract(pxSample);
+
+        float4 samples[4][4];
+        for (int32_t y = 0; y < 4; ++y) {
+            for (int32_t x = 0; x < 4; ++x) {
+                samples[y][x] = fsr2CpuLoad(internalUpscaledColor, clampLoad(pxBase, int2(x - 1, y - 1), textureSize));
+            }
+        }
+
+        float4 rows[4];
+        for (int32_t y = 0; y < 4; ++y) {
+            rows[y] = lanczos2(samples[y][0], samples[y][1], samples[y][2], samples[y][3], pxFrac.x);
+        }
+        const float4 colorXY = lanczos2(rows[0], rows[1], rows[2], rows[3], pxFrac.y);
+
+        // Deringing
+        const float4 deringingMin = min(min(samples[1][1], samples[1][2]), min(samples[2][1], samples[2][2]));
+        const float4 deringingMax = max(max(samples[1][1], samples[1][2]), max(samples[2][1], samples[2][2]));
+
+        return clamp(colorXY, deringingMin, deringingMax);
+    }
+
+    float2 getMotionVector(int2 pxHrPos, float2 hrUv) const
+    {
+        if (lowResMotionVectors()) {
+            return fsr2CpuLoad(motionVectors, toInt(hrUv * toFloat(renderSize()))).xy();
+        }
+        return loadInputMotionVector(motionVectors, pxHrPos);
+    }
+
+    AccumulationPassCommonParams initParams(int2 pxHrPos) const
+    {
+        AccumulationPassCommonParams params;
+
+        params.pxHrPos = pxHrPos;
+        params.hrUv = (toFloat(pxHrPos) + 0.5f) / toFloat(displaySize());
+
+        const float2 lrUvJittered = params.hrUv + jitter() / toFloat(renderSize());
+        params.lrUvHwSampler = clampUv(lrUvJittered, renderSize(), maxRenderSize());
+
+        params.motionVector = getMotionVector(pxHrPos, params.hrUv);
+        params.hrVelocity = length(params.motionVector * toFloat(displaySize()));
+
+        params.reprojectedHrUv = params.hrUv + params.motionVector;
+        params.isExistingSample = isUvInside(params.reprojectedHrUv);
+
+        params.depthClipFactor = saturate(fsr2CpuSampleLinearClamp(preparedInputColor, params.lrUvHwSampler).w);
+
+        const float2 dilatedReactiveMasksValue = fsr2CpuSampleLinearClamp(dilatedReactiveMasks, params.lrUvHwSampler).xy();
+        params.dilatedReactiveFactor = dilatedReactiveMasksValue.x;
+        params.accumulationMask = dilatedReactiveMasksValue.y;
+        params.isResetFrame = (0 == constants.frameIndex);
+
+        params.isNewSample = (params.isExistingSample == false || params.isResetFrame);
+
+        return params;
+    }
+
+    void reprojectHistoryColor(const AccumulationPassCommonParams& params, float3& historyColor, float& temporalReactiveFactor, bool& inMotionLastFrame) const
+    {
+        const float4 history = historySample(params.reprojectedHrUv, displaySize());
+
+        historyColor = prepareRgb(history.xyz(), exposureValue, constants.previousFramePreExposure);
+        historyColor = rgbToYCoCg(historyColor);
+
+        // Compute temporal reactivity info
+        temporalReactiveFactor = saturate(fabsf(history.w));
+        inMotionLastFrame = (history.w < 0.0f);
+    }
+
+    LockState reprojectHistoryLockStatus(const AccumulationPassCommonParams& params, float2& reprojectedLockStatus) const
+    {
+        LockState state = { false, false };
+        const float newLockIntensity = fsr2CpuLoad(rwNewLocks, params.pxHrPos).x;
+        state.newLock = newLockIntensity > (127.0f / 255.0f);
+
+        reprojectedLockStatus = fsr2CpuSampleLinearClamp(lockStatus, params.reprojectedHrUv).xy();
+
+        if (reprojectedLockStatus[LOCK_LIFETIME_REMAINING] != 0.0f) {
+            state.wasLockedPrevFrame = true;
+        }
+
+        return state;
+    }
+
+    float getShadingChangeLuma(float2 uvCoord) const
+    {
+        const float div = float(2 << constants.lumaMipLevelToUse);
+        const int2 mipRenderSize = toInt(toFloat(renderSize()) / div);
+        uvCoord = clampUv(uvCoord, mipRenderSize, lumaMipDimensions());
+        const float shadingChangeLuma = exposureValue * expf(fsr2CpuSampleLinearClamp(imgMips, uvCoord, uint32_t(constants.lumaMipLevelToUse)).x);
+        return powf(shadingChangeLuma, 1.0f / 6.0f);
+    }
+
+    void updateLockStatus(const AccumulationPassCommonParams& params, float& reactiveFactor, LockState state, float2& lockStatusValue,
+        float& lockContributionThisFrame, float& luminanceDiff) const
+    {
+        const float shadingChangeLuma = getShadingChangeLuma(params.hrUv);
+
+        // init temporal shading change factor, init to -1 or so in reproject to know if "true new"?
+        lockStatusValue[LOCK_TEMPORAL_LUMA] = (lockStatusValue[LOCK_TEMPORAL_LUMA] == 0.0f) ? shadingChangeLuma : lockStatusValue[LOCK_TEMPORAL_LUMA];
+
+        const float previousShadingChangeLuma = lockStatusValue[LOCK_TEMPORAL_LUMA];
+
+        luminanceDiff = 1.0f - minDividedByMax(previousShadingChangeLuma, shadingChangeLuma);
+
+        if (state.newLock) {
+            lockStatusValue[LOCK_TEMPORAL_LUMA] = shadingChangeLuma;
+            lockStatusValue[LOCK_LIFETIME_REMAINING] = (lockStatusValue[LOCK_LIFETIME_REMAINING] != 0.0f) ? 2.0f : 1.0f;
+        } else if (lockStatusValue[LOCK_LIFETIME_REMAINING] <= 1.0f) {
+            lockStatusValue[LOCK_TEMPORAL_LUMA] = lerp(lockStatusValue[LOCK_TEMPORAL_LUMA], shadingChangeLuma, 0.5f);
+        } else if (luminanceDiff > 0.1f) {
+            lockStatusValue[LOCK_LIFETIME_REMAINING] = 0.0f;
+        }
+
+        reactiveFactor = max(reactiveFactor, saturate((luminanceDiff - 0.1f) * 10.0f));
+        lockStatusValue[LOCK_LIFETIME_REMAINING] *= (1.0f - reactiveFactor);
+
+        lockStatusValue[LOCK_LIFETIME_REMAINING] *= saturate(1.0f - params.accumulationMask);
+        lockStatusValue[LOCK_LIFETIME_REMAINING] *= float(params.depthClipFactor < 0.1f);
+
+        // Compute this frame lock contribution
+        const float lifetimeContribution = saturate(lockStatusValue[LOCK_LIFETIME_REMAINING] - 1.0f);
+        const float shadingChangeContribution = saturate(minDividedByMax(lockStatusValue[LOCK_TEMPORAL_LUMA], shadingChangeLuma));
+
+        lockContributionThisFrame = saturate(saturate(lifetimeContribution * 4.0f) * shadingChangeContribution);
+    }
+
+    float4 computeUpsampledColorAndWeight(const AccumulationPassCommonParams& params, RectificationBox& clippingBox, float reactiveFactor) const
+    {
+        // We compute a sliced lanczos filter with 2 lobes (other slices are accumulated temporaly)
+        const float2 dstOutputPos = toFloat(params.pxHrPos) + float2(0.5f);  // Destination resolution output pixel center position
+        const float2 srcOutputPos = dstOutputPos * downscaleFactor();       // Source resolution output pixel center position
+        const int2 srcInputPos = toInt(floor(srcOutputPos));
+
+        const float2 srcUnjitteredPos = (toFloat(srcInputPos) + float2(0.5f)) - jitter(); // This is the un-jittered position of the sample at offset 0,0
+
+        int2 offsetTL;
+        offsetTL.x = (srcUnjitteredPos.x > srcOutputPos.x) ? -2 : -1;
+        offsetTL.y = (srcUnjitteredPos.y > srcOutputPos.y) ? -2 : -1;
+
+        // Load samples
+        // If fSrcUnjitteredPos.y > fSrcOutputPos.y, indicates offsetTL.y = -2, sample offset Y will be [-2, 1], clipbox will be rows [1, 3].
+        // Flip row# for sampling offset in this case, so first 0~2 rows in the sampled array can always be used for computing the clipbox.
+        // This reduces branch or cmove on sampled colors, but moving this overhead to sample position / weight calculation time which apply to less values.
+        const bool flipRow = srcUnjitteredPos.y > srcOutputPos.y;
+        const bool flipCol = srcUnjitteredPos.x > srcOutputPos.x;
+
+        const float2 baseSampleOffset = srcUnjitteredPos - srcOutputPos;
+
+        // Compute the kernel bias for this pixel
+        const float kernelReactiveFactor = max(reactiveFactor, float(params.isNewSample));
+        const float kernelBiasMax = min(1.99f, 1.0f + (1.0f / downscaleFactor().x - 1.0f)) * (1.0f - kernelReactiveFactor);
+
+        const float kernelBiasMin = max(1.0f, ((1.0f + kernelBiasMax) * 0.3f));
+        const float kernelBiasFactor = max(0.0f, max(0.25f * params.depthClipFactor, kernelReactiveFactor));
+        const float kernelBias = lerp(kernelBiasMax, kernelBiasMin, kernelBiasFactor);
+
+        const float rectificationCurveBias = lerp(-2.0f, -3.0f, saturate(params.hrVelocity / 50.0f));
+
+        float4 colorAndWeight;
+        for (int32_t row = 0; row < 3; row++) {
+            for (int32_t col = 0; col < 3; col++) {
+
+                const int2 sampleColRow = int2(flipCol ? (3 - col) : col, flipRow ? (3 - row) : row);
+                const int2 offset = offsetTL + sampleColRow;
+                const float2 srcSampleOffset = baseSampleOffset + toFloat(offset);
+                const int2 srcSamplePos = srcInputPos + offset;
+
+                const float3 sample = fsr2CpuLoad(preparedInputColor, srcSamplePos).xyz();
+
+                const float onScreenFactor = float(isOnScreen(srcSamplePos, renderSize()));
+                const float2 srcSampleOffsetBiased = srcSampleOffset * kernelBias;
+                const float sampleWeight = onScreenFactor * lanczos2ApproxSq(dot(srcSampleOffsetBiased, srcSampleOffsetBiased));
+
+                colorAndWeight += float4(sample * sampleWeight, sampleWeight);
+
+                // Update rectification box
+                const float srcSampleOffsetSq = dot(srcSampleOffset, srcSampleOffset);
+                const float boxSampleWeight = expf(rectificationCurveBias * srcSampleOffsetSq);
+
+                clippingBox.addSample((row == 0) && (col == 0), sample, boxSampleWeight);
+            }
+        }
+
+        clippingBox.computeVarianceBoxData();
+
+        colorAndWeight.w *= float(colorAndWeight.w > FSR2_EPSILON);
+
+        if (colorAndWeight.w > FSR2_EPSILON) {
+            // Normalize for deringing (we need to compare colors)
+            const float3 color = clamp(colorAndWeight.xyz() / colorAndWeight.w, clippingBox.aabbMin, clippingBox.aabbMax);
+            colorAndWeight = float4(color, colorAndWeight.w * FSR2_UPSAMPLE_LANCZOS_WEIGHT_SCALE);
+        }
+
+        return colorAndWeight;
+    }
+
+    float computeLumaInstabilityFactor(const AccumulationPassCommonParams& params, const RectificationBox& clippingBox, float thisFrameReactiveFactor, float luminanceDiff) const
+    {
+        const float unormThreshold = 1.0f / 255.0f;
+        const int32_t N_MINUS_1 = 0;
+        const int32_t N_MINUS_2 = 1;
+        const int32_t N_MINUS_3 = 2;
+        const int32_t N_MINUS_4 = 3;
+
+        float currentFrameLuma = clippingBox.boxCenter.x;
+
+        if (hdr()) {
+            currentFrameLuma = currentFrameLuma / (1.0f + max(0.0f, currentFrameLuma));
+        }
+
+        currentFrameLuma = roundf(currentFrameLuma * 255.0f) / 255.0f;
+
+        const bool sampleLumaHistory = (max(max(params.depthClipFactor, params.accumulationMask), luminanceDiff) < 0.1f) && (params.isNewSample == false);
+        float4 currentFrameLumaHistory = sampleLumaHistory ? fsr2CpuSampleLinearClamp(lumaHistory, params.reprojectedHrUv) : float4(0.0f);
+
+        float lumaInstability = 0.0f;
+        const float diffs0 = (currentFrameLuma - currentFrameLumaHistory[N_MINUS_1]);
+
+        float minDiff = fabsf(diffs0);
+
+        if (minDiff >= unormThreshold) {
+            for (int32_t i = N_MINUS_2; i <= N_MINUS_4; i++) {
+                const float diffs1 = (currentFrameLuma - currentFrameLumaHistory[i]);
+
+                if (sign(diffs0) == sign(diffs1)) {
+
+                    // Scale difference to protect historically similar values
+                    const float minBias = 1.0f;
+                    minDiff = min(minDiff, fabsf(diffs1) * minBias);
+                }
+            }
+
+            const float boxSize = clippingBox.boxVec.x;
+            const float boxSizeFactor = powf(saturate(boxSize / 0.1f), 6.0f);
+
+            lumaInstability = float(minDiff != fabsf(diffs0)) * boxSizeFactor;
+            lumaInstability = float(lumaInstability > unormThreshold);
+
+            lumaInstability *= 1.0f - max(params.accumulationMask, powf(thisFrameReactiveFactor, 1.0f / 6.0f));
+        }
+
+        // Shift history
+        currentFrameLumaHistory[N_MINUS_4] = currentFrameLumaHistory[N_MINUS_3];
+        currentFrameLumaHistory[N_MINUS_3] = currentFrameLumaHistory[N_MINUS_2];
+        currentFrameLumaHistory[N_MINUS_2] = currentFrameLumaHistory[N_MINUS_1];
+        currentFrameLumaHistory[N_MINUS_1] = currentFrameLuma;
+
+        fsr2CpuStore(rwLumaHistory, params.pxHrPos, currentFrameLumaHistory);
+
+        return lumaInstability * float(currentFrameLumaHistory[N_MINUS_4] != 0.0f);
+    }
+
+    float computeBaseAccumulationWeight(const AccumulationPassCommonParams& params, float thisFrameReactiveFactor, bool inMotionLastFrame, float upsampledWeight) const
+    {
+        // Always assume max accumulation was reached
+        float baseAccumulation = 1.0f * float(params.isExistingSample) * (1.0f - thisFrameReactiveFactor) * (1.0f - params.depthClipFactor);
+
+        baseAccumulation = min(baseAccumulation, lerp(baseAccumulation, upsampledWeight * 10.0f, max(float(inMotionLastFrame), saturate(params.hrVelocity * 10.0f))));
+
+        baseAccumulation = min(baseAccumulation, lerp(baseAccumulation, upsampledWeight, saturate(params.hrVelocity / 20.0f)));
+
+        return baseAccumulation;
+    }
+
+    void rectifyHistory(const AccumulationPassCommonParams& params, const RectificationBox& clippingBox, float3& historyColor, float& accumulation,
+        float lockContributionThisFrame, float lumaInstabilityFactor) const
+    {
+        const float scaleFactorInfluence = min(20.0f, powf(1.0f / fabsf(downscaleFactor().x * downscaleFactor().y), 3.0f));
+
+        const float velocityFactor = saturate(params.hrVelocity / 20.0f);
+        const float boxScaleT = max(params.depthClipFactor, max(params.accumulationMask, velocityFactor));
+        const float boxScale = lerp(scaleFactorInfluence, 1.0f, boxScaleT);
+
+        const float3 scaledBoxVec = clippingBox.boxVec * boxScale;
+        const float3 boxMin = max(clippingBox.aabbMin, clippingBox.boxCenter - scaledBoxVec);
+        const float3 boxMax = min(clippingBox.aabbMax, clippingBox.boxCenter + scaledBoxVec);
+
+        const bool outside =
+            boxMin.x > historyColor.x || boxMin.y > historyColor.y || boxMin.z > historyColor.z ||
+            historyColor.x > boxMax.x || historyColor.y > boxMax.y || historyColor.z > boxMax.z;
+
+        if (outside) {
+
+            const float3 clampedHistoryColor = clamp(historyColor, boxMin, boxMax);
+
+            const float reactiveContribution = 1.0f - powf(params.dilatedReactiveFactor, 1.0f / 2.0f);
+            const float historyContribution = max(lumaInstabilityFactor, lockContributionThisFrame) * reactiveContribution;
+
+            // Scale history color using rectification info, also using accumulation mask to avoid potential invalid color protection
+            historyColor = lerp(clampedHistoryColor, historyColor, saturate(historyContribution));
+
+            // Scale accumulation using rectification info
+            const float accumulationMin = min(accumulation, 0.1f);
+            accumulation = lerp(accumulationMin, accumulation, saturate(historyContribution));
+        }
+    }
+
+    void accumulate(float3& historyColor, float accumulation, float4 upsampledColorAndWeight) const
+    {
+        // Avoid invalid values when accumulation and upsampled weight is 0
+        accumulation = max(FSR2_EPSILON, accumulation + upsampledColorAndWeight.w);
+
+        float3 upsampledColor = upsampledColorAndWeight.xyz();
+        if (hdr()) {
+            // YCoCg -> RGB -> Tonemap -> YCoCg (Use RGB tonemapper to avoid color desaturation)
+            upsampledColor = rgbToYCoCg(tonemap(yCoCgToRgb(upsampledColor)));
+            historyColor = rgbToYCoCg(tonemap(yCoCgToRgb(historyColor)));
+        }
+
+        const float alpha = upsampledColorAndWeight.w / accumulation;
+        historyColor = lerp(historyColor, upsampledColor, alpha);
+
+        historyColor = yCoCgToRgb(historyColor);
+
+        if (hdr()) {
+            historyColor = inverseTonemap(historyColor);
+        }
+    }
+
+    void finalizeLockStatus(const AccumulationPassCommonParams& params, float2 lockStatusValue, float upsampledWeight) const
+    {
+        // we expect similar motion for next frame
+        // kill lock if that location is outside screen, avoid locks to be clamped to screen borders
+        const float2 estimatedUvNextFrame = params.hrUv - params.motionVector;
+        if (isUvInside(estimatedUvNextFrame) == false) {
+            lockStatusValue[LOCK_LIFETIME_REMAINING] = 0.0f;
+        } else {
+            // Decrease lock lifetime
+            const float lifetimeDecreaseLanczosMax = constants.jitterPhaseCount * FSR2_AVERAGE_LANCZOS_WEIGHT_PER_FRAME;
+            const float lifetimeDecrease = upsampledWeight / lifetimeDecreaseLanczosMax;
+            lockStatusValue[LOCK_LIFETIME_REMAINING] = max(0.0f, lockStatusValue[LOCK_LIFETIME_REMAINING] - lifetimeDecrease);
+        }
+
+        fsr2CpuStore(rwLockStatus, params.pxHrPos, float4(lockStatusValue.x, lockStatusValue.y, 0.0f, 0.0f));
+    }
+
+    float computeTemporalReactiveFactor(const AccumulationPassCommonParams& params, float temporalReactiveFactor) const
+    {
+        float newFactor = min(0.99f, temporalReactiveFactor);
+
+        newFactor = max(newFactor, lerp(newFactor, 0.4f, saturate(params.hrVelocity)));
+
+        newFactor = max(newFactor * newFactor, max(params.depthClipFactor * 0.1f, params.dilatedReactiveFactor));
+
+        // Force reactive factor for new samples
+        newFactor = params.isNewSample ? 1.0f : newFactor;
+
+        if (saturate(params.hrVelocity * 10.0f) >= 1.0f) {
+            newFactor = max(FSR2_EPSILON, newFactor) * -1.0f;
+        }
+
+        return newFactor;
+    }
+
+    void accumulate(int2 pxHrPos) const
+    {
+        const AccumulationPassCommonParams params = initParams(pxHrPos);
+
+        float3 historyColor;
+        float2 lockStatusValue;
+        float temporalReactiveFactor = 0.0f;
+        bool inMotionLastFrame = false;
+        LockState lockState = { false, false };
+        if (params.isExistingSample && !params.isResetFrame) {
+            reprojectHistoryColor(params, historyColor, temporalReactiveFactor, inMotionLastFrame);
+            lockState = reprojectHistoryLockStatus(params, lockStatusValue);
+        }
+
+        float thisFrameReactiveFactor = max(params.dilatedReactiveFactor, temporalReactiveFactor);
+
+        float luminanceDiff = 0.0f;
+        float lockContributionThisFrame = 0.0f;
+        updateLockStatus(params, thisFrameReactiveFactor, lockState, lockStatusValue, lockContributionThisFrame, luminanceDiff);
+
+        // Load upsampled input color
+        RectificationBox clippingBox;
+        clippingBox.reset();
+        const float4 upsampledColorAndWeight = computeUpsampledColorAndWeight(params, clippingBox, thisFrameReactiveFactor);
+
+        const float lumaInstabilityFactor = computeLumaInstabilityFactor(params, clippingBox, thisFrameReactiveFactor, luminanceDiff);
+
+        float accumulation = computeBaseAccumulationWeight(params, thisFrameReactiveFactor, inMotionLastFrame, upsampledColorAndWeight.w);
+
+        if (params.isNewSample) {
+            historyColor = yCoCgToRgb(upsampledColorAndWeight.xyz());
+        } else {
+            rectifyHistory(params, clippingBox, historyColor, accumulation, lockContributionThisFrame, lumaInstabilityFactor);
+
+            accumulate(historyColor, accumulation, upsampledColorAndWeight);
+        }
+
+        historyColor = unprepareRgb(historyColor, exposureValue, constants.preExposure);
+
+        finalizeLockStatus(params, lockStatusValue, upsampledColorAndWeight.w);
+
+        // Get new temporal reactive factor
+        temporalReactiveFactor = computeTemporalReactiveFactor(params, thisFrameReactiveFactor);
+
+        fsr2CpuStore(rwInternalUpscaledColor, pxHrPos, float4(historyColor, temporalReactiveFactor));
+
+        // Output final color when RCAS is disabled
+        if (!sharpening()) {
+            fsr2CpuStore(rwUpscaledOutput, pxHrPos, float4(historyColor, 1.0f));
+        }
+
+        fsr2CpuStore(rwNewLocks, pxHrPos, float4(0.0f));
+    }
+};
+
+} // namespace
+
+void fsr2CpuAccumulateKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    const AccumulatePass pass(job);
+
+    for (int32_t threadY = 0; threadY < 8; ++threadY) {
+        for (int32_t threadX = 0; threadX < 8; ++threadX) {
+
+            pass.accumulate(int2(int32_t(groupX * 8) + threadX, int32_t(groupY * 8) + threadY));
+        }
+    }
+}
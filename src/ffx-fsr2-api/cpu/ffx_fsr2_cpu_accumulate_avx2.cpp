@@ -0,0 +1,45 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// AVX2 build of the vectorized Accumulate pass, see ffx_fsr2_cpu_accumulate_simd.h.
+
+#include "ffx_fsr2_cpu_simd.h"
+
+#if FSR2_CPU_SIMD_X86
+
+#include <immintrin.h>
+#include "ffx_fsr2_cpu_common.h"
+
+FSR2_CPU_TARGET_BEGIN_AVX2
+
+#define FSR2_CPU_SIMD_NAMESPACE avx2
+#include "ffx_fsr2_cpu_simd_avx2.h"
+#include "ffx_fsr2_cpu_simd_common.h"
+#include "ffx_fsr2_cpu_accumulate_simd.h"
+
+void fsr2CpuAccumulateKernelAVX2(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    fsr2cpu::avx2::accumulateKernel(job, groupX, groupY, groupShared);
+}
+
+FSR2_CPU_TARGET_END
+
+#endif // #if FSR2_CPU_SIMD_X86
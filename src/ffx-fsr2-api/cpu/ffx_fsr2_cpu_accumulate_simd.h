@@ -0,0 +1,666 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Vectorized port of ffx_fsr2_accumulate_pass.hlsl, see ffx_fsr2_cpu_accumulate.cpp for the scalar
+// reference. Each packet covers SIMD_WIDTH display pixels of a 8x8 thread group, row by row, and
+// every branch of the shader becomes a per-lane select.
+
+#pragma once
+
+#include "ffx_fsr2_cpu_simd_common.h"
+
+// Kernel of the upsample, see FFX_FSR2_OPTION_UPSAMPLE_USE_LANCZOS_TYPE in ffx_fsr2_upsample.h.
+#ifndef FSR2_CPU_UPSAMPLE_LANCZOS_TYPE
+#define FSR2_CPU_UPSAMPLE_LANCZOS_TYPE 2 // Approximate
+#endif // #ifndef FSR2_CPU_UPSAMPLE_LANCZOS_TYPE
+
+namespace fsr2cpu {
+namespace FSR2_CPU_SIMD_NAMESPACE {
+
+static const float FSR2_PI = 3.141592653589793f;
+
+inline vfloat lanczos2(vfloat x)
+{
+    x = min(abs(x), vfloat(2.0f));
+    const vfloat value = (sinPi(x) / (FSR2_PI * x)) * (sinPi(0.5f * x) / (0.5f * FSR2_PI * x));
+    return select(x < FSR2_EPSILON, vfloat(1.0f), value);
+}
+
+inline vfloat lanczos2ApproxSq(vfloat x2)
+{
+    x2 = min(x2, vfloat(4.0f));
+    const vfloat a = (2.0f / 5.0f) * x2 - 1.0f;
+    const vfloat b = (1.0f / 4.0f) * x2 - 1.0f;
+    return ((25.0f / 16.0f) * a * a - (25.0f / 16.0f - 1.0f)) * (b * b);
+}
+
+// ClampLoad for a constant offset.
+inline vint clampLoad(vint pos, int32_t offset, int32_t textureSize)
+{
+    const vint result = pos + vint(offset);
+    if (offset < 0) {
+        return max(result, vint(0));
+    }
+    if (offset > 0) {
+        return min(result, vint(textureSize - 1));
+    }
+    return result;
+}
+
+// The prepared input color read by the upsample of one thread group, staged in groupshared memory as
+// planar r, g and b so the taps gather from L1 without bounds checks. planes is null when the
+// footprint does not fit, the taps then load from the surface.
+struct UpsampleTile {
+
+    const float* planes;
+    int2         origin;
+    int32_t      stride;        // texels, a multiple of SIMD_WIDTH
+    int32_t      planeSize;     // texels
+};
+
+struct AccumulationPassCommonParams {
+
+    vint2   pxHrPos;
+    vfloat2 hrUv;
+    vfloat2 lrUvHwSampler;
+    vfloat2 motionVector;
+    vfloat2 reprojectedHrUv;
+    vfloat  hrVelocity;
+    vfloat  depthClipFactor;
+    vfloat  dilatedReactiveFactor;
+    vfloat  accumulationMask;
+    vmask   active;
+    vmask   isExistingSample;
+    vmask   isNewSample;
+    bool    isResetFrame;
+};
+
+struct AccumulatePass : PassContext {
+
+    SimdSurface motionVectors;
+    SimdSurface dilatedReactiveMasks;
+    SimdSurface internalUpscaledColor;
+    SimdSurface lockStatus;
+    SimdSurface preparedInputColor;
+    SimdSurface imgMipShadingChange;
+    SimdSurface lumaHistory;
+    SimdSurface lanczosLut;
+    SimdSurface rwInternalUpscaledColor;
+    SimdSurface rwLockStatus;
+    SimdSurface rwUpscaledOutput;
+    SimdSurface rwNewLocks;
+    SimdSurface rwLumaHistory;
+    float       exposureValue;
+
+    explicit AccumulatePass(const Fsr2CpuJob* job)
+        : PassContext(job)
+        , motionVectors(job->srvs[FSR2_CPU_ACCUMULATE_SRV_MOTION_VECTORS])
+        , dilatedReactiveMasks(job->srvs[FSR2_CPU_ACCUMULATE_SRV_DILATED_REACTIVE_MASKS])
+        , internalUpscaledColor(job->srvs[FSR2_CPU_ACCUMULATE_SRV_INTERNAL_UPSCALED_COLOR])
+        , lockStatus(job->srvs[FSR2_CPU_ACCUMULATE_SRV_LOCK_STATUS])
+        , preparedInputColor(job->srvs[FSR2_CPU_ACCUMULATE_SRV_PREPARED_INPUT_COLOR])
+        , imgMipShadingChange(job->srvs[FSR2_CPU_ACCUMULATE_SRV_IMG_MIPS], uint32_t(reinterpret_cast<const Fsr2Constants*>(job->cbs[0])->lumaMipLevelToUse))
+        , lumaHistory(job->srvs[FSR2_CPU_ACCUMULATE_SRV_LUMA_HISTORY])
+        , lanczosLut(job->srvs[FSR2_CPU_ACCUMULATE_SRV_LANCZOS_LUT])
+        , rwInternalUpscaledColor(job->uavs[FSR2_CPU_ACCUMULATE_UAV_INTERNAL_UPSCALED_COLOR])
+        , rwLockStatus(job->uavs[FSR2_CPU_ACCUMULATE_UAV_LOCK_STATUS])
+        , rwUpscaledOutput(job->uavs[FSR2_CPU_ACCUMULATE_UAV_UPSCALED_OUTPUT])
+        , rwNewLocks(job->uavs[FSR2_CPU_ACCUMULATE_UAV_NEW_LOCKS])
+        , rwLumaHistory(job->uavs[FSR2_CPU_ACCUMULATE_UAV_LUMA_HISTORY])
+        , exposureValue(exposure(job->srvs[FSR2_CPU_ACCUMULATE_SRV_INPUT_EXPOSURE]))
+    {
+    }
+
+    // Lanczos2 reconstruction of the history over a 4x4 footprint, with deringing (HistorySample).
+    vfloat4 historySample(const vfloat2& uvSample, int2 textureSize, vmask active) const
+    {
+        vfloat2 pxSample = uvSample * vfloat2(fsr2cpu::toFloat(textureSize)) - vfloat2(0.5f);
+        pxSample.x = max(vfloat(0.0f), min(vfloat(float(textureSize.x)), pxSample.x));
+        pxSample.y = max(vfloat(0.0f), min(vfloat(float(textureSize.y)), pxSample.y));
+
+        const vfloat2 pxFloor = vfloat2(floor(pxSample.x), floor(pxSample.y));
+        const vint2 pxBase = vint2(truncToInt(pxFloor.x), truncToInt(pxFloor.y));
+        const vfloat2 pxFrac = pxSample - pxFloor;
+
+        // the weights are shared by every row and column
+        vfloat weightX[4], weightY[4];
+        for (int32_t i = 0; i < 4; ++i) {
+            weightX[i] = lanczos2(float(i - 1) - pxFrac.x);
+            weightY[i] = lanczos2(float(i - 1) - pxFrac.y);
+        }
+        const vfloat weightSumX = weightX[0] + weightX[1] + weightX[2] + weightX[3];
+        const vfloat weightSumY = weightY[0] + weightY[1] + weightY[2] + weightY[3];
+
+        vfloat4 colorXY(0.0f);
+        vfloat4 deringingMin(FSR2_FLT_MAX);
+        vfloat4 deringingMax(-FSR2_FLT_MAX);
+        for (int32_t y = 0; y < 4; ++y) {
+
+            const vint sampleY = clampLoad(pxBase.y, y - 1, textureSize.y);
+
+            vfloat4 row(0.0f);
+            for (int32_t x = 0; x < 4; ++x) {
+
+                const vfloat4 sample = load(internalUpscaledColor, vint2(clampLoad(pxBase.x, x - 1, textureSize.x), sampleY), active);
+                row = row + sample * weightX[x];
+
+                // Deringing
+                if ((x == 1 || x == 2) && (y == 1 || y == 2)) {
+                    deringingMin = min(deringingMin, sample);
+                    deringingMax = max(deringingMax, sample);
+                }
+            }
+
+            colorXY = colorXY + row * (weightY[y] / weightSumX);
+        }
+        colorXY = colorXY * (1.0f / weightSumY);
+
+        return clamp(colorXY, deringingMin, deringingMax);
+    }
+
+    vfloat2 getMotionVector(const AccumulationPassCommonParams& params) const
+    {
+        if (lowResMotionVectors()) {
+            const vfloat2 pos = params.hrUv * vfloat2(fsr2cpu::toFloat(renderSize()));
+            return load(motionVectors, vint2(truncToInt(pos.x), truncToInt(pos.y)), params.active).xy();
+        }
+
+        // LoadInputMotionVector
+        vfloat2 mv = load(motionVectors, params.pxHrPos, params.active).xy() * vfloat2(float2(constants.motionVectorScale[0], constants.motionVectorScale[1]));
+        if (jitteredMotionVectors()) {
+            mv = mv - vfloat2(float2(constants.motionVectorJitterCancellation[0], constants.motionVectorJitterCancellation[1]));
+        }
+        return mv;
+    }
+
+    AccumulationPassCommonParams initParams(const vint2& pxHrPos, vmask active) const
+    {
+        AccumulationPassCommonParams params;
+
+        params.pxHrPos = pxHrPos;
+        params.active = active;
+        params.hrUv = (toFloat(pxHrPos) + vfloat2(0.5f)) / vfloat2(fsr2cpu::toFloat(displaySize()));
+
+        const vfloat2 lrUvJittered = params.hrUv + vfloat2(jitter() / fsr2cpu::toFloat(renderSize()));
+        params.lrUvHwSampler = clampUv(lrUvJittered, renderSize(), maxRenderSize());
+
+        params.motionVector = getMotionVector(params);
+        params.hrVelocity = length(params.motionVector * vfloat2(fsr2cpu::toFloat(displaySize())));
+
+        params.reprojectedHrUv = params.hrUv + params.motionVector;
+        params.isExistingSample = isUvInside(params.reprojectedHrUv);
+
+        params.depthClipFactor = saturate(sampleLinearClamp(preparedInputColor, params.lrUvHwSampler, active).w);
+
+        const vfloat2 dilatedReactiveMasksValue = sampleLinearClamp(dilatedReactiveMasks, params.lrUvHwSampler, active).xy();
+        params.dilatedReactiveFactor = dilatedReactiveMasksValue.x;
+        params.accumulationMask = dilatedReactiveMasksValue.y;
+        params.isResetFrame = (0 == constants.frameIndex);
+
+        params.isNewSample = params.isResetFrame ? maskAll(true) : !params.isExistingSample;
+
+        return params;
+    }
+
+    void reprojectHistoryColor(const AccumulationPassCommonParams& params, vmask reproject, vfloat3& historyColor, vfloat& temporalReactiveFactor, vmask& inMotionLastFrame) const
+    {
+        const vfloat4 history = historySample(params.reprojectedHrUv, displaySize(), reproject);
+
+        historyColor = prepareRgb(history.xyz(), exposureValue, constants.previousFramePreExposure);
+        historyColor = rgbToYCoCg(historyColor);
+
+        // Compute temporal reactivity info
+        temporalReactiveFactor = saturate(abs(history.w));
+        inMotionLastFrame = reproject & (history.w < 0.0f);
+    }
+
+    vmask reprojectHistoryLockStatus(const AccumulationPassCommonParams& params, vmask reproject, vfloat2& reprojectedLockStatus) const
+    {
+        const vfloat newLockIntensity = load(rwNewLocks, params.pxHrPos, reproject).x;
+        reprojectedLockStatus = sampleLinearClamp(lockStatus, params.reprojectedHrUv, reproject).xy();
+
+        return reproject & (newLockIntensity > (127.0f / 255.0f));
+    }
+
+    vfloat getShadingChangeLuma(const AccumulationPassCommonParams& params) const
+    {
+        const float div = float(2 << constants.lumaMipLevelToUse);
+        const int2 mipRenderSize = toInt(fsr2cpu::toFloat(renderSize()) / div);
+        const vfloat2 uvCoord = clampUv(params.hrUv, mipRenderSize, lumaMipDimensions());
+        const vfloat shadingChangeLuma = exposureValue * exp(sampleLinearClamp(imgMipShadingChange, uvCoord, params.active).x);
+        return pow(shadingChangeLuma, 1.0f / 6.0f);
+    }
+
+    void updateLockStatus(const AccumulationPassCommonParams& params, vfloat& reactiveFactor, vmask newLock, vfloat2& lockStatusValue,
+        vfloat& lockContributionThisFrame, vfloat& luminanceDiff) const
+    {
+        vfloat& lifetimeRemaining = lockStatusValue.x;
+        vfloat& temporalLuma = lockStatusValue.y;
+        FFX_STATIC_ASSERT(LOCK_LIFETIME_REMAINING == 0 && LOCK_TEMPORAL_LUMA == 1);
+
+        const vfloat shadingChangeLuma = getShadingChangeLuma(params);
+
+        // init temporal shading change factor, init to -1 or so in reproject to know if "true new"?
+        temporalLuma = select(temporalLuma == 0.0f, shadingChangeLuma, temporalLuma);
+
+        const vfloat previousShadingChangeLuma = temporalLuma;
+
+        luminanceDiff = 1.0f - minDividedByMax(previousShadingChangeLuma, shadingChangeLuma);
+
+        const vmask notNewLock = !newLock;
+        const vmask shortLived = notNewLock & (lifetimeRemaining <= 1.0f);
+        const vmask shadingChanged = notNewLock & (lifetimeRemaining > 1.0f) & (luminanceDiff > 0.1f);
+
+        temporalLuma = select(newLock, shadingChangeLuma, temporalLuma);
+        temporalLuma = select(shortLived, lerp(temporalLuma, shadingChangeLuma, vfloat(0.5f)), temporalLuma);
+        lifetimeRemaining = select(newLock, select(lifetimeRemaining != 0.0f, vfloat(2.0f), vfloat(1.0f)), lifetimeRemaining);
+        lifetimeRemaining = select(shadingChanged, vfloat(0.0f), lifetimeRemaining);
+
+        reactiveFactor = max(reactiveFactor, saturate((luminanceDiff - 0.1f) * 10.0f));
+        lifetimeRemaining *= (1.0f - reactiveFactor);
+
+        lifetimeRemaining *= saturate(1.0f - params.accumulationMask);
+        lifetimeRemaining *= maskToFloat(params.depthClipFactor < 0.1f);
+
+        // Compute this frame lock contribution
+        const vfloat lifetimeContribution = saturate(lifetimeRemaining - 1.0f);
+        const vfloat shadingChangeContribution = saturate(minDividedByMax(temporalLuma, shadingChangeLuma));
+
+        lockContributionThisFrame = saturate(saturate(lifetimeContribution * 4.0f) * shadingChangeContribution);
+    }
+
+    // Copy the prepared input color under the upsample footprint of a 8x8 thread group to groupShared.
+    UpsampleTile loadUpsampleTile(uint32_t groupX, uint32_t groupY, void* groupShared) const
+    {
+        UpsampleTile tile = {};
+
+        // srcInputPos of the first and last pixel, widened by the [-2, 1] tap offsets plus a texel for rounding
+        const float2 firstOutputPos = (fsr2cpu::toFloat(int2(int32_t(groupX * 8), int32_t(groupY * 8))) + float2(0.5f)) * downscaleFactor();
+        const float2 lastOutputPos = (fsr2cpu::toFloat(int2(int32_t(groupX * 8 + 7), int32_t(groupY * 8 + 7))) + float2(0.5f)) * downscaleFactor();
+        const int2 origin = toInt(fsr2cpu::floor(firstOutputPos)) - int2(3, 3);
+        const int2 end = toInt(fsr2cpu::floor(lastOutputPos)) + int2(2, 2);
+
+        const int32_t width = end.x - origin.x + 1;
+        const int32_t height = end.y - origin.y + 1;
+        const int32_t stride = (width + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+        if (size_t(stride) * size_t(height) * 3 * sizeof(float) > FSR2_CPU_GROUPSHARED_SIZE) {
+            return tile;
+        }
+
+        float* planes = static_cast<float*>(groupShared);
+        const int32_t planeSize = stride * height;
+        for (int32_t y = 0; y < height; ++y) {
+            for (int32_t x = 0; x < stride; x += SIMD_WIDTH) {
+
+                const vint2 pos = vint2(laneIndex() + vint(origin.x + x), vint(origin.y + y));
+                const vfloat3 color = load(preparedInputColor, pos, maskAll(true)).xyz();
+
+                float* texel = planes + y * stride + x;
+                storeLanes(texel, color.x);
+                storeLanes(texel + planeSize, color.y);
+                storeLanes(texel + 2 * planeSize, color.z);
+            }
+        }
+
+        tile.planes = planes;
+        tile.origin = origin;
+        tile.stride = stride;
+        tile.planeSize = planeSize;
+        return tile;
+    }
+
+    // GetUpsampleLanczosWeight, taking the squared biased sample offset.
+    vfloat getUpsampleLanczosWeight(vfloat offsetSq, vmask active) const
+    {
+#if FSR2_CPU_UPSAMPLE_LANCZOS_TYPE == 0 // LANCZOS_TYPE_REFERENCE
+        FFX_UNUSED(active);
+        return lanczos2(sqrt(offsetSq));
+#elif FSR2_CPU_UPSAMPLE_LANCZOS_TYPE == 1 // LANCZOS_TYPE_LUT
+        return sampleLinearClamp(lanczosLut, vfloat2(sqrt(offsetSq) * 0.5f, vfloat(0.5f)), active).x;
+#else // LANCZOS_TYPE_APPROXIMATE
+        FFX_UNUSED(active);
+        return lanczos2ApproxSq(offsetSq);
+#endif // #if FSR2_CPU_UPSAMPLE_LANCZOS_TYPE == 0
+    }
+
+    vfloat4 computeUpsampledColorAndWeight(const AccumulationPassCommonParams& params, const UpsampleTile& tile, RectificationBox& clippingBox, vfloat reactiveFactor) const
+    {
+        // We compute a sliced lanczos filter with 2 lobes (other slices are accumulated temporaly)
+        const vfloat2 dstOutputPos = toFloat(params.pxHrPos) + vfloat2(0.5f);                // Destination resolution output pixel center position
+        const vfloat2 srcOutputPos = dstOutputPos * vfloat2(downscaleFactor());             // Source resolution output pixel center position
+        const vint2 srcInputPos = floorToInt(srcOutputPos);
+
+        const vfloat2 srcUnjitteredPos = (toFloat(srcInputPos) + vfloat2(0.5f)) - vfloat2(jitter()); // This is the un-jittered position of the sample at offset 0,0
+        const vfloat2 baseSampleOffset = srcUnjitteredPos - srcOutputPos;
+
+        // The shader flips rows and columns of the 4x4 footprint so that the first three always hold the
+        // clip box samples, i.e. tap i of an axis sits at offset i - 1, or 1 - i when flipped.
+        const vmask flipRow = srcUnjitteredPos.y > srcOutputPos.y;
+        const vmask flipCol = srcUnjitteredPos.x > srcOutputPos.x;
+
+        // Compute the kernel bias for this pixel
+        const vfloat kernelReactiveFactor = max(reactiveFactor, maskToFloat(params.isNewSample));
+        const vfloat kernelBiasMax = fsr2cpu::min(1.99f, 1.0f + (1.0f / downscaleFactor().x - 1.0f)) * (1.0f - kernelReactiveFactor);
+
+        const vfloat kernelBiasMin = max(vfloat(1.0f), ((1.0f + kernelBiasMax) * 0.3f));
+        const vfloat kernelBiasFactor = max(vfloat(0.0f), max(0.25f * params.depthClipFactor, kernelReactiveFactor));
+        const vfloat kernelBias = lerp(kernelBiasMax, kernelBiasMin, kernelBiasFactor);
+
+        const vfloat rectificationCurveBias = lerp(vfloat(-2.0f), vfloat(-3.0f), saturate(params.hrVelocity / 50.0f));
+
+        // Everything but the lanczos weight is separable, evaluate it once per row and column.
+        // The box weight exp(bias * (x^2 + y^2)) becomes exp(bias * x^2) * exp(bias * y^2).
+        vint   tapX[3], tapY[3];
+        vint   tileOffsetX[3], tileOffsetY[3];
+        vmask  onScreenX[3], onScreenY[3];
+        vfloat biasedSqX[3], biasedSqY[3];
+        vfloat boxWeightX[3], boxWeightY[3];
+        for (int32_t i = 0; i < 3; i++) {
+
+            const vint offsetX = select(flipCol, vint(1 - i), vint(i - 1));
+            const vint offsetY = select(flipRow, vint(1 - i), vint(i - 1));
+            tapX[i] = srcInputPos.x + offsetX;
+            tapY[i] = srcInputPos.y + offsetY;
+
+            tileOffsetX[i] = (tapX[i] - vint(tile.origin.x)) << 2;
+            tileOffsetY[i] = ((tapY[i] - vint(tile.origin.y)) * vint(tile.stride)) << 2;
+
+            onScreenX[i] = (tapX[i] >= vint(0)) & (tapX[i] < vint(renderSize().x));
+            onScreenY[i] = (tapY[i] >= vint(0)) & (tapY[i] < vint(renderSize().y));
+
+            const vfloat srcSampleOffsetX = baseSampleOffset.x + toFloat(offsetX);
+            const vfloat srcSampleOffsetY = baseSampleOffset.y + toFloat(offsetY);
+            const vfloat biasedX = srcSampleOffsetX * kernelBias;
+            const vfloat biasedY = srcSampleOffsetY * kernelBias;
+            biasedSqX[i] = biasedX * biasedX;
+            biasedSqY[i] = biasedY * biasedY;
+
+            boxWeightX[i] = exp(rectificationCurveBias * (srcSampleOffsetX * srcSampleOffsetX));
+            boxWeightY[i] = exp(rectificationCurveBias * (srcSampleOffsetY * srcSampleOffsetY));
+        }
+
+        vfloat4 colorAndWeight(0.0f);
+        for (int32_t row = 0; row < 3; row++) {
+            for (int32_t col = 0; col < 3; col++) {
+
+                vfloat3 sample;
+                if (tile.planes) {
+                    const vint offset = tileOffsetY[row] + tileOffsetX[col];
+                    sample.x = gather(tile.planes, offset, params.active);
+                    sample.y = gather(tile.planes + tile.planeSize, offset, params.active);
+                    sample.z = gather(tile.planes + 2 * tile.planeSize, offset, params.active);
+                } else {
+                    sample = load(preparedInputColor, vint2(tapX[col], tapY[row]), params.active).xyz();
+                }
+
+                const vfloat onScreenFactor = maskToFloat(onScreenX[col] & onScreenY[row]);
+                const vfloat sampleWeight = onScreenFactor * getUpsampleLanczosWeight(biasedSqX[col] + biasedSqY[row], params.active);
+
+                colorAndWeight = colorAndWeight + vfloat4(sample * vfloat3(sampleWeight), sampleWeight);
+
+                // Update rectification box
+                clippingBox.addSample((row == 0) && (col == 0), sample, boxWeightX[col] * boxWeightY[row]);
+            }
+        }
+
+        clippingBox.computeVarianceBoxData();
+
+        colorAndWeight.w *= maskToFloat(colorAndWeight.w > FSR2_EPSILON);
+
+        // Normalize for deringing (we need to compare colors)
+        const vmask hasWeight = colorAndWeight.w > FSR2_EPSILON;
+        const vfloat3 color = clamp(colorAndWeight.xyz() / vfloat3(colorAndWeight.w), clippingBox.aabbMin, clippingBox.aabbMax);
+
+        return select(hasWeight, vfloat4(color, colorAndWeight.w * FSR2_UPSAMPLE_LANCZOS_WEIGHT_SCALE), colorAndWeight);
+    }
+
+    vfloat computeLumaInstabilityFactor(const AccumulationPassCommonParams& params, const RectificationBox& clippingBox, vfloat thisFrameReactiveFactor, vfloat luminanceDiff) const
+    {
+        const float unormThreshold = 1.0f / 255.0f;
+
+        vfloat currentFrameLuma = clippingBox.boxCenter.x;
+
+        if (hdr()) {
+            currentFrameLuma = currentFrameLuma / (1.0f + max(vfloat(0.0f), currentFrameLuma));
+        }
+
+        currentFrameLuma = round(currentFrameLuma * 255.0f) / 255.0f;
+
+        const vmask sampleLumaHistory = (max(max(params.depthClipFactor, params.accumulationMask), luminanceDiff) < 0.1f) & !params.isNewSample;
+        const vfloat4 history = sampleLinearClamp(lumaHistory, params.reprojectedHrUv, params.active & sampleLumaHistory);
+
+        // N_MINUS_1 to N_MINUS_4
+        const vfloat currentFrameLumaHistory[4] = { history.x, history.y, history.z, history.w };
+
+        const vfloat diffs0 = (currentFrameLuma - currentFrameLumaHistory[0]);
+
+        vfloat minDiff = abs(diffs0);
+        const vmask unstable = minDiff >= unormThreshold;
+
+        vfloat lumaInstability = 0.0f;
+        if (any(unstable & params.active)) {
+
+            for (int32_t i = 1; i <= 3; i++) {
+                const vfloat diffs1 = (currentFrameLuma - currentFrameLumaHistory[i]);
+
+                // Scale difference to protect historically similar values
+                minDiff = select(sign(diffs0) == sign(diffs1), min(minDiff, abs(diffs1)), minDiff);
+            }
+
+            const vfloat boxSize = clippingBox.boxVec.x;
+            const vfloat boxSizeRatio = saturate(boxSize / 0.1f);
+            const vfloat boxSizeRatioSq = boxSizeRatio * boxSizeRatio;
+            const vfloat boxSizeFactor = boxSizeRatioSq * boxSizeRatioSq * boxSizeRatioSq;
+
+            vfloat instability = maskToFloat(minDiff != abs(diffs0)) * boxSizeFactor;
+            instability = maskToFloat(instability > unormThreshold);
+
+            instability *= 1.0f - max(params.accumulationMask, pow(thisFrameReactiveFactor, 1.0f / 6.0f));
+
+            lumaInstability = select(unstable, instability, vfloat(0.0f));
+        }
+
+        // Shift history
+        store(rwLumaHistory, params.pxHrPos, params.active, vfloat4(currentFrameLuma, history.x, history.y, history.z));
+
+        return lumaInstability * maskToFloat(history.z != 0.0f);
+    }
+
+    vfloat computeBaseAccumulationWeight(const AccumulationPassCommonParams& params, vfloat thisFrameReactiveFactor, vmask inMotionLastFrame, vfloat upsampledWeight) const
+    {
+        // Always assume max accumulation was reached
+        vfloat baseAccumulation = maskToFloat(params.isExistingSample) * (1.0f - thisFrameReactiveFactor) * (1.0f - params.depthClipFactor);
+
+        baseAccumulation = min(baseAccumulation, lerp(baseAccumulation, upsampledWeight * 10.0f, max(maskToFloat(inMotionLastFrame), saturate(params.hrVelocity * 10.0f))));
+
+        baseAccumulation = min(baseAccumulation, lerp(baseAccumulation, upsampledWeight, saturate(params.hrVelocity / 20.0f)));
+
+        return baseAccumulation;
+    }
+
+    void rectifyHistory(const AccumulationPassCommonParams& params, const RectificationBox& clippingBox, vfloat3& historyColor, vfloat& accumulation,
+        vfloat lockContributionThisFrame, vfloat lumaInstabilityFactor) const
+    {
+        const float scaleFactorInfluence = fsr2cpu::min(20.0f, powf(1.0f / fabsf(downscaleFactor().x * downscaleFactor().y), 3.0f));
+
+        const vfloat velocityFactor = saturate(params.hrVelocity / 20.0f);
+        const vfloat boxScaleT = max(params.depthClipFactor, max(params.accumulationMask, velocityFactor));
+        const vfloat boxScale = lerp(vfloat(scaleFactorInfluence), vfloat(1.0f), boxScaleT);
+
+        const vfloat3 scaledBoxVec = clippingBox.boxVec * vfloat3(boxScale);
+        const vfloat3 boxMin = max(clippingBox.aabbMin, clippingBox.boxCenter - scaledBoxVec);
+        const vfloat3 boxMax = min(clippingBox.aabbMax, clippingBox.boxCenter + scaledBoxVec);
+
+        const vmask outside =
+            (boxMin.x > historyColor.x) | (boxMin.y > historyColor.y) | (boxMin.z > historyColor.z) |
+            (historyColor.x > boxMax.x) | (historyColor.y > boxMax.y) | (historyColor.z > boxMax.z);
+
+        if (!any(outside)) {
+            return;
+        }
+
+        const vfloat3 clampedHistoryColor = clamp(historyColor, boxMin, boxMax);
+
+        const vfloat reactiveContribution = 1.0f - sqrt(params.dilatedReactiveFactor);
+        const vfloat historyContribution = saturate(max(lumaInstabilityFactor, lockContributionThisFrame) * reactiveContribution);
+
+        // Scale history color using rectification info, also using accumulation mask to avoid potential invalid color protection
+        historyColor = select(outside, lerp(clampedHistoryColor, historyColor, historyContribution), historyColor);
+
+        // Scale accumulation using rectification info
+        const vfloat accumulationMin = min(accumulation, vfloat(0.1f));
+        accumulation = select(outside, lerp(accumulationMin, accumulation, historyContribution), accumulation);
+    }
+
+    vfloat3 accumulate(vfloat3 historyColor, vfloat accumulation, const vfloat4& upsampledColorAndWeight) const
+    {
+        // Avoid invalid values when accumulation and upsampled weight is 0
+        accumulation = max(vfloat(FSR2_EPSILON), accumulation + upsampledColorAndWeight.w);
+
+        vfloat3 upsampledColor = upsampledColorAndWeight.xyz();
+        if (hdr()) {
+            // YCoCg -> RGB -> Tonemap -> YCoCg (Use RGB tonemapper to avoid color desaturation)
+            upsampledColor = rgbToYCoCg(tonemap(yCoCgToRgb(upsampledColor)));
+            historyColor = rgbToYCoCg(tonemap(yCoCgToRgb(historyColor)));
+        }
+
+        const vfloat alpha = upsampledColorAndWeight.w / accumulation;
+        historyColor = lerp(historyColor, upsampledColor, alpha);
+
+        historyColor = yCoCgToRgb(historyColor);
+
+        if (hdr()) {
+            historyColor = inverseTonemap(historyColor);
+        }
+
+        return historyColor;
+    }
+
+    void finalizeLockStatus(const AccumulationPassCommonParams& params, vfloat2 lockStatusValue, vfloat upsampledWeight) const
+    {
+        // we expect similar motion for next frame
+        // kill lock if that location is outside screen, avoid locks to be clamped to screen borders
+        const vfloat2 estimatedUvNextFrame = params.hrUv - params.motionVector;
+
+        // Decrease lock lifetime
+        const float lifetimeDecreaseLanczosMax = constants.jitterPhaseCount * FSR2_AVERAGE_LANCZOS_WEIGHT_PER_FRAME;
+        const vfloat lifetimeDecrease = upsampledWeight / lifetimeDecreaseLanczosMax;
+        lockStatusValue.x = select(isUvInside(estimatedUvNextFrame), max(vfloat(0.0f), lockStatusValue.x - lifetimeDecrease), vfloat(0.0f));
+
+        store(rwLockStatus, params.pxHrPos, params.active, vfloat4(lockStatusValue.x, lockStatusValue.y, 0.0f, 0.0f));
+    }
+
+    vfloat computeTemporalReactiveFactor(const AccumulationPassCommonParams& params, vfloat temporalReactiveFactor) const
+    {
+        vfloat newFactor = min(vfloat(0.99f), temporalReactiveFactor);
+
+        newFactor = max(newFactor, lerp(newFactor, vfloat(0.4f), saturate(params.hrVelocity)));
+
+        newFactor = max(newFactor * newFactor, max(params.depthClipFactor * 0.1f, params.dilatedReactiveFactor));
+
+        // Force reactive factor for new samples
+        newFactor = select(params.isNewSample, vfloat(1.0f), newFactor);
+
+        return select(saturate(params.hrVelocity * 10.0f) >= 1.0f, -max(vfloat(FSR2_EPSILON), newFactor), newFactor);
+    }
+
+    void accumulate(const vint2& pxHrPos, const UpsampleTile& tile) const
+    {
+        const vmask active = isOnScreen(pxHrPos, displaySize());
+        if (!any(active)) {
+            return;
+        }
+
+        const AccumulationPassCommonParams params = initParams(pxHrPos, active);
+
+        vfloat3 historyColor(0.0f);
+        vfloat2 lockStatusValue(0.0f);
+        vfloat temporalReactiveFactor = 0.0f;
+        vmask inMotionLastFrame = maskAll(false);
+        vmask newLock = maskAll(false);
+
+        const vmask reproject = params.isResetFrame ? maskAll(false) : (active & params.isExistingSample);
+        if (any(reproject)) {
+
+            reprojectHistoryColor(params, reproject, historyColor, temporalReactiveFactor, inMotionLastFrame);
+            newLock = reprojectHistoryLockStatus(params, reproject, lockStatusValue);
+        }
+
+        vfloat thisFrameReactiveFactor = max(params.dilatedReactiveFactor, temporalReactiveFactor);
+
+        vfloat luminanceDiff = 0.0f;
+        vfloat lockContributionThisFrame = 0.0f;
+        updateLockStatus(params, thisFrameReactiveFactor, newLock, lockStatusValue, lockContributionThisFrame, luminanceDiff);
+
+        // Load upsampled input color
+        RectificationBox clippingBox;
+        const vfloat4 upsampledColorAndWeight = computeUpsampledColorAndWeight(params, tile, clippingBox, thisFrameReactiveFactor);
+
+        const vfloat lumaInstabilityFactor = computeLumaInstabilityFactor(params, clippingBox, thisFrameReactiveFactor, luminanceDiff);
+
+        vfloat accumulation = computeBaseAccumulationWeight(params, thisFrameReactiveFactor, inMotionLastFrame, upsampledColorAndWeight.w);
+
+        const vfloat3 newSampleColor = yCoCgToRgb(upsampledColorAndWeight.xyz());
+        if (!all(params.isNewSample | !active)) {
+
+            rectifyHistory(params, clippingBox, historyColor, accumulation, lockContributionThisFrame, lumaInstabilityFactor);
+
+            historyColor = accumulate(historyColor, accumulation, upsampledColorAndWeight);
+        }
+        historyColor = select(params.isNewSample, newSampleColor, historyColor);
+
+        historyColor = unprepareRgb(historyColor, exposureValue, constants.preExposure);
+
+        finalizeLockStatus(params, lockStatusValue, upsampledColorAndWeight.w);
+
+        // Get new temporal reactive factor
+        temporalReactiveFactor = computeTemporalReactiveFactor(params, thisFrameReactiveFactor);
+
+        store(rwInternalUpscaledColor, pxHrPos, active, vfloat4(historyColor, temporalReactiveFactor));
+
+        // Output final color when RCAS is disabled
+        if (!sharpening()) {
+            store(rwUpscaledOutput, pxHrPos, active, vfloat4(historyColor, 1.0f));
+        }
+
+        store(rwNewLocks, pxHrPos, active, vfloat4(0.0f));
+    }
+};
+
+inline void accumulateKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_STATIC_ASSERT(64 % SIMD_WIDTH == 0);
+
+    const AccumulatePass pass(job);
+    const UpsampleTile tile = pass.loadUpsampleTile(groupX, groupY, groupShared);
+
+    // lanes walk the 8x8 thread group in row major order
+    const vint groupOrigin = vint(int32_t(groupX * 8));
+    for (int32_t firstThread = 0; firstThread < 64; firstThread += SIMD_WIDTH) {
+
+        const vint thread = laneIndex() + vint(firstThread);
+        const vint2 pxHrPos = vint2(groupOrigin + (thread & vint(7)), vint(int32_t(groupY * 8)) + (thread >> 3));
+        pass.accumulate(pxHrPos, tile);
+    }
+}
+
+} // namespace FSR2_CPU_SIMD_NAMESPACE
+} // namespace fsr2cpu
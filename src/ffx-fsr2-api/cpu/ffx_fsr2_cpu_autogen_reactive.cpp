@@ -0,0 +1,66 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_autogen_reactive_pass.hlsl.
+
+#include "ffx_fsr2_cpu_common.h"
+
+using namespace fsr2cpu;
+
+void fsr2CpuGenerateReactiveKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    const Fsr2GenerateReactiveConstants& reactive = *reinterpret_cast<const Fsr2GenerateReactiveConstants*>(job->cbs[0]);
+    const Fsr2CpuSurface& opaqueOnly = job->srvs[FSR2_CPU_AUTOGEN_REACTIVE_SRV_INPUT_OPAQUE_ONLY];
+    const Fsr2CpuSurface& inputColor = job->srvs[FSR2_CPU_AUTOGEN_REACTIVE_SRV_INPUT_COLOR];
+    const Fsr2CpuSurface& autoReactive = job->uavs[FSR2_CPU_AUTOGEN_REACTIVE_UAV_AUTOREACTIVE];
+
+    for (int32_t threadY = 0; threadY < 8; ++threadY) {
+        for (int32_t threadX = 0; threadX < 8; ++threadX) {
+
+            const int2 pos = int2(int32_t(groupX * 8) + threadX, int32_t(groupY * 8) + threadY);
+
+            float3 colorPreAlpha = fsr2CpuLoad(opaqueOnly, pos).xyz();
+            float3 colorPostAlpha = fsr2CpuLoad(inputColor, pos).xyz();
+
+            if (reactive.flags & FFX_FSR2_AUTOREACTIVEFLAGS_APPLY_TONEMAP) {
+                colorPreAlpha = tonemap(colorPreAlpha);
+                colorPostAlpha = tonemap(colorPostAlpha);
+            }
+
+            if (reactive.flags & FFX_FSR2_AUTOREACTIVEFLAGS_APPLY_INVERSETONEMAP) {
+                colorPreAlpha = inverseTonemap(colorPreAlpha);
+                colorPostAlpha = inverseTonemap(colorPostAlpha);
+            }
+
+            const float3 delta = abs(colorPostAlpha - colorPreAlpha);
+            float reactiveValue = (reactive.flags & FFX_FSR2_AUTOREACTIVEFLAGS_USE_COMPONENTS_MAX) ? max3(delta.x, delta.y, delta.z) : length(delta);
+            reactiveValue *= reactive.scale;
+
+            if (reactive.flags & FFX_FSR2_AUTOREACTIVEFLAGS_APPLY_THRESHOLD) {
+                reactiveValue = reactiveValue < reactive.threshold ? 0.0f : reactive.binaryValue;
+            }
+
+            fsr2CpuStore(autoReactive, pos, float4(reactiveValue));
+        }
+    }
+}
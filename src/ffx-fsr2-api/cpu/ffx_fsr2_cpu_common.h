@@ -0,0 +1,281 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Host ports of the helpers in ffx_fsr2_common.h and ffx_fsr2_callbacks_hlsl.h, shared by the CPU pass kernels.
+
+#pragma once
+
+#include "ffx_fsr2_cpu_private.h"
+
+namespace fsr2cpu {
+
+static const float FSR2_EPSILON                                     = 1e-03f;
+static const float FSR2_FLT_MAX                                     = 3.402823466e+38f;
+static const float FSR2_FP16_MAX                                    = 65504.0f;
+static const float FSR2_TONEMAP_EPSILON                             = 1.0f / 65504.0f;
+static const float FSR2_RECONSTRUCTED_DEPTH_BILINEAR_WEIGHT_THRESHOLD = 0.01f;
+static const float FSR2_UPSAMPLE_LANCZOS_WEIGHT_SCALE               = 1.0f / 12.0f;
+static const float FSR2_AVERAGE_LANCZOS_WEIGHT_PER_FRAME            = 0.74f * FSR2_UPSAMPLE_LANCZOS_WEIGHT_SCALE;
+static const float FSR2_RESET_AUTO_EXPOSURE_AVERAGE_SMOOTHING       = 1e8f;
+
+// The constant buffers and permutation of the job currently executed.
+struct PassContext {
+
+    const Fsr2Constants&        constants;
+    uint32_t                    permutationFlags;
+
+    explicit PassContext(const Fsr2CpuJob* job)
+        : constants(*reinterpret_cast<const Fsr2Constants*>(job->cbs[0]))
+        , permutationFlags(job->pipeline->permutationFlags)
+    {
+    }
+
+    bool hdr() const                    { return (permutationFlags & FSR2_CPU_PERMUTATION_HDR_COLOR_INPUT) != 0; }
+    bool lowResMotionVectors() const    { return (permutationFlags & FSR2_CPU_PERMUTATION_LOW_RESOLUTION_MOTION_VECTORS) != 0; }
+    bool jitteredMotionVectors() const  { return (permutationFlags & FSR2_CPU_PERMUTATION_JITTERED_MOTION_VECTORS) != 0; }
+    bool invertedDepth() const          { return (permutationFlags & FSR2_CPU_PERMUTATION_INVERTED_DEPTH) != 0; }
+    bool sharpening() const             { return (permutationFlags & FSR2_CPU_PERMUTATION_APPLY_SHARPENING) != 0; }
+
+    int2   renderSize() const           { return int2(constants.renderSize[0], constants.renderSize[1]); }
+    int2   maxRenderSize() const        { return int2(constants.maxRenderSize[0], constants.maxRenderSize[1]); }
+    int2   displaySize() const          { return int2(constants.displaySize[0], constants.displaySize[1]); }
+    int2   inputColorResourceDimensions() const { return int2(constants.inputColorResourceDimensions[0], constants.inputColorResourceDimensions[1]); }
+    int2   lumaMipDimensions() const    { return int2(constants.lumaMipDimensions[0], constants.lumaMipDimensions[1]); }
+    float2 jitter() const               { return float2(constants.jitterOffset[0], constants.jitterOffset[1]); }
+    float2 downscaleFactor() const      { return float2(constants.downscaleFactor[0], constants.downscaleFactor[1]); }
+
+    float getViewSpaceDepth(float deviceDepth) const
+    {
+        return constants.deviceToViewDepth[1] / (deviceDepth - constants.deviceToViewDepth[0]);
+    }
+
+    float getViewSpaceDepthInMeters(float deviceDepth) const
+    {
+        return getViewSpaceDepth(deviceDepth) * constants.viewSpaceToMetersFactor;
+    }
+
+    float3 getViewSpacePosition(int2 viewportPos, int2 viewportSize, float deviceDepth) const
+    {
+        const float z = getViewSpaceDepth(deviceDepth);
+        const float2 ndc = toFloat(viewportPos) / toFloat(viewportSize) * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f);
+        return float3(constants.deviceToViewDepth[2] * ndc.x * z, constants.deviceToViewDepth[3] * ndc.y * z, z);
+    }
+
+    float getMaxDistanceInMeters() const
+    {
+        return getViewSpaceDepth(invertedDepth() ? 0.0f : 1.0f) * constants.viewSpaceToMetersFactor;
+    }
+
+    int2 computeHrPosFromLrPos(int2 lrPos) const
+    {
+        const float2 srcOutputPos = toFloat(lrPos) + 0.5f - jitter();
+        const float2 lrOutputPos = srcOutputPos / toFloat(renderSize()) * toFloat(displaySize());
+        return toInt(floor(lrOutputPos));
+    }
+
+    // LoadInputMotionVector: scale to UV space and optionally remove the jitter baked into the vectors.
+    float2 loadInputMotionVector(const Fsr2CpuSurface& motionVectors, int2 pos) const
+    {
+        float2 mv = fsr2CpuLoad(motionVectors, pos).xy() * float2(constants.motionVectorScale[0], constants.motionVectorScale[1]);
+        if (jitteredMotionVectors()) {
+            mv -= float2(constants.motionVectorJitterCancellation[0], constants.motionVectorJitterCancellation[1]);
+        }
+        return mv;
+    }
+};
+
+inline float exposure(const Fsr2CpuSurface& exposureSurface)
+{
+    const float value = fsr2CpuLoad(exposureSurface, 0, 0).x;
+    return value == 0.0f ? 1.0f : value;
+}
+
+inline bool isOnScreen(int2 pos, int2 size)
+{
+    return uint32_t(pos.x) < uint32_t(size.x) && uint32_t(pos.y) < uint32_t(size.y);
+}
+
+inline bool isUvInside(float2 uv)
+{
+    return uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f;
+}
+
+// Clamp a sample position only in the direction of the offset (ClampLoad / ClampCoord).
+inline int2 clampLoad(int2 pos, int2 offset, int2 textureSize)
+{
+    int2 result = pos + offset;
+    result.x = (offset.x < 0) ? max(result.x, 0) : result.x;
+    result.x = (offset.x > 0) ? min(result.x, textureSize.x - 1) : result.x;
+    result.y = (offset.y < 0) ? max(result.y, 0) : result.y;
+    result.y = (offset.y > 0) ? min(result.y, textureSize.y - 1) : result.y;
+    return result;
+}
+
+inline float2 clampUv(float2 uv, int2 textureSize, int2 resourceSize)
+{
+    const float2 sampleLocation = uv * toFloat(textureSize);
+    const float2 clampedLocation = max(float2(0.5f), min(sampleLocation, toFloat(textureSize) - float2(0.5f)));
+    return clampedLocation / toFloat(resourceSize);
+}
+
+struct BilinearSamplingData {
+
+    int2  offsets[4];
+    float weights[4];
+    int2  basePos;
+};
+
+inline BilinearSamplingData getBilinearSamplingData(float2 uv, int2 size)
+{
+    BilinearSamplingData data;
+    const float2 pxSample = uv * toFloat(size) - float2(0.5f);
+    data.basePos = toInt(floor(pxSample));
+    const float2 pxFrac = fract(pxSample);
+
+    data.offsets[0] = int2(0, 0);
+    data.offsets[1] = int2(1, 0);
+    data.offsets[2] = int2(0, 1);
+    data.offsets[3] = int2(1, 1);
+
+    data.weights[0] = (1.0f - pxFrac.x) * (1.0f - pxFrac.y);
+    data.weights[1] = (pxFrac.x) * (1.0f - pxFrac.y);
+    data.weights[2] = (1.0f - pxFrac.x) * (pxFrac.y);
+    data.weights[3] = (pxFrac.x) * (pxFrac.y);
+    return data;
+}
+
+inline float minDividedByMax(float a, float b)
+{
+    const float m = max(a, b);
+    return m != 0.0f ? min(a, b) / m : 0.0f;
+}
+
+inline float3 prepareRgb(float3 rgb, float exposureValue, float preExposure)
+{
+    rgb = rgb / preExposure;
+    rgb = rgb * exposureValue;
+    return clamp(rgb, 0.0f, FSR2_FP16_MAX);
+}
+
+inline float3 unprepareRgb(float3 rgb, float exposureValue, float preExposure)
+{
+    rgb = rgb / exposureValue;
+    rgb = rgb * preExposure;
+    return rgb;
+}
+
+inline float3 tonemap(float3 rgb)
+{
+    return rgb / (max(max(0.0f, rgb.x), max(rgb.y, rgb.z)) + 1.0f);
+}
+
+inline float3 inverseTonemap(float3 rgb)
+{
+    return rgb / max(FSR2_TONEMAP_EPSILON, 1.0f - max(rgb.x, max(rgb.y, rgb.z)));
+}
+
+inline float3 rgbToYCoCg(float3 rgb)
+{
+    return float3(
+        0.25f * rgb.x + 0.5f * rgb.y + 0.25f * rgb.z,
+        0.5f * rgb.x - 0.5f * rgb.z,
+        -0.25f * rgb.x + 0.5f * rgb.y - 0.25f * rgb.z);
+}
+
+inline float3 yCoCgToRgb(float3 yCoCg)
+{
+    return float3(
+        yCoCg.x + yCoCg.y - yCoCg.z,
+        yCoCg.x + yCoCg.z,
+        yCoCg.x - yCoCg.y - yCoCg.z);
+}
+
+inline float rgbToLuma(float3 rgb)
+{
+    return dot(rgb, float3(0.2126f, 0.7152f, 0.0722f));
+}
+
+inline float rgbToPerceivedLuma(float3 rgb)
+{
+    const float luminance = rgbToLuma(rgb);
+    const float percievedLuminance = (luminance <= 216.0f / 24389.0f) ? luminance * (24389.0f / 27.0f) : powf(luminance, 1.0f / 3.0f) * 116.0f - 16.0f;
+    return percievedLuminance * 0.01f;
+}
+
+inline float computeAutoExposureFromLavg(float lavg)
+{
+    lavg = expf(lavg);
+
+    const float S = 100.0f;
+    const float K = 12.5f;
+    const float ev100 = log2f(lavg * S / K);
+    const float q = 0.65f;
+    const float lmax = (78.0f / (q * S)) * powf(2.0f, ev100);
+    return 1.0f / lmax;
+}
+
+// Running min/max/mean/variance of the neighborhood used for history rectification.
+struct RectificationBox {
+
+    float3 boxCenter;
+    float3 boxVec;
+    float3 aabbMin;
+    float3 aabbMax;
+    float  fBoxCenterWeight;
+
+    void reset()
+    {
+        fBoxCenterWeight = 0.0f;
+        boxCenter = float3(0.0f);
+        boxVec = float3(0.0f);
+        aabbMin = float3(FSR2_FLT_MAX);
+        aabbMax = float3(-FSR2_FLT_MAX);
+    }
+
+    void addSample(bool initialSample, float3 sample, float weight)
+    {
+        if (initialSample) {
+            boxCenter = sample * weight;
+            boxVec = sample * sample * weight;
+            aabbMin = sample;
+            aabbMax = sample;
+            fBoxCenterWeight = weight;
+        } else {
+            boxCenter += sample * weight;
+            boxVec += sample * sample * weight;
+            aabbMin = min(aabbMin, sample);
+            aabbMax = max(aabbMax, sample);
+            fBoxCenterWeight += weight;
+        }
+    }
+
+    void computeVarianceBoxData()
+    {
+        const float weight = (fabsf(fBoxCenterWeight) > FSR2_EPSILON) ? fBoxCenterWeight : 1.0f;
+        boxCenter /= weight;
+        boxVec /= weight;
+        const float3 stdDev = sqrt(abs(boxVec - boxCenter * boxCenter));
+        boxVec = stdDev;
+    }
+};
+
+} // namespace fsr2cpu
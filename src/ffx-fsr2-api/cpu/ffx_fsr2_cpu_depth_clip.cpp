@@ -0,0 +1,299 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_depth_clip_pass.hlsl.
+
+#include "ffx_fsr2_cpu_common.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+struct DepthClipPass : PassContext {
+
+    const Fsr2CpuSurface& reconstructedPreviousNearestDepth;
+    const Fsr2CpuSurface& dilatedMotionVectors;
+    const Fsr2CpuSurface& dilatedDepth;
+    const Fsr2CpuSurface& reactiveMask;
+    const Fsr2CpuSurface& transparencyAndCompositionMask;
+    const Fsr2CpuSurface& previousDilatedMotionVectors;
+    const Fsr2CpuSurface& inputMotionVectors;
+    const Fsr2CpuSurface& inputColor;
+    const Fsr2CpuSurface& inputDepth;
+    const Fsr2CpuSurface& inputExposure;
+    const Fsr2CpuSurface& dilatedReactiveMasks;
+    const Fsr2CpuSurface& preparedInputColor;
+    const Fsr2CpuTile*    dilatedDepthTile;
+
+    DepthClipPass(const Fsr2CpuJob* job, const Fsr2CpuTile* dilatedDepthTile_)
+        : PassContext(job)
+        , reconstructedPreviousNearestDepth(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH])
+        , dilatedMotionVectors(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_DILATED_MOTION_VECTORS])
+        , dilatedDepth(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_DILATED_DEPTH])
+        , reactiveMask(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_REACTIVE_MASK])
+        , transparencyAndCompositionMask(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_TRANSPARENCY_AND_COMPOSITION_MASK])
+        , previousDilatedMotionVectors(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_PREVIOUS_DILATED_MOTION_VECTORS])
+        , inputMotionVectors(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_INPUT_MOTION_VECTORS])
+        , inputColor(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_INPUT_COLOR])
+        , inputDepth(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_INPUT_DEPTH])
+        , inputExposure(job->srvs[FSR2_CPU_DEPTH_CLIP_SRV_INPUT_EXPOSURE])
+        , dilatedReactiveMasks(job->uavs[FSR2_CPU_DEPTH_CLIP_UAV_DILATED_REACTIVE_MASKS])
+        , preparedInputColor(job->uavs[FSR2_CPU_DEPTH_CLIP_UAV_PREPARED_INPUT_COLOR])
+        , dilatedDepthTile(dilatedDepthTile_)
+    {
+    }
+
+    float loadDilatedDepth(int2 pos) const
+    {
+        return dilatedDepthTile ? fsr2CpuTileTexel(*dilatedDepthTile, pos) : fsr2CpuLoad(dilatedDepth, pos).x;
+    }
+
+    float loadReconstructedPrevDepth(int2 pos) const
+    {
+        return asfloat(fsr2CpuLoadUint(reconstructedPreviousNearestDepth, pos.x, pos.y));
+    }
+
+    float computeDepthClip(float2 uvSample, float currentDepthSample) const
+    {
+        const float currentDepthViewSpace = getViewSpaceDepth(currentDepthSample);
+        const BilinearSamplingData bilinearInfo = getBilinearSamplingData(uvSample, renderSize());
+
+        float depth = 0.0f;
+        float weightSum = 0.0f;
+        for (int32_t sampleIndex = 0; sampleIndex < 4; sampleIndex++) {
+
+            const int2 samplePos = bilinearInfo.basePos + bilinearInfo.offsets[sampleIndex];
+            if (!isOnScreen(samplePos, renderSize())) {
+                continue;
+            }
+
+            const float weight = bilinearInfo.weights[sampleIndex];
+            if (weight > FSR2_RECONSTRUCTED_DEPTH_BILINEAR_WEIGHT_THRESHOLD) {
+
+                const float prevDepthSample = loadReconstructedPrevDepth(samplePos);
+                const float prevNearestDepthViewSpace = getViewSpaceDepth(prevDepthSample);
+                const float depthDiff = currentDepthViewSpace - prevNearestDepthViewSpace;
+
+                if (depthDiff > 0.0f) {
+
+                    const float planeDepth = invertedDepth() ? min(prevDepthSample, currentDepthSample) : max(prevDepthSample, currentDepthSample);
+
+                    const float3 center = getViewSpacePosition(toInt(toFloat(renderSize()) * 0.5f), renderSize(), planeDepth);
+                    const float3 corner = getViewSpacePosition(int2(0, 0), renderSize(), planeDepth);
+
+                    const float halfViewportWidth = length(toFloat(renderSize()));
+                    const float depthThreshold = max(currentDepthViewSpace, prevNearestDepthViewSpace);
+
+                    const float Ksep = 1.37e-05f;
+                    const float Kfov = length(corner) / length(center);
+                    const float requiredDepthSeparation = Ksep * Kfov * halfViewportWidth * depthThreshold;
+
+                    const float resolutionFactor = saturate(length(toFloat(renderSize())) / length(float2(1920.0f, 1080.0f)));
+                    const float power = lerp(1.0f, 3.0f, resolutionFactor);
+                    depth += powf(saturate(requiredDepthSeparation / depthDiff), power) * weight;
+                    weightSum += weight;
+                }
+            }
+        }
+
+        return (weightSum > 0.0f) ? saturate(1.0f - depth / weightSum) : 0.0f;
+    }
+
+    float computeMotionDivergence(int2 pxPos, int2 inputMotionVectorSize) const
+    {
+        float minconvergence = 1.0f;
+
+        const float2 motionVectorNucleus = loadInputMotionVector(inputMotionVectors, pxPos);
+        const float nucleusVelocityLr = length(motionVectorNucleus * toFloat(renderSize()));
+        float maxVelocityUv = length(motionVectorNucleus);
+
+        const float motionVectorVelocityEpsilon = 1e-02f;
+
+        if (nucleusVelocityLr > motionVectorVelocityEpsilon) {
+            for (int32_t y = -1; y <= 1; ++y) {
+                for (int32_t x = -1; x <= 1; ++x) {
+
+                    const int2 sp = clampLoad(pxPos, int2(x, y), inputMotionVectorSize);
+
+                    const float2 motionVector = loadInputMotionVector(inputMotionVectors, sp);
+                    float velocityUv = length(motionVector);
+
+                    maxVelocityUv = max(velocityUv, maxVelocityUv);
+                    velocityUv = max(velocityUv, maxVelocityUv);
+                    minconvergence = min(minconvergence, dot(motionVector / velocityUv, motionVectorNucleus / velocityUv));
+                }
+            }
+        }
+
+        return saturate(1.0f - minconvergence) * saturate(maxVelocityUv / 0.01f);
+    }
+
+    float computeDepthDivergence(int2 pxPos) const
+    {
+        const float maxDistInMeters = getMaxDistanceInMeters();
+        float depthMax = 0.0f;
+        float depthMin = maxDistInMeters;
+
+        bool maxDistFound = false;
+
+        for (int32_t y = -1; y < 2; y++) {
+            for (int32_t x = -1; x < 2; x++) {
+
+                const int2 samplePos = pxPos + int2(x, y);
+
+                const float onScreenFactor = isOnScreen(samplePos, renderSize()) ? 1.0f : 0.0f;
+                const float depth = getViewSpaceDepthInMeters(loadDilatedDepth(samplePos)) * onScreenFactor;
+
+                maxDistFound |= (maxDistInMeters == depth);
+
+                depthMin = min(depthMin, depth);
+                depthMax = max(depthMax, depth);
+            }
+        }
+
+        return (1.0f - depthMin / depthMax) * (maxDistFound ? 0.0f : 1.0f);
+    }
+
+    float computeTemporalMotionDivergence(int2 pxPos) const
+    {
+        const float2 uv = (toFloat(pxPos) + 0.5f) / toFloat(renderSize());
+
+        const float2 motionVector = fsr2CpuLoad(dilatedMotionVectors, pxPos).xy();
+        float2 reprojectedUv = uv + motionVector;
+        reprojectedUv = clampUv(reprojectedUv, renderSize(), maxRenderSize());
+        const float2 prevMotionVector = fsr2CpuSampleLinearClamp(previousDilatedMotionVectors, reprojectedUv).xy();
+
+        const float pxDistance = length(motionVector * toFloat(displaySize()));
+        return pxDistance > 1.0f ? lerp(0.0f, 1.0f - saturate(length(prevMotionVector) / length(motionVector)), saturate(powf(pxDistance / 20.0f, 3.0f))) : 0.0f;
+    }
+
+    void preProcessReactiveMasks(int2 pxLrPos, float motionDivergence) const
+    {
+        const float3 referenceColor = fsr2CpuLoad(inputColor, pxLrPos).xyz();
+        float2 reactiveFactor = float2(0.0f, motionDivergence);
+
+        float masksSum = 0.0f;
+
+        float3 colorSamples[9];
+        float reactiveSamples[9];
+        float transparencyAndCompositionSamples[9];
+
+        for (int32_t y = -1; y < 2; y++) {
+            for (int32_t x = -1; x < 2; x++) {
+
+                const int2 sampleCoord = clampLoad(pxLrPos, int2(x, y), renderSize());
+                const int32_t sampleIdx = (y + 1) * 3 + x + 1;
+
+                colorSamples[sampleIdx] = fsr2CpuLoad(inputColor, sampleCoord).xyz();
+                reactiveSamples[sampleIdx] = fsr2CpuLoad(reactiveMask, sampleCoord).x;
+                transparencyAndCompositionSamples[sampleIdx] = fsr2CpuLoad(transparencyAndCompositionMask, sampleCoord).x;
+
+                masksSum += (reactiveSamples[sampleIdx] + transparencyAndCompositionSamples[sampleIdx]);
+            }
+        }
+
+        if (masksSum > 0.0f) {
+            for (int32_t sampleIdx = 0; sampleIdx < 9; sampleIdx++) {
+
+                const float3 colorSample = colorSamples[sampleIdx];
+
+                const float maxLenSq = max(dot(referenceColor, referenceColor), dot(colorSample, colorSample));
+                const float similarity = dot(referenceColor, colorSample) / maxLenSq;
+
+                // Increase power for non-similar samples
+                const float powerBiasMax = 6.0f;
+                const float similarityPower = 1.0f + (powerBiasMax - similarity * powerBiasMax);
+                const float weightedReactiveSample = powf(reactiveSamples[sampleIdx], similarityPower);
+                const float weightedTransparencyAndCompositionSample = powf(transparencyAndCompositionSamples[sampleIdx], similarityPower);
+
+                reactiveFactor = max(reactiveFactor, float2(weightedReactiveSample, weightedTransparencyAndCompositionSample));
+            }
+        }
+
+        fsr2CpuStore(dilatedReactiveMasks, pxLrPos, float4(reactiveFactor.x, reactiveFactor.y, 0.0f, 0.0f));
+    }
+
+    float3 computePreparedInputColor(int2 pxLrPos) const
+    {
+        // We assume linear data. if non-linear input (sRGB, ...),
+        // then we should convert to linear first and back to sRGB on output.
+        float3 rgb = max(float3(0.0f), fsr2CpuLoad(inputColor, pxLrPos).xyz());
+
+        rgb = prepareRgb(rgb, exposure(inputExposure), constants.preExposure);
+
+        return rgbToYCoCg(rgb);
+    }
+
+    float evaluateSurface(int2 pxPos) const
+    {
+        const float d0 = getViewSpaceDepth(loadReconstructedPrevDepth(pxPos + int2(0, -1)));
+        const float d1 = getViewSpaceDepth(loadReconstructedPrevDepth(pxPos + int2(0, 0)));
+        const float d2 = getViewSpaceDepth(loadReconstructedPrevDepth(pxPos + int2(0, 1)));
+
+        return 1.0f - float(((d0 - d1) > (d1 * 0.01f)) && ((d1 - d2) > (d2 * 0.01f)));
+    }
+
+    void depthClip(int2 pxPos) const
+    {
+        const float2 depthUv = (toFloat(pxPos) + 0.5f) / toFloat(renderSize());
+        float2 motionVector = fsr2CpuLoad(dilatedMotionVectors, pxPos).xy();
+
+        // Discard tiny mvs
+        motionVector *= float(length(motionVector * toFloat(displaySize())) > 0.01f);
+
+        const float2 dilatedUv = depthUv + motionVector;
+        const float dilatedDepthValue = loadDilatedDepth(pxPos);
+
+        // Compute prepared input color and depth clip
+        const float depthClipValue = computeDepthClip(dilatedUv, dilatedDepthValue) * evaluateSurface(pxPos);
+        const float3 preparedYCoCg = computePreparedInputColor(pxPos);
+        fsr2CpuStore(preparedInputColor, pxPos, float4(preparedYCoCg, depthClipValue));
+
+        // Compute dilated reactive mask
+        const int2 samplePos = lowResMotionVectors() ? pxPos : computeHrPosFromLrPos(pxPos);
+
+        const float motionDivergence = computeMotionDivergence(samplePos, renderSize());
+        const float temporalMotionDifference = saturate(computeTemporalMotionDivergence(pxPos) - computeDepthDivergence(pxPos));
+
+        preProcessReactiveMasks(pxPos, max(temporalMotionDifference, motionDivergence));
+    }
+};
+
+} // namespace
+
+void fsr2CpuDepthClipKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    fsr2CpuDepthClipRegion(job, int2(int32_t(groupX * 8), int32_t(groupY * 8)), int2(8, 8), NULL);
+}
+
+void fsr2CpuDepthClipRegion(const Fsr2CpuJob* job, int2 origin, int2 size, const Fsr2CpuTile* dilatedDepth)
+{
+    const DepthClipPass pass(job, dilatedDepth);
+
+    for (int32_t y = 0; y < size.y; ++y) {
+        for (int32_t x = 0; x < size.x; ++x) {
+
+            pass.depthClip(origin + int2(x, y));
+        }
+    }
+}
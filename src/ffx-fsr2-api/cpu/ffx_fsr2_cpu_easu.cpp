@@ -0,0 +1,310 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Host port of ffxFsrEasuFloat from ffx_fsr1.h, and ffxFsr2EasuCPU which upscales a plain RGBA image
+// with it, splitting the output rows over the CPU executor.
+
+#include <thread>
+#include "ffx_fsr2_cpu_common.h"
+#include "ffx_fsr2_cpu.h"
+#include "ffx_fsr2_cpu_executor.h"
+#include "ffx_fsr2_cpu_simd.h"
+#define FFX_CPU
+#include "../shaders/ffx_core.h"
+#include "../shaders/ffx_fsr1.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+// Output rows filtered by a single group of the dispatch.
+static const uint32_t EASU_ROWS_PER_GROUP = 8;
+
+// Estimates used by ffxFsrEasuFloat, kept so the host output matches the shader bit for bit where the
+// arithmetic allows. They also keep flat regions free of NaN, as the reciprocal of zero stays finite.
+inline float approximateRcp(float v)
+{
+    return asfloat(0x7ef07ebbu - asuint(v));
+}
+
+inline float approximateRsqrt(float v)
+{
+    return asfloat(0x5f347d74u - (asuint(v) >> 1));
+}
+
+// Position of 'f' along an axis. Fused like the mad of the shader so that every row filter picks the
+// same texel when the position lands on a texel edge, which is common for integer scale factors.
+inline float easuPosition(uint32_t coordinate, float scale, float offset)
+{
+    return fmaf(float(coordinate), scale, offset);
+}
+
+inline float3 loadRgb(const uint8_t* row, int32_t x)
+{
+    const float* texel = reinterpret_cast<const float*>(row) + size_t(x) * 4;
+    return float3(texel[0], texel[1], texel[2]);
+}
+
+// Luma times 2.
+inline float luma2(const float3& c)
+{
+    return c.z * 0.5f + (c.x * 0.5f + c.y);
+}
+
+// fsrEasuSetFloat, l holding the luma of the '+' a (above), b c d (left, center, right) and e (below).
+void easuSet(float2& dir, float& len, float weight, float lA, float lB, float lC, float lD, float lE)
+{
+    const float dc = lD - lC;
+    const float cb = lC - lB;
+    float lenX = approximateRcp(max(fabsf(dc), fabsf(cb)));
+    const float dirX = lD - lB;
+    dir.x += dirX * weight;
+    lenX = saturate(fabsf(dirX) * lenX);
+    len += lenX * lenX * weight;
+
+    const float ec = lE - lC;
+    const float ca = lC - lA;
+    float lenY = approximateRcp(max(fabsf(ec), fabsf(ca)));
+    const float dirY = lE - lA;
+    dir.y += dirY * weight;
+    lenY = saturate(fabsf(dirY) * lenY);
+    len += lenY * lenY * weight;
+}
+
+// fsrEasuTapFloat
+void easuTap(float3& aC, float& aW, float2 off, float2 dir, float2 len2, float lob, float clp, const float3& color)
+{
+    // Rotate offset by direction, and apply the anisotropy.
+    const float2 v = float2(off.x * dir.x + off.y * dir.y, off.x * -dir.y + off.y * dir.x) * len2;
+
+    // Limit to the window as at corner, 2 taps can easily be outside.
+    const float d2 = min(v.x * v.x + v.y * v.y, clp);
+
+    // Approximation of lanczos2 without sin() or rcp(), or sqrt() to get x.
+    float wB = 2.0f / 5.0f * d2 - 1.0f;
+    float wA = lob * d2 - 1.0f;
+    wB *= wB;
+    wA *= wA;
+    wB = 25.0f / 16.0f * wB - (25.0f / 16.0f - 1.0f);
+    const float w = wB * wA;
+
+    aC += color * w;
+    aW += w;
+}
+
+struct EasuJob {
+
+    Fsr2CpuEasuSource           source;
+    uint8_t*                    destination;
+    size_t                      destinationPitch;
+    uint32_t                    width;
+    uint32_t                    height;
+    Fsr2CpuEasuRowFunc          easuRow;
+};
+
+void easuRows(const EasuJob& easu, uint32_t firstRow)
+{
+    const uint32_t lastRow = FFX_MINIMUM(easu.height, firstRow + EASU_ROWS_PER_GROUP);
+
+    for (uint32_t y = firstRow; y < lastRow; ++y) {
+        easu.easuRow(&easu.source, y, reinterpret_cast<float*>(easu.destination + size_t(y) * easu.destinationPitch), easu.width);
+    }
+}
+
+void easuKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupX);
+    FFX_UNUSED(groupShared);
+
+    easuRows(*static_cast<const EasuJob*>(job->cbs[0]), groupY * EASU_ROWS_PER_GROUP);
+}
+
+} // namespace
+
+void fsr2CpuEasuRow(const Fsr2CpuEasuSource* source, uint32_t y, float* output, uint32_t count)
+{
+    // The rows of the 12-tap kernel are the same for the whole output row.
+    //    b c
+    //  e f g h
+    //  i j k l
+    //    n o
+    const float ppY = easuPosition(y, source->scale[1], source->offset[1]);
+    const int32_t fpY = int32_t(floorf(ppY));
+    const float fracY = ppY - floorf(ppY);
+
+    const uint8_t* rows[4];
+    for (int32_t row = 0; row < 4; ++row) {
+        rows[row] = source->data + size_t(min(max(fpY + row - 1, 0), source->height - 1)) * source->rowPitch;
+    }
+
+    for (uint32_t x = 0; x < count; ++x) {
+
+        // Get position of 'f', texels outside the source are clamped to its edges like the sampler does.
+        const float ppX = easuPosition(x, source->scale[0], source->offset[0]);
+        const int32_t fpX = int32_t(floorf(ppX));
+        const float2 pp = float2(ppX - floorf(ppX), fracY);
+
+        int32_t cols[4];
+        for (int32_t col = 0; col < 4; ++col) {
+            cols[col] = min(max(fpX + col - 1, 0), source->width - 1);
+        }
+
+        const float3 b = loadRgb(rows[0], cols[1]);
+        const float3 c = loadRgb(rows[0], cols[2]);
+        const float3 e = loadRgb(rows[1], cols[0]);
+        const float3 f = loadRgb(rows[1], cols[1]);
+        const float3 g = loadRgb(rows[1], cols[2]);
+        const float3 h = loadRgb(rows[1], cols[3]);
+        const float3 i = loadRgb(rows[2], cols[0]);
+        const float3 j = loadRgb(rows[2], cols[1]);
+        const float3 k = loadRgb(rows[2], cols[2]);
+        const float3 l = loadRgb(rows[2], cols[3]);
+        const float3 n = loadRgb(rows[3], cols[1]);
+        const float3 o = loadRgb(rows[3], cols[2]);
+
+        const float bL = luma2(b), cL = luma2(c), eL = luma2(e), fL = luma2(f), gL = luma2(g), hL = luma2(h);
+        const float iL = luma2(i), jL = luma2(j), kL = luma2(k), lL = luma2(l), nL = luma2(n), oL = luma2(o);
+
+        // Accumulate for bilinear interpolation.
+        float2 dir = float2(0.0f, 0.0f);
+        float len = 0.0f;
+        easuSet(dir, len, (1.0f - pp.x) * (1.0f - pp.y), bL, eL, fL, gL, jL);
+        easuSet(dir, len, pp.x * (1.0f - pp.y), cL, fL, gL, hL, kL);
+        easuSet(dir, len, (1.0f - pp.x) * pp.y, fL, iL, jL, kL, nL);
+        easuSet(dir, len, pp.x * pp.y, gL, jL, kL, lL, oL);
+
+        // Normalize with approximation, and cleanup close to zero.
+        float dirR = dir.x * dir.x + dir.y * dir.y;
+        const bool zro = dirR < 1.0f / 32768.0f;
+        dirR = zro ? 1.0f : approximateRsqrt(dirR);
+        dir.x = zro ? 1.0f : dir.x;
+        dir = dir * dirR;
+
+        // Transform from {0 to 2} to {0 to 1} range, and shape with square.
+        len = len * 0.5f;
+        len *= len;
+
+        // Stretch kernel {1.0 vert|horz, to sqrt(2.0) on diagonal}.
+        const float stretch = (dir.x * dir.x + dir.y * dir.y) * approximateRcp(max(fabsf(dir.x), fabsf(dir.y)));
+
+        // Anisotropic length after rotation, x := 1.0 lerp to 'stretch' on edges, y := 1.0 lerp to 2x on edges.
+        const float2 len2 = float2(1.0f + (stretch - 1.0f) * len, 1.0f - 0.5f * len);
+
+        // Based on the amount of 'edge', the window shifts from +/-{sqrt(2.0) to slightly beyond 2.0}.
+        const float lob = 0.5f + ((1.0f / 4.0f - 0.04f) - 0.5f) * len;
+
+        // Set distance^2 clipping point to the end of the adjustable window.
+        const float clp = approximateRcp(lob);
+
+        // Accumulation mixed with min/max of 4 nearest.
+        const float3 min4 = min(min(min(f, g), j), k);
+        const float3 max4 = max(max(max(f, g), j), k);
+
+        float3 aC = float3(0.0f);
+        float aW = 0.0f;
+        easuTap(aC, aW, float2(0.0f, -1.0f) - pp, dir, len2, lob, clp, b);
+        easuTap(aC, aW, float2(1.0f, -1.0f) - pp, dir, len2, lob, clp, c);
+        easuTap(aC, aW, float2(-1.0f, 1.0f) - pp, dir, len2, lob, clp, i);
+        easuTap(aC, aW, float2(0.0f, 1.0f) - pp, dir, len2, lob, clp, j);
+        easuTap(aC, aW, float2(0.0f, 0.0f) - pp, dir, len2, lob, clp, f);
+        easuTap(aC, aW, float2(-1.0f, 0.0f) - pp, dir, len2, lob, clp, e);
+        easuTap(aC, aW, float2(1.0f, 1.0f) - pp, dir, len2, lob, clp, k);
+        easuTap(aC, aW, float2(2.0f, 1.0f) - pp, dir, len2, lob, clp, l);
+        easuTap(aC, aW, float2(2.0f, 0.0f) - pp, dir, len2, lob, clp, h);
+        easuTap(aC, aW, float2(1.0f, 0.0f) - pp, dir, len2, lob, clp, g);
+        easuTap(aC, aW, float2(1.0f, 2.0f) - pp, dir, len2, lob, clp, o);
+        easuTap(aC, aW, float2(0.0f, 2.0f) - pp, dir, len2, lob, clp, n);
+
+        // Normalize and dering.
+        const float3 color = min(max4, max(min4, aC * rcp(aW)));
+
+        float* texel = output + size_t(x) * 4;
+        texel[0] = color.x;
+        texel[1] = color.y;
+        texel[2] = color.z;
+        texel[3] = 1.0f;
+    }
+}
+
+FfxErrorCode ffxFsr2EasuCPU(
+    const void* source, size_t sourcePitch, uint32_t sourceWidth, uint32_t sourceHeight,
+    void* destination, size_t destinationPitch, uint32_t destinationWidth, uint32_t destinationHeight,
+    const uint32_t* constants, uint32_t threadCount)
+{
+    FFX_RETURN_ON_ERROR(source && destination, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(source != destination, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(sourceWidth > 0 && sourceHeight > 0 && destinationWidth > 0 && destinationHeight > 0, FFX_ERROR_INVALID_ARGUMENT);
+    // the vectorized row filters address texels of a row with 32-bit byte offsets
+    FFX_RETURN_ON_ERROR(sourceWidth <= INT32_MAX / 16 && sourceHeight <= INT32_MAX, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(sourcePitch >= size_t(sourceWidth) * 16 && destinationPitch >= size_t(destinationWidth) * 16, FFX_ERROR_INVALID_ARGUMENT);
+
+    FfxUInt32x4 con[4];
+    if (constants) {
+        memcpy(con, constants, sizeof(con));
+    } else {
+        ffxFsrPopulateEasuConstants(con[0], con[1], con[2], con[3],
+            float(sourceWidth), float(sourceHeight), float(sourceWidth), float(sourceHeight), float(destinationWidth), float(destinationHeight));
+    }
+
+    // con1..con3 only hold the gather coordinates of the taps relative to con0, which the row
+    // filters derive from the texel position of 'f' instead.
+    EasuJob easu = {};
+    easu.source.data = static_cast<const uint8_t*>(source);
+    easu.source.rowPitch = sourcePitch;
+    easu.source.width = int32_t(sourceWidth);
+    easu.source.height = int32_t(sourceHeight);
+    easu.source.scale[0] = asfloat(con[0][0]);
+    easu.source.scale[1] = asfloat(con[0][1]);
+    easu.source.offset[0] = asfloat(con[0][2]);
+    easu.source.offset[1] = asfloat(con[0][3]);
+    easu.destination = static_cast<uint8_t*>(destination);
+    easu.destinationPitch = destinationPitch;
+    easu.width = destinationWidth;
+    easu.height = destinationHeight;
+    easu.easuRow = fsr2CpuSelectEasuRow();
+
+    const uint32_t groupCount = (destinationHeight + EASU_ROWS_PER_GROUP - 1) / EASU_ROWS_PER_GROUP;
+    const uint32_t hardwareThreads = FFX_MAXIMUM(1u, std::thread::hardware_concurrency());
+    const uint32_t workerCount = FFX_MINIMUM(groupCount, threadCount ? threadCount : hardwareThreads);
+
+    if (workerCount <= 1) {
+
+        for (uint32_t group = 0; group < groupCount; ++group) {
+            easuRows(easu, group * EASU_ROWS_PER_GROUP);
+        }
+        return FFX_OK;
+    }
+
+    const Fsr2CpuPipeline pipeline = { FFX_FSR2_PASS_COUNT, 0, easuKernel, NULL, false };
+
+    Fsr2CpuJob job = {};
+    job.pipeline = &pipeline;
+    job.dimensions[0] = 1;
+    job.dimensions[1] = groupCount;
+    job.dimensions[2] = 1;
+    job.cbs[0] = &easu;
+
+    Fsr2CpuExecutor executor(workerCount);
+    executor.dispatch(&job);
+
+    return FFX_OK;
+}
@@ -0,0 +1,237 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// AVX2 build of the EASU row filter, see fsr2CpuEasuRow in ffx_fsr2_cpu_easu.cpp for the reference.
+
+#include "ffx_fsr2_cpu_simd.h"
+
+#if FSR2_CPU_SIMD_X86
+
+#include <immintrin.h>
+#include "ffx_fsr2_cpu_common.h"
+
+FSR2_CPU_TARGET_BEGIN_AVX2
+
+#define FSR2_CPU_SIMD_NAMESPACE avx2
+#include "ffx_fsr2_cpu_simd_avx2.h"
+#include "ffx_fsr2_cpu_simd_common.h"
+
+namespace fsr2cpu {
+namespace avx2 {
+
+inline vfloat approximateRcp(vfloat v)
+{
+    return asFloat(vint(0x7ef07ebb) - asInt(v));
+}
+
+inline vfloat approximateRsqrt(vfloat v)
+{
+    return asFloat(vint(0x5f347d74) - (asInt(v) >> 1));
+}
+
+// Gather the RGB of a texel per lane, columnOffsets being the byte offsets of the texels in row.
+inline vfloat3 gatherRgb(const uint8_t* row, vint columnOffsets)
+{
+    const float* base = reinterpret_cast<const float*>(row);
+    const vmask all = maskAll(true);
+    return vfloat3(gather(base, columnOffsets, all), gather(base + 1, columnOffsets, all), gather(base + 2, columnOffsets, all));
+}
+
+// Interleave 8 texels into RGBA, alpha being 1.
+inline void storeRgb1(float* texels, const vfloat3& color)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 rg0 = _mm256_unpacklo_ps(color.x.v, color.y.v);
+    const __m256 ba0 = _mm256_unpacklo_ps(color.z.v, one);
+    const __m256 rg1 = _mm256_unpackhi_ps(color.x.v, color.y.v);
+    const __m256 ba1 = _mm256_unpackhi_ps(color.z.v, one);
+
+    // texels 0|4, 1|5, 2|6 and 3|7
+    const __m256 t04 = _mm256_shuffle_ps(rg0, ba0, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 t15 = _mm256_shuffle_ps(rg0, ba0, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 t26 = _mm256_shuffle_ps(rg1, ba1, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 t37 = _mm256_shuffle_ps(rg1, ba1, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(texels + 0, _mm256_permute2f128_ps(t04, t15, 0x20));
+    _mm256_storeu_ps(texels + 8, _mm256_permute2f128_ps(t26, t37, 0x20));
+    _mm256_storeu_ps(texels + 16, _mm256_permute2f128_ps(t04, t15, 0x31));
+    _mm256_storeu_ps(texels + 24, _mm256_permute2f128_ps(t26, t37, 0x31));
+}
+
+// Luma times 2.
+inline vfloat luma2(const vfloat3& c)
+{
+    return c.z * 0.5f + (c.x * 0.5f + c.y);
+}
+
+inline void easuSet(vfloat2& dir, vfloat& len, vfloat weight, vfloat lA, vfloat lB, vfloat lC, vfloat lD, vfloat lE)
+{
+    const vfloat dc = lD - lC;
+    const vfloat cb = lC - lB;
+    vfloat lenX = approximateRcp(max(abs(dc), abs(cb)));
+    const vfloat dirX = lD - lB;
+    dir.x += dirX * weight;
+    lenX = saturate(abs(dirX) * lenX);
+    len += lenX * lenX * weight;
+
+    const vfloat ec = lE - lC;
+    const vfloat ca = lC - lA;
+    vfloat lenY = approximateRcp(max(abs(ec), abs(ca)));
+    const vfloat dirY = lE - lA;
+    dir.y += dirY * weight;
+    lenY = saturate(abs(dirY) * lenY);
+    len += lenY * lenY * weight;
+}
+
+inline void easuTap(vfloat3& aC, vfloat& aW, vfloat offX, vfloat offY, const vfloat2& dir, const vfloat2& len2, vfloat lob, vfloat clp, const vfloat3& color)
+{
+    const vfloat vX = (offX * dir.x + offY * dir.y) * len2.x;
+    const vfloat vY = (offX * -dir.y + offY * dir.x) * len2.y;
+
+    const vfloat d2 = min(vX * vX + vY * vY, clp);
+
+    vfloat wB = 2.0f / 5.0f * d2 - 1.0f;
+    vfloat wA = lob * d2 - 1.0f;
+    wB *= wB;
+    wA *= wA;
+    wB = 25.0f / 16.0f * wB - (25.0f / 16.0f - 1.0f);
+    const vfloat w = wB * wA;
+
+    aC += color * vfloat3(w);
+    aW += w;
+}
+
+// Filter the 8 texels of a row starting at firstX.
+inline void easuPacket(const Fsr2CpuEasuSource* source, const uint8_t* const* rows, vfloat fracY, int32_t firstX, float* output)
+{
+    const vfloat ppX = fmadd(toFloat(laneIndex() + vint(firstX)), source->scale[0], source->offset[0]);
+    const vfloat fpX = floor(ppX);
+    const vint fX = truncToInt(fpX);
+    const vfloat ppx = ppX - fpX;
+    const vfloat ppy = fracY;
+
+    vint cols[4];
+    for (int32_t col = 0; col < 4; ++col) {
+        cols[col] = min(max(fX + vint(col - 1), vint(0)), vint(source->width - 1)) << 4;
+    }
+
+    //    b c
+    //  e f g h
+    //  i j k l
+    //    n o
+    const vfloat3 b = gatherRgb(rows[0], cols[1]);
+    const vfloat3 c = gatherRgb(rows[0], cols[2]);
+    const vfloat3 e = gatherRgb(rows[1], cols[0]);
+    const vfloat3 f = gatherRgb(rows[1], cols[1]);
+    const vfloat3 g = gatherRgb(rows[1], cols[2]);
+    const vfloat3 h = gatherRgb(rows[1], cols[3]);
+    const vfloat3 i = gatherRgb(rows[2], cols[0]);
+    const vfloat3 j = gatherRgb(rows[2], cols[1]);
+    const vfloat3 k = gatherRgb(rows[2], cols[2]);
+    const vfloat3 l = gatherRgb(rows[2], cols[3]);
+    const vfloat3 n = gatherRgb(rows[3], cols[1]);
+    const vfloat3 o = gatherRgb(rows[3], cols[2]);
+
+    const vfloat bL = luma2(b), cL = luma2(c), eL = luma2(e), fL = luma2(f), gL = luma2(g), hL = luma2(h);
+    const vfloat iL = luma2(i), jL = luma2(j), kL = luma2(k), lL = luma2(l), nL = luma2(n), oL = luma2(o);
+
+    // Accumulate for bilinear interpolation.
+    vfloat2 dir = vfloat2(0.0f);
+    vfloat len = 0.0f;
+    easuSet(dir, len, (1.0f - ppx) * (1.0f - ppy), bL, eL, fL, gL, jL);
+    easuSet(dir, len, ppx * (1.0f - ppy), cL, fL, gL, hL, kL);
+    easuSet(dir, len, (1.0f - ppx) * ppy, fL, iL, jL, kL, nL);
+    easuSet(dir, len, ppx * ppy, gL, jL, kL, lL, oL);
+
+    // Normalize with approximation, and cleanup close to zero.
+    const vfloat dirR = dir.x * dir.x + dir.y * dir.y;
+    const vmask zro = dirR < vfloat(1.0f / 32768.0f);
+    const vfloat dirScale = select(zro, vfloat(1.0f), approximateRsqrt(dirR));
+    dir.x = select(zro, vfloat(1.0f), dir.x) * dirScale;
+    dir.y = dir.y * dirScale;
+
+    // Transform from {0 to 2} to {0 to 1} range, and shape with square.
+    len = len * 0.5f;
+    len *= len;
+
+    const vfloat stretch = (dir.x * dir.x + dir.y * dir.y) * approximateRcp(max(abs(dir.x), abs(dir.y)));
+    const vfloat2 len2 = vfloat2(1.0f + (stretch - 1.0f) * len, 1.0f - 0.5f * len);
+    const vfloat lob = 0.5f + ((1.0f / 4.0f - 0.04f) - 0.5f) * len;
+    const vfloat clp = approximateRcp(lob);
+
+    // Accumulation mixed with min/max of 4 nearest.
+    const vfloat3 min4 = min(min(min(f, g), j), k);
+    const vfloat3 max4 = max(max(max(f, g), j), k);
+
+    vfloat3 aC = vfloat3(0.0f);
+    vfloat aW = 0.0f;
+    easuTap(aC, aW, 0.0f - ppx, -1.0f - ppy, dir, len2, lob, clp, b);
+    easuTap(aC, aW, 1.0f - ppx, -1.0f - ppy, dir, len2, lob, clp, c);
+    easuTap(aC, aW, -1.0f - ppx, 1.0f - ppy, dir, len2, lob, clp, i);
+    easuTap(aC, aW, 0.0f - ppx, 1.0f - ppy, dir, len2, lob, clp, j);
+    easuTap(aC, aW, 0.0f - ppx, 0.0f - ppy, dir, len2, lob, clp, f);
+    easuTap(aC, aW, -1.0f - ppx, 0.0f - ppy, dir, len2, lob, clp, e);
+    easuTap(aC, aW, 1.0f - ppx, 1.0f - ppy, dir, len2, lob, clp, k);
+    easuTap(aC, aW, 2.0f - ppx, 1.0f - ppy, dir, len2, lob, clp, l);
+    easuTap(aC, aW, 2.0f - ppx, 0.0f - ppy, dir, len2, lob, clp, h);
+    easuTap(aC, aW, 1.0f - ppx, 0.0f - ppy, dir, len2, lob, clp, g);
+    easuTap(aC, aW, 1.0f - ppx, 2.0f - ppy, dir, len2, lob, clp, o);
+    easuTap(aC, aW, 0.0f - ppx, 2.0f - ppy, dir, len2, lob, clp, n);
+
+    // Normalize and dering.
+    storeRgb1(output, min(max4, max(min4, aC * vfloat3(1.0f / aW))));
+}
+
+} // namespace avx2
+} // namespace fsr2cpu
+
+void fsr2CpuEasuRowAVX2(const Fsr2CpuEasuSource* source, uint32_t y, float* output, uint32_t count)
+{
+    using namespace fsr2cpu::avx2;
+
+    const float ppY = fmaf(float(y), source->scale[1], source->offset[1]);
+    const int32_t fpY = int32_t(floorf(ppY));
+    const vfloat fracY = ppY - floorf(ppY);
+
+    const uint8_t* rows[4];
+    for (int32_t row = 0; row < 4; ++row) {
+        rows[row] = source->data + size_t(fsr2cpu::min(fsr2cpu::max(fpY + row - 1, 0), source->height - 1)) * source->rowPitch;
+    }
+
+    const uint32_t packetCount = count / SIMD_WIDTH;
+    for (uint32_t packet = 0; packet < packetCount; ++packet) {
+        easuPacket(source, rows, fracY, int32_t(packet * SIMD_WIDTH), output + size_t(packet) * SIMD_WIDTH * 4);
+    }
+
+    // the taps of the texels past the end of the row are clamped to the image, so the last packet
+    // is filtered in full and only the texels inside the row are copied out
+    const uint32_t tail = count % SIMD_WIDTH;
+    if (tail) {
+        float texels[SIMD_WIDTH * 4];
+        easuPacket(source, rows, fracY, int32_t(packetCount * SIMD_WIDTH), texels);
+        memcpy(output + size_t(packetCount) * SIMD_WIDTH * 4, texels, tail * 4 * sizeof(float));
+    }
+}
+
+FSR2_CPU_TARGET_END
+
+#endif // #if FSR2_CPU_SIMD_X86
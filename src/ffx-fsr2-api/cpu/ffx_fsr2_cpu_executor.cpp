@@ -0,0 +1,188 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ffx_fsr2_cpu_executor.h"
+#include "ffx_fsr2_cpu_simd.h"
+
+// Number of tiles each worker receives per dispatch, higher values give finer grained balancing.
+static const uint32_t FSR2_CPU_TILES_PER_WORKER = 8;
+
+Fsr2CpuExecutor::Fsr2CpuExecutor(uint32_t threadCount)
+    : workerCount(FFX_MAXIMUM(1u, threadCount))
+    , workers(new Worker[FFX_MAXIMUM(1u, threadCount)])
+    , pendingGroups(0)
+    , generation(0)
+    , shutdown(false)
+{
+    // worker 0 is the thread calling dispatch
+    for (uint32_t workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+
+        workers[workerIndex].thread = std::thread(&Fsr2CpuExecutor::workerMain, this, workerIndex);
+    }
+}
+
+Fsr2CpuExecutor::~Fsr2CpuExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        shutdown = true;
+    }
+    wakeCondition.notify_all();
+
+    for (uint32_t workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+
+        workers[workerIndex].thread.join();
+    }
+}
+
+void Fsr2CpuExecutor::dispatch(const Fsr2CpuJob* const* jobs, uint32_t jobCount)
+{
+    uint32_t groupCounts[FSR2_CPU_MAX_DISPATCHED_JOBS];
+    uint32_t tileSizes[FSR2_CPU_MAX_DISPATCHED_JOBS];
+    uint32_t totalGroupCount = 0;
+    uint32_t totalTileCount = 0;
+
+    FFX_ASSERT(jobCount <= FSR2_CPU_MAX_DISPATCHED_JOBS);
+    for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex) {
+
+        const Fsr2CpuJob* job = jobs[jobIndex];
+        groupCounts[jobIndex] = FFX_MAXIMUM(1u, job->dimensions[0]) * FFX_MAXIMUM(1u, job->dimensions[1]) * FFX_MAXIMUM(1u, job->dimensions[2]);
+        tileSizes[jobIndex] = FFX_MAXIMUM(1u, groupCounts[jobIndex] / (workerCount * FSR2_CPU_TILES_PER_WORKER));
+        totalGroupCount += groupCounts[jobIndex];
+        totalTileCount += (groupCounts[jobIndex] + tileSizes[jobIndex] - 1) / tileSizes[jobIndex];
+    }
+
+    if (totalGroupCount == 0) {
+        return;
+    }
+
+    pendingGroups.store(totalGroupCount, std::memory_order_relaxed);
+
+    const uint32_t floatControl = fsr2CpuGetFloatControl();
+
+    // hand each worker a contiguous run of tiles so neighboring groups stay on the same core
+    uint32_t tileIndex = 0;
+    for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex) {
+
+        const uint32_t groupCount = groupCounts[jobIndex];
+        const uint32_t tileSize = tileSizes[jobIndex];
+
+        for (uint32_t firstGroup = 0; firstGroup < groupCount; firstGroup += tileSize, ++tileIndex) {
+
+            const uint32_t workerIndex = uint32_t(uint64_t(tileIndex) * workerCount / totalTileCount);
+            const Tile tile = { jobs[jobIndex], firstGroup, FFX_MINIMUM(groupCount, firstGroup + tileSize), floatControl };
+
+            std::lock_guard<std::mutex> lock(workers[workerIndex].mutex);
+            workers[workerIndex].tiles.push_back(tile);
+        }
+    }
+
+    if (workerCount > 1) {
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            ++generation;
+        }
+        wakeCondition.notify_all();
+    }
+
+    runTiles(0);
+
+    // the last tiles may still be running on other workers
+    while (pendingGroups.load(std::memory_order_acquire) != 0) {
+
+        std::this_thread::yield();
+    }
+}
+
+bool Fsr2CpuExecutor::popTile(uint32_t workerIndex, Tile* outTile)
+{
+    Worker& worker = workers[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tiles.empty()) {
+        return false;
+    }
+
+    *outTile = worker.tiles.front();
+    worker.tiles.pop_front();
+    return true;
+}
+
+bool Fsr2CpuExecutor::stealTile(uint32_t workerIndex, Tile* outTile)
+{
+    // take from the end furthest away from where the owner is working
+    for (uint32_t offset = 1; offset < workerCount; ++offset) {
+
+        Worker& victim = workers[(workerIndex + offset) % workerCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tiles.empty()) {
+
+            *outTile = victim.tiles.back();
+            victim.tiles.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Fsr2CpuExecutor::runTiles(uint32_t workerIndex)
+{
+    void* groupShared = workers[workerIndex].groupShared;
+
+    Tile tile;
+    while (popTile(workerIndex, &tile) || stealTile(workerIndex, &tile)) {
+
+        // tiles carry the control state, a worker may steal from the next dispatch before it is woken up
+        if (fsr2CpuGetFloatControl() != tile.floatControl) {
+            fsr2CpuSetFloatControl(tile.floatControl);
+        }
+
+        const Fsr2CpuJob* job = tile.job;
+        const uint32_t groupCountX = FFX_MAXIMUM(1u, job->dimensions[0]);
+
+        for (uint32_t group = tile.firstGroup; group < tile.lastGroup; ++group) {
+
+            job->pipeline->kernel(job, group % groupCountX, group / groupCountX, groupShared);
+        }
+
+        pendingGroups.fetch_sub(tile.lastGroup - tile.firstGroup, std::memory_order_acq_rel);
+    }
+}
+
+void Fsr2CpuExecutor::workerMain(uint32_t workerIndex)
+{
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait(lock, [&] { return shutdown || generation != seenGeneration; });
+            if (shutdown) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runTiles(workerIndex);
+    }
+}
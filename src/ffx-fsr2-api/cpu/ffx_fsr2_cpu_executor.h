@@ -0,0 +1,115 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Persistent host thread pool executing the thread groups of a compute job.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "ffx_fsr2_cpu_private.h"
+
+// Number of jobs a single dispatch can run together.
+#define FSR2_CPU_MAX_DISPATCHED_JOBS (64)
+
+// Runs the thread groups of the jobs of a backend context, on threads owned by the context
+// (Fsr2CpuExecutor) or shared with other contexts (Fsr2CpuService::Stream).
+class Fsr2CpuScheduler {
+
+public:
+    virtual ~Fsr2CpuScheduler() {}
+
+    // Bracket the dispatches of an execute call, the frame of a shared scheduler.
+    virtual void beginFrame() {}
+    virtual void endFrame() {}
+
+    // Run every thread group of the job and return once all of them completed.
+    void dispatch(const Fsr2CpuJob* job) { dispatch(&job, 1); }
+
+    // Run every thread group of jobCount jobs and return once all of them completed. The groups of
+    // the jobs run in any order, so none of the jobs may read memory another one writes.
+    virtual void dispatch(const Fsr2CpuJob* const* jobs, uint32_t jobCount) = 0;
+};
+
+// Executes the thread groups of Fsr2CpuJobs on a persistent pool of host threads.
+//
+// The groups of a dispatch are cut into tiles of consecutive groups, and the tiles are spread over
+// per-worker deques. Each worker drains its own deque from the front and, once empty, steals tiles
+// from the back of the other workers' deques, so passes with uneven per-group cost or few groups
+// keep every worker busy. The thread calling dispatch takes part as worker 0. Independent jobs can
+// be dispatched together, their tiles then share the deques so the groups of a job with little work
+// fill the gaps left by the others.
+//
+// Every thread group of a dispatch runs with the floating point control state of the thread calling
+// dispatch, so which worker runs a group never changes its results.
+class Fsr2CpuExecutor : public Fsr2CpuScheduler {
+
+public:
+    explicit Fsr2CpuExecutor(uint32_t threadCount);
+    ~Fsr2CpuExecutor();
+
+    Fsr2CpuExecutor(const Fsr2CpuExecutor&) = delete;
+    Fsr2CpuExecutor& operator=(const Fsr2CpuExecutor&) = delete;
+
+    uint32_t getThreadCount() const { return workerCount; }
+
+    using Fsr2CpuScheduler::dispatch;
+    void dispatch(const Fsr2CpuJob* const* jobs, uint32_t jobCount) override;
+
+private:
+    // A range of thread groups [firstGroup, lastGroup) of a job.
+    struct Tile {
+
+        const Fsr2CpuJob*       job;
+        uint32_t                firstGroup;
+        uint32_t                lastGroup;
+        uint32_t                floatControl;
+    };
+
+    struct alignas(64) Worker {
+
+        std::mutex              mutex;
+        std::deque<Tile>        tiles;
+        std::thread             thread;
+
+        // stands in for the groupshared memory of the thread group being executed
+        alignas(64) uint8_t     groupShared[FSR2_CPU_GROUPSHARED_SIZE];
+    };
+
+    bool popTile(uint32_t workerIndex, Tile* outTile);
+    bool stealTile(uint32_t workerIndex, Tile* outTile);
+    void runTiles(uint32_t workerIndex);
+    void workerMain(uint32_t workerIndex);
+
+    uint32_t                    workerCount;
+    std::unique_ptr<Worker[]>   workers;
+
+    std::atomic<uint32_t>       pendingGroups;
+
+    std::mutex                  wakeMutex;
+    std::condition_variable     wakeCondition;
+    uint64_t                    generation;
+    bool                        shutdown;
+};
@@ -0,0 +1,378 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Conversion of texels between the FFX surface formats and 32-bit floats.
+
+#include <cmath>
+#include "ffx_fsr2_cpu_private.h"
+#include "ffx_fsr2_cpu_simd.h"
+
+using namespace fsr2cpu;
+
+static float halfToFloat(uint16_t value)
+{
+    const uint32_t sign = uint32_t(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1fu;
+    const uint32_t mantissa = value & 0x3ffu;
+
+    if (exponent == 0) {
+
+        // zero or denormal
+        const float result = float(mantissa) * (1.0f / 16777216.0f);
+        return sign ? -result : result;
+    }
+
+    if (exponent == 31) {
+
+        return asfloat(sign | 0x7f800000u | (mantissa << 13));
+    }
+
+    return asfloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+// Round-to-nearest-even conversion of a positive float to an unsigned float with a 5 bit exponent and
+// the given number of mantissa bits. Covers the halves of fp16 as well as the 11 and 10 bit floats.
+static uint32_t floatToSmallFloatMagnitude(uint32_t bits, uint32_t mantissaBits, uint32_t maxValue)
+{
+    if (bits >= 0x7f800000u) {
+
+        // infinity or NaN
+        return (31u << mantissaBits) | (bits > 0x7f800000u ? (1u << (mantissaBits - 1)) : 0);
+    }
+
+    if (bits < 0x38800000u) {
+
+        // denormal or zero in the destination format
+        return uint32_t(lrintf(asfloat(bits) * float(1u << (14 + mantissaBits))));
+    }
+
+    const uint32_t shift = 23 - mantissaBits;
+    const uint32_t result = (bits - 0x38000000u + ((1u << (shift - 1)) - 1) + ((bits >> shift) & 1)) >> shift;
+    return result < maxValue ? result : maxValue;
+}
+
+static uint16_t floatToHalf(float value)
+{
+    const uint32_t bits = asuint(value);
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    return uint16_t(sign | floatToSmallFloatMagnitude(bits & 0x7fffffffu, 10, 0x7c00u));
+}
+
+#if FSR2_CPU_SIMD_X86
+static bool hostHasF16C()
+{
+    // every host running the AVX2 kernels has F16C, see detectSimdLevel
+    static const bool f16c = fsr2CpuGetSimdLevel() >= FSR2_CPU_SIMD_LEVEL_AVX2;
+    return f16c;
+}
+#endif // #if FSR2_CPU_SIMD_X86
+
+static void decodeHalves(const uint16_t* value, float* outValue, uint32_t count)
+{
+#if FSR2_CPU_SIMD_X86
+    if (hostHasF16C()) {
+        fsr2CpuDecodeHalvesF16C(value, outValue, count);
+        return;
+    }
+#endif // #if FSR2_CPU_SIMD_X86
+
+    for (uint32_t i = 0; i < count; ++i) outValue[i] = halfToFloat(value[i]);
+}
+
+static void encodeHalves(const float* value, uint16_t* outValue, uint32_t count)
+{
+#if FSR2_CPU_SIMD_X86
+    if (hostHasF16C()) {
+        fsr2CpuEncodeHalvesF16C(value, outValue, count);
+        return;
+    }
+#endif // #if FSR2_CPU_SIMD_X86
+
+    for (uint32_t i = 0; i < count; ++i) outValue[i] = floatToHalf(value[i]);
+}
+
+static float smallFloatToFloat(uint32_t value, uint32_t mantissaBits)
+{
+    const uint32_t exponent = value >> mantissaBits;
+    const uint32_t mantissa = value & ((1u << mantissaBits) - 1);
+
+    if (exponent == 0) {
+
+        return float(mantissa) / float(1u << (14 + mantissaBits));
+    }
+
+    if (exponent == 31) {
+
+        return asfloat(0x7f800000u | (mantissa << (23 - mantissaBits)));
+    }
+
+    return asfloat(((exponent + 112) << 23) | (mantissa << (23 - mantissaBits)));
+}
+
+static uint32_t floatToSmallFloat(float value, uint32_t mantissaBits)
+{
+    // negative values and NaN are stored as zero, overflow clamps to the largest finite value
+    if (!(value > 0.0f)) {
+
+        return 0;
+    }
+
+    const uint32_t maxFinite = (31u << mantissaBits) - 1;
+    const uint32_t result = floatToSmallFloatMagnitude(asuint(value), mantissaBits, maxFinite);
+    return result > maxFinite ? maxFinite : result;
+}
+
+static float unormToFloat(uint32_t value, uint32_t maxValue)
+{
+    return float(value) / float(maxValue);
+}
+
+static uint32_t floatToUnorm(float value, uint32_t maxValue)
+{
+    return uint32_t(saturate(value) * float(maxValue) + 0.5f);
+}
+
+static float snormToFloat(int16_t value)
+{
+    return max(float(value) / 32767.0f, -1.0f);
+}
+
+static int16_t floatToSnorm(float value)
+{
+    const float clamped = value == value ? clamp(value, -1.0f, 1.0f) : 0.0f;
+    return int16_t(clamped >= 0.0f ? clamped * 32767.0f + 0.5f : clamped * 32767.0f - 0.5f);
+}
+
+uint32_t fsr2CpuGetSurfaceFormatSize(FfxSurfaceFormat format)
+{
+    switch (format) {
+
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        return 16;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        return 8;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        return 4;
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16_UINT:
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        return 2;
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+FfxSurfaceFormat fsr2CpuGetInternalStorageFormat(FfxSurfaceFormat format)
+{
+    // Internal surfaces are promoted to 32 bits per component so the passes never pay for conversions,
+    // except for the float formats with a fast path in both directions: fp16 converts with F16C and the
+    // vectorized kernels pack and unpack R11G11B10 a whole packet at once, which is cheaper than the
+    // memory traffic of twice or three times the size.
+#if FSR2_CPU_PACKED_STORAGE
+    if (format == FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT || format == FFX_SURFACE_FORMAT_R11G11B10_FLOAT ||
+        format == FFX_SURFACE_FORMAT_R16G16_FLOAT || format == FFX_SURFACE_FORMAT_R16_FLOAT) {
+        return format;
+    }
+#endif // #if FSR2_CPU_PACKED_STORAGE
+
+    switch (format) {
+
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+        return FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT;
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        return FFX_SURFACE_FORMAT_R32G32_FLOAT;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+    case FFX_SURFACE_FORMAT_R16_UINT:
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        return FFX_SURFACE_FORMAT_R32_UINT;
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+        return FFX_SURFACE_FORMAT_R16G16_UINT;
+    default:
+        return FFX_SURFACE_FORMAT_R32_FLOAT;
+    }
+}
+
+void fsr2CpuDecodeTexel(FfxSurfaceFormat format, const uint8_t* texel, float* outValue)
+{
+    outValue[0] = outValue[1] = outValue[2] = 0.0f;
+    outValue[3] = 1.0f;
+
+    switch (format) {
+
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        memcpy(outValue, texel, 4 * sizeof(float));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT: {
+        decodeHalves(reinterpret_cast<const uint16_t*>(texel), outValue, 4);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM: {
+        const uint16_t* value = reinterpret_cast<const uint16_t*>(texel);
+        for (int32_t i = 0; i < 4; ++i) outValue[i] = unormToFloat(value[i], 0xffffu);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        memcpy(outValue, texel, 2 * sizeof(float));
+        break;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+        outValue[0] = float(*reinterpret_cast<const uint32_t*>(texel));
+        break;
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+        for (int32_t i = 0; i < 4; ++i) outValue[i] = unormToFloat(texel[i], 0xffu);
+        break;
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT: {
+        const uint32_t value = *reinterpret_cast<const uint32_t*>(texel);
+        outValue[0] = smallFloatToFloat(value & 0x7ffu, 6);
+        outValue[1] = smallFloatToFloat((value >> 11) & 0x7ffu, 6);
+        outValue[2] = smallFloatToFloat(value >> 22, 5);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+        decodeHalves(reinterpret_cast<const uint16_t*>(texel), outValue, 2);
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_UINT: {
+        const uint16_t* value = reinterpret_cast<const uint16_t*>(texel);
+        outValue[0] = float(value[0]);
+        outValue[1] = float(value[1]);
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+        decodeHalves(reinterpret_cast<const uint16_t*>(texel), outValue, 1);
+        break;
+    case FFX_SURFACE_FORMAT_R16_UINT:
+        outValue[0] = float(*reinterpret_cast<const uint16_t*>(texel));
+        break;
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+        outValue[0] = unormToFloat(*reinterpret_cast<const uint16_t*>(texel), 0xffffu);
+        break;
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+        outValue[0] = snormToFloat(*reinterpret_cast<const int16_t*>(texel));
+        break;
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+        outValue[0] = unormToFloat(texel[0], 0xffu);
+        break;
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        outValue[0] = float(texel[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        outValue[0] = unormToFloat(texel[0], 0xffu);
+        outValue[1] = unormToFloat(texel[1], 0xffu);
+        break;
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        memcpy(outValue, texel, sizeof(float));
+        break;
+    default:
+        break;
+    }
+}
+
+void fsr2CpuEncodeTexel(FfxSurfaceFormat format, const float* value, uint8_t* outTexel)
+{
+    switch (format) {
+
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        memcpy(outTexel, value, 4 * sizeof(float));
+        break;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+        encodeHalves(value, reinterpret_cast<uint16_t*>(outTexel), 4);
+        break;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM: {
+        uint16_t* texel = reinterpret_cast<uint16_t*>(outTexel);
+        for (int32_t i = 0; i < 4; ++i) texel[i] = uint16_t(floatToUnorm(value[i], 0xffffu));
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        memcpy(outTexel, value, 2 * sizeof(float));
+        break;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+        *reinterpret_cast<uint32_t*>(outTexel) = uint32_t(max(value[0], 0.0f));
+        break;
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+        for (int32_t i = 0; i < 4; ++i) outTexel[i] = uint8_t(floatToUnorm(value[i], 0xffu));
+        break;
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+        *reinterpret_cast<uint32_t*>(outTexel) = floatToSmallFloat(value[0], 6) | (floatToSmallFloat(value[1], 6) << 11) | (floatToSmallFloat(value[2], 5) << 22);
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+        encodeHalves(value, reinterpret_cast<uint16_t*>(outTexel), 2);
+        break;
+    case FFX_SURFACE_FORMAT_R16G16_UINT: {
+        uint16_t* texel = reinterpret_cast<uint16_t*>(outTexel);
+        texel[0] = uint16_t(max(value[0], 0.0f));
+        texel[1] = uint16_t(max(value[1], 0.0f));
+        break;
+    }
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+        encodeHalves(value, reinterpret_cast<uint16_t*>(outTexel), 1);
+        break;
+    case FFX_SURFACE_FORMAT_R16_UINT:
+        *reinterpret_cast<uint16_t*>(outTexel) = uint16_t(max(value[0], 0.0f));
+        break;
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+        *reinterpret_cast<uint16_t*>(outTexel) = uint16_t(floatToUnorm(value[0], 0xffffu));
+        break;
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+        *reinterpret_cast<int16_t*>(outTexel) = floatToSnorm(value[0]);
+        break;
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+        outTexel[0] = uint8_t(floatToUnorm(value[0], 0xffu));
+        break;
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        outTexel[0] = uint8_t(max(value[0], 0.0f));
+        break;
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        outTexel[0] = uint8_t(floatToUnorm(value[0], 0xffu));
+        outTexel[1] = uint8_t(floatToUnorm(value[1], 0xffu));
+        break;
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        memcpy(outTexel, value, sizeof(float));
+        break;
+    default:
+        break;
+    }
+}
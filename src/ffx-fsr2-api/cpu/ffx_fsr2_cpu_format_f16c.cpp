@@ -0,0 +1,110 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// F16C conversions of the fp16 texel channels, used by fsr2CpuDecodeTexel and fsr2CpuEncodeTexel
+// when the host supports them.
+
+#include "ffx_fsr2_cpu_simd.h"
+
+#if FSR2_CPU_SIMD_X86
+
+#include <immintrin.h>
+
+FSR2_CPU_TARGET_BEGIN_AVX2
+
+// Only the count channels of a texel are accessed, a single texel may end its allocation.
+static __m128i loadHalves(const uint16_t* value, uint32_t count)
+{
+    switch (count) {
+
+        case 4:
+            return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(value));
+        case 2: {
+            uint32_t bits;
+            memcpy(&bits, value, sizeof(bits));
+            return _mm_cvtsi32_si128(int32_t(bits));
+        }
+        default:
+            return _mm_cvtsi32_si128(value[0]);
+    }
+}
+
+void fsr2CpuDecodeHalvesF16C(const uint16_t* value, float* outValue, uint32_t count)
+{
+    FFX_ASSERT(count == 1 || count == 2 || count == 4);
+
+    const __m128 result = _mm_cvtph_ps(loadHalves(value, count));
+
+    switch (count) {
+
+        case 4:
+            _mm_storeu_ps(outValue, result);
+            break;
+        case 2:
+            _mm_storel_pi(reinterpret_cast<__m64*>(outValue), result);
+            break;
+        default:
+            _mm_store_ss(outValue, result);
+            break;
+    }
+}
+
+void fsr2CpuEncodeHalvesF16C(const float* value, uint16_t* outValue, uint32_t count)
+{
+    FFX_ASSERT(count == 1 || count == 2 || count == 4);
+
+    __m128 channels;
+    switch (count) {
+
+        case 4:
+            channels = _mm_loadu_ps(value);
+            break;
+        case 2:
+            channels = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(value)));
+            break;
+        default:
+            channels = _mm_load_ss(value);
+            break;
+    }
+
+    // round to nearest even like the scalar conversion, overflow becomes infinity
+    const __m128i result = _mm_cvtps_ph(channels, _MM_FROUND_TO_NEAREST_INT);
+
+    switch (count) {
+
+        case 4:
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(outValue), result);
+            break;
+        case 2: {
+            const uint32_t bits = uint32_t(_mm_cvtsi128_si32(result));
+            memcpy(outValue, &bits, sizeof(bits));
+            break;
+        }
+        default:
+            outValue[0] = uint16_t(_mm_cvtsi128_si32(result));
+            break;
+    }
+}
+
+FSR2_CPU_TARGET_END
+
+#endif // #if FSR2_CPU_SIMD_X86
@@ -0,0 +1,162 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_lock_pass.hlsl.
+
+#include "ffx_fsr2_cpu_common.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+struct LockPass : PassContext {
+
+    const Fsr2CpuSurface& lockInputLuma;
+    const Fsr2CpuSurface& newLocks;
+    const Fsr2CpuSurface& reconstructedPreviousNearestDepth;
+    const Fsr2CpuTile*    lockInputLumaTile;
+
+    LockPass(const Fsr2CpuJob* job, const Fsr2CpuTile* lockInputLumaTile_)
+        : PassContext(job)
+        , lockInputLuma(job->srvs[FSR2_CPU_LOCK_SRV_LOCK_INPUT_LUMA])
+        , newLocks(job->uavs[FSR2_CPU_LOCK_UAV_NEW_LOCKS])
+        , reconstructedPreviousNearestDepth(job->uavs[FSR2_CPU_LOCK_UAV_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH])
+        , lockInputLumaTile(lockInputLumaTile_)
+    {
+    }
+
+    float loadLockInputLuma(int2 pos) const
+    {
+        return lockInputLumaTile ? fsr2CpuTileTexel(*lockInputLumaTile, pos) : fsr2CpuLoad(lockInputLuma, pos).x;
+    }
+
+    void clearResourcesForNextFrame(int2 pxPos) const
+    {
+        if (pxPos.x < renderSize().x && pxPos.y < renderSize().y) {
+
+            const uint32_t farZ = invertedDepth() ? 0x0 : 0x3f800000;
+            fsr2CpuStoreUint(reconstructedPreviousNearestDepth, pxPos.x, pxPos.y, farZ);
+        }
+    }
+
+    bool computeThinFeatureConfidence(int2 pos) const
+    {
+        const float nucleus = loadLockInputLuma(pos);
+
+        const float similarThreshold = 1.05f;
+        float dissimilarLumaMin = FSR2_FLT_MAX;
+        float dissimilarLumaMax = 0.0f;
+
+        /*
+         0 1 2
+         3 4 5
+         6 7 8
+        */
+        uint32_t mask = 1u << 4; // flag nucleus as similar
+
+        static const uint32_t rejectionMasks[4] = {
+            (1u << 0) | (1u << 1) | (1u << 3) | (1u << 4), // Upper left
+            (1u << 1) | (1u << 2) | (1u << 4) | (1u << 5), // Upper right
+            (1u << 3) | (1u << 4) | (1u << 6) | (1u << 7), // Lower left
+            (1u << 4) | (1u << 5) | (1u << 7) | (1u << 8), // Lower right
+        };
+
+        int32_t idx = 0;
+        for (int32_t y = -1; y <= 1; y++) {
+            for (int32_t x = -1; x <= 1; x++, idx++) {
+
+                if (x == 0 && y == 0) {
+                    continue;
+                }
+
+                const int2 samplePos = clampLoad(pos, int2(x, y), renderSize());
+
+                const float sampleLuma = loadLockInputLuma(samplePos);
+                const float difference = max(sampleLuma, nucleus) / min(sampleLuma, nucleus);
+
+                if (difference > 0.0f && (difference < similarThreshold)) {
+                    mask |= 1u << idx;
+                } else {
+                    dissimilarLumaMin = min(dissimilarLumaMin, sampleLuma);
+                    dissimilarLumaMax = max(dissimilarLumaMax, sampleLuma);
+                }
+            }
+        }
+
+        const bool isRidge = nucleus > dissimilarLumaMax || nucleus < dissimilarLumaMin;
+        if (!isRidge) {
+            return false;
+        }
+
+        for (int32_t i = 0; i < 4; i++) {
+            if ((mask & rejectionMasks[i]) == rejectionMasks[i]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void computeLock(int2 pxLrPos) const
+    {
+        if (computeThinFeatureConfidence(pxLrPos)) {
+            fsr2CpuStore(newLocks, computeHrPosFromLrPos(pxLrPos), float4(1.0f));
+        }
+
+        // in the fused pre-pass other tiles may still read the reconstructed depth
+        if (!lockInputLumaTile) {
+            clearResourcesForNextFrame(pxLrPos);
+        }
+    }
+};
+
+} // namespace
+
+void fsr2CpuLockKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    fsr2CpuLockRegion(job, int2(int32_t(groupX * 8), int32_t(groupY * 8)), int2(8, 8), NULL);
+}
+
+void fsr2CpuLockRegion(const Fsr2CpuJob* job, int2 origin, int2 size, const Fsr2CpuTile* lockInputLuma)
+{
+    const LockPass pass(job, lockInputLuma);
+
+    for (int32_t y = 0; y < size.y; ++y) {
+        for (int32_t x = 0; x < size.x; ++x) {
+
+            pass.computeLock(origin + int2(x, y));
+        }
+    }
+}
+
+void fsr2CpuLockClearRegion(const Fsr2CpuJob* job, int2 origin, int2 size)
+{
+    const LockPass pass(job, NULL);
+
+    for (int32_t y = 0; y < size.y; ++y) {
+        for (int32_t x = 0; x < size.x; ++x) {
+
+            pass.clearResourcesForNextFrame(origin + int2(x, y));
+        }
+    }
+}
@@ -0,0 +1,165 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_compute_luminance_pyramid_pass.hlsl as a two level reduction. Each thread group
+// reduces a 64x64 tile of the input to a single texel of mip 5, then the resolve of the pass reduces
+// mip 5 down to 1x1 once every group completed. Unlike the single pass downsampler of ffx_spd.h, no
+// global atomic counter is needed to elect the group finishing the pyramid, and only the mips read
+// later on are written: the shading change mip, mip 5 between both levels and the exposure.
+
+#include "ffx_fsr2_cpu_common.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+// Number of mips a single thread group reduces its 64x64 tile through.
+static const uint32_t SPD_TILE_MIP_COUNT = 6;
+
+struct LuminancePyramidPass : PassContext {
+
+    const Fsr2SpdConstants& spd;
+    const Fsr2CpuSurface&   inputColor;
+    const Fsr2CpuSurface&   imgMipShadingChange;
+    const Fsr2CpuSurface&   imgMip5;
+    const Fsr2CpuSurface&   autoExposure;
+
+    explicit LuminancePyramidPass(const Fsr2CpuJob* job)
+        : PassContext(job)
+        , spd(*reinterpret_cast<const Fsr2SpdConstants*>(job->cbs[1]))
+        , inputColor(job->srvs[FSR2_CPU_LUMINANCE_PYRAMID_SRV_INPUT_COLOR])
+        , imgMipShadingChange(job->uavs[FSR2_CPU_LUMINANCE_PYRAMID_UAV_MIP_SHADING_CHANGE])
+        , imgMip5(job->uavs[FSR2_CPU_LUMINANCE_PYRAMID_UAV_MIP_5])
+        , autoExposure(job->uavs[FSR2_CPU_LUMINANCE_PYRAMID_UAV_AUTO_EXPOSURE])
+    {
+    }
+
+    float loadSourceImage(int2 tex) const
+    {
+        float2 uv = (toFloat(tex) + 0.5f + jitter()) / toFloat(renderSize());
+        uv = clampUv(uv, renderSize(), inputColorResourceDimensions());
+        float3 rgb = fsr2CpuSampleLinearClamp(inputColor, uv).xyz();
+
+        rgb = rgb / constants.preExposure;
+
+        // compute log luma
+        const float logLuma = logf(max(FSR2_EPSILON, rgbToLuma(rgb)));
+
+        // Make sure out of screen pixels contribute no value to the end result
+        return (tex.x < renderSize().x && tex.y < renderSize().y) ? logLuma : 0.0f;
+    }
+
+    void store(int2 pix, float value, uint32_t index) const
+    {
+        if (index == uint32_t(constants.lumaMipLevelToUse)) {
+            fsr2CpuStore(imgMipShadingChange, pix, float4(value));
+        } else if (index == 5) {
+            fsr2CpuStore(imgMip5, pix, float4(value));
+        }
+
+        if (index == spd.mips - 1) {
+            // accumulate on 1x1 level
+            if (pix.x == 0 && pix.y == 0) {
+
+                const float prev = fsr2CpuLoad(autoExposure, 0, 0).y;
+                float result = value;
+
+                if (prev < FSR2_RESET_AUTO_EXPOSURE_AVERAGE_SMOOTHING) {
+                    // Compare Lavg, so small or negative values
+                    const float rate = 1.0f;
+                    result = prev + (result - prev) * (1.0f - expf(-constants.deltaTime * rate));
+                }
+
+                fsr2CpuStore(autoExposure, 0, 0, float4(computeAutoExposureFromLavg(result), result, 0.0f, 0.0f));
+            }
+        }
+    }
+
+    // Reduce a size x size level held in values (stride 64) in place, storing mips firstIndex onwards.
+    void reduce(float* values, uint32_t size, int2 tileOrigin, uint32_t firstIndex) const
+    {
+        for (uint32_t index = firstIndex; size > 1 && index < spd.mips; ++index) {
+
+            size /= 2;
+            for (uint32_t y = 0; y < size; ++y) {
+                for (uint32_t x = 0; x < size; ++x) {
+
+                    const float v0 = values[(2 * y + 0) * 64 + 2 * x + 0];
+                    const float v1 = values[(2 * y + 0) * 64 + 2 * x + 1];
+                    const float v2 = values[(2 * y + 1) * 64 + 2 * x + 0];
+                    const float v3 = values[(2 * y + 1) * 64 + 2 * x + 1];
+                    const float v = (v0 + v1 + v2 + v3) * 0.25f;
+
+                    values[y * 64 + x] = v;
+                    store(int2(tileOrigin.x * int32_t(size) + int32_t(x), tileOrigin.y * int32_t(size) + int32_t(y)), v, index);
+                }
+            }
+        }
+    }
+
+    // values is the groupshared intermediate storage of SPD, 64x64 texels.
+    void downsampleTile(int2 workGroupId, float* values) const
+    {
+        for (int32_t y = 0; y < 64; ++y) {
+            for (int32_t x = 0; x < 64; ++x) {
+                values[y * 64 + x] = loadSourceImage(int2(workGroupId.x * 64 + x, workGroupId.y * 64 + y));
+            }
+        }
+
+        reduce(values, 64, workGroupId, 0);
+    }
+
+    // After mip 5 there is only a single 64x64 region left to downsample.
+    void downsampleMip5(float* values) const
+    {
+        for (int32_t y = 0; y < 64; ++y) {
+            for (int32_t x = 0; x < 64; ++x) {
+                values[y * 64 + x] = fsr2CpuLoad(imgMip5, x, y).x;
+            }
+        }
+
+        reduce(values, 64, int2(0, 0), SPD_TILE_MIP_COUNT);
+    }
+};
+
+} // namespace
+
+void fsr2CpuComputeLuminancePyramidKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_STATIC_ASSERT(sizeof(float) * 64 * 64 <= FSR2_CPU_GROUPSHARED_SIZE);
+
+    const LuminancePyramidPass pass(job);
+
+    pass.downsampleTile(int2(int32_t(groupX + pass.spd.workGroupOffset[0]), int32_t(groupY + pass.spd.workGroupOffset[1])), static_cast<float*>(groupShared));
+}
+
+void fsr2CpuComputeLuminancePyramidResolve(const Fsr2CpuJob* job)
+{
+    const LuminancePyramidPass pass(job);
+
+    // a single group already reduced the input down to 1x1
+    if (pass.spd.mips <= SPD_TILE_MIP_COUNT) {
+        return;
+    }
+
+    float values[64 * 64];
+    pass.downsampleMip5(values);
+}
@@ -0,0 +1,129 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Small HLSL-like vector helpers used by the host ports of the FSR2 passes.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace fsr2cpu {
+
+struct float2 {
+    float x, y;
+    float2() : x(0.0f), y(0.0f) {}
+    float2(float v) : x(v), y(v) {}
+    float2(float x_, float y_) : x(x_), y(y_) {}
+    float&       operator[](int i)       { return (&x)[i]; }
+    const float& operator[](int i) const { return (&x)[i]; }
+};
+
+struct float3 {
+    float x, y, z;
+    float3() : x(0.0f), y(0.0f), z(0.0f) {}
+    float3(float v) : x(v), y(v), z(v) {}
+    float3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+    float&       operator[](int i)       { return (&x)[i]; }
+    const float& operator[](int i) const { return (&x)[i]; }
+};
+
+struct float4 {
+    float x, y, z, w;
+    float4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+    float4(float v) : x(v), y(v), z(v), w(v) {}
+    float4(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+    float4(const float3& v, float w_) : x(v.x), y(v.y), z(v.z), w(w_) {}
+    float3       xyz() const { return float3(x, y, z); }
+    float2       xy() const { return float2(x, y); }
+    float&       operator[](int i)       { return (&x)[i]; }
+    const float& operator[](int i) const { return (&x)[i]; }
+};
+
+struct int2 {
+    int32_t x, y;
+    int2() : x(0), y(0) {}
+    int2(int32_t x_, int32_t y_) : x(x_), y(y_) {}
+};
+
+#define FSR2_CPU_VECTOR_OPERATORS(T, N)                                                                                 \
+    inline T operator+(const T& a, const T& b) { T r; for (int i = 0; i < N; ++i) r[i] = a[i] + b[i]; return r; }     \
+    inline T operator-(const T& a, const T& b) { T r; for (int i = 0; i < N; ++i) r[i] = a[i] - b[i]; return r; }     \
+    inline T operator*(const T& a, const T& b) { T r; for (int i = 0; i < N; ++i) r[i] = a[i] * b[i]; return r; }     \
+    inline T operator/(const T& a, const T& b) { T r; for (int i = 0; i < N; ++i) r[i] = a[i] / b[i]; return r; }     \
+    inline T operator*(const T& a, float b)    { T r; for (int i = 0; i < N; ++i) r[i] = a[i] * b; return r; }        \
+    inline T operator*(float a, const T& b)    { T r; for (int i = 0; i < N; ++i) r[i] = a * b[i]; return r; }        \
+    inline T operator/(const T& a, float b)    { T r; for (int i = 0; i < N; ++i) r[i] = a[i] / b; return r; }        \
+    inline T operator+(const T& a, float b)    { T r; for (int i = 0; i < N; ++i) r[i] = a[i] + b; return r; }        \
+    inline T operator-(const T& a, float b)    { T r; for (int i = 0; i < N; ++i) r[i] = a[i] - b; return r; }        \
+    inline T operator-(const T& a)             { T r; for (int i = 0; i < N; ++i) r[i] = -a[i]; return r; }           \
+    inline T& operator+=(T& a, const T& b)     { a = a + b; return a; }                                                \
+    inline T& operator-=(T& a, const T& b)     { a = a - b; return a; }                                                \
+    inline T& operator*=(T& a, const T& b)     { a = a * b; return a; }                                                \
+    inline T& operator*=(T& a, float b)        { a = a * b; return a; }                                                \
+    inline T& operator/=(T& a, const T& b)     { a = a / b; return a; }                                                \
+    inline T& operator/=(T& a, float b)        { a = a / b; return a; }                                                \
+    inline float dot(const T& a, const T& b)   { float r = 0.0f; for (int i = 0; i < N; ++i) r += a[i] * b[i]; return r; } \
+    inline float length(const T& a)            { return sqrtf(dot(a, a)); }                                            \
+    inline T abs(const T& a)                   { T r; for (int i = 0; i < N; ++i) r[i] = fabsf(a[i]); return r; }     \
+    inline T floor(const T& a)                 { T r; for (int i = 0; i < N; ++i) r[i] = floorf(a[i]); return r; }    \
+    inline T min(const T& a, const T& b)       { T r; for (int i = 0; i < N; ++i) r[i] = min(a[i], b[i]); return r; } \
+    inline T max(const T& a, const T& b)       { T r; for (int i = 0; i < N; ++i) r[i] = max(a[i], b[i]); return r; } \
+    inline T clamp(const T& v, const T& a, const T& b) { return min(max(v, a), b); }                                   \
+    inline T saturate(const T& a)              { T r; for (int i = 0; i < N; ++i) r[i] = saturate(a[i]); return r; }  \
+    inline T lerp(const T& a, const T& b, float t) { return a + (b - a) * t; }                                        \
+    inline T sqrt(const T& a)                  { T r; for (int i = 0; i < N; ++i) r[i] = sqrtf(a[i]); return r; }     \
+    inline T fract(const T& a)                 { return a - floor(a); }
+
+// Scalar helpers follow the HLSL semantics the passes were written against:
+// min/max return the non-NaN operand and saturate maps NaN to zero.
+inline float min(float a, float b)                  { return fminf(a, b); }
+inline float max(float a, float b)                  { return fmaxf(a, b); }
+inline int32_t min(int32_t a, int32_t b)            { return a < b ? a : b; }
+inline int32_t max(int32_t a, int32_t b)            { return a > b ? a : b; }
+inline float clamp(float v, float a, float b)       { return min(max(v, a), b); }
+inline float saturate(float v)                      { return v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f; }
+inline float lerp(float a, float b, float t)        { return a + (b - a) * t; }
+inline float fract(float v)                         { return v - floorf(v); }
+inline float rcp(float v)                           { return 1.0f / v; }
+inline float sign(float v)                          { return v > 0.0f ? 1.0f : (v < 0.0f ? -1.0f : 0.0f); }
+inline float min3(float a, float b, float c)        { return min(a, min(b, c)); }
+inline float max3(float a, float b, float c)        { return max(a, max(b, c)); }
+
+FSR2_CPU_VECTOR_OPERATORS(float2, 2)
+FSR2_CPU_VECTOR_OPERATORS(float3, 3)
+FSR2_CPU_VECTOR_OPERATORS(float4, 4)
+
+#undef FSR2_CPU_VECTOR_OPERATORS
+
+inline int2 operator+(const int2& a, const int2& b) { return int2(a.x + b.x, a.y + b.y); }
+inline int2 operator-(const int2& a, const int2& b) { return int2(a.x - b.x, a.y - b.y); }
+inline float2 toFloat(const int2& v)                { return float2(float(v.x), float(v.y)); }
+inline int2 toInt(const float2& v)                  { return int2(int32_t(v.x), int32_t(v.y)); }
+
+inline float asfloat(uint32_t v)                    { float f; memcpy(&f, &v, sizeof(f)); return f; }
+inline uint32_t asuint(float v)                     { uint32_t u; memcpy(&u, &v, sizeof(u)); return u; }
+
+inline float3 clamp(const float3& v, float a, float b) { return clamp(v, float3(a), float3(b)); }
+
+} // namespace fsr2cpu
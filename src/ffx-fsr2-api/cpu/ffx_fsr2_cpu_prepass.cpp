@@ -0,0 +1,138 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Fused render resolution pre-pass, running the reconstruct, depth clip and lock passes of a frame
+// in three sweeps instead of three full passes over their intermediate surfaces.
+//
+// 1. Reconstruct and dilate. The reconstructed previous depth is scattered along the motion vectors
+//    to anywhere in the frame, so this sweep completes before any depth clip reads it. Only the
+//    dilated motion vectors, also read by accumulate and the next frame, are stored.
+// 2. Depth clip and lock, tile by tile. Each tile first recomputes the dilated depth and lock input
+//    luma of itself and a one texel halo into groupshared memory, so FSR2_DilatedDepth and
+//    FSR2_LockInputLuma are neither written nor read back.
+// 3. Clear the reconstructed depth for the next frame, which the lock pass does on the GPU, once no
+//    tile reads it anymore.
+
+#include "ffx_fsr2_cpu_common.h"
+#include "ffx_fsr2_cpu_executor.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+// Render resolution texels per side of a sweep 2 tile, and the neighborhood read around them.
+static const int32_t PREPASS_TILE_SIZE = 32;
+static const int32_t PREPASS_HALO = 1;
+static const int32_t PREPASS_HALO_TILE_SIZE = PREPASS_TILE_SIZE + 2 * PREPASS_HALO;
+
+void tileRegion(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, int2& origin, int2& size)
+{
+    const Fsr2CpuFusedPrepass& prepass = *static_cast<const Fsr2CpuFusedPrepass*>(job->cbs[0]);
+
+    origin = int2(int32_t(groupX) * PREPASS_TILE_SIZE, int32_t(groupY) * PREPASS_TILE_SIZE);
+    size = int2(min(PREPASS_TILE_SIZE, prepass.width - origin.x), min(PREPASS_TILE_SIZE, prepass.height - origin.y));
+}
+
+void depthClipAndLockKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_STATIC_ASSERT(sizeof(float) * 2 * PREPASS_HALO_TILE_SIZE * PREPASS_HALO_TILE_SIZE <= FSR2_CPU_GROUPSHARED_SIZE);
+
+    const Fsr2CpuFusedPrepass& prepass = *static_cast<const Fsr2CpuFusedPrepass*>(job->cbs[0]);
+
+    int2 origin, size;
+    tileRegion(job, groupX, groupY, origin, size);
+
+    float* shared = static_cast<float*>(groupShared);
+    const int2 haloOrigin = origin - int2(PREPASS_HALO, PREPASS_HALO);
+    const int2 haloSize = size + int2(2 * PREPASS_HALO, 2 * PREPASS_HALO);
+    const Fsr2CpuTile dilatedDepth = { shared, haloOrigin.x, haloOrigin.y, haloSize.x, haloSize.y };
+    const Fsr2CpuTile lockInputLuma = { shared + PREPASS_HALO_TILE_SIZE * PREPASS_HALO_TILE_SIZE, haloOrigin.x, haloOrigin.y, haloSize.x, haloSize.y };
+
+    fsr2CpuDilateRegion(prepass.reconstruct, dilatedDepth, lockInputLuma);
+    fsr2CpuDepthClipRegion(prepass.depthClip, origin, size, &dilatedDepth);
+    fsr2CpuLockRegion(prepass.lock, origin, size, &lockInputLuma);
+}
+
+void clearKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    const Fsr2CpuFusedPrepass& prepass = *static_cast<const Fsr2CpuFusedPrepass*>(job->cbs[0]);
+
+    int2 origin, size;
+    tileRegion(job, groupX, groupY, origin, size);
+
+    fsr2CpuLockClearRegion(prepass.lock, origin, size);
+}
+
+} // namespace
+
+void fsr2CpuSetupFusedPrepass(Fsr2CpuFusedPrepass* prepass, const Fsr2CpuJob* reconstructJob, const Fsr2CpuJob* depthClipJob, const Fsr2CpuJob* lockJob)
+{
+    FFX_ASSERT(reconstructJob->dimensions[0] == depthClipJob->dimensions[0] && reconstructJob->dimensions[0] == lockJob->dimensions[0]);
+    FFX_ASSERT(reconstructJob->dimensions[1] == depthClipJob->dimensions[1] && reconstructJob->dimensions[1] == lockJob->dimensions[1]);
+
+    // the passes run 8x8 thread groups, with one thread per texel
+    prepass->reconstruct = reconstructJob;
+    prepass->depthClip = depthClipJob;
+    prepass->lock = lockJob;
+    prepass->width = int32_t(reconstructJob->dimensions[0] * 8);
+    prepass->height = int32_t(reconstructJob->dimensions[1] * 8);
+
+    // sweep 1
+    prepass->pipelines[0] = *reconstructJob->pipeline;
+    prepass->pipelines[0].kernel = fsr2CpuReconstructPreviousDepthFusedKernel;
+    prepass->pipelines[0].resolve = NULL;
+
+    prepass->sweeps[0] = *reconstructJob;
+    prepass->sweeps[0].pipeline = &prepass->pipelines[0];
+
+    // sweeps 2 and 3 only read the structure
+    Fsr2CpuJob* job = &prepass->sweeps[1];
+    memset(job, 0, sizeof(*job));
+    job->dimensions[0] = uint32_t(prepass->width + PREPASS_TILE_SIZE - 1) / PREPASS_TILE_SIZE;
+    job->dimensions[1] = uint32_t(prepass->height + PREPASS_TILE_SIZE - 1) / PREPASS_TILE_SIZE;
+    job->dimensions[2] = 1;
+    job->cbs[0] = prepass;
+    prepass->sweeps[2] = *job;
+
+    // sweep 2
+    const Fsr2CpuPipeline depthClipAndLockPipeline = { FFX_FSR2_PASS_DEPTH_CLIP, depthClipJob->pipeline->permutationFlags, depthClipAndLockKernel, NULL, depthClipJob->pipeline->deterministic };
+    prepass->pipelines[1] = depthClipAndLockPipeline;
+    prepass->sweeps[1].pipeline = &prepass->pipelines[1];
+
+    // sweep 3
+    const Fsr2CpuPipeline clearPipeline = { FFX_FSR2_PASS_LOCK, lockJob->pipeline->permutationFlags, clearKernel, NULL, lockJob->pipeline->deterministic };
+    prepass->pipelines[2] = clearPipeline;
+    prepass->sweeps[2].pipeline = &prepass->pipelines[2];
+}
+
+void fsr2CpuExecuteFusedPrepass(Fsr2CpuScheduler* executor, const Fsr2CpuJob* reconstructJob, const Fsr2CpuJob* depthClipJob, const Fsr2CpuJob* lockJob)
+{
+    Fsr2CpuFusedPrepass prepass;
+    fsr2CpuSetupFusedPrepass(&prepass, reconstructJob, depthClipJob, lockJob);
+
+    for (uint32_t sweepIndex = 0; sweepIndex < FSR2_CPU_PREPASS_SWEEP_COUNT; ++sweepIndex) {
+
+        executor->dispatch(&prepass.sweeps[sweepIndex]);
+    }
+}
@@ -0,0 +1,424 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Internal structures shared between the CPU backend and the host ports of the FSR2 passes.
+
+#pragma once
+
+#include <atomic>
+#include "../ffx_fsr2.h"
+#include "../ffx_fsr2_private.h"
+#include "ffx_fsr2_cpu_math.h"
+
+#define FSR2_CPU_MAX_MIP_COUNT  (16)
+
+// Size of the scratch block each host thread hands to a kernel in place of groupshared memory.
+// Matches the D3D12 limit of 32KB of groupshared memory per thread group.
+#define FSR2_CPU_GROUPSHARED_SIZE (32 * 1024)
+
+// Permutation options, mirroring the FFX_FSR2_OPTION_* defines of the shader permutations.
+typedef enum Fsr2CpuPermutationFlags {
+
+    FSR2_CPU_PERMUTATION_HDR_COLOR_INPUT            = (1<<0),
+    FSR2_CPU_PERMUTATION_LOW_RESOLUTION_MOTION_VECTORS = (1<<1),
+    FSR2_CPU_PERMUTATION_JITTERED_MOTION_VECTORS    = (1<<2),
+    FSR2_CPU_PERMUTATION_INVERTED_DEPTH             = (1<<3),
+    FSR2_CPU_PERMUTATION_APPLY_SHARPENING           = (1<<4),
+} Fsr2CpuPermutationFlags;
+
+// A view of one mip level of a host surface.
+typedef struct Fsr2CpuSurfaceMip {
+
+    uint8_t*                    data;
+    int32_t                     width;
+    int32_t                     height;
+    size_t                      rowPitch;
+} Fsr2CpuSurfaceMip;
+
+// A host surface as seen by a pass: either a whole resource (SRV) or a resource starting at a given mip (UAV).
+typedef struct Fsr2CpuSurface {
+
+    FfxSurfaceFormat            format;
+    uint32_t                    mipCount;
+    Fsr2CpuSurfaceMip           mips[FSR2_CPU_MAX_MIP_COUNT];
+} Fsr2CpuSurface;
+
+struct Fsr2CpuJob;
+
+// Runs every thread of the thread group (groupX, groupY) of a dispatch. groupShared points to
+// FSR2_CPU_GROUPSHARED_SIZE bytes owned by the calling host thread for the duration of the call.
+typedef void (*Fsr2CpuKernelFunc)(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+
+// Runs once on the dispatching thread after every thread group of a dispatch completed. Passes that
+// reduce over the whole dispatch use it for their last level, instead of electing the last group.
+typedef void (*Fsr2CpuResolveFunc)(const Fsr2CpuJob* job);
+
+// The object backing FfxPipelineState::pipeline for the CPU backend.
+typedef struct Fsr2CpuPipeline {
+
+    FfxFsr2Pass                 pass;
+    uint32_t                    permutationFlags;
+    Fsr2CpuKernelFunc           kernel;
+    Fsr2CpuResolveFunc          resolve;
+
+    // Only the scalar reference paths run, so the output does not depend on the instruction sets of the host.
+    bool                        deterministic;
+} Fsr2CpuPipeline;
+
+// A compute job with all bindings resolved to host surfaces.
+typedef struct Fsr2CpuJob {
+
+    const Fsr2CpuPipeline*      pipeline;
+    uint32_t                    dimensions[3];
+    Fsr2CpuSurface              srvs[FFX_MAX_NUM_SRVS];
+    Fsr2CpuSurface              uavs[FFX_MAX_NUM_UAVS];
+    const void*                 cbs[FFX_MAX_NUM_CONST_BUFFERS];
+} Fsr2CpuJob;
+
+// Binding slots of each pass. The CPU backend reports the bindings to the FSR2 runtime in this order
+// from CreatePipeline, so the runtime hands the resources back to the kernels at these indices.
+enum {
+    FSR2_CPU_ACCUMULATE_SRV_INPUT_EXPOSURE,
+    FSR2_CPU_ACCUMULATE_SRV_DILATED_REACTIVE_MASKS,
+    FSR2_CPU_ACCUMULATE_SRV_MOTION_VECTORS,
+    FSR2_CPU_ACCUMULATE_SRV_INTERNAL_UPSCALED_COLOR,
+    FSR2_CPU_ACCUMULATE_SRV_LOCK_STATUS,
+    FSR2_CPU_ACCUMULATE_SRV_PREPARED_INPUT_COLOR,
+    FSR2_CPU_ACCUMULATE_SRV_LANCZOS_LUT,
+    FSR2_CPU_ACCUMULATE_SRV_UPSAMPLE_MAXIMUM_BIAS_LUT,
+    FSR2_CPU_ACCUMULATE_SRV_IMG_MIPS,
+    FSR2_CPU_ACCUMULATE_SRV_AUTO_EXPOSURE,
+    FSR2_CPU_ACCUMULATE_SRV_LUMA_HISTORY,
+    FSR2_CPU_ACCUMULATE_SRV_COUNT
+};
+enum {
+    FSR2_CPU_ACCUMULATE_UAV_INTERNAL_UPSCALED_COLOR,
+    FSR2_CPU_ACCUMULATE_UAV_LOCK_STATUS,
+    FSR2_CPU_ACCUMULATE_UAV_UPSCALED_OUTPUT,
+    FSR2_CPU_ACCUMULATE_UAV_NEW_LOCKS,
+    FSR2_CPU_ACCUMULATE_UAV_LUMA_HISTORY,
+    FSR2_CPU_ACCUMULATE_UAV_COUNT
+};
+
+enum {
+    FSR2_CPU_AUTOGEN_REACTIVE_SRV_INPUT_OPAQUE_ONLY,
+    FSR2_CPU_AUTOGEN_REACTIVE_SRV_INPUT_COLOR,
+    FSR2_CPU_AUTOGEN_REACTIVE_SRV_COUNT
+};
+enum {
+    FSR2_CPU_AUTOGEN_REACTIVE_UAV_AUTOREACTIVE,
+    FSR2_CPU_AUTOGEN_REACTIVE_UAV_COUNT
+};
+
+enum {
+    FSR2_CPU_LUMINANCE_PYRAMID_SRV_INPUT_COLOR,
+    FSR2_CPU_LUMINANCE_PYRAMID_SRV_COUNT
+};
+enum {
+    FSR2_CPU_LUMINANCE_PYRAMID_UAV_MIP_SHADING_CHANGE,
+    FSR2_CPU_LUMINANCE_PYRAMID_UAV_MIP_5,
+    FSR2_CPU_LUMINANCE_PYRAMID_UAV_AUTO_EXPOSURE,
+    FSR2_CPU_LUMINANCE_PYRAMID_UAV_COUNT
+};
+
+enum {
+    FSR2_CPU_DEPTH_CLIP_SRV_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH,
+    FSR2_CPU_DEPTH_CLIP_SRV_DILATED_MOTION_VECTORS,
+    FSR2_CPU_DEPTH_CLIP_SRV_DILATED_DEPTH,
+    FSR2_CPU_DEPTH_CLIP_SRV_REACTIVE_MASK,
+    FSR2_CPU_DEPTH_CLIP_SRV_TRANSPARENCY_AND_COMPOSITION_MASK,
+    FSR2_CPU_DEPTH_CLIP_SRV_PREVIOUS_DILATED_MOTION_VECTORS,
+    FSR2_CPU_DEPTH_CLIP_SRV_INPUT_MOTION_VECTORS,
+    FSR2_CPU_DEPTH_CLIP_SRV_INPUT_COLOR,
+    FSR2_CPU_DEPTH_CLIP_SRV_INPUT_DEPTH,
+    FSR2_CPU_DEPTH_CLIP_SRV_INPUT_EXPOSURE,
+    FSR2_CPU_DEPTH_CLIP_SRV_COUNT
+};
+enum {
+    FSR2_CPU_DEPTH_CLIP_UAV_DILATED_REACTIVE_MASKS,
+    FSR2_CPU_DEPTH_CLIP_UAV_PREPARED_INPUT_COLOR,
+    FSR2_CPU_DEPTH_CLIP_UAV_COUNT
+};
+
+enum {
+    FSR2_CPU_LOCK_SRV_LOCK_INPUT_LUMA,
+    FSR2_CPU_LOCK_SRV_COUNT
+};
+enum {
+    FSR2_CPU_LOCK_UAV_NEW_LOCKS,
+    FSR2_CPU_LOCK_UAV_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH,
+    FSR2_CPU_LOCK_UAV_COUNT
+};
+
+enum {
+    FSR2_CPU_RCAS_SRV_INPUT_EXPOSURE,
+    FSR2_CPU_RCAS_SRV_RCAS_INPUT,
+    FSR2_CPU_RCAS_SRV_COUNT
+};
+enum {
+    FSR2_CPU_RCAS_UAV_UPSCALED_OUTPUT,
+    FSR2_CPU_RCAS_UAV_COUNT
+};
+
+enum {
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_MOTION_VECTORS,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_DEPTH,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_COLOR,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_EXPOSURE,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_COUNT
+};
+enum {
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_DILATED_MOTION_VECTORS,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_DILATED_DEPTH,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_LOCK_INPUT_LUMA,
+    FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_COUNT
+};
+
+enum {
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_INPUT_OPAQUE_ONLY,
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_INPUT_COLOR,
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_INPUT_MOTION_VECTORS,
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_PREV_PRE_ALPHA_COLOR,
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_PREV_POST_ALPHA_COLOR,
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_REACTIVE_MASK,
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_TRANSPARENCY_AND_COMPOSITION_MASK,
+    FSR2_CPU_TCR_AUTOGENERATE_SRV_COUNT
+};
+enum {
+    FSR2_CPU_TCR_AUTOGENERATE_UAV_AUTOREACTIVE,
+    FSR2_CPU_TCR_AUTOGENERATE_UAV_AUTOCOMPOSITION,
+    FSR2_CPU_TCR_AUTOGENERATE_UAV_PREV_PRE_ALPHA_COLOR,
+    FSR2_CPU_TCR_AUTOGENERATE_UAV_PREV_POST_ALPHA_COLOR,
+    FSR2_CPU_TCR_AUTOGENERATE_UAV_COUNT
+};
+
+// Pass kernels, one per FfxFsr2Pass.
+void fsr2CpuDepthClipKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuReconstructPreviousDepthKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuLockKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuAccumulateKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuRcasKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuComputeLuminancePyramidKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuComputeLuminancePyramidResolve(const Fsr2CpuJob* job);
+void fsr2CpuGenerateReactiveKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuTcrAutogenerateKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+
+// Execute the reconstruct, depth clip and lock passes as one fused pre-pass, see ffx_fsr2_cpu_prepass.cpp.
+#ifndef FSR2_CPU_FUSE_PREPASS
+#define FSR2_CPU_FUSE_PREPASS 1
+#endif // #ifndef FSR2_CPU_FUSE_PREPASS
+
+// A single channel region of a render resolution surface kept in groupshared memory instead of the
+// surface, addressed with the coordinates of the surface.
+typedef struct Fsr2CpuTile {
+
+    float*                      data;
+    int32_t                     originX;
+    int32_t                     originY;
+    int32_t                     width;
+    int32_t                     height;
+} Fsr2CpuTile;
+
+inline float& fsr2CpuTileTexel(const Fsr2CpuTile& tile, fsr2cpu::int2 pos)
+{
+    FFX_ASSERT(uint32_t(pos.x - tile.originX) < uint32_t(tile.width) && uint32_t(pos.y - tile.originY) < uint32_t(tile.height));
+    return tile.data[(pos.y - tile.originY) * tile.width + (pos.x - tile.originX)];
+}
+
+class Fsr2CpuScheduler;
+
+// Building blocks of the fused pre-pass, each covering the texels [origin, origin + size).
+// fsr2CpuReconstructPreviousDepthFusedKernel leaves the dilated depth and lock input luma to
+// fsr2CpuDilateRegion, which fills both tiles from the bindings of the reconstruct job. Given the
+// tiles, depth clip and lock read them instead of the surfaces, and lock leaves the clear of the
+// reconstructed depth to fsr2CpuLockClearRegion.
+void fsr2CpuReconstructPreviousDepthFusedKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuDilateRegion(const Fsr2CpuJob* reconstructJob, const Fsr2CpuTile& dilatedDepth, const Fsr2CpuTile& lockInputLuma);
+void fsr2CpuDepthClipRegion(const Fsr2CpuJob* job, fsr2cpu::int2 origin, fsr2cpu::int2 size, const Fsr2CpuTile* dilatedDepth);
+void fsr2CpuLockRegion(const Fsr2CpuJob* job, fsr2cpu::int2 origin, fsr2cpu::int2 size, const Fsr2CpuTile* lockInputLuma);
+void fsr2CpuLockClearRegion(const Fsr2CpuJob* job, fsr2cpu::int2 origin, fsr2cpu::int2 size);
+
+// Number of sweeps of the fused pre-pass, each dispatched once the previous one completed.
+#define FSR2_CPU_PREPASS_SWEEP_COUNT (3)
+
+// The sweeps of the fused pre-pass of a frame, set up by fsr2CpuSetupFusedPrepass. The sweeps point
+// into the structure and to the jobs of the passes, which all have to stay in place until the last
+// sweep completed.
+typedef struct Fsr2CpuFusedPrepass {
+
+    const Fsr2CpuJob*           reconstruct;
+    const Fsr2CpuJob*           depthClip;
+    const Fsr2CpuJob*           lock;
+
+    // texels covered by the dispatches of the passes
+    int32_t                     width;
+    int32_t                     height;
+
+    Fsr2CpuPipeline             pipelines[FSR2_CPU_PREPASS_SWEEP_COUNT];
+    Fsr2CpuJob                  sweeps[FSR2_CPU_PREPASS_SWEEP_COUNT];
+} Fsr2CpuFusedPrepass;
+
+void fsr2CpuSetupFusedPrepass(Fsr2CpuFusedPrepass* prepass, const Fsr2CpuJob* reconstructJob, const Fsr2CpuJob* depthClipJob, const Fsr2CpuJob* lockJob);
+
+// Run the jobs of the reconstruct, depth clip and lock passes of a frame on a scheduler.
+void fsr2CpuExecuteFusedPrepass(Fsr2CpuScheduler* executor, const Fsr2CpuJob* reconstructJob, const Fsr2CpuJob* depthClipJob, const Fsr2CpuJob* lockJob);
+
+// Execute the jobs of an execute call as a graph, running jobs that touch disjoint memory together
+// instead of one after the other, see ExecuteGpuJobsCPU.
+#ifndef FSR2_CPU_PIPELINE_JOBS
+#define FSR2_CPU_PIPELINE_JOBS 1
+#endif // #ifndef FSR2_CPU_PIPELINE_JOBS
+
+// Keep internal fp16 and R11G11B10 surfaces in their own format instead of promoting them to 32-bit
+// floats, see fsr2CpuGetInternalStorageFormat.
+#ifndef FSR2_CPU_PACKED_STORAGE
+#define FSR2_CPU_PACKED_STORAGE 1
+#endif // #ifndef FSR2_CPU_PACKED_STORAGE
+
+// Format helpers.
+uint32_t fsr2CpuGetSurfaceFormatSize(FfxSurfaceFormat format);
+FfxSurfaceFormat fsr2CpuGetInternalStorageFormat(FfxSurfaceFormat format);
+void fsr2CpuDecodeTexel(FfxSurfaceFormat format, const uint8_t* texel, float* outValue);
+void fsr2CpuEncodeTexel(FfxSurfaceFormat format, const float* value, uint8_t* outTexel);
+
+inline uint8_t* fsr2CpuTexelAddress(const Fsr2CpuSurfaceMip& mip, int32_t x, int32_t y, uint32_t texelSize)
+{
+    return mip.data + size_t(y) * mip.rowPitch + size_t(x) * texelSize;
+}
+
+inline bool fsr2CpuIsInside(const Fsr2CpuSurfaceMip& mip, int32_t x, int32_t y)
+{
+    return mip.data && uint32_t(x) < uint32_t(mip.width) && uint32_t(y) < uint32_t(mip.height);
+}
+
+// Typed load from a mip. Out of bounds and unbound loads return zero, as on the GPU.
+inline fsr2cpu::float4 fsr2CpuLoad(const Fsr2CpuSurface& surface, int32_t x, int32_t y, uint32_t mipLevel = 0)
+{
+    fsr2cpu::float4 value;
+    const Fsr2CpuSurfaceMip& mip = surface.mips[mipLevel];
+    if (fsr2CpuIsInside(mip, x, y)) {
+
+        fsr2CpuDecodeTexel(surface.format, fsr2CpuTexelAddress(mip, x, y, fsr2CpuGetSurfaceFormatSize(surface.format)), &value.x);
+    }
+    return value;
+}
+
+inline fsr2cpu::float4 fsr2CpuLoad(const Fsr2CpuSurface& surface, fsr2cpu::int2 pos, uint32_t mipLevel = 0)
+{
+    return fsr2CpuLoad(surface, pos.x, pos.y, mipLevel);
+}
+
+// Typed store to a mip. Out of bounds and unbound stores are dropped, as on the GPU.
+inline void fsr2CpuStore(const Fsr2CpuSurface& surface, int32_t x, int32_t y, const fsr2cpu::float4& value, uint32_t mipLevel = 0)
+{
+    const Fsr2CpuSurfaceMip& mip = surface.mips[mipLevel];
+    if (fsr2CpuIsInside(mip, x, y)) {
+
+        fsr2CpuEncodeTexel(surface.format, &value.x, fsr2CpuTexelAddress(mip, x, y, fsr2CpuGetSurfaceFormatSize(surface.format)));
+    }
+}
+
+inline void fsr2CpuStore(const Fsr2CpuSurface& surface, fsr2cpu::int2 pos, const fsr2cpu::float4& value, uint32_t mipLevel = 0)
+{
+    fsr2CpuStore(surface, pos.x, pos.y, value, mipLevel);
+}
+
+// Raw 32-bit access for R32_UINT surfaces.
+inline uint32_t fsr2CpuLoadUint(const Fsr2CpuSurface& surface, int32_t x, int32_t y)
+{
+    const Fsr2CpuSurfaceMip& mip = surface.mips[0];
+    if (fsr2CpuIsInside(mip, x, y)) {
+
+        return *reinterpret_cast<const uint32_t*>(fsr2CpuTexelAddress(mip, x, y, sizeof(uint32_t)));
+    }
+    return 0;
+}
+
+inline void fsr2CpuStoreUint(const Fsr2CpuSurface& surface, int32_t x, int32_t y, uint32_t value)
+{
+    const Fsr2CpuSurfaceMip& mip = surface.mips[0];
+    if (fsr2CpuIsInside(mip, x, y)) {
+
+        *reinterpret_cast<uint32_t*>(fsr2CpuTexelAddress(mip, x, y, sizeof(uint32_t))) = value;
+    }
+}
+
+inline std::atomic<uint32_t>* fsr2CpuAtomicUint(const Fsr2CpuSurface& surface, int32_t x, int32_t y)
+{
+    FFX_STATIC_ASSERT(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+    const Fsr2CpuSurfaceMip& mip = surface.mips[0];
+    if (fsr2CpuIsInside(mip, x, y)) {
+
+        return reinterpret_cast<std::atomic<uint32_t>*>(fsr2CpuTexelAddress(mip, x, y, sizeof(uint32_t)));
+    }
+    return nullptr;
+}
+
+// Equivalent of InterlockedMin/InterlockedMax on a R32_UINT surface.
+inline void fsr2CpuAtomicMin(const Fsr2CpuSurface& surface, int32_t x, int32_t y, uint32_t value)
+{
+    std::atomic<uint32_t>* target = fsr2CpuAtomicUint(surface, x, y);
+    if (target) {
+
+        uint32_t current = target->load(std::memory_order_relaxed);
+        while (value < current && !target->compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+}
+
+inline void fsr2CpuAtomicMax(const Fsr2CpuSurface& surface, int32_t x, int32_t y, uint32_t value)
+{
+    std::atomic<uint32_t>* target = fsr2CpuAtomicUint(surface, x, y);
+    if (target) {
+
+        uint32_t current = target->load(std::memory_order_relaxed);
+        while (value > current && !target->compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+}
+
+// Equivalent of SampleLevel with a MIN_MAG_MIP_LINEAR / CLAMP sampler at an integer mip level.
+inline fsr2cpu::float4 fsr2CpuSampleLinearClamp(const Fsr2CpuSurface& surface, fsr2cpu::float2 uv, uint32_t mipLevel = 0)
+{
+    const Fsr2CpuSurfaceMip& mip = surface.mips[mipLevel];
+    if (!mip.data) {
+        return fsr2cpu::float4();
+    }
+
+    const float px = uv.x * float(mip.width) - 0.5f;
+    const float py = uv.y * float(mip.height) - 0.5f;
+    const float fx = floorf(px);
+    const float fy = floorf(py);
+    const float wx = fsr2cpu::saturate(px - fx);
+    const float wy = fsr2cpu::saturate(py - fy);
+
+    const int32_t x0 = int32_t(fsr2cpu::clamp(fx, 0.0f, float(mip.width - 1)));
+    const int32_t x1 = int32_t(fsr2cpu::clamp(fx + 1.0f, 0.0f, float(mip.width - 1)));
+    const int32_t y0 = int32_t(fsr2cpu::clamp(fy, 0.0f, float(mip.height - 1)));
+    const int32_t y1 = int32_t(fsr2cpu::clamp(fy + 1.0f, 0.0f, float(mip.height - 1)));
+
+    const fsr2cpu::float4 c00 = fsr2CpuLoad(surface, x0, y0, mipLevel);
+    const fsr2cpu::float4 c10 = fsr2CpuLoad(surface, x1, y0, mipLevel);
+    const fsr2cpu::float4 c01 = fsr2CpuLoad(surface, x0, y1, mipLevel);
+    const fsr2cpu::float4 c11 = fsr2CpuLoad(surface, x1, y1, mipLevel);
+
+    return fsr2cpu::lerp(fsr2cpu::lerp(c00, c10, wx), fsr2cpu::lerp(c01, c11, wx), wy);
+}
@@ -0,0 +1,225 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_rcas_pass.hlsl, i.e. FsrRcasF from ffx_fsr1.h with FSR_RCAS_DENOISE enabled,
+// and ffxFsr2RcasCPU which runs the same filter over a plain RGBA image.
+
+#include "ffx_fsr2_cpu_common.h"
+#include "ffx_fsr2_cpu.h"
+#include "ffx_fsr2_cpu_simd.h"
+#define FFX_CPU
+#include "../shaders/ffx_core.h"
+#include "../shaders/ffx_fsr1.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+// A 16x16 thread group reads a 18x18 neighborhood.
+static const int32_t RCAS_GROUP_SIZE = 16;
+static const int32_t RCAS_TILE_SIZE  = RCAS_GROUP_SIZE + 2;
+
+inline float3 loadRgb(const float* texel)
+{
+    return float3(texel[0], texel[1], texel[2]);
+}
+
+struct RcasPass : PassContext {
+
+    const Fsr2RcasConstants& rcas;
+    const Fsr2CpuSurface&    rcasInput;
+    const Fsr2CpuSurface&    upscaledOutput;
+    float                    exposureValue;
+    Fsr2CpuRcasRowFunc       rcasRow;
+
+    explicit RcasPass(const Fsr2CpuJob* job)
+        : PassContext(job)
+        , rcas(*reinterpret_cast<const Fsr2RcasConstants*>(job->cbs[1]))
+        , rcasInput(job->srvs[FSR2_CPU_RCAS_SRV_RCAS_INPUT])
+        , upscaledOutput(job->uavs[FSR2_CPU_RCAS_UAV_UPSCALED_OUTPUT])
+        , exposureValue(exposure(job->srvs[FSR2_CPU_RCAS_SRV_INPUT_EXPOSURE]))
+        , rcasRow(job->pipeline->deterministic ? fsr2CpuRcasRow : fsr2CpuSelectRcasRow())
+    {
+    }
+
+    // Decode and prepare the input of the whole group once, as every texel is read by up to five threads.
+    // The tile holds RGBA rows so it can be handed to the row filter directly.
+    void loadTile(int2 tileOrigin, float* tile) const
+    {
+        for (int32_t y = 0; y < RCAS_TILE_SIZE; ++y) {
+            for (int32_t x = 0; x < RCAS_TILE_SIZE; ++x) {
+
+                const float3 color = prepareRgb(fsr2CpuLoad(rcasInput, tileOrigin + int2(x, y)).xyz(), exposureValue, constants.preExposure);
+
+                float* texel = &tile[(y * RCAS_TILE_SIZE + x) * 4];
+                texel[0] = color.x;
+                texel[1] = color.y;
+                texel[2] = color.z;
+                texel[3] = 1.0f;
+            }
+        }
+    }
+
+    // Filter the row of the group starting at pos, tileRow being its row in the tile filled by loadTile.
+    void filterRow(int2 pos, const float* tile, int32_t tileRow) const
+    {
+        const float* center = &tile[(tileRow * RCAS_TILE_SIZE + 1) * 4];
+
+        float output[RCAS_GROUP_SIZE * 4];
+        rcasRow(center - RCAS_TILE_SIZE * 4, center, center + RCAS_TILE_SIZE * 4, output, RCAS_GROUP_SIZE, asfloat(rcas.rcasConfig[0]));
+
+        for (int32_t x = 0; x < RCAS_GROUP_SIZE; ++x) {
+
+            const float3 color = unprepareRgb(loadRgb(&output[x * 4]), exposureValue, constants.preExposure);
+            fsr2CpuStore(upscaledOutput, pos + int2(x, 0), float4(color, 1.0f));
+        }
+    }
+};
+
+// Filter a single texel of an image, clamping its neighbours to the edges.
+void rcasClamped(const float* source, float* destination, int32_t x, int32_t y, int32_t width, int32_t height, float lobeScale)
+{
+    const size_t rowSize = size_t(width) * 4;
+    const float* above = source + size_t(max(y - 1, 0)) * rowSize;
+    const float* row = source + size_t(y) * rowSize;
+    const float* below = source + size_t(min(y + 1, height - 1)) * rowSize;
+
+    float center[3 * 4];
+    memcpy(&center[0], row + size_t(max(x - 1, 0)) * 4, 4 * sizeof(float));
+    memcpy(&center[4], row + size_t(x) * 4, 4 * sizeof(float));
+    memcpy(&center[8], row + size_t(min(x + 1, width - 1)) * 4, 4 * sizeof(float));
+
+    fsr2CpuRcasRow(above + size_t(x) * 4, &center[4], below + size_t(x) * 4, destination + size_t(y) * rowSize + size_t(x) * 4, 1, lobeScale);
+}
+
+} // namespace
+
+void fsr2CpuRcasRow(const float* above, const float* center, const float* below, float* output, uint32_t count, float lobeScale)
+{
+    // Limit of the sharpening lobe, see ffx_fsr1.h.
+    const float rcasLimit = float(FSR_RCAS_LIMIT);
+
+    for (uint32_t x = 0; x < count; ++x) {
+
+        // Algorithm uses minimal 3x3 pixel neighborhood.
+        //    b
+        //  d e f
+        //    h
+        const float* e4 = center + x * 4;
+        const float3 b = loadRgb(above + x * 4);
+        const float3 d = loadRgb(e4 - 4);
+        const float3 e = loadRgb(e4);
+        const float3 f = loadRgb(e4 + 4);
+        const float3 h = loadRgb(below + x * 4);
+
+        // Luma times 2.
+        const float bL = b.z * 0.5f + (b.x * 0.5f + b.y);
+        const float dL = d.z * 0.5f + (d.x * 0.5f + d.y);
+        const float eL = e.z * 0.5f + (e.x * 0.5f + e.y);
+        const float fL = f.z * 0.5f + (f.x * 0.5f + f.y);
+        const float hL = h.z * 0.5f + (h.x * 0.5f + h.y);
+
+        // Noise detection.
+        float nz = 0.25f * bL + 0.25f * dL + 0.25f * fL + 0.25f * hL - eL;
+        nz = saturate(fabsf(nz) * rcp(max3(max3(bL, dL, eL), fL, hL) - min3(min3(bL, dL, eL), fL, hL)));
+        nz = -0.5f * nz + 1.0f;
+
+        // Min and max of ring.
+        const float3 mn4 = min(min(min(b, d), f), h);
+        const float3 mx4 = max(max(max(b, d), f), h);
+
+        // Immediate constants for peak range.
+        const float2 peakC = float2(1.0f, -1.0f * 4.0f);
+
+        // Limiters, these need to be high precision RCPs.
+        float3 lobeRgb;
+        for (int32_t channel = 0; channel < 3; ++channel) {
+
+            const float hitMin = mn4[channel] * rcp(4.0f * mx4[channel]);
+            const float hitMax = (peakC.x - mx4[channel]) * rcp(4.0f * mn4[channel] + peakC.y);
+            lobeRgb[channel] = max(-hitMin, hitMax);
+        }
+        float lobe = max(-rcasLimit, min(max3(lobeRgb.x, lobeRgb.y, lobeRgb.z), 0.0f)) * lobeScale;
+
+        // Apply noise removal.
+        lobe *= nz;
+
+        // Resolve, which needs the medium precision rcp approximation to avoid visible tonality changes.
+        const float rcpL = rcp(4.0f * lobe + 1.0f);
+        const float3 color = (b * lobe + d * lobe + h * lobe + f * lobe + e) * rcpL;
+
+        float* texel = output + x * 4;
+        texel[0] = color.x;
+        texel[1] = color.y;
+        texel[2] = color.z;
+        texel[3] = e4[3];
+    }
+}
+
+void fsr2CpuRcasKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_STATIC_ASSERT(sizeof(float) * 4 * RCAS_TILE_SIZE * RCAS_TILE_SIZE <= FSR2_CPU_GROUPSHARED_SIZE);
+
+    const RcasPass pass(job);
+
+    // Each thread group covers a 16x16 region.
+    const int2 groupOrigin = int2(int32_t(groupX) * RCAS_GROUP_SIZE, int32_t(groupY) * RCAS_GROUP_SIZE);
+    float* tile = static_cast<float*>(groupShared);
+    pass.loadTile(groupOrigin - int2(1, 1), tile);
+
+    for (int32_t y = 0; y < RCAS_GROUP_SIZE; ++y) {
+        pass.filterRow(groupOrigin + int2(0, y), tile, y + 1);
+    }
+}
+
+FfxErrorCode ffxFsr2RcasCPU(const float* source, float* destination, uint32_t width, uint32_t height, float sharpness)
+{
+    FFX_RETURN_ON_ERROR(source && destination, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(source != destination, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(width > 0 && height > 0 && width <= INT32_MAX && height <= INT32_MAX, FFX_ERROR_INVALID_ARGUMENT);
+
+    // same mapping of the sharpness as ffxFsr2ContextDispatch
+    FfxUInt32x4 rcasConfig;
+    FsrRcasCon(rcasConfig, (-2.0f * sharpness) + 2.0f);
+    const float lobeScale = asfloat(rcasConfig[0]);
+
+    const Fsr2CpuRcasRowFunc rcasRow = fsr2CpuSelectRcasRow();
+    const size_t rowSize = size_t(width) * 4;
+
+    for (uint32_t y = 0; y < height; ++y) {
+
+        rcasClamped(source, destination, 0, int32_t(y), int32_t(width), int32_t(height), lobeScale);
+
+        // every neighbour of the inner texels is inside the image
+        if (width > 2) {
+            const float* center = source + size_t(y) * rowSize + 4;
+            const float* above = (y > 0) ? center - rowSize : center;
+            const float* below = (y + 1 < height) ? center + rowSize : center;
+            rcasRow(above, center, below, destination + size_t(y) * rowSize + 4, width - 2, lobeScale);
+        }
+
+        if (width > 1) {
+            rcasClamped(source, destination, int32_t(width - 1), int32_t(y), int32_t(width), int32_t(height), lobeScale);
+        }
+    }
+
+    return FFX_OK;
+}
@@ -0,0 +1,154 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// AVX2 build of the RCAS row filter, see fsr2CpuRcasRow in ffx_fsr2_cpu_rcas.cpp for the reference.
+
+#include "ffx_fsr2_cpu_simd.h"
+
+#if FSR2_CPU_SIMD_X86
+
+#include <immintrin.h>
+#include "ffx_fsr2_cpu_common.h"
+
+FSR2_CPU_TARGET_BEGIN_AVX2
+
+#define FSR2_CPU_SIMD_NAMESPACE avx2
+#include "ffx_fsr2_cpu_simd_avx2.h"
+#include "ffx_fsr2_cpu_simd_common.h"
+
+namespace fsr2cpu {
+namespace avx2 {
+
+// Limit of the sharpening lobe, see ffx_fsr1.h.
+static const float FSR_RCAS_LIMIT = 0.25f - (1.0f / 16.0f);
+
+// Deinterleave 8 RGBA texels into one packet per channel. Texels end up in the lane order
+// 0 2 4 6 1 3 5 7, which storeRgba undoes, and every lane wise operation in between ignores.
+inline vfloat4 loadRgba(const float* texels)
+{
+    const __m256 v0 = _mm256_loadu_ps(texels + 0);
+    const __m256 v1 = _mm256_loadu_ps(texels + 8);
+    const __m256 v2 = _mm256_loadu_ps(texels + 16);
+    const __m256 v3 = _mm256_loadu_ps(texels + 24);
+
+    const __m256 rg02 = _mm256_unpacklo_ps(v0, v1);
+    const __m256 rg46 = _mm256_unpacklo_ps(v2, v3);
+    const __m256 ba02 = _mm256_unpackhi_ps(v0, v1);
+    const __m256 ba46 = _mm256_unpackhi_ps(v2, v3);
+
+    return vfloat4(
+        vfloat(_mm256_shuffle_ps(rg02, rg46, _MM_SHUFFLE(1, 0, 1, 0))),
+        vfloat(_mm256_shuffle_ps(rg02, rg46, _MM_SHUFFLE(3, 2, 3, 2))),
+        vfloat(_mm256_shuffle_ps(ba02, ba46, _MM_SHUFFLE(1, 0, 1, 0))),
+        vfloat(_mm256_shuffle_ps(ba02, ba46, _MM_SHUFFLE(3, 2, 3, 2))));
+}
+
+inline void storeRgba(float* texels, const vfloat4& color)
+{
+    const __m256 rg0 = _mm256_unpacklo_ps(color.x.v, color.y.v);
+    const __m256 ba0 = _mm256_unpacklo_ps(color.z.v, color.w.v);
+    const __m256 rg1 = _mm256_unpackhi_ps(color.x.v, color.y.v);
+    const __m256 ba1 = _mm256_unpackhi_ps(color.z.v, color.w.v);
+
+    _mm256_storeu_ps(texels + 0, _mm256_shuffle_ps(rg0, ba0, _MM_SHUFFLE(1, 0, 1, 0)));
+    _mm256_storeu_ps(texels + 8, _mm256_shuffle_ps(rg0, ba0, _MM_SHUFFLE(3, 2, 3, 2)));
+    _mm256_storeu_ps(texels + 16, _mm256_shuffle_ps(rg1, ba1, _MM_SHUFFLE(1, 0, 1, 0)));
+    _mm256_storeu_ps(texels + 24, _mm256_shuffle_ps(rg1, ba1, _MM_SHUFFLE(3, 2, 3, 2)));
+}
+
+inline vfloat luma2(const vfloat4& c)
+{
+    return c.z * 0.5f + (c.x * 0.5f + c.y);
+}
+
+// The limiter of a single channel, mn and mx being the min and max of the ring.
+inline vfloat lobeChannel(vfloat mn, vfloat mx)
+{
+    const vfloat hitMin = mn / (4.0f * mx);
+    const vfloat hitMax = (1.0f - mx) / (4.0f * mn - 4.0f);
+    return max(-hitMin, hitMax);
+}
+
+inline void rcasPacket(const float* above, const float* center, const float* below, float* output, vfloat lobeScale)
+{
+    // Algorithm uses minimal 3x3 pixel neighborhood.
+    //    b
+    //  d e f
+    //    h
+    const vfloat4 b = loadRgba(above);
+    const vfloat4 d = loadRgba(center - 4);
+    const vfloat4 e = loadRgba(center);
+    const vfloat4 f = loadRgba(center + 4);
+    const vfloat4 h = loadRgba(below);
+
+    // Luma times 2.
+    const vfloat bL = luma2(b);
+    const vfloat dL = luma2(d);
+    const vfloat eL = luma2(e);
+    const vfloat fL = luma2(f);
+    const vfloat hL = luma2(h);
+
+    // Noise detection.
+    vfloat nz = 0.25f * bL + 0.25f * dL + 0.25f * fL + 0.25f * hL - eL;
+    const vfloat maxL = max(max(max(bL, dL), max(eL, fL)), hL);
+    const vfloat minL = min(min(min(bL, dL), min(eL, fL)), hL);
+    nz = saturate(abs(nz) / (maxL - minL));
+    nz = -0.5f * nz + 1.0f;
+
+    // Min and max of ring, and the limiters.
+    const vfloat4 mn4 = min(min(min(b, d), f), h);
+    const vfloat4 mx4 = max(max(max(b, d), f), h);
+    const vfloat lobeRgb = max(max(lobeChannel(mn4.x, mx4.x), lobeChannel(mn4.y, mx4.y)), lobeChannel(mn4.z, mx4.z));
+    vfloat lobe = max(vfloat(-FSR_RCAS_LIMIT), min(lobeRgb, vfloat(0.0f))) * lobeScale;
+
+    // Apply noise removal.
+    lobe *= nz;
+
+    // Resolve
+    const vfloat rcpL = 1.0f / (4.0f * lobe + 1.0f);
+    const vfloat4 color(
+        (b.x * lobe + d.x * lobe + h.x * lobe + f.x * lobe + e.x) * rcpL,
+        (b.y * lobe + d.y * lobe + h.y * lobe + f.y * lobe + e.y) * rcpL,
+        (b.z * lobe + d.z * lobe + h.z * lobe + f.z * lobe + e.z) * rcpL,
+        e.w);
+
+    storeRgba(output, color);
+}
+
+} // namespace avx2
+} // namespace fsr2cpu
+
+void fsr2CpuRcasRowAVX2(const float* above, const float* center, const float* below, float* output, uint32_t count, float lobeScale)
+{
+    const uint32_t packetCount = count / fsr2cpu::avx2::SIMD_WIDTH;
+    for (uint32_t packet = 0; packet < packetCount; ++packet) {
+
+        const size_t offset = size_t(packet) * fsr2cpu::avx2::SIMD_WIDTH * 4;
+        fsr2cpu::avx2::rcasPacket(above + offset, center + offset, below + offset, output + offset, lobeScale);
+    }
+
+    const size_t tail = size_t(packetCount) * fsr2cpu::avx2::SIMD_WIDTH * 4;
+    fsr2CpuRcasRow(above + tail, center + tail, below + tail, output + tail, count % fsr2cpu::avx2::SIMD_WIDTH, lobeScale);
+}
+
+FSR2_CPU_TARGET_END
+
+#endif // #if FSR2_CPU_SIMD_X86
@@ -0,0 +1,213 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_reconstruct_previous_depth_pass.hlsl.
+
+#include "ffx_fsr2_cpu_common.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+struct ReconstructPreviousDepthPass : PassContext {
+
+    const Fsr2CpuSurface& inputMotionVectors;
+    const Fsr2CpuSurface& inputDepth;
+    const Fsr2CpuSurface& inputColor;
+    const Fsr2CpuSurface& inputExposure;
+    const Fsr2CpuSurface& reconstructedPreviousNearestDepth;
+    const Fsr2CpuSurface& dilatedMotionVectors;
+    const Fsr2CpuSurface& dilatedDepth;
+    const Fsr2CpuSurface& lockInputLuma;
+
+    explicit ReconstructPreviousDepthPass(const Fsr2CpuJob* job)
+        : PassContext(job)
+        , inputMotionVectors(job->srvs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_MOTION_VECTORS])
+        , inputDepth(job->srvs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_DEPTH])
+        , inputColor(job->srvs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_COLOR])
+        , inputExposure(job->srvs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_SRV_INPUT_EXPOSURE])
+        , reconstructedPreviousNearestDepth(job->uavs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH])
+        , dilatedMotionVectors(job->uavs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_DILATED_MOTION_VECTORS])
+        , dilatedDepth(job->uavs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_DILATED_DEPTH])
+        , lockInputLuma(job->uavs[FSR2_CPU_RECONSTRUCT_PREVIOUS_DEPTH_UAV_LOCK_INPUT_LUMA])
+    {
+    }
+
+    void storeReconstructedDepth(int2 pos, float depth) const
+    {
+        // min for standard, max for inverted depth
+        if (invertedDepth()) {
+            fsr2CpuAtomicMax(reconstructedPreviousNearestDepth, pos.x, pos.y, asuint(depth));
+        } else {
+            fsr2CpuAtomicMin(reconstructedPreviousNearestDepth, pos.x, pos.y, asuint(depth));
+        }
+    }
+
+    void reconstructPrevDepth(int2 pxPos, float depth, float2 motionVector, int2 depthSize) const
+    {
+        motionVector *= float(length(motionVector * toFloat(displaySize())) > 0.1f);
+        const float2 uv = (toFloat(pxPos) + 0.5f) / toFloat(depthSize);
+        const float2 reprojectedUv = uv + motionVector;
+
+        const BilinearSamplingData bilinearInfo = getBilinearSamplingData(reprojectedUv, renderSize());
+
+        // Project current depth into previous frame locations.
+        // Push to all pixels having some contribution if reprojection is using bilinear logic.
+        for (int32_t sampleIndex = 0; sampleIndex < 4; sampleIndex++) {
+
+            if (bilinearInfo.weights[sampleIndex] > FSR2_RECONSTRUCTED_DEPTH_BILINEAR_WEIGHT_THRESHOLD) {
+
+                const int2 storePos = bilinearInfo.basePos + bilinearInfo.offsets[sampleIndex];
+                if (isOnScreen(storePos, depthSize)) {
+                    storeReconstructedDepth(storePos, depth);
+                }
+            }
+        }
+    }
+
+    void findNearestDepth(int2 pxPos, int2 size, float& nearestDepth, int2& nearestDepthCoord) const
+    {
+        static const int2 sampleOffsets[9] = {
+            int2(+0, +0),
+            int2(+1, +0),
+            int2(+0, +1),
+            int2(+0, -1),
+            int2(-1, +0),
+            int2(-1, +1),
+            int2(+1, +1),
+            int2(-1, -1),
+            int2(+1, -1),
+        };
+
+        nearestDepthCoord = pxPos;
+        nearestDepth = fsr2CpuLoad(inputDepth, pxPos).x;
+        for (int32_t sampleIndex = 1; sampleIndex < 9; ++sampleIndex) {
+
+            const int2 pos = pxPos + sampleOffsets[sampleIndex];
+            if (isOnScreen(pos, size)) {
+
+                const float depth = fsr2CpuLoad(inputDepth, pos).x;
+                if (invertedDepth() ? (depth > nearestDepth) : (depth < nearestDepth)) {
+                    nearestDepthCoord = pos;
+                    nearestDepth = depth;
+                }
+            }
+        }
+    }
+
+    float computeLockInputLuma(int2 pxLrPos) const
+    {
+        // We assume linear data. if non-linear input (sRGB, ...),
+        // then we should convert to linear first and back to sRGB on output.
+        float3 rgb = max(float3(0.0f), fsr2CpuLoad(inputColor, pxLrPos).xyz());
+
+        // Use internal auto exposure for locking logic
+        rgb = rgb / constants.preExposure;
+        rgb = rgb * exposure(inputExposure);
+
+        if (hdr()) {
+            rgb = tonemap(rgb);
+        }
+
+        return powf(rgbToPerceivedLuma(rgb), 1.0f / 6.0f);
+    }
+
+    // The fused pre-pass recomputes the dilated depth and lock input luma where they are read,
+    // so storeIntermediates is only set when the surfaces are consumed by separate passes.
+    void reconstructAndDilate(int2 pxLrPos, bool storeIntermediates) const
+    {
+        float dilatedDepthValue;
+        int2 nearestDepthCoord;
+        findNearestDepth(pxLrPos, renderSize(), dilatedDepthValue, nearestDepthCoord);
+
+        const int2 motionVectorPos = lowResMotionVectors() ? nearestDepthCoord : computeHrPosFromLrPos(nearestDepthCoord);
+        const float2 dilatedMotionVector = loadInputMotionVector(inputMotionVectors, motionVectorPos);
+
+        if (storeIntermediates) {
+            fsr2CpuStore(dilatedDepth, pxLrPos, float4(dilatedDepthValue));
+        }
+        fsr2CpuStore(dilatedMotionVectors, pxLrPos, float4(dilatedMotionVector.x, dilatedMotionVector.y, 0.0f, 0.0f));
+
+        reconstructPrevDepth(pxLrPos, dilatedDepthValue, dilatedMotionVector, renderSize());
+
+        if (storeIntermediates) {
+            fsr2CpuStore(lockInputLuma, pxLrPos, float4(computeLockInputLuma(pxLrPos)));
+        }
+    }
+
+    // Fill the tiles with the values reconstructAndDilate stores, texels outside the surfaces read as zero.
+    void dilate(const Fsr2CpuTile& dilatedDepthTile, const Fsr2CpuTile& lockInputLumaTile) const
+    {
+        for (int32_t y = 0; y < dilatedDepthTile.height; ++y) {
+            for (int32_t x = 0; x < dilatedDepthTile.width; ++x) {
+
+                const int2 pxLrPos = int2(dilatedDepthTile.originX + x, dilatedDepthTile.originY + y);
+
+                float dilatedDepthValue = 0.0f;
+                if (fsr2CpuIsInside(dilatedDepth.mips[0], pxLrPos.x, pxLrPos.y)) {
+                    int2 nearestDepthCoord;
+                    findNearestDepth(pxLrPos, renderSize(), dilatedDepthValue, nearestDepthCoord);
+                }
+                fsr2CpuTileTexel(dilatedDepthTile, pxLrPos) = dilatedDepthValue;
+
+                const bool lumaInside = fsr2CpuIsInside(lockInputLuma.mips[0], pxLrPos.x, pxLrPos.y);
+                fsr2CpuTileTexel(lockInputLumaTile, pxLrPos) = lumaInside ? computeLockInputLuma(pxLrPos) : 0.0f;
+            }
+        }
+    }
+};
+
+void reconstructGroup(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, bool storeIntermediates)
+{
+    const ReconstructPreviousDepthPass pass(job);
+
+    for (int32_t threadY = 0; threadY < 8; ++threadY) {
+        for (int32_t threadX = 0; threadX < 8; ++threadX) {
+
+            pass.reconstructAndDilate(int2(int32_t(groupX * 8) + threadX, int32_t(groupY * 8) + threadY), storeIntermediates);
+        }
+    }
+}
+
+} // namespace
+
+void fsr2CpuReconstructPreviousDepthKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    reconstructGroup(job, groupX, groupY, true);
+}
+
+void fsr2CpuReconstructPreviousDepthFusedKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    reconstructGroup(job, groupX, groupY, false);
+}
+
+void fsr2CpuDilateRegion(const Fsr2CpuJob* reconstructJob, const Fsr2CpuTile& dilatedDepth, const Fsr2CpuTile& lockInputLuma)
+{
+    FFX_ASSERT(dilatedDepth.originX == lockInputLuma.originX && dilatedDepth.width == lockInputLuma.width);
+    FFX_ASSERT(dilatedDepth.originY == lockInputLuma.originY && dilatedDepth.height == lockInputLuma.height);
+
+    const ReconstructPreviousDepthPass pass(reconstructJob);
+    pass.dilate(dilatedDepth, lockInputLuma);
+}
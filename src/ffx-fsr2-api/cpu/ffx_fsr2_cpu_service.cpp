@@ -0,0 +1,290 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <algorithm>
+#include "ffx_fsr2_cpu_service.h"
+#include "ffx_fsr2_cpu_simd.h"
+
+// Number of tiles each worker receives per dispatch, as in the executor.
+static const uint32_t FSR2_CPU_SERVICE_TILES_PER_WORKER = 8;
+
+// Share of the budget of a frame left when its dispatches become urgent.
+static const uint32_t FSR2_CPU_SERVICE_URGENT_FRACTION = 4;
+
+Fsr2CpuService::Stream::Stream(Fsr2CpuService* service, uint32_t weight, uint32_t frameBudgetMicroseconds)
+    : service(service)
+    , weight(double(FFX_MAXIMUM(1u, weight)))
+    , frameBudget(std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds(frameBudgetMicroseconds)))
+    , hasDeadline(false)
+    , finishTag(0.0)
+{
+}
+
+void Fsr2CpuService::Stream::beginFrame()
+{
+    // the budget includes the time spent waiting for admission
+    hasDeadline = frameBudget.count() > 0;
+    deadline = Clock::now() + frameBudget;
+
+    std::unique_lock<std::mutex> lock(service->mutex);
+    const uint64_t ticket = service->nextTicket++;
+    service->admitCondition.wait(lock, [&] {
+        return ticket == service->admittedTicket && service->activeFrameCount < service->maximumActiveFrameCount;
+    });
+
+    service->admittedTicket++;
+    service->activeFrameCount++;
+
+    // the next ticket may be admitted as well
+    service->admitCondition.notify_all();
+}
+
+void Fsr2CpuService::Stream::endFrame()
+{
+    std::lock_guard<std::mutex> lock(service->mutex);
+    FFX_ASSERT(service->activeFrameCount > 0);
+
+    service->activeFrameCount--;
+    service->completedFrameCount++;
+    if (hasDeadline && Clock::now() > deadline) {
+        service->missedDeadlineCount++;
+    }
+
+    service->admitCondition.notify_all();
+}
+
+void Fsr2CpuService::Stream::dispatch(const Fsr2CpuJob* const* jobs, uint32_t jobCount)
+{
+    FFX_ASSERT(jobCount <= FSR2_CPU_MAX_DISPATCHED_JOBS);
+
+    uint32_t groupCount = 0;
+    for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex) {
+
+        groupCount += FFX_MAXIMUM(1u, jobs[jobIndex]->dimensions[0]) * FFX_MAXIMUM(1u, jobs[jobIndex]->dimensions[1]) * FFX_MAXIMUM(1u, jobs[jobIndex]->dimensions[2]);
+    }
+
+    if (groupCount == 0) {
+        return;
+    }
+
+    Request request;
+    request.stream = this;
+    request.jobs = jobs;
+    request.jobCount = jobCount;
+    request.jobIndex = 0;
+    request.nextGroup = 0;
+    request.pendingGroups = groupCount;
+    request.floatControl = fsr2CpuGetFloatControl();
+
+    std::unique_lock<std::mutex> lock(service->mutex);
+
+    // the thread groups stand in for the cost of the dispatch
+    request.startTag = std::max(service->virtualTime, finishTag);
+    request.finishTag = request.startTag + double(groupCount) / weight;
+    finishTag = request.finishTag;
+
+    service->requests.push_back(&request);
+    service->workCondition.notify_all();
+
+    service->doneCondition.wait(lock, [&] { return request.pendingGroups == 0; });
+}
+
+Fsr2CpuService::Fsr2CpuService(uint32_t threadCount, uint32_t maximumActiveFrameCount)
+    : workerCount(FFX_MAXIMUM(1u, threadCount))
+    , workers(new Worker[FFX_MAXIMUM(1u, threadCount)])
+    , shutdown(false)
+    , virtualTime(0.0)
+    , streamCount(0)
+    , maximumActiveFrameCount(maximumActiveFrameCount ? maximumActiveFrameCount : UINT32_MAX)
+    , activeFrameCount(0)
+    , nextTicket(0)
+    , admittedTicket(0)
+    , completedFrameCount(0)
+    , missedDeadlineCount(0)
+{
+    // unlike the executor, the threads calling dispatch do not run thread groups
+    for (uint32_t workerIndex = 0; workerIndex < workerCount; ++workerIndex) {
+
+        workers[workerIndex].thread = std::thread(&Fsr2CpuService::workerMain, this, workerIndex);
+    }
+}
+
+Fsr2CpuService::~Fsr2CpuService()
+{
+    FFX_ASSERT(streamCount == 0);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shutdown = true;
+    }
+    workCondition.notify_all();
+
+    for (uint32_t workerIndex = 0; workerIndex < workerCount; ++workerIndex) {
+
+        workers[workerIndex].thread.join();
+    }
+}
+
+Fsr2CpuService::Stream* Fsr2CpuService::createStream(uint32_t weight, uint32_t frameBudgetMicroseconds)
+{
+    Stream* stream = new(std::nothrow) Stream(this, weight, frameBudgetMicroseconds);
+    if (stream) {
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stream->finishTag = virtualTime;
+        streamCount++;
+    }
+    return stream;
+}
+
+void Fsr2CpuService::destroyStream(Stream* stream)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        FFX_ASSERT(streamCount > 0);
+        streamCount--;
+    }
+
+    delete stream;
+}
+
+uint32_t Fsr2CpuService::getStreamCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return streamCount;
+}
+
+void Fsr2CpuService::getStatistics(FfxFsr2ServiceStatisticsCPU* outStatistics)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    outStatistics->streamCount = streamCount;
+    outStatistics->activeFrameCount = activeFrameCount;
+    outStatistics->waitingFrameCount = uint32_t(nextTicket - admittedTicket);
+    outStatistics->completedFrameCount = completedFrameCount;
+    outStatistics->missedDeadlineCount = missedDeadlineCount;
+}
+
+bool Fsr2CpuService::isUrgent(const Request* request, Clock::time_point now) const
+{
+    const Stream* stream = request->stream;
+    return stream->hasDeadline && stream->deadline - now < stream->frameBudget / FSR2_CPU_SERVICE_URGENT_FRACTION;
+}
+
+Fsr2CpuService::Request* Fsr2CpuService::pickRequest()
+{
+    const Clock::time_point now = Clock::now();
+
+    Request* urgentRequest = nullptr;
+    Request* fairRequest = nullptr;
+    for (Request* request : requests) {
+
+        if (isUrgent(request, now)) {
+
+            if (!urgentRequest || request->stream->deadline < urgentRequest->stream->deadline) {
+                urgentRequest = request;
+            }
+        }
+        else if (!fairRequest || request->finishTag < fairRequest->finishTag) {
+
+            fairRequest = request;
+        }
+    }
+
+    if (urgentRequest) {
+        return urgentRequest;
+    }
+
+    // the virtual time follows the start tag of the dispatch in service
+    if (fairRequest) {
+        virtualTime = std::max(virtualTime, fairRequest->startTag);
+    }
+    return fairRequest;
+}
+
+bool Fsr2CpuService::takeTile(Tile* outTile)
+{
+    Request* request = pickRequest();
+    if (!request) {
+        return false;
+    }
+
+    const Fsr2CpuJob* job = request->jobs[request->jobIndex];
+    const uint32_t groupCount = FFX_MAXIMUM(1u, job->dimensions[0]) * FFX_MAXIMUM(1u, job->dimensions[1]) * FFX_MAXIMUM(1u, job->dimensions[2]);
+    const uint32_t tileSize = FFX_MAXIMUM(1u, groupCount / (workerCount * FSR2_CPU_SERVICE_TILES_PER_WORKER));
+
+    outTile->request = request;
+    outTile->job = job;
+    outTile->firstGroup = request->nextGroup;
+    outTile->lastGroup = FFX_MINIMUM(groupCount, request->nextGroup + tileSize);
+
+    request->nextGroup = outTile->lastGroup;
+    if (request->nextGroup == groupCount) {
+
+        request->nextGroup = 0;
+        if (++request->jobIndex == request->jobCount) {
+
+            // every group is handed out, the request stays alive until its caller saw them complete
+            requests.erase(std::find(requests.begin(), requests.end(), request));
+        }
+    }
+
+    return true;
+}
+
+void Fsr2CpuService::workerMain(uint32_t workerIndex)
+{
+    void* groupShared = workers[workerIndex].groupShared;
+
+    Tile tile = {};
+    for (;;) {
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            if (tile.request) {
+
+                tile.request->pendingGroups -= tile.lastGroup - tile.firstGroup;
+                if (tile.request->pendingGroups == 0) {
+                    doneCondition.notify_all();
+                }
+                tile.request = nullptr;
+            }
+
+            workCondition.wait(lock, [&] { return shutdown || !requests.empty(); });
+            if (shutdown) {
+                return;
+            }
+
+            takeTile(&tile);
+        }
+
+        if (fsr2CpuGetFloatControl() != tile.request->floatControl) {
+            fsr2CpuSetFloatControl(tile.request->floatControl);
+        }
+
+        const uint32_t groupCountX = FFX_MAXIMUM(1u, tile.job->dimensions[0]);
+        for (uint32_t group = tile.firstGroup; group < tile.lastGroup; ++group) {
+
+            tile.job->pipeline->kernel(tile.job, group % groupCountX, group / groupCountX, groupShared);
+        }
+    }
+}
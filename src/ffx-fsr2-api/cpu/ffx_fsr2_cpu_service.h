@@ -0,0 +1,155 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Host thread pool shared by the CPU backend contexts of many FSR2 sessions.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../ffx_fsr2.h"
+#include "ffx_fsr2_cpu.h"
+#include "ffx_fsr2_cpu_executor.h"
+
+// Executes the thread groups of the jobs of many backend contexts on one pool of host threads.
+//
+// Each context dispatches through a Stream. The frames of the streams, one per execute call, are
+// admitted in arrival order up to a maximum number of active frames, later frames wait in
+// beginFrame, which pushes back on the sessions instead of oversubscribing the host. The threads
+// calling dispatch only wait, so the host never runs more threads than the pool holds.
+//
+// The workers hand out tiles of the dispatches of the active frames by priority:
+// - a dispatch whose frame has less than a quarter of its budget left is urgent, and the urgent
+//   dispatches run earliest deadline first, ahead of all others,
+// - the other dispatches share the pool by weighted fair queuing. Each dispatch is tagged with
+//   the virtual time at which it would finish if its stream got a share of the pool proportional
+//   to its weight, and the dispatch with the smallest tag runs first.
+//
+// As with Fsr2CpuExecutor, every thread group runs with the floating point control state of the
+// thread calling dispatch.
+class Fsr2CpuService {
+
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    class Stream : public Fsr2CpuScheduler {
+
+    public:
+        using Fsr2CpuScheduler::dispatch;
+        void beginFrame() override;
+        void endFrame() override;
+        void dispatch(const Fsr2CpuJob* const* jobs, uint32_t jobCount) override;
+
+    private:
+        friend class Fsr2CpuService;
+
+        Stream(Fsr2CpuService* service, uint32_t weight, uint32_t frameBudgetMicroseconds);
+
+        Fsr2CpuService*         service;
+        double                  weight;
+        Clock::duration         frameBudget;
+
+        // deadline of the current frame, when the stream has a budget
+        Clock::time_point       deadline;
+        bool                    hasDeadline;
+
+        // virtual finish tag of the last dispatch of the stream
+        double                  finishTag;
+    };
+
+    Fsr2CpuService(uint32_t threadCount, uint32_t maximumActiveFrameCount);
+    ~Fsr2CpuService();
+
+    Fsr2CpuService(const Fsr2CpuService&) = delete;
+    Fsr2CpuService& operator=(const Fsr2CpuService&) = delete;
+
+    // weight is the relative share of the pool the stream receives under load, and
+    // frameBudgetMicroseconds the time from the start of an execute call to its deadline, or 0 for
+    // frames without a deadline.
+    Stream* createStream(uint32_t weight, uint32_t frameBudgetMicroseconds);
+    void destroyStream(Stream* stream);
+
+    uint32_t getStreamCount();
+    void getStatistics(FfxFsr2ServiceStatisticsCPU* outStatistics);
+
+private:
+    // The jobs of a dispatch and the groups of them not handed out yet.
+    struct Request {
+
+        Stream*                 stream;
+        const Fsr2CpuJob* const* jobs;
+        uint32_t                jobCount;
+        uint32_t                jobIndex;
+        uint32_t                nextGroup;
+        uint32_t                pendingGroups;
+        uint32_t                floatControl;
+        double                  startTag;
+        double                  finishTag;
+    };
+
+    // A range of thread groups [firstGroup, lastGroup) of a job.
+    struct Tile {
+
+        Request*                request;
+        const Fsr2CpuJob*       job;
+        uint32_t                firstGroup;
+        uint32_t                lastGroup;
+    };
+
+    struct alignas(64) Worker {
+
+        std::thread             thread;
+
+        // stands in for the groupshared memory of the thread group being executed
+        alignas(64) uint8_t     groupShared[FSR2_CPU_GROUPSHARED_SIZE];
+    };
+
+    bool isUrgent(const Request* request, Clock::time_point now) const;
+    Request* pickRequest();
+    bool takeTile(Tile* outTile);
+    void workerMain(uint32_t workerIndex);
+
+    uint32_t                    workerCount;
+    std::unique_ptr<Worker[]>   workers;
+
+    std::mutex                  mutex;
+    std::condition_variable     workCondition;
+    std::condition_variable     doneCondition;
+    std::condition_variable     admitCondition;
+    bool                        shutdown;
+
+    std::vector<Request*>       requests;
+    double                      virtualTime;
+
+    uint32_t                    streamCount;
+    uint32_t                    maximumActiveFrameCount;
+    uint32_t                    activeFrameCount;
+    uint64_t                    nextTicket;
+    uint64_t                    admittedTicket;
+
+    uint64_t                    completedFrameCount;
+    uint64_t                    missedDeadlineCount;
+};
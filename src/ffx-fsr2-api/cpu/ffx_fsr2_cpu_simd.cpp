@@ -0,0 +1,189 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ffx_fsr2_cpu_simd.h"
+
+#if FSR2_CPU_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif // #if defined(_MSC_VER)
+#else
+#include <cfenv>
+#endif // #if FSR2_CPU_SIMD_X86
+
+#if FSR2_CPU_SIMD_X86
+
+static void cpuid(uint32_t leaf, uint32_t subLeaf, uint32_t* regs)
+{
+#if defined(_MSC_VER)
+    int32_t info[4];
+    __cpuidex(info, int32_t(leaf), int32_t(subLeaf));
+    for (int32_t i = 0; i < 4; ++i) regs[i] = uint32_t(info[i]);
+#else
+    __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif // #if defined(_MSC_VER)
+}
+
+static uint64_t xgetbv0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (uint64_t(edx) << 32) | eax;
+#endif // #if defined(_MSC_VER)
+}
+
+static Fsr2CpuSimdLevel detectSimdLevel()
+{
+    uint32_t regs[4];
+    cpuid(0, 0, regs);
+    const uint32_t maxLeaf = regs[0];
+    if (maxLeaf < 7) {
+        return FSR2_CPU_SIMD_LEVEL_SCALAR;
+    }
+
+    cpuid(1, 0, regs);
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool fma = (regs[2] & (1u << 12)) != 0;
+    const bool f16c = (regs[2] & (1u << 29)) != 0;
+    if (!osxsave || !fma || !f16c) {
+        return FSR2_CPU_SIMD_LEVEL_SCALAR;
+    }
+
+    // the OS has to save the YMM (and for AVX-512 the opmask and ZMM) state on context switches
+    const uint64_t xcr0 = xgetbv0();
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = (xcr0 & 0xe6) == 0xe6;
+
+    cpuid(7, 0, regs);
+    const bool avx2 = (regs[1] & (1u << 5)) != 0;
+    const bool avx512f = (regs[1] & (1u << 16)) != 0;
+
+    if (avx512f && avx2 && zmmState) {
+        return FSR2_CPU_SIMD_LEVEL_AVX512;
+    }
+    if (avx2 && ymmState) {
+        return FSR2_CPU_SIMD_LEVEL_AVX2;
+    }
+    return FSR2_CPU_SIMD_LEVEL_SCALAR;
+}
+
+#endif // #if FSR2_CPU_SIMD_X86
+
+Fsr2CpuSimdLevel fsr2CpuGetSimdLevel()
+{
+#if FSR2_CPU_SIMD_X86
+    static const Fsr2CpuSimdLevel level = detectSimdLevel();
+    return level;
+#else
+    return FSR2_CPU_SIMD_LEVEL_SCALAR;
+#endif // #if FSR2_CPU_SIMD_X86
+}
+
+#if FSR2_CPU_SIMD_X86
+// MXCSR without the sticky exception flags, the SSE and AVX kernels never touch the x87 unit.
+static const uint32_t MXCSR_CONTROL_MASK = ~0x3fu;
+
+uint32_t fsr2CpuGetFloatControl()
+{
+    return _mm_getcsr() & MXCSR_CONTROL_MASK;
+}
+
+void fsr2CpuSetFloatControl(uint32_t control)
+{
+    _mm_setcsr((_mm_getcsr() & ~MXCSR_CONTROL_MASK) | control);
+}
+
+uint32_t fsr2CpuGetDefaultFloatControl()
+{
+    // every exception masked, round to nearest, no flush to zero nor denormals are zero
+    return 0x1f80u;
+}
+#else
+uint32_t fsr2CpuGetFloatControl()
+{
+    return uint32_t(fegetround());
+}
+
+void fsr2CpuSetFloatControl(uint32_t control)
+{
+    fesetround(int32_t(control));
+}
+
+uint32_t fsr2CpuGetDefaultFloatControl()
+{
+    return uint32_t(FE_TONEAREST);
+}
+#endif // #if FSR2_CPU_SIMD_X86
+
+Fsr2CpuKernelFunc fsr2CpuSelectKernel(FfxFsr2Pass pass, Fsr2CpuKernelFunc scalarKernel)
+{
+#if FSR2_CPU_SIMD_X86
+    const Fsr2CpuSimdLevel level = fsr2CpuGetSimdLevel();
+
+    switch (pass) {
+
+        case FFX_FSR2_PASS_ACCUMULATE:
+        case FFX_FSR2_PASS_ACCUMULATE_SHARPEN:
+            if (level >= FSR2_CPU_SIMD_LEVEL_AVX512) {
+                return fsr2CpuAccumulateKernelAVX512;
+            }
+            if (level >= FSR2_CPU_SIMD_LEVEL_AVX2) {
+                return fsr2CpuAccumulateKernelAVX2;
+            }
+            break;
+
+        default:
+            break;
+    }
+#else
+    FFX_UNUSED(pass);
+#endif // #if FSR2_CPU_SIMD_X86
+
+    return scalarKernel;
+}
+
+Fsr2CpuRcasRowFunc fsr2CpuSelectRcasRow()
+{
+#if FSR2_CPU_SIMD_X86
+    if (fsr2CpuGetSimdLevel() >= FSR2_CPU_SIMD_LEVEL_AVX2) {
+        return fsr2CpuRcasRowAVX2;
+    }
+#endif // #if FSR2_CPU_SIMD_X86
+
+    return fsr2CpuRcasRow;
+}
+
+Fsr2CpuEasuRowFunc fsr2CpuSelectEasuRow()
+{
+#if FSR2_CPU_SIMD_X86
+    if (fsr2CpuGetSimdLevel() >= FSR2_CPU_SIMD_LEVEL_AVX2) {
+        return fsr2CpuEasuRowAVX2;
+    }
+#endif // #if FSR2_CPU_SIMD_X86
+
+    return fsr2CpuEasuRow;
+}
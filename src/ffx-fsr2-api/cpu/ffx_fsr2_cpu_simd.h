@@ -0,0 +1,113 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Runtime selection of the vectorized CPU pass kernels.
+//
+// Vectorized kernels live in their own translation units, one per instruction set, and are compiled
+// between FSR2_CPU_TARGET_BEGIN_* / FSR2_CPU_TARGET_END so that only the functions in that region
+// may use the wider instructions. Everything they include before the region is compiled for the
+// baseline target, so shared inline helpers never leak AVX encodings into the scalar paths.
+
+#pragma once
+
+#include "ffx_fsr2_cpu_private.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define FSR2_CPU_SIMD_X86 1
+#else
+#define FSR2_CPU_SIMD_X86 0
+#endif // #if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+
+#if defined(__clang__)
+#define FSR2_CPU_TARGET_BEGIN_AVX2      _Pragma("clang attribute push(__attribute__((target(\"avx2,fma,f16c\"))), apply_to = function)")
+#define FSR2_CPU_TARGET_BEGIN_AVX512    _Pragma("clang attribute push(__attribute__((target(\"avx512f,avx2,fma,f16c\"))), apply_to = function)")
+#define FSR2_CPU_TARGET_END             _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+#define FSR2_CPU_TARGET_BEGIN_AVX2      _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma,f16c\")")
+#define FSR2_CPU_TARGET_BEGIN_AVX512    _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx2,fma,f16c\")")
+#define FSR2_CPU_TARGET_END             _Pragma("GCC pop_options")
+#else
+// MSVC accepts intrinsics of every instruction set without /arch
+#define FSR2_CPU_TARGET_BEGIN_AVX2
+#define FSR2_CPU_TARGET_BEGIN_AVX512
+#define FSR2_CPU_TARGET_END
+#endif // #if defined(__clang__)
+
+// Widest instruction set the host supports, in increasing order.
+typedef enum Fsr2CpuSimdLevel {
+
+    FSR2_CPU_SIMD_LEVEL_SCALAR,
+    FSR2_CPU_SIMD_LEVEL_AVX2,       // AVX2 + FMA + F16C, 8 lanes
+    FSR2_CPU_SIMD_LEVEL_AVX512,     // AVX-512F, 16 lanes
+} Fsr2CpuSimdLevel;
+
+// Query the host CPU and OS once, later calls return the cached result.
+Fsr2CpuSimdLevel fsr2CpuGetSimdLevel();
+
+// Floating point control state of the calling thread. It holds everything besides the inputs that
+// changes the result of float arithmetic: the rounding mode and, on x86, flush to zero and denormals
+// are zero. The default state rounds to nearest and keeps denormals.
+uint32_t fsr2CpuGetFloatControl();
+void fsr2CpuSetFloatControl(uint32_t control);
+uint32_t fsr2CpuGetDefaultFloatControl();
+
+// Vectorized pass kernels, only valid to call when the host supports their instruction set.
+void fsr2CpuAccumulateKernelAVX2(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+void fsr2CpuAccumulateKernelAVX512(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared);
+
+// Convert count (1, 2 or 4) fp16 channels of a texel with F16C, only valid on hosts with FSR2_CPU_SIMD_LEVEL_AVX2.
+void fsr2CpuDecodeHalvesF16C(const uint16_t* value, float* outValue, uint32_t count);
+void fsr2CpuEncodeHalvesF16C(const float* value, uint16_t* outValue, uint32_t count);
+
+// Pick the fastest kernel for a pass on this host, falling back to scalarKernel.
+Fsr2CpuKernelFunc fsr2CpuSelectKernel(FfxFsr2Pass pass, Fsr2CpuKernelFunc scalarKernel);
+
+// Sharpen count RGBA texels of a row with RCAS, lobeScale being the linear sharpness of FsrRcasCon.
+// above, center and below point at the first texel in their row, center[-1] and center[count] are
+// read as the horizontal neighbours. Alpha is passed through from center.
+typedef void (*Fsr2CpuRcasRowFunc)(const float* above, const float* center, const float* below, float* output, uint32_t count, float lobeScale);
+
+void fsr2CpuRcasRow(const float* above, const float* center, const float* below, float* output, uint32_t count, float lobeScale);
+void fsr2CpuRcasRowAVX2(const float* above, const float* center, const float* below, float* output, uint32_t count, float lobeScale);
+
+// Pick the fastest RCAS row filter on this host.
+Fsr2CpuRcasRowFunc fsr2CpuSelectRcasRow();
+
+// An RGBA image with 32-bit float channels read by the EASU row filters. scale and offset are con0 of
+// ffxFsrPopulateEasuConstants, mapping an output texel to the position of 'f' in the image.
+typedef struct Fsr2CpuEasuSource {
+
+    const uint8_t*              data;
+    size_t                      rowPitch;
+    int32_t                     width;
+    int32_t                     height;
+    float                       scale[2];
+    float                       offset[2];
+} Fsr2CpuEasuSource;
+
+// Upscale the first count RGBA texels of output row y with EASU. Alpha is written as 1.
+typedef void (*Fsr2CpuEasuRowFunc)(const Fsr2CpuEasuSource* source, uint32_t y, float* output, uint32_t count);
+
+void fsr2CpuEasuRow(const Fsr2CpuEasuSource* source, uint32_t y, float* output, uint32_t count);
+void fsr2CpuEasuRowAVX2(const Fsr2CpuEasuSource* source, uint32_t y, float* output, uint32_t count);
+
+// Pick the fastest EASU row filter on this host.
+Fsr2CpuEasuRowFunc fsr2CpuSelectEasuRow();
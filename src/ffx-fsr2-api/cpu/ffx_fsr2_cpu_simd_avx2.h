@@ -0,0 +1,141 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// 8-lane AVX2 packet types for the vectorized CPU kernels. Must be included between
+// FSR2_CPU_TARGET_BEGIN_AVX2 and FSR2_CPU_TARGET_END, see ffx_fsr2_cpu_simd.h.
+
+#pragma once
+
+#include <immintrin.h>
+
+namespace fsr2cpu {
+namespace avx2 {
+
+static const int32_t SIMD_WIDTH = 8;
+
+struct vmask {
+
+    __m256 v;
+
+    vmask() {}
+    explicit vmask(__m256 v_) : v(v_) {}
+};
+
+struct vfloat {
+
+    __m256 v;
+
+    vfloat() {}
+    vfloat(float s) : v(_mm256_set1_ps(s)) {}
+    explicit vfloat(__m256 v_) : v(v_) {}
+};
+
+struct vint {
+
+    __m256i v;
+
+    vint() {}
+    vint(int32_t s) : v(_mm256_set1_epi32(s)) {}
+    explicit vint(__m256i v_) : v(v_) {}
+};
+
+inline vint laneIndex()                                 { return vint(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)); }
+
+inline vfloat operator+(vfloat a, vfloat b)             { return vfloat(_mm256_add_ps(a.v, b.v)); }
+inline vfloat operator-(vfloat a, vfloat b)             { return vfloat(_mm256_sub_ps(a.v, b.v)); }
+inline vfloat operator*(vfloat a, vfloat b)             { return vfloat(_mm256_mul_ps(a.v, b.v)); }
+inline vfloat operator/(vfloat a, vfloat b)             { return vfloat(_mm256_div_ps(a.v, b.v)); }
+inline vfloat operator-(vfloat a)                       { return vfloat(_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))); }
+inline vfloat& operator+=(vfloat& a, vfloat b)          { a = a + b; return a; }
+inline vfloat& operator-=(vfloat& a, vfloat b)          { a = a - b; return a; }
+inline vfloat& operator*=(vfloat& a, vfloat b)          { a = a * b; return a; }
+inline vfloat& operator/=(vfloat& a, vfloat b)          { a = a / b; return a; }
+
+inline vmask operator<(vfloat a, vfloat b)              { return vmask(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)); }
+inline vmask operator<=(vfloat a, vfloat b)             { return vmask(_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)); }
+inline vmask operator>(vfloat a, vfloat b)              { return vmask(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)); }
+inline vmask operator>=(vfloat a, vfloat b)             { return vmask(_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)); }
+inline vmask operator==(vfloat a, vfloat b)             { return vmask(_mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ)); }
+inline vmask operator!=(vfloat a, vfloat b)             { return vmask(_mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ)); }
+
+inline vfloat min(vfloat a, vfloat b)                   { return vfloat(_mm256_min_ps(a.v, b.v)); }
+inline vfloat max(vfloat a, vfloat b)                   { return vfloat(_mm256_max_ps(a.v, b.v)); }
+inline vfloat abs(vfloat a)                             { return vfloat(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)); }
+inline vfloat floor(vfloat a)                           { return vfloat(_mm256_round_ps(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)); }
+inline vfloat sqrt(vfloat a)                            { return vfloat(_mm256_sqrt_ps(a.v)); }
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c)       { return vfloat(_mm256_fmadd_ps(a.v, b.v, c.v)); }
+inline vfloat select(vmask m, vfloat a, vfloat b)       { return vfloat(_mm256_blendv_ps(b.v, a.v, m.v)); }
+
+inline vmask operator&(vmask a, vmask b)                { return vmask(_mm256_and_ps(a.v, b.v)); }
+inline vmask operator|(vmask a, vmask b)                { return vmask(_mm256_or_ps(a.v, b.v)); }
+inline vmask operator!(vmask a)                         { return vmask(_mm256_xor_ps(a.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))); }
+inline vmask maskAll(bool value)                        { return vmask(_mm256_castsi256_ps(_mm256_set1_epi32(value ? -1 : 0))); }
+inline uint32_t maskBits(vmask m)                       { return uint32_t(_mm256_movemask_ps(m.v)); }
+inline bool any(vmask m)                                { return maskBits(m) != 0; }
+inline bool all(vmask m)                                { return maskBits(m) == 0xffu; }
+
+inline vint operator+(vint a, vint b)                   { return vint(_mm256_add_epi32(a.v, b.v)); }
+inline vint operator-(vint a, vint b)                   { return vint(_mm256_sub_epi32(a.v, b.v)); }
+inline vint operator*(vint a, vint b)                   { return vint(_mm256_mullo_epi32(a.v, b.v)); }
+inline vint operator&(vint a, vint b)                   { return vint(_mm256_and_si256(a.v, b.v)); }
+inline vint operator|(vint a, vint b)                   { return vint(_mm256_or_si256(a.v, b.v)); }
+inline vint operator<<(vint a, int32_t bits)            { return vint(_mm256_sll_epi32(a.v, _mm_cvtsi32_si128(bits))); }
+inline vint operator>>(vint a, int32_t bits)            { return vint(_mm256_sra_epi32(a.v, _mm_cvtsi32_si128(bits))); }
+inline vint shiftRightLogical(vint a, int32_t bits)     { return vint(_mm256_srl_epi32(a.v, _mm_cvtsi32_si128(bits))); }
+
+inline vmask operator==(vint a, vint b)                 { return vmask(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a.v, b.v))); }
+inline vmask operator>(vint a, vint b)                  { return vmask(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a.v, b.v))); }
+inline vmask operator<(vint a, vint b)                  { return b > a; }
+inline vmask operator>=(vint a, vint b)                 { return !(b > a); }
+
+inline vint min(vint a, vint b)                         { return vint(_mm256_min_epi32(a.v, b.v)); }
+inline vint max(vint a, vint b)                         { return vint(_mm256_max_epi32(a.v, b.v)); }
+inline vint select(vmask m, vint a, vint b)             { return vint(_mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b.v), _mm256_castsi256_ps(a.v), m.v))); }
+
+inline vfloat toFloat(vint a)                           { return vfloat(_mm256_cvtepi32_ps(a.v)); }
+inline vint truncToInt(vfloat a)                        { return vint(_mm256_cvttps_epi32(a.v)); }
+inline vfloat asFloat(vint a)                           { return vfloat(_mm256_castsi256_ps(a.v)); }
+inline vint asInt(vfloat a)                             { return vint(_mm256_castps_si256(a.v)); }
+
+inline vfloat loadLanes(const float* values)            { return vfloat(_mm256_loadu_ps(values)); }
+inline void storeLanes(float* values, vfloat a)         { _mm256_storeu_ps(values, a.v); }
+inline void storeLanes(int32_t* values, vint a)         { _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), a.v); }
+
+// fp16 conversions with F16C, the half lives in the low 16 bits of each lane of a vint.
+inline vfloat halfToFloat(vint a)
+{
+    const __m256i words = _mm256_packus_epi32(_mm256_and_si256(a.v, _mm256_set1_epi32(0xffff)), _mm256_setzero_si256());
+    return vfloat(_mm256_cvtph_ps(_mm256_castsi256_si128(_mm256_permute4x64_epi64(words, 0x08))));
+}
+
+inline vint floatToHalf(vfloat a)
+{
+    return vint(_mm256_cvtepu16_epi32(_mm256_cvtps_ph(a.v, _MM_FROUND_TO_NEAREST_INT)));
+}
+
+// Masked gather of 32-bit floats at base + byteOffsets, inactive lanes read zero.
+inline vfloat gather(const float* base, vint byteOffsets, vmask m)
+{
+    return vfloat(_mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, byteOffsets.v, m.v, 1));
+}
+
+} // namespace avx2
+} // namespace fsr2cpu
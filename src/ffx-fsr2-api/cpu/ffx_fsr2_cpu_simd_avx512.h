@@ -0,0 +1,140 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// 16-lane AVX-512 packet types for the vectorized CPU kernels. Must be included between
+// FSR2_CPU_TARGET_BEGIN_AVX512 and FSR2_CPU_TARGET_END, see ffx_fsr2_cpu_simd.h.
+
+#pragma once
+
+#include <immintrin.h>
+
+namespace fsr2cpu {
+namespace avx512 {
+
+static const int32_t SIMD_WIDTH = 16;
+
+struct vmask {
+
+    __mmask16 v;
+
+    vmask() {}
+    explicit vmask(__mmask16 v_) : v(v_) {}
+};
+
+struct vfloat {
+
+    __m512 v;
+
+    vfloat() {}
+    vfloat(float s) : v(_mm512_set1_ps(s)) {}
+    explicit vfloat(__m512 v_) : v(v_) {}
+};
+
+struct vint {
+
+    __m512i v;
+
+    vint() {}
+    vint(int32_t s) : v(_mm512_set1_epi32(s)) {}
+    explicit vint(__m512i v_) : v(v_) {}
+};
+
+inline vint laneIndex()                                 { return vint(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)); }
+
+inline vfloat operator+(vfloat a, vfloat b)             { return vfloat(_mm512_add_ps(a.v, b.v)); }
+inline vfloat operator-(vfloat a, vfloat b)             { return vfloat(_mm512_sub_ps(a.v, b.v)); }
+inline vfloat operator*(vfloat a, vfloat b)             { return vfloat(_mm512_mul_ps(a.v, b.v)); }
+inline vfloat operator/(vfloat a, vfloat b)             { return vfloat(_mm512_div_ps(a.v, b.v)); }
+inline vfloat operator-(vfloat a)                       { return vfloat(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(int32_t(0x80000000u))))); }
+inline vfloat& operator+=(vfloat& a, vfloat b)          { a = a + b; return a; }
+inline vfloat& operator-=(vfloat& a, vfloat b)          { a = a - b; return a; }
+inline vfloat& operator*=(vfloat& a, vfloat b)          { a = a * b; return a; }
+inline vfloat& operator/=(vfloat& a, vfloat b)          { a = a / b; return a; }
+
+inline vmask operator<(vfloat a, vfloat b)              { return vmask(_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)); }
+inline vmask operator<=(vfloat a, vfloat b)             { return vmask(_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)); }
+inline vmask operator>(vfloat a, vfloat b)              { return vmask(_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)); }
+inline vmask operator>=(vfloat a, vfloat b)             { return vmask(_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)); }
+inline vmask operator==(vfloat a, vfloat b)             { return vmask(_mm512_cmp_ps_mask(a.v, b.v, _CMP_EQ_OQ)); }
+inline vmask operator!=(vfloat a, vfloat b)             { return vmask(_mm512_cmp_ps_mask(a.v, b.v, _CMP_NEQ_UQ)); }
+
+inline vfloat min(vfloat a, vfloat b)                   { return vfloat(_mm512_min_ps(a.v, b.v)); }
+inline vfloat max(vfloat a, vfloat b)                   { return vfloat(_mm512_max_ps(a.v, b.v)); }
+inline vfloat abs(vfloat a)                             { return vfloat(_mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(0x7fffffff)))); }
+inline vfloat floor(vfloat a)                           { return vfloat(_mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)); }
+inline vfloat sqrt(vfloat a)                            { return vfloat(_mm512_sqrt_ps(a.v)); }
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c)       { return vfloat(_mm512_fmadd_ps(a.v, b.v, c.v)); }
+inline vfloat select(vmask m, vfloat a, vfloat b)       { return vfloat(_mm512_mask_blend_ps(m.v, b.v, a.v)); }
+
+inline vmask operator&(vmask a, vmask b)                { return vmask(__mmask16(a.v & b.v)); }
+inline vmask operator|(vmask a, vmask b)                { return vmask(__mmask16(a.v | b.v)); }
+inline vmask operator!(vmask a)                         { return vmask(__mmask16(~a.v)); }
+inline vmask maskAll(bool value)                        { return vmask(__mmask16(value ? 0xffffu : 0u)); }
+inline uint32_t maskBits(vmask m)                       { return uint32_t(m.v); }
+inline bool any(vmask m)                                { return m.v != 0; }
+inline bool all(vmask m)                                { return m.v == 0xffffu; }
+
+inline vint operator+(vint a, vint b)                   { return vint(_mm512_add_epi32(a.v, b.v)); }
+inline vint operator-(vint a, vint b)                   { return vint(_mm512_sub_epi32(a.v, b.v)); }
+inline vint operator*(vint a, vint b)                   { return vint(_mm512_mullo_epi32(a.v, b.v)); }
+inline vint operator&(vint a, vint b)                   { return vint(_mm512_and_si512(a.v, b.v)); }
+inline vint operator|(vint a, vint b)                   { return vint(_mm512_or_si512(a.v, b.v)); }
+inline vint operator<<(vint a, int32_t bits)            { return vint(_mm512_sll_epi32(a.v, _mm_cvtsi32_si128(bits))); }
+inline vint operator>>(vint a, int32_t bits)            { return vint(_mm512_sra_epi32(a.v, _mm_cvtsi32_si128(bits))); }
+inline vint shiftRightLogical(vint a, int32_t bits)     { return vint(_mm512_srl_epi32(a.v, _mm_cvtsi32_si128(bits))); }
+
+inline vmask operator==(vint a, vint b)                 { return vmask(_mm512_cmpeq_epi32_mask(a.v, b.v)); }
+inline vmask operator>(vint a, vint b)                  { return vmask(_mm512_cmpgt_epi32_mask(a.v, b.v)); }
+inline vmask operator<(vint a, vint b)                  { return vmask(_mm512_cmplt_epi32_mask(a.v, b.v)); }
+inline vmask operator>=(vint a, vint b)                 { return vmask(_mm512_cmpge_epi32_mask(a.v, b.v)); }
+
+inline vint min(vint a, vint b)                         { return vint(_mm512_min_epi32(a.v, b.v)); }
+inline vint max(vint a, vint b)                         { return vint(_mm512_max_epi32(a.v, b.v)); }
+inline vint select(vmask m, vint a, vint b)             { return vint(_mm512_mask_blend_epi32(m.v, b.v, a.v)); }
+
+inline vfloat toFloat(vint a)                           { return vfloat(_mm512_cvtepi32_ps(a.v)); }
+inline vint truncToInt(vfloat a)                        { return vint(_mm512_cvttps_epi32(a.v)); }
+inline vfloat asFloat(vint a)                           { return vfloat(_mm512_castsi512_ps(a.v)); }
+inline vint asInt(vfloat a)                             { return vint(_mm512_castps_si512(a.v)); }
+
+inline vfloat loadLanes(const float* values)            { return vfloat(_mm512_loadu_ps(values)); }
+inline void storeLanes(float* values, vfloat a)         { _mm512_storeu_ps(values, a.v); }
+inline void storeLanes(int32_t* values, vint a)         { _mm512_storeu_si512(values, a.v); }
+
+// fp16 conversions with F16C, the half lives in the low 16 bits of each lane of a vint.
+inline vfloat halfToFloat(vint a)
+{
+    return vfloat(_mm512_cvtph_ps(_mm512_cvtepi32_epi16(a.v)));
+}
+
+inline vint floatToHalf(vfloat a)
+{
+    return vint(_mm512_cvtepu16_epi32(_mm512_cvtps_ph(a.v, _MM_FROUND_TO_NEAREST_INT)));
+}
+
+// Masked gather of 32-bit floats at base + byteOffsets, inactive lanes read zero.
+inline vfloat gather(const float* base, vint byteOffsets, vmask m)
+{
+    return vfloat(_mm512_mask_i32gather_ps(_mm512_setzero_ps(), m.v, byteOffsets.v, base, 1));
+}
+
+} // namespace avx512
+} // namespace fsr2cpu
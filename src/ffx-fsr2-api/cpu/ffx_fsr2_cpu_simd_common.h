@@ -0,0 +1,589 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Vector math and surface access shared by the vectorized CPU kernels.
+//
+// The packet types vfloat, vint and vmask come from the instruction set header included before this
+// one, which also names the namespace everything below is compiled into (FSR2_CPU_SIMD_NAMESPACE).
+// Lanes that are not active never touch memory and read zero, like out of bounds loads on the GPU.
+
+#pragma once
+
+#include "ffx_fsr2_cpu_common.h"
+
+#ifndef FSR2_CPU_SIMD_NAMESPACE
+#error "Include an instruction set header (ffx_fsr2_cpu_simd_avx2.h, ...) and define FSR2_CPU_SIMD_NAMESPACE first"
+#endif // #ifndef FSR2_CPU_SIMD_NAMESPACE
+
+namespace fsr2cpu {
+namespace FSR2_CPU_SIMD_NAMESPACE {
+
+inline vfloat saturate(vfloat v)                        { return min(max(v, vfloat(0.0f)), vfloat(1.0f)); }
+inline vfloat clamp(vfloat v, vfloat a, vfloat b)       { return min(max(v, a), b); }
+inline vfloat lerp(vfloat a, vfloat b, vfloat t)        { return fmadd(b - a, t, a); }
+inline vfloat maskToFloat(vmask m)                      { return select(m, vfloat(1.0f), vfloat(0.0f)); }
+inline vfloat sign(vfloat v)                            { return select(v > 0.0f, vfloat(1.0f), select(v < 0.0f, vfloat(-1.0f), vfloat(0.0f))); }
+inline vint floorToInt(vfloat v)                        { return truncToInt(floor(v)); }
+
+// Rounds half away from zero, like roundf.
+inline vfloat round(vfloat v)
+{
+    const vfloat magnitude = floor(abs(v) + 0.5f);
+    return select(v < 0.0f, -magnitude, magnitude);
+}
+
+inline vfloat minDividedByMax(vfloat a, vfloat b)
+{
+    const vfloat m = max(a, b);
+    return select(m != 0.0f, min(a, b) / m, vfloat(0.0f));
+}
+
+// Cephes style expf, relative error below 2e-7 for results in the normal float range.
+inline vfloat exp(vfloat x)
+{
+    x = clamp(x, vfloat(-87.0f), vfloat(88.0f));
+
+    const vfloat fx = floor(fmadd(x, vfloat(1.44269504088896341f), vfloat(0.5f)));
+    x = x - fx * 0.693359375f + fx * 2.12194440e-4f;
+
+    const vfloat x2 = x * x;
+    vfloat y = 1.9875691500e-4f;
+    y = fmadd(y, x, vfloat(1.3981999507e-3f));
+    y = fmadd(y, x, vfloat(8.3334519073e-3f));
+    y = fmadd(y, x, vfloat(4.1665795894e-2f));
+    y = fmadd(y, x, vfloat(1.6666665459e-1f));
+    y = fmadd(y, x, vfloat(5.0000001201e-1f));
+    y = fmadd(y, x2, x + 1.0f);
+
+    const vfloat pow2n = asFloat((truncToInt(fx) + 127) << 23);
+    return y * pow2n;
+}
+
+// Cephes style logf for positive arguments, zero returns -FLT_MAX.
+inline vfloat log(vfloat x)
+{
+    const vmask zero = x <= 0.0f;
+    x = max(x, vfloat(1.17549435e-38f));
+
+    const vint bits = asInt(x);
+    vfloat e = toFloat((bits >> 23) - 126);
+    x = asFloat((bits & vint(0x007fffff)) | vint(0x3f000000));
+
+    // keep the mantissa in [sqrt(0.5), sqrt(2))
+    const vmask small = x < 0.707106781186547524f;
+    e = e - maskToFloat(small);
+    x = x - 1.0f + select(small, x, vfloat(0.0f));
+
+    const vfloat z = x * x;
+    vfloat y = 7.0376836292e-2f;
+    y = fmadd(y, x, vfloat(-1.1514610310e-1f));
+    y = fmadd(y, x, vfloat(1.1676998740e-1f));
+    y = fmadd(y, x, vfloat(-1.2420140846e-1f));
+    y = fmadd(y, x, vfloat(1.4249322787e-1f));
+    y = fmadd(y, x, vfloat(-1.6668057665e-1f));
+    y = fmadd(y, x, vfloat(2.0000714765e-1f));
+    y = fmadd(y, x, vfloat(-2.4999993993e-1f));
+    y = fmadd(y, x, vfloat(3.3333331174e-1f));
+    y = y * x * z;
+
+    y = fmadd(e, vfloat(-2.12194440e-4f), y);
+    y = fmadd(z, vfloat(-0.5f), y);
+    x = x + y;
+    x = fmadd(e, vfloat(0.693359375f), x);
+
+    return select(zero, vfloat(-FSR2_FLT_MAX), x);
+}
+
+// powf for non-negative bases.
+inline vfloat pow(vfloat x, float exponent)
+{
+    return select(x > 0.0f, exp(log(x) * exponent), vfloat(0.0f));
+}
+
+// sin(pi * t), absolute error below 1e-6.
+inline vfloat sinPi(vfloat t)
+{
+    const vfloat n = floor(t + 0.5f);
+    const vfloat r = t - n;
+    const vfloat r2 = r * r;
+
+    vfloat s = -0.00737043094571435f;
+    s = fmadd(s, r2, vfloat(0.0821458866111282f));
+    s = fmadd(s, r2, vfloat(-0.599264529320792f));
+    s = fmadd(s, r2, vfloat(2.55016403987735f));
+    s = fmadd(s, r2, vfloat(-5.16771278004997f));
+    s = fmadd(s, r2, vfloat(3.14159265358979f));
+    s = s * r;
+
+    const vmask odd = (truncToInt(n) & vint(1)) == vint(1);
+    return select(odd, -s, s);
+}
+
+struct vint2 {
+
+    vint x, y;
+
+    vint2() {}
+    vint2(vint x_, vint y_) : x(x_), y(y_) {}
+};
+
+struct vfloat2 {
+
+    vfloat x, y;
+
+    vfloat2() {}
+    vfloat2(float v) : x(v), y(v) {}
+    vfloat2(vfloat v) : x(v), y(v) {}
+    vfloat2(vfloat x_, vfloat y_) : x(x_), y(y_) {}
+    vfloat2(const float2& v) : x(v.x), y(v.y) {}
+};
+
+struct vfloat3 {
+
+    vfloat x, y, z;
+
+    vfloat3() {}
+    vfloat3(vfloat v) : x(v), y(v), z(v) {}
+    vfloat3(vfloat x_, vfloat y_, vfloat z_) : x(x_), y(y_), z(z_) {}
+};
+
+struct vfloat4 {
+
+    vfloat x, y, z, w;
+
+    vfloat4() {}
+    vfloat4(vfloat v) : x(v), y(v), z(v), w(v) {}
+    vfloat4(vfloat x_, vfloat y_, vfloat z_, vfloat w_) : x(x_), y(y_), z(z_), w(w_) {}
+    vfloat4(const vfloat3& v, vfloat w_) : x(v.x), y(v.y), z(v.z), w(w_) {}
+
+    vfloat2 xy() const                                  { return vfloat2(x, y); }
+    vfloat3 xyz() const                                 { return vfloat3(x, y, z); }
+};
+
+inline vint2 operator+(const vint2& a, const vint2& b)          { return vint2(a.x + b.x, a.y + b.y); }
+inline vfloat2 toFloat(const vint2& v)                          { return vfloat2(toFloat(v.x), toFloat(v.y)); }
+inline vint2 floorToInt(const vfloat2& v)                       { return vint2(floorToInt(v.x), floorToInt(v.y)); }
+
+inline vfloat2 operator+(const vfloat2& a, const vfloat2& b)    { return vfloat2(a.x + b.x, a.y + b.y); }
+inline vfloat2 operator-(const vfloat2& a, const vfloat2& b)    { return vfloat2(a.x - b.x, a.y - b.y); }
+inline vfloat2 operator*(const vfloat2& a, const vfloat2& b)    { return vfloat2(a.x * b.x, a.y * b.y); }
+inline vfloat2 operator/(const vfloat2& a, const vfloat2& b)    { return vfloat2(a.x / b.x, a.y / b.y); }
+inline vfloat dot(const vfloat2& a, const vfloat2& b)           { return fmadd(a.x, b.x, a.y * b.y); }
+inline vfloat length(const vfloat2& v)                          { return sqrt(dot(v, v)); }
+inline vfloat2 select(vmask m, const vfloat2& a, const vfloat2& b) { return vfloat2(select(m, a.x, b.x), select(m, a.y, b.y)); }
+
+inline vfloat3 operator+(const vfloat3& a, const vfloat3& b)    { return vfloat3(a.x + b.x, a.y + b.y, a.z + b.z); }
+inline vfloat3 operator-(const vfloat3& a, const vfloat3& b)    { return vfloat3(a.x - b.x, a.y - b.y, a.z - b.z); }
+inline vfloat3 operator*(const vfloat3& a, const vfloat3& b)    { return vfloat3(a.x * b.x, a.y * b.y, a.z * b.z); }
+inline vfloat3 operator/(const vfloat3& a, const vfloat3& b)    { return vfloat3(a.x / b.x, a.y / b.y, a.z / b.z); }
+inline vfloat3& operator+=(vfloat3& a, const vfloat3& b)        { a = a + b; return a; }
+inline vfloat3& operator/=(vfloat3& a, const vfloat3& b)        { a = a / b; return a; }
+inline vfloat3 min(const vfloat3& a, const vfloat3& b)          { return vfloat3(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z)); }
+inline vfloat3 max(const vfloat3& a, const vfloat3& b)          { return vfloat3(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z)); }
+inline vfloat3 clamp(const vfloat3& v, const vfloat3& a, const vfloat3& b) { return min(max(v, a), b); }
+inline vfloat3 abs(const vfloat3& v)                            { return vfloat3(abs(v.x), abs(v.y), abs(v.z)); }
+inline vfloat3 sqrt(const vfloat3& v)                           { return vfloat3(sqrt(v.x), sqrt(v.y), sqrt(v.z)); }
+inline vfloat3 lerp(const vfloat3& a, const vfloat3& b, vfloat t) { return vfloat3(lerp(a.x, b.x, t), lerp(a.y, b.y, t), lerp(a.z, b.z, t)); }
+inline vfloat3 select(vmask m, const vfloat3& a, const vfloat3& b) { return vfloat3(select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z)); }
+
+inline vfloat4 operator+(const vfloat4& a, const vfloat4& b)    { return vfloat4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); }
+inline vfloat4 operator*(const vfloat4& a, vfloat b)            { return vfloat4(a.x * b, a.y * b, a.z * b, a.w * b); }
+inline vfloat4 min(const vfloat4& a, const vfloat4& b)          { return vfloat4(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z), min(a.w, b.w)); }
+inline vfloat4 max(const vfloat4& a, const vfloat4& b)          { return vfloat4(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z), max(a.w, b.w)); }
+inline vfloat4 clamp(const vfloat4& v, const vfloat4& a, const vfloat4& b) { return min(max(v, a), b); }
+inline vfloat4 lerp(const vfloat4& a, const vfloat4& b, vfloat t) { return vfloat4(lerp(a.x, b.x, t), lerp(a.y, b.y, t), lerp(a.z, b.z, t), lerp(a.w, b.w, t)); }
+inline vfloat4 select(vmask m, const vfloat4& a, const vfloat4& b) { return vfloat4(select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z), select(m, a.w, b.w)); }
+
+inline vfloat3 prepareRgb(const vfloat3& rgb, float exposureValue, float preExposure)
+{
+    return clamp(rgb / vfloat3(preExposure) * vfloat3(exposureValue), vfloat3(0.0f), vfloat3(FSR2_FP16_MAX));
+}
+
+inline vfloat3 unprepareRgb(const vfloat3& rgb, float exposureValue, float preExposure)
+{
+    return rgb / vfloat3(exposureValue) * vfloat3(preExposure);
+}
+
+inline vfloat3 tonemap(const vfloat3& rgb)
+{
+    return rgb / vfloat3(max(max(vfloat(0.0f), rgb.x), max(rgb.y, rgb.z)) + 1.0f);
+}
+
+inline vfloat3 inverseTonemap(const vfloat3& rgb)
+{
+    return rgb / vfloat3(max(vfloat(FSR2_TONEMAP_EPSILON), 1.0f - max(rgb.x, max(rgb.y, rgb.z))));
+}
+
+inline vfloat3 rgbToYCoCg(const vfloat3& rgb)
+{
+    return vfloat3(
+        0.25f * rgb.x + 0.5f * rgb.y + 0.25f * rgb.z,
+        0.5f * rgb.x - 0.5f * rgb.z,
+        -0.25f * rgb.x + 0.5f * rgb.y - 0.25f * rgb.z);
+}
+
+inline vfloat3 yCoCgToRgb(const vfloat3& yCoCg)
+{
+    return vfloat3(
+        yCoCg.x + yCoCg.y - yCoCg.z,
+        yCoCg.x + yCoCg.z,
+        yCoCg.x - yCoCg.y - yCoCg.z);
+}
+
+inline vmask isUvInside(const vfloat2& uv)
+{
+    return (uv.x >= 0.0f) & (uv.x <= 1.0f) & (uv.y >= 0.0f) & (uv.y <= 1.0f);
+}
+
+inline vmask isOnScreen(const vint2& pos, int2 size)
+{
+    return (pos.x >= vint(0)) & (pos.x < vint(size.x)) & (pos.y >= vint(0)) & (pos.y < vint(size.y));
+}
+
+inline vfloat2 clampUv(const vfloat2& uv, int2 textureSize, int2 resourceSize)
+{
+    const vfloat2 size = vfloat2(fsr2cpu::toFloat(textureSize));
+    const vfloat2 sampleLocation = uv * size;
+    const vfloat2 clampedLocation = vfloat2(
+        clamp(sampleLocation.x, vfloat(0.5f), size.x - 0.5f),
+        clamp(sampleLocation.y, vfloat(0.5f), size.y - 0.5f));
+    return clampedLocation / vfloat2(fsr2cpu::toFloat(resourceSize));
+}
+
+// The channels of R11G11B10_FLOAT are fp16 values without the sign bit and with 6 or 5 mantissa bits,
+// so unpacking only shifts them into place for the F16C conversion.
+inline vfloat3 unpackR11G11B10(vint packed)
+{
+    return vfloat3(
+        halfToFloat((packed & vint(0x7ff)) << 4),
+        halfToFloat((shiftRightLogical(packed, 11) & vint(0x7ff)) << 4),
+        halfToFloat(shiftRightLogical(packed, 22) << 5));
+}
+
+// Round to nearest even conversion to an unsigned float with a 5 bit exponent, negative values and NaN
+// become zero and overflow clamps to the largest finite value, like fsr2CpuEncodeTexel.
+inline vint floatToSmallFloat(vfloat value, int32_t mantissaBits)
+{
+    const int32_t shift = 23 - mantissaBits;
+    const vint bits = asInt(value);
+
+    // denormals are scaled to an integer, adding 2^23 rounds it into the low mantissa bits
+    const vint denormal = asInt(value * float(1u << (14 + mantissaBits)) + 8388608.0f) - vint(0x4b000000);
+    const vint normal = (bits - vint(0x38000000) + vint((1 << (shift - 1)) - 1) + ((bits >> shift) & vint(1))) >> shift;
+
+    const vint result = select(bits < vint(0x38800000), denormal, min(normal, vint((31 << mantissaBits) - 1)));
+    return select(value > 0.0f, result, vint(0));
+}
+
+inline vint packR11G11B10(const vfloat3& value)
+{
+    return floatToSmallFloat(value.x, 6) | (floatToSmallFloat(value.y, 6) << 11) | (floatToSmallFloat(value.z, 5) << 22);
+}
+
+// A mip of a host surface read and written by a whole packet at once. 32-bit float, fp16 and
+// R11G11B10 formats are accessed directly with gathers and converted in registers, any other format
+// falls back to decoding lane by lane.
+struct SimdSurface {
+
+    enum Layout {
+
+        LAYOUT_TEXEL,           // fsr2CpuLoad and fsr2CpuStore per lane
+        LAYOUT_FLOAT,           // 32-bit float channels
+        LAYOUT_HALF,            // pairs of fp16 channels in 32-bit words
+        LAYOUT_R11G11B10,       // a single 32-bit word
+    };
+
+    const Fsr2CpuSurface*       surface;
+    uint32_t                    mipLevel;
+    const uint8_t*              data;
+    int32_t                     width;
+    int32_t                     height;
+    int32_t                     rowPitch;
+    int32_t                     texelSize;
+    Layout                      layout;
+    int32_t                     channels;
+
+    SimdSurface(const Fsr2CpuSurface& surface_, uint32_t mipLevel_ = 0)
+        : surface(&surface_)
+        , mipLevel(mipLevel_)
+        , data(surface_.mips[mipLevel_].data)
+        , width(surface_.mips[mipLevel_].width)
+        , height(surface_.mips[mipLevel_].height)
+        , rowPitch(0)
+        , texelSize(0)
+        , layout(LAYOUT_TEXEL)
+        , channels(0)
+    {
+        if (!data) {
+            return;
+        }
+
+        texelSize = int32_t(fsr2CpuGetSurfaceFormatSize(surface_.format));
+
+        // gathers take 32-bit offsets
+        const size_t pitch = surface_.mips[mipLevel_].rowPitch;
+        if (pitch * size_t(height) > size_t(INT32_MAX)) {
+            return;
+        }
+        rowPitch = int32_t(pitch);
+
+        // R16_FLOAT stays per lane, a 32-bit gather of the last texel would read past the surface
+        switch (surface_.format) {
+
+            case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+            case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+                layout = LAYOUT_FLOAT;
+                channels = 4;
+                break;
+            case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+                layout = LAYOUT_FLOAT;
+                channels = 2;
+                break;
+            case FFX_SURFACE_FORMAT_R32_FLOAT:
+                layout = LAYOUT_FLOAT;
+                channels = 1;
+                break;
+            case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+                layout = LAYOUT_HALF;
+                channels = 4;
+                break;
+            case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+                layout = LAYOUT_HALF;
+                channels = 2;
+                break;
+            case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+                layout = LAYOUT_R11G11B10;
+                channels = 3;
+                break;
+            default:
+                break;
+        }
+    }
+
+    vmask inside(const vint2& pos, vmask active) const
+    {
+        return active & (pos.x >= vint(0)) & (pos.x < vint(width)) & (pos.y >= vint(0)) & (pos.y < vint(height));
+    }
+};
+
+// Typed load of the lanes in active, see fsr2CpuLoad.
+inline vfloat4 load(const SimdSurface& surface, const vint2& pos, vmask active)
+{
+    vfloat4 result(0.0f);
+    if (!surface.data) {
+        return result;
+    }
+
+    const vmask inside = surface.inside(pos, active);
+    if (!any(inside)) {
+        return result;
+    }
+
+    const vint offsets = pos.y * vint(surface.rowPitch) + pos.x * vint(surface.texelSize);
+    const float* base = reinterpret_cast<const float*>(surface.data);
+
+    switch (surface.layout) {
+
+        case SimdSurface::LAYOUT_FLOAT:
+            result.x = gather(base, offsets, inside);
+            result.y = surface.channels > 1 ? gather(base + 1, offsets, inside) : vfloat(0.0f);
+            result.z = surface.channels > 2 ? gather(base + 2, offsets, inside) : vfloat(0.0f);
+            result.w = surface.channels > 3 ? gather(base + 3, offsets, inside) : maskToFloat(inside);
+            return result;
+
+        case SimdSurface::LAYOUT_HALF: {
+            const vint xy = asInt(gather(base, offsets, inside));
+            result.x = halfToFloat(xy);
+            result.y = halfToFloat(shiftRightLogical(xy, 16));
+            if (surface.channels > 2) {
+                const vint zw = asInt(gather(base + 1, offsets, inside));
+                result.z = halfToFloat(zw);
+                result.w = halfToFloat(shiftRightLogical(zw, 16));
+            } else {
+                result.w = maskToFloat(inside);
+            }
+            return result;
+        }
+
+        case SimdSurface::LAYOUT_R11G11B10:
+            return vfloat4(unpackR11G11B10(asInt(gather(base, offsets, inside))), maskToFloat(inside));
+
+        default:
+            break;
+    }
+
+    int32_t x[SIMD_WIDTH], y[SIMD_WIDTH];
+    float channels[4][SIMD_WIDTH] = {};
+    storeLanes(x, pos.x);
+    storeLanes(y, pos.y);
+
+    const uint32_t laneMask = maskBits(inside);
+    for (int32_t lane = 0; lane < SIMD_WIDTH; ++lane) {
+
+        if (laneMask & (1u << lane)) {
+
+            const float4 value = fsr2CpuLoad(*surface.surface, x[lane], y[lane], surface.mipLevel);
+            channels[0][lane] = value.x;
+            channels[1][lane] = value.y;
+            channels[2][lane] = value.z;
+            channels[3][lane] = value.w;
+        }
+    }
+
+    return vfloat4(loadLanes(channels[0]), loadLanes(channels[1]), loadLanes(channels[2]), loadLanes(channels[3]));
+}
+
+// Typed store of the lanes in active, see fsr2CpuStore.
+inline void store(const SimdSurface& surface, const vint2& pos, vmask active, const vfloat4& value)
+{
+    if (!surface.data) {
+        return;
+    }
+
+    const vmask inside = surface.inside(pos, active);
+    const uint32_t laneMask = maskBits(inside);
+    if (!laneMask) {
+        return;
+    }
+
+    int32_t x[SIMD_WIDTH], y[SIMD_WIDTH];
+    float channels[4][SIMD_WIDTH];
+    storeLanes(x, pos.x);
+    storeLanes(y, pos.y);
+
+    // packed formats are encoded for the whole packet, then written a 32-bit word at a time
+    int32_t words[2][SIMD_WIDTH];
+    int32_t wordCount = 0;
+
+    switch (surface.layout) {
+
+        case SimdSurface::LAYOUT_HALF:
+            storeLanes(words[0], floatToHalf(value.x) | (floatToHalf(value.y) << 16));
+            if (surface.channels > 2) {
+                storeLanes(words[1], floatToHalf(value.z) | (floatToHalf(value.w) << 16));
+            }
+            wordCount = surface.channels / 2;
+            break;
+
+        case SimdSurface::LAYOUT_R11G11B10:
+            storeLanes(words[0], packR11G11B10(value.xyz()));
+            wordCount = 1;
+            break;
+
+        default:
+            storeLanes(channels[0], value.x);
+            storeLanes(channels[1], value.y);
+            storeLanes(channels[2], value.z);
+            storeLanes(channels[3], value.w);
+            break;
+    }
+
+    for (int32_t lane = 0; lane < SIMD_WIDTH; ++lane) {
+
+        if (!(laneMask & (1u << lane))) {
+            continue;
+        }
+
+        uint8_t* texel = const_cast<uint8_t*>(surface.data) + size_t(y[lane]) * size_t(surface.rowPitch) + size_t(x[lane]) * size_t(surface.texelSize);
+
+        if (wordCount) {
+
+            for (int32_t word = 0; word < wordCount; ++word) {
+                memcpy(texel + word * sizeof(int32_t), &words[word][lane], sizeof(int32_t));
+            }
+        } else if (surface.layout == SimdSurface::LAYOUT_FLOAT) {
+
+            for (int32_t channel = 0; channel < surface.channels; ++channel) {
+                reinterpret_cast<float*>(texel)[channel] = channels[channel][lane];
+            }
+        } else {
+
+            fsr2CpuStore(*surface.surface, x[lane], y[lane], float4(channels[0][lane], channels[1][lane], channels[2][lane], channels[3][lane]), surface.mipLevel);
+        }
+    }
+}
+
+// SampleLevel with a MIN_MAG_MIP_LINEAR / CLAMP sampler, see fsr2CpuSampleLinearClamp.
+inline vfloat4 sampleLinearClamp(const SimdSurface& surface, const vfloat2& uv, vmask active)
+{
+    if (!surface.data) {
+        return vfloat4(0.0f);
+    }
+
+    const vfloat px = uv.x * float(surface.width) - 0.5f;
+    const vfloat py = uv.y * float(surface.height) - 0.5f;
+    const vfloat fx = floor(px);
+    const vfloat fy = floor(py);
+    const vfloat wx = saturate(px - fx);
+    const vfloat wy = saturate(py - fy);
+
+    const vfloat maxX = float(surface.width - 1);
+    const vfloat maxY = float(surface.height - 1);
+    const vint x0 = truncToInt(clamp(fx, vfloat(0.0f), maxX));
+    const vint x1 = truncToInt(clamp(fx + 1.0f, vfloat(0.0f), maxX));
+    const vint y0 = truncToInt(clamp(fy, vfloat(0.0f), maxY));
+    const vint y1 = truncToInt(clamp(fy + 1.0f, vfloat(0.0f), maxY));
+
+    const vfloat4 c00 = load(surface, vint2(x0, y0), active);
+    const vfloat4 c10 = load(surface, vint2(x1, y0), active);
+    const vfloat4 c01 = load(surface, vint2(x0, y1), active);
+    const vfloat4 c11 = load(surface, vint2(x1, y1), active);
+
+    return lerp(lerp(c00, c10, wx), lerp(c01, c11, wx), wy);
+}
+
+// Running min/max/mean/variance of the neighborhood used for history rectification.
+struct RectificationBox {
+
+    vfloat3 boxCenter;
+    vfloat3 boxVec;
+    vfloat3 aabbMin;
+    vfloat3 aabbMax;
+    vfloat  fBoxCenterWeight;
+
+    void addSample(bool initialSample, const vfloat3& sample, vfloat weight)
+    {
+        if (initialSample) {
+            boxCenter = sample * vfloat3(weight);
+            boxVec = sample * sample * vfloat3(weight);
+            aabbMin = sample;
+            aabbMax = sample;
+            fBoxCenterWeight = weight;
+        } else {
+            boxCenter += sample * vfloat3(weight);
+            boxVec += sample * sample * vfloat3(weight);
+            aabbMin = min(aabbMin, sample);
+            aabbMax = max(aabbMax, sample);
+            fBoxCenterWeight += weight;
+        }
+    }
+
+    void computeVarianceBoxData()
+    {
+        const vfloat weight = select(abs(fBoxCenterWeight) > FSR2_EPSILON, fBoxCenterWeight, vfloat(1.0f));
+        boxCenter /= vfloat3(weight);
+        boxVec /= vfloat3(weight);
+        boxVec = sqrt(abs(boxVec - boxCenter * boxCenter));
+    }
+};
+
+} // namespace FSR2_CPU_SIMD_NAMESPACE
+} // namespace fsr2cpu
@@ -0,0 +1,206 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Host port of ffx_fsr2_tcr_autogen_pass.hlsl.
+
+#include "ffx_fsr2_cpu_common.h"
+
+using namespace fsr2cpu;
+
+namespace {
+
+static const float AUTOGEN_EPSILON = 0.01f;
+
+struct TcrAutogeneratePass : PassContext {
+
+    const Fsr2GenerateReactiveConstants2& autogen;
+    const Fsr2CpuSurface& opaqueOnly;
+    const Fsr2CpuSurface& inputColor;
+    const Fsr2CpuSurface& inputMotionVectors;
+    const Fsr2CpuSurface& prevPreAlpha;
+    const Fsr2CpuSurface& prevPostAlpha;
+    const Fsr2CpuSurface& reactiveMask;
+    const Fsr2CpuSurface& transparencyAndCompositionMask;
+    const Fsr2CpuSurface& autoReactive;
+    const Fsr2CpuSurface& autoComposition;
+    const Fsr2CpuSurface& rwPrevPreAlpha;
+    const Fsr2CpuSurface& rwPrevPostAlpha;
+
+    explicit TcrAutogeneratePass(const Fsr2CpuJob* job)
+        : PassContext(job)
+        , autogen(*reinterpret_cast<const Fsr2GenerateReactiveConstants2*>(job->cbs[1]))
+        , opaqueOnly(job->srvs[FSR2_CPU_TCR_AUTOGENERATE_SRV_INPUT_OPAQUE_ONLY])
+        , inputColor(job->srvs[FSR2_CPU_TCR_AUTOGENERATE_SRV_INPUT_COLOR])
+        , inputMotionVectors(job->srvs[FSR2_CPU_TCR_AUTOGENERATE_SRV_INPUT_MOTION_VECTORS])
+        , prevPreAlpha(job->srvs[FSR2_CPU_TCR_AUTOGENERATE_SRV_PREV_PRE_ALPHA_COLOR])
+        , prevPostAlpha(job->srvs[FSR2_CPU_TCR_AUTOGENERATE_SRV_PREV_POST_ALPHA_COLOR])
+        , reactiveMask(job->srvs[FSR2_CPU_TCR_AUTOGENERATE_SRV_REACTIVE_MASK])
+        , transparencyAndCompositionMask(job->srvs[FSR2_CPU_TCR_AUTOGENERATE_SRV_TRANSPARENCY_AND_COMPOSITION_MASK])
+        , autoReactive(job->uavs[FSR2_CPU_TCR_AUTOGENERATE_UAV_AUTOREACTIVE])
+        , autoComposition(job->uavs[FSR2_CPU_TCR_AUTOGENERATE_UAV_AUTOCOMPOSITION])
+        , rwPrevPreAlpha(job->uavs[FSR2_CPU_TCR_AUTOGENERATE_UAV_PREV_PRE_ALPHA_COLOR])
+        , rwPrevPostAlpha(job->uavs[FSR2_CPU_TCR_AUTOGENERATE_UAV_PREV_POST_ALPHA_COLOR])
+    {
+    }
+
+    static bool anyGreaterThanEpsilon(float3 v)
+    {
+        return fabsf(v.x) > AUTOGEN_EPSILON || fabsf(v.y) > AUTOGEN_EPSILON || fabsf(v.z) > AUTOGEN_EPSILON;
+    }
+
+    float computeAutoTC01(int2 pos, int2 prevIdx) const
+    {
+        const float3 colorPreAlpha = rgbToYCoCg(fsr2CpuLoad(opaqueOnly, pos).xyz());
+        const float3 colorPostAlpha = rgbToYCoCg(fsr2CpuLoad(inputColor, pos).xyz());
+        const float3 colorPrevPreAlpha = rgbToYCoCg(fsr2CpuLoad(prevPreAlpha, prevIdx).xyz());
+        const float3 colorPrevPostAlpha = rgbToYCoCg(fsr2CpuLoad(prevPostAlpha, prevIdx).xyz());
+
+        const float3 X = colorPreAlpha;
+        const float3 Y = colorPostAlpha;
+        const float3 Z = colorPrevPreAlpha;
+        const float3 W = colorPrevPostAlpha;
+
+        const float retVal = saturate(dot(abs(abs(Y - X) - abs(W - Z)), float3(1.0f)));
+
+        // cleanup very small values
+        return (retVal < autogen.autoTcThreshold) ? 0.0f : 1.0f;
+    }
+
+    float computeAutoTC02(int2 pos, int2 prevIdx) const
+    {
+        const float3 colorPreAlpha = rgbToYCoCg(fsr2CpuLoad(opaqueOnly, pos).xyz());
+        const float3 colorPostAlpha = rgbToYCoCg(fsr2CpuLoad(inputColor, pos).xyz());
+        const float3 colorPrevPreAlpha = rgbToYCoCg(fsr2CpuLoad(prevPreAlpha, prevIdx).xyz());
+        const float3 colorPrevPostAlpha = rgbToYCoCg(fsr2CpuLoad(prevPostAlpha, prevIdx).xyz());
+
+        const bool hasAlpha = anyGreaterThanEpsilon(colorPostAlpha - colorPreAlpha);
+        const bool hadAlpha = anyGreaterThanEpsilon(colorPrevPostAlpha - colorPrevPreAlpha);
+
+        const float3 N = colorPreAlpha - colorPrevPreAlpha;
+        const float3 NminusNA = colorPostAlpha - colorPrevPostAlpha;
+
+        const float3 A = (hasAlpha || hadAlpha) ? NminusNA / max(float3(AUTOGEN_EPSILON), N) : float3(0.0f);
+
+        const float retVal = max3(A.x, A.y, A.z);
+
+        // only pixels that have significantly changed in color shuold be considered
+        return saturate(retVal * length(colorPostAlpha - colorPrevPostAlpha));
+    }
+
+    float computeTransparencyAndComposition(int2 pos, int2 prevIdx) const
+    {
+        float retVal = computeAutoTC02(pos, prevIdx);
+        if (retVal > 0.01f) {
+            retVal = computeAutoTC01(pos, prevIdx);
+        }
+        return retVal;
+    }
+
+    float computeSolidEdge(int2 curPos, int2 prevPos) const
+    {
+        float lum[9];
+        int32_t i = 0;
+        for (int32_t y = -1; y < 2; ++y) {
+            for (int32_t x = -1; x < 2; ++x) {
+
+                const float3 curCol = fsr2CpuLoad(opaqueOnly, curPos + int2(x, y)).xyz();
+                const float3 prevCol = fsr2CpuLoad(prevPreAlpha, prevPos + int2(x, y)).xyz();
+                lum[i++] = length(curCol - prevCol);
+            }
+        }
+
+        const float gradX = fabsf(lum[3] - lum[4]) * fabsf(lum[5] - lum[4]);
+        const float gradY = fabsf(lum[1] - lum[4]) * fabsf(lum[7] - lum[4]);
+        return sqrtf(sqrtf(gradX * gradY));
+    }
+
+    float computeAlphaEdge(int2 curPos, int2 prevPos) const
+    {
+        float lum[9];
+        int32_t i = 0;
+        for (int32_t y = -1; y < 2; ++y) {
+            for (int32_t x = -1; x < 2; ++x) {
+
+                const float3 curCol = abs(fsr2CpuLoad(inputColor, curPos + int2(x, y)).xyz() - fsr2CpuLoad(opaqueOnly, curPos + int2(x, y)).xyz());
+                const float3 prevCol = abs(fsr2CpuLoad(prevPostAlpha, prevPos + int2(x, y)).xyz() - fsr2CpuLoad(prevPreAlpha, prevPos + int2(x, y)).xyz());
+                lum[i++] = length(curCol - prevCol);
+            }
+        }
+
+        const float gradX = fabsf(lum[3] - lum[4]) * fabsf(lum[5] - lum[4]);
+        const float gradY = fabsf(lum[1] - lum[4]) * fabsf(lum[7] - lum[4]);
+        return sqrtf(sqrtf(gradX * gradY));
+    }
+
+    float computeReactive(int2 pos, int2 prevIdx) const
+    {
+        // mark pixels with huge variance in alpha as reactive
+        const float alphaEdge = computeAlphaEdge(pos, prevIdx);
+        const float opaqueEdge = computeSolidEdge(pos, prevIdx);
+        return saturate(alphaEdge - opaqueEdge);
+    }
+
+    void execute(int2 pos) const
+    {
+        const float2 uv = (toFloat(pos) + float2(0.5f)) / toFloat(renderSize());
+        const float2 prevUv = uv + loadInputMotionVector(inputMotionVectors, pos);
+        const int2 prevIdx = toInt(prevUv * toFloat(renderSize()) - 0.5f);
+
+        const float3 colorPreAlpha = fsr2CpuLoad(opaqueOnly, pos).xyz();
+        const float3 colorPostAlpha = fsr2CpuLoad(inputColor, pos).xyz();
+
+        float2 outReactiveMask;
+        outReactiveMask.y = computeTransparencyAndComposition(pos, prevIdx);
+
+        if (outReactiveMask.y > 0.5f) {
+            outReactiveMask.x = computeReactive(pos, prevIdx);
+            outReactiveMask.x *= autogen.autoReactiveScale;
+            outReactiveMask.x = outReactiveMask.x < autogen.autoReactiveMax ? outReactiveMask.x : autogen.autoReactiveMax;
+        }
+
+        outReactiveMask.y *= autogen.autoTcScale;
+
+        outReactiveMask.x = max(outReactiveMask.x, fsr2CpuLoad(reactiveMask, pos).x);
+        outReactiveMask.y = max(outReactiveMask.y, fsr2CpuLoad(transparencyAndCompositionMask, pos).x);
+
+        fsr2CpuStore(autoReactive, pos, float4(outReactiveMask.x));
+        fsr2CpuStore(autoComposition, pos, float4(outReactiveMask.y));
+
+        fsr2CpuStore(rwPrevPreAlpha, pos, float4(colorPreAlpha, 0.0f));
+        fsr2CpuStore(rwPrevPostAlpha, pos, float4(colorPostAlpha, 0.0f));
+    }
+};
+
+} // namespace
+
+void fsr2CpuTcrAutogenerateKernel(const Fsr2CpuJob* job, uint32_t groupX, uint32_t groupY, void* groupShared)
+{
+    FFX_UNUSED(groupShared);
+
+    const TcrAutogeneratePass pass(job);
+
+    for (int32_t threadY = 0; threadY < 8; ++threadY) {
+        for (int32_t threadX = 0; threadX < 8; ++threadX) {
+
+            pass.execute(int2(int32_t(groupX * 8) + threadX, int32_t(groupY * 8) + threadY));
+        }
+    }
+}
@@ -26,6 +26,8 @@
 #include <d3d12shader.h>
 #include "d3dx12.h"
 #include "../ffx_fsr2.h"
+#include "../ffx_fsr2_device_cache.h"
+#include "../ffx_fsr2_trace.h"
 #include "ffx_fsr2_dx12.h"
 #include "shaders/ffx_fsr2_shaders_dx12.h"  // include all the precompiled D3D12 shaders for the FSR2 passes
 #include "../ffx_fsr2_private.h"
@@ -43,9 +45,10 @@ FfxErrorCode CreatePipelineDX12(FfxFsr2Interface* backendInterface, FfxFsr2Pass
 FfxErrorCode DestroyPipelineDX12(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline);
 FfxErrorCode ScheduleGpuJobDX12(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job);
 FfxErrorCode ExecuteGpuJobsDX12(FfxFsr2Interface* backendInterface, FfxCommandList commandList);
+FfxErrorCode GetGpuJobStatisticsDX12(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount);
 
 #define FSR2_MAX_QUEUED_FRAMES  ( 4)
-#define FSR2_MAX_RESOURCE_COUNT (64)
+#define FSR2_MAX_RESOURCE_COUNT (64 + FFX_FSR2_MAX_VIEW_RESOURCE_COUNT * (FFX_FSR2_MAX_VIEW_COUNT - 1))
 #define FSR2_DESC_RING_SIZE     (FSR2_MAX_QUEUED_FRAMES * FFX_FSR2_PASS_COUNT * FSR2_MAX_RESOURCE_COUNT)
 #define FSR2_MAX_BARRIERS       (16)
 #define FSR2_MAX_GPU_JOBS       (32)
@@ -89,6 +92,11 @@ typedef struct BackendContext_DX12 {
 
     D3D12_RESOURCE_BARRIER  barriers[FSR2_MAX_BARRIERS];
     uint32_t                barrierCount;
+
+    // barriers added since the backend context was created, and per job of the last execute call
+    uint32_t                addedBarrierCount;
+    FfxGpuJobStatistics     jobStatistics[FSR2_MAX_GPU_JOBS];
+    uint32_t                jobStatisticsCount;
 } BackendContext_DX12;
 
 FFX_API size_t ffxFsr2GetScratchMemorySizeDX12()
@@ -125,6 +133,11 @@ FfxErrorCode ffxFsr2GetInterfaceDX12(
     outInterface->fpDestroyPipeline = DestroyPipelineDX12;
     outInterface->fpScheduleGpuJob = ScheduleGpuJobDX12;
     outInterface->fpExecuteGpuJobs = ExecuteGpuJobsDX12;
+    outInterface->fpReadResource = NULL;    // internal resources are not accessed from the host
+    outInterface->fpWriteResource = NULL;
+    outInterface->fpGetGpuJobStatistics = GetGpuJobStatisticsDX12;
+    outInterface->fpGetResourceMemoryRequirements = NULL;   // transient resources are created in dedicated allocations
+    outInterface->fpCreateTransientHeap = NULL;
     outInterface->scratchBuffer = scratchBuffer;
     outInterface->scratchBufferSize = scratchBufferSize;
 
@@ -610,6 +623,9 @@ FfxErrorCode GetDeviceCapabilitiesDX12(FfxFsr2Interface* backendInterface, FfxDe
         deviceCapabilities->raytracingSupported = (d3d12Options5.RaytracingTier != D3D12_RAYTRACING_TIER_NOT_SUPPORTED);
     }
 
+    // the job list and the descriptor ring are sized for a single frame per execution
+    deviceCapabilities->maximumBatchedFrameCount = 0;
+
     return FFX_OK;
 }
 
@@ -694,6 +710,49 @@ FfxErrorCode DestroyBackendContextDX12(FfxFsr2Interface* backendInterface)
     return FFX_OK;
 }
 
+// Take the slot of a destroyed internal resource, or a new one below the dynamic resources of a frame,
+// so that resizing a context does not use up the store.
+static FfxErrorCode allocateStaticResourceDX12(BackendContext_DX12* backendContext, int32_t* outIndex)
+{
+    uint32_t resourceIndex = 1;
+    while (resourceIndex < backendContext->nextStaticResource && backendContext->resources[resourceIndex].resourcePtr) {
+        ++resourceIndex;
+    }
+
+    if (resourceIndex == backendContext->nextStaticResource) {
+
+        FFX_RETURN_ON_ERROR(
+            backendContext->nextStaticResource + 1 < backendContext->nextDynamicResource,
+            FFX_ERROR_OUT_OF_MEMORY);
+        ++backendContext->nextStaticResource;
+    }
+
+    backendContext->resources[resourceIndex] = {};
+    *outIndex = int32_t(resourceIndex);
+    return FFX_OK;
+}
+
+// First fit of a range of static UAV descriptors around the ones the live internal resources hold,
+// which reuses the descriptors of destroyed resources.
+static uint32_t findStaticUavDescriptorsDX12(const BackendContext_DX12* backendContext, uint32_t descriptorCount)
+{
+    uint32_t firstDescriptor = 0;
+    for (uint32_t resourceIndex = 1; resourceIndex < backendContext->nextStaticResource; ++resourceIndex) {
+
+        const BackendContext_DX12::Resource* resource = &backendContext->resources[resourceIndex];
+        if (resource->resourcePtr && resource->uavDescCount
+            && firstDescriptor < resource->uavDescIndex + resource->uavDescCount
+            && resource->uavDescIndex < firstDescriptor + descriptorCount) {
+
+            // move past the range of this resource and check all of them again
+            firstDescriptor = resource->uavDescIndex + resource->uavDescCount;
+            resourceIndex = 0;
+        }
+    }
+
+    return firstDescriptor;
+}
+
 // create a internal resource that will stay alive until effect gets shut down
 FfxErrorCode CreateResourceDX12(
     FfxFsr2Interface* backendInterface,
@@ -722,9 +781,9 @@ FfxErrorCode CreateResourceDX12(
     dx12ResourceDescription.SampleDesc.Count = 1;
     dx12ResourceDescription.Flags = ffxGetDX12ResourceFlags(createResourceDescription->usage);
     
-    FFX_ASSERT(backendContext->nextStaticResource + 1 < backendContext->nextDynamicResource);
+    const FfxErrorCode slotErrorCode = allocateStaticResourceDX12(backendContext, &outTexture->internalIndex);
+    FFX_RETURN_ON_ERROR(slotErrorCode == FFX_OK, slotErrorCode);
 
-    outTexture->internalIndex = backendContext->nextStaticResource++;
     BackendContext_DX12::Resource* backendResource = &backendContext->resources[outTexture->internalIndex];
     backendResource->resourceDescription = createResourceDescription->resourceDescription;
 
@@ -877,10 +936,13 @@ FfxErrorCode CreateResourceDX12(
                 if (dx12Resource->GetDesc().Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) {
 
                     const int32_t uavDescriptorCount = (dx12Resource->GetDesc().Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) ? dx12Resource->GetDesc().MipLevels : 1;
-                    FFX_ASSERT(backendContext->nextStaticUavDescriptor + uavDescriptorCount < backendContext->nextDynamicResource);
+                    const uint32_t uavDescriptorIndex = findStaticUavDescriptorsDX12(backendContext, uavDescriptorCount);
+                    FFX_RETURN_ON_ERROR(
+                        uavDescriptorIndex + uavDescriptorCount <= backendContext->nextDynamicUavDescriptor,
+                        FFX_ERROR_OUT_OF_MEMORY);
 
                     backendResource->uavDescCount = uavDescriptorCount;
-                    backendResource->uavDescIndex = backendContext->nextStaticUavDescriptor;
+                    backendResource->uavDescIndex = uavDescriptorIndex;
 
                     for (int32_t currentMipIndex = 0; currentMipIndex < uavDescriptorCount; ++currentMipIndex) {
 
@@ -895,7 +957,7 @@ FfxErrorCode CreateResourceDX12(
                         dx12Device->CreateUnorderedAccessView(dx12Resource, 0, &dx12UavDescription, dx12CpuHandle);
                     }
 
-                    backendContext->nextStaticUavDescriptor += uavDescriptorCount;
+                    backendContext->nextStaticUavDescriptor = FFX_MAXIMUM(backendContext->nextStaticUavDescriptor, uavDescriptorIndex + uavDescriptorCount);
                 }
             }
         }
@@ -909,7 +971,8 @@ FfxErrorCode CreateResourceDX12(
             uploadDescription.usage = FFX_RESOURCE_USAGE_READ_ONLY;
             uploadDescription.initalState = FFX_RESOURCE_STATE_GENERIC_READ;
 
-            backendInterface->fpCreateResource(backendInterface, &uploadDescription, &copySrc);
+            const FfxErrorCode uploadErrorCode = backendInterface->fpCreateResource(backendInterface, &uploadDescription, &copySrc);
+            FFX_RETURN_ON_ERROR(uploadErrorCode == FFX_OK, uploadErrorCode);
 
             // setup the upload job
             FfxGpuJobDescription copyJob = {
@@ -938,73 +1001,32 @@ FfxResourceDescription GetResourceDescriptorDX12(
     return resourceDescription;
 }
 
-FfxErrorCode CreatePipelineDX12(
-    FfxFsr2Interface* backendInterface,
-    FfxFsr2Pass pass,
-    const FfxPipelineDescription* pipelineDescription,
-    FfxPipelineState* outPipeline)
-{
-    FFX_ASSERT(NULL != backendInterface);
-    FFX_ASSERT(NULL != pipelineDescription);
-
-    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
-    ID3D12Device* dx12Device = backendContext->device;
-
-    // check if we have shader model 6.6
-    bool haveShaderModel66 = true;
-    D3D12_FEATURE_DATA_SHADER_MODEL dx12ShaderModel = { D3D_SHADER_MODEL_6_6 };
-
-    HRESULT result = dx12Device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &dx12ShaderModel, sizeof(D3D12_FEATURE_DATA_SHADER_MODEL));
-
-    if (SUCCEEDED(result))
-        haveShaderModel66 = dx12ShaderModel.HighestShaderModel >= D3D_SHADER_MODEL_6_6;
-    else
-        haveShaderModel66 = false;
-
-    // check if we can force wave64 mode.
-    D3D12_FEATURE_DATA_D3D12_OPTIONS1 d3d12Options1 = {};
-    bool canForceWave64 = false;
-    bool useLut = false;
-    result = dx12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &d3d12Options1, sizeof(d3d12Options1));
-    if (SUCCEEDED(result)) {
-
-        const uint32_t waveLaneCountMin = d3d12Options1.WaveLaneCountMin;
-        const uint32_t waveLaneCountMax = d3d12Options1.WaveLaneCountMax;
-
-        if (waveLaneCountMin == 32 && waveLaneCountMax == 64) {
+// the root signature and PSO of a pipeline, shared by the contexts of a device
+typedef struct PipelineObjectsDX12 {
 
-            useLut = true;
-            canForceWave64 = haveShaderModel66;
-        }
-        else {
+    ID3D12RootSignature*    rootSignature;
+    ID3D12PipelineState*    pipeline;
 
-            canForceWave64 = false;
-        }
-    }
+    bool operator==(const PipelineObjectsDX12& other) const { return pipeline == other.pipeline; }
+} PipelineObjectsDX12;
 
-    // check if we have 16bit floating point.
-    bool supportedFP16 = false;
-    D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Options = {};
-    result = dx12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &d3d12Options, sizeof(d3d12Options));
-    if (SUCCEEDED(result)) {
+typedef struct PipelineKeyDX12 {
 
-        supportedFP16 = !!(d3d12Options.MinPrecisionSupport & D3D12_SHADER_MIN_PRECISION_SUPPORT_16_BIT);
-    }
+    ID3D12Device*           device;
+    FfxFsr2Pass             pass;
+    uint32_t                permutationFlags;
 
-    // work out what permutation to load.
-    uint32_t flags = 0;
-    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_HIGH_DYNAMIC_RANGE) ? FSR2_SHADER_PERMUTATION_HDR_COLOR_INPUT : 0;
-    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS) ? 0 : FSR2_SHADER_PERMUTATION_LOW_RES_MOTION_VECTORS;
-    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_MOTION_VECTORS_JITTER_CANCELLATION) ? FSR2_SHADER_PERMUTATION_JITTER_MOTION_VECTORS : 0;
-    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_DEPTH_INVERTED) ? FSR2_SHADER_PERMUTATION_DEPTH_INVERTED : 0;
-    flags |= (pass == FFX_FSR2_PASS_ACCUMULATE_SHARPEN) ? FSR2_SHADER_PERMUTATION_ENABLE_SHARPENING : 0;
-    flags |= (useLut) ? FSR2_SHADER_PERMUTATION_USE_LANCZOS_TYPE : 0;
-    flags |= (canForceWave64) ? FSR2_SHADER_PERMUTATION_FORCE_WAVE64 : 0;
-    flags |= (supportedFP16 && (pass != FFX_FSR2_PASS_RCAS)) ? FSR2_SHADER_PERMUTATION_ALLOW_FP16 : 0;
+    bool operator==(const PipelineKeyDX12& other) const { return device == other.device && pass == other.pass && permutationFlags == other.permutationFlags; }
+} PipelineKeyDX12;
 
-    const Fsr2ShaderBlobDX12 shaderBlob = fsr2GetPermutationBlobByIndexDX12(pass, flags);
-    FFX_ASSERT(shaderBlob.data && shaderBlob.size);
+static Fsr2DeviceCache<PipelineKeyDX12, PipelineObjectsDX12> pipelineCacheDX12;
 
+static FfxErrorCode createPipelineObjectsDX12(
+    ID3D12Device* dx12Device,
+    const FfxPipelineDescription* pipelineDescription,
+    const Fsr2ShaderBlobDX12& shaderBlob,
+    PipelineObjectsDX12* outObjects)
+{
     // set up root signature
     // easiest implementation: simply create one root signature per pipeline
     // should add some management later on to avoid unnecessarily re-binding the root signature
@@ -1158,7 +1180,7 @@ FfxErrorCode CreatePipelineDX12(
                 size_t blobSize = outBlob->GetBufferSize();
                 int64_t* blobData = (int64_t*)outBlob->GetBufferPointer();
 
-                result = dx12Device->CreateRootSignature(0, outBlob->GetBufferPointer(), outBlob->GetBufferSize(), IID_PPV_ARGS(reinterpret_cast<ID3D12RootSignature**>(&outPipeline->rootSignature)));
+                result = dx12Device->CreateRootSignature(0, outBlob->GetBufferPointer(), outBlob->GetBufferSize(), IID_PPV_ARGS(&outObjects->rootSignature));
                 if (FAILED(result)) {
 
                     return FFX_ERROR_BACKEND_API_ERROR;
@@ -1171,7 +1193,102 @@ FfxErrorCode CreatePipelineDX12(
         }
     }
 
-    ID3D12RootSignature* dx12RootSignature = reinterpret_cast<ID3D12RootSignature*>(outPipeline->rootSignature);
+    // create the PSO
+    D3D12_COMPUTE_PIPELINE_STATE_DESC dx12PipelineStateDescription = {};
+    dx12PipelineStateDescription.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+    dx12PipelineStateDescription.pRootSignature = outObjects->rootSignature;
+    dx12PipelineStateDescription.CS.pShaderBytecode = shaderBlob.data;
+    dx12PipelineStateDescription.CS.BytecodeLength = shaderBlob.size;
+    HRESULT result = dx12Device->CreateComputePipelineState(&dx12PipelineStateDescription, IID_PPV_ARGS(&outObjects->pipeline));
+
+    if (FAILED(result)) {
+
+        outObjects->rootSignature->Release();
+        return FFX_ERROR_BACKEND_API_ERROR;
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode CreatePipelineDX12(
+    FfxFsr2Interface* backendInterface,
+    FfxFsr2Pass pass,
+    const FfxPipelineDescription* pipelineDescription,
+    FfxPipelineState* outPipeline)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_ASSERT(NULL != pipelineDescription);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    ID3D12Device* dx12Device = backendContext->device;
+
+    // check if we have shader model 6.6
+    bool haveShaderModel66 = true;
+    D3D12_FEATURE_DATA_SHADER_MODEL dx12ShaderModel = { D3D_SHADER_MODEL_6_6 };
+
+    HRESULT result = dx12Device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &dx12ShaderModel, sizeof(D3D12_FEATURE_DATA_SHADER_MODEL));
+
+    if (SUCCEEDED(result))
+        haveShaderModel66 = dx12ShaderModel.HighestShaderModel >= D3D_SHADER_MODEL_6_6;
+    else
+        haveShaderModel66 = false;
+
+    // check if we can force wave64 mode.
+    D3D12_FEATURE_DATA_D3D12_OPTIONS1 d3d12Options1 = {};
+    bool canForceWave64 = false;
+    bool useLut = false;
+    result = dx12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &d3d12Options1, sizeof(d3d12Options1));
+    if (SUCCEEDED(result)) {
+
+        const uint32_t waveLaneCountMin = d3d12Options1.WaveLaneCountMin;
+        const uint32_t waveLaneCountMax = d3d12Options1.WaveLaneCountMax;
+
+        if (waveLaneCountMin == 32 && waveLaneCountMax == 64) {
+
+            useLut = true;
+            canForceWave64 = haveShaderModel66;
+        }
+        else {
+
+            canForceWave64 = false;
+        }
+    }
+
+    // check if we have 16bit floating point.
+    bool supportedFP16 = false;
+    D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Options = {};
+    result = dx12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &d3d12Options, sizeof(d3d12Options));
+    if (SUCCEEDED(result)) {
+
+        supportedFP16 = !!(d3d12Options.MinPrecisionSupport & D3D12_SHADER_MIN_PRECISION_SUPPORT_16_BIT);
+    }
+
+    // work out what permutation to load.
+    uint32_t flags = 0;
+    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_HIGH_DYNAMIC_RANGE) ? FSR2_SHADER_PERMUTATION_HDR_COLOR_INPUT : 0;
+    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS) ? 0 : FSR2_SHADER_PERMUTATION_LOW_RES_MOTION_VECTORS;
+    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_MOTION_VECTORS_JITTER_CANCELLATION) ? FSR2_SHADER_PERMUTATION_JITTER_MOTION_VECTORS : 0;
+    flags |= (pipelineDescription->contextFlags & FFX_FSR2_ENABLE_DEPTH_INVERTED) ? FSR2_SHADER_PERMUTATION_DEPTH_INVERTED : 0;
+    flags |= (pass == FFX_FSR2_PASS_ACCUMULATE_SHARPEN) ? FSR2_SHADER_PERMUTATION_ENABLE_SHARPENING : 0;
+    flags |= (useLut) ? FSR2_SHADER_PERMUTATION_USE_LANCZOS_TYPE : 0;
+    flags |= (canForceWave64) ? FSR2_SHADER_PERMUTATION_FORCE_WAVE64 : 0;
+    flags |= (supportedFP16 && (pass != FFX_FSR2_PASS_RCAS)) ? FSR2_SHADER_PERMUTATION_ALLOW_FP16 : 0;
+
+    const Fsr2ShaderBlobDX12 shaderBlob = fsr2GetPermutationBlobByIndexDX12(pass, flags);
+    FFX_ASSERT(shaderBlob.data && shaderBlob.size);
+
+    // pipelines are shared by all contexts on the device that use the same permutation, the
+    // frontend describes the samplers and root constants of a pass the same way for every context
+    const PipelineKeyDX12 key = { dx12Device, pass, flags };
+    PipelineObjectsDX12 pipelineObjects = {};
+    const FfxErrorCode errorCode = pipelineCacheDX12.acquire(key, &pipelineObjects, [&](PipelineObjectsDX12* outObjects) {
+
+        return createPipelineObjectsDX12(dx12Device, pipelineDescription, shaderBlob, outObjects);
+    });
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    outPipeline->rootSignature = reinterpret_cast<FfxRootSignature>(pipelineObjects.rootSignature);
+    outPipeline->pipeline = reinterpret_cast<FfxPipeline>(pipelineObjects.pipeline);
 
     // populate the pass.
     outPipeline->srvCount = shaderBlob.srvCount;
@@ -1194,19 +1311,6 @@ FfxErrorCode CreatePipelineDX12(
         wcscpy_s(outPipeline->cbResourceBindings[cbIndex].name, converter.from_bytes(shaderBlob.boundCBVResourceNames[cbIndex]).c_str());
     }
 
-    // create the PSO
-    D3D12_COMPUTE_PIPELINE_STATE_DESC dx12PipelineStateDescription = {};
-    dx12PipelineStateDescription.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-    dx12PipelineStateDescription.pRootSignature = dx12RootSignature;
-    dx12PipelineStateDescription.CS.pShaderBytecode = shaderBlob.data;
-    dx12PipelineStateDescription.CS.BytecodeLength = shaderBlob.size;
-    result = dx12Device->CreateComputePipelineState(&dx12PipelineStateDescription, IID_PPV_ARGS(reinterpret_cast<ID3D12PipelineState**>(&outPipeline->pipeline)));
-
-    if (FAILED(result)) {
-
-        return FFX_ERROR_BACKEND_API_ERROR;
-    }
-
     return FFX_OK;
 }
 
@@ -1262,11 +1366,13 @@ void addBarrier(BackendContext_DX12* backendContext, FfxResourceInternal* resour
 
         *currentState = newState;
         ++backendContext->barrierCount;
+        ++backendContext->addedBarrierCount;
 
     } else if(newState == FFX_RESOURCE_STATE_UNORDERED_ACCESS) {
         
         *barrier = CD3DX12_RESOURCE_BARRIER::UAV(dx12Resource);
         ++backendContext->barrierCount;
+        ++backendContext->addedBarrierCount;
     }
 }
 
@@ -1461,33 +1567,51 @@ FfxErrorCode ExecuteGpuJobsDX12(
     FFX_ASSERT(NULL != backendInterface);
 
     BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    const FfxFsr2TraceScope traceScope("ExecuteGpuJobsDX12", "backend");
 
     FfxErrorCode errorCode = FFX_OK;
 
+    // jobs are not timed, only their barriers are counted
+    memset(backendContext->jobStatistics, 0, sizeof(backendContext->jobStatistics));
+    backendContext->jobStatisticsCount = backendContext->gpuJobCount;
+
     // execute all GpuJobs
     for (uint32_t currentGpuJobIndex = 0; currentGpuJobIndex < backendContext->gpuJobCount; ++currentGpuJobIndex) {
 
         FfxGpuJobDescription* GpuJob = &backendContext->gpuJobs[currentGpuJobIndex];
         ID3D12GraphicsCommandList* dx12CommandList = reinterpret_cast<ID3D12GraphicsCommandList*>(commandList);
         ID3D12Device* dx12Device = reinterpret_cast<ID3D12Device*>(backendContext->device);
+        const uint32_t firstBarrier = backendContext->addedBarrierCount;
 
+        // the trace holds the time spent recording each job, the device executes it later
         switch (GpuJob->jobType) {
 
             case FFX_GPU_JOB_CLEAR_FLOAT:
+            {
+                const FfxFsr2TraceScope jobTraceScope("Clear", "record");
                 errorCode = executeGpuJobClearFloat(backendContext, GpuJob, dx12Device, dx12CommandList);
                 break;
+            }
 
             case FFX_GPU_JOB_COPY:
+            {
+                const FfxFsr2TraceScope jobTraceScope("Copy", "record");
                 errorCode = executeGpuJobCopy(backendContext, GpuJob, dx12Device, dx12CommandList);
                 break;
+            }
 
             case FFX_GPU_JOB_COMPUTE:
+            {
+                const FfxFsr2TraceScope jobTraceScope("Dispatch", "record");
                 errorCode = executeGpuJobCompute(backendContext, GpuJob, dx12Device, dx12CommandList);
                 break;
+            }
 
             default:
                 break;
         }
+
+        backendContext->jobStatistics[currentGpuJobIndex].barrierCount = backendContext->addedBarrierCount - firstBarrier;
     }
 
     // check the execute function returned cleanly.
@@ -1500,6 +1624,18 @@ FfxErrorCode ExecuteGpuJobsDX12(
     return FFX_OK;
 }
 
+FfxErrorCode GetGpuJobStatisticsDX12(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_RETURN_ON_ERROR(outStatistics && inoutJobCount, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
+    *inoutJobCount = FFX_MINIMUM(*inoutJobCount, backendContext->jobStatisticsCount);
+    memcpy(outStatistics, backendContext->jobStatistics, *inoutJobCount * sizeof(FfxGpuJobStatistics));
+
+    return FFX_OK;
+}
+
 FfxErrorCode DestroyResourceDX12(
     FfxFsr2Interface* backendInterface,
     FfxResourceInternal resource)
@@ -1527,18 +1663,19 @@ FfxErrorCode DestroyPipelineDX12(
         return FFX_OK;
     }
 
-    // destroy Rootsignature
-    ID3D12RootSignature* dx12RootSignature = reinterpret_cast<ID3D12RootSignature*>(pipeline->rootSignature);
-    if (dx12RootSignature) {
-        dx12RootSignature->Release();
-    }
-    pipeline->rootSignature = nullptr;
+    // the root signature and pipeline are destroyed with the last context using them
+    const PipelineObjectsDX12 pipelineObjects = {
+        reinterpret_cast<ID3D12RootSignature*>(pipeline->rootSignature),
+        reinterpret_cast<ID3D12PipelineState*>(pipeline->pipeline) };
+    if (pipelineObjects.pipeline) {
+
+        pipelineCacheDX12.release(pipelineObjects, [](const PipelineObjectsDX12& objects) {
 
-    // destroy pipeline
-    ID3D12PipelineState* dx12Pipeline = reinterpret_cast<ID3D12PipelineState*>(pipeline->pipeline);
-    if (dx12Pipeline) {
-        dx12Pipeline->Release();
+            objects.rootSignature->Release();
+            objects.pipeline->Release();
+        });
     }
+    pipeline->rootSignature = nullptr;
     pipeline->pipeline = nullptr;
 
     return FFX_OK;
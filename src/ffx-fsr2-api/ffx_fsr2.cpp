@@ -23,7 +23,10 @@
 #include <cmath>        // for fabs, abs, sinf, sqrt, etc.
 #include <string.h>     // for memset
 #include <cfloat>       // for FLT_EPSILON
+#include <chrono>       // for steady_clock used by the statistics
+#include <vector>       // for the history carried over a resize
 #include "ffx_fsr2.h"
+#include "ffx_fsr2_trace.h"
 #define FFX_CPU
 #include "shaders/ffx_core.h"
 #include "shaders/ffx_fsr1.h"
@@ -120,44 +123,6 @@ typedef enum Fsr2RootSignatureLayout {
     FSR2_ROOT_SIGNATURE_LAYOUT_PARAMETER_COUNT
 } Fsr2RootSignatureLayout;
 
-typedef struct Fsr2RcasConstants {
-
-    uint32_t                    rcasConfig[4];
-} FfxRcasConstants;
-
-typedef struct Fsr2SpdConstants {
-
-    uint32_t                    mips;
-    uint32_t                    numworkGroups;
-    uint32_t                    workGroupOffset[2];
-    uint32_t                    renderSize[2];
-} Fsr2SpdConstants;
-
-typedef struct Fsr2GenerateReactiveConstants
-{
-    float       scale;
-    float       threshold;
-    float       binaryValue;
-    uint32_t    flags;
-
-} Fsr2GenerateReactiveConstants;
-
-typedef struct Fsr2GenerateReactiveConstants2
-{
-    float       autoTcThreshold;
-    float       autoTcScale;
-    float       autoReactiveScale;
-    float       autoReactiveMax;
-
-} Fsr2GenerateReactiveConstants2;
-
-typedef union Fsr2SecondaryUnion {
-
-    Fsr2RcasConstants               rcas;
-    Fsr2SpdConstants                spd;
-    Fsr2GenerateReactiveConstants2  autogenReactive;
-} Fsr2SecondaryUnion;
-
 typedef struct Fsr2ResourceDescription {
 
     uint32_t                    id;
@@ -172,11 +137,11 @@ typedef struct Fsr2ResourceDescription {
     void*                       initData;
 } Fsr2ResourceDescription;
 
-FfxConstantBuffer globalFsr2ConstantBuffers[4] = {
-    { sizeof(Fsr2Constants) / sizeof(uint32_t) },
-    { sizeof(Fsr2SpdConstants) / sizeof(uint32_t) },
-    { sizeof(Fsr2RcasConstants) / sizeof(uint32_t) },
-    { sizeof(Fsr2GenerateReactiveConstants) / sizeof(uint32_t) }
+static const uint32_t constantBufferSizeTable[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_COUNT] = {
+    sizeof(Fsr2Constants) / sizeof(uint32_t),
+    sizeof(Fsr2SpdConstants) / sizeof(uint32_t),
+    sizeof(Fsr2RcasConstants) / sizeof(uint32_t),
+    sizeof(Fsr2GenerateReactiveConstants) / sizeof(uint32_t)
 };
 
 // Lanczos
@@ -430,75 +395,132 @@ static FfxErrorCode createPipelineStates(FfxFsr2Context_Private* context)
     return FFX_OK;
 }
 
-static FfxErrorCode generateReactiveMaskInternal(FfxFsr2Context_Private* contextPrivate, const FfxFsr2DispatchDescription* params);
+// The resources each view of a context owns, the ones read by later frames. Every other resource is
+// shared by the views.
+static const uint32_t viewResourceTable[] =
+{
+    FFX_FSR2_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH,
+    FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DILATED_MOTION_VECTORS_1,
+    FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DILATED_MOTION_VECTORS_2,
+    FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_1,
+    FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_2,
+    FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_UPSCALED_COLOR_1,
+    FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_UPSCALED_COLOR_2,
+    FFX_FSR2_RESOURCE_IDENTIFIER_LUMA_HISTORY_1,
+    FFX_FSR2_RESOURCE_IDENTIFIER_LUMA_HISTORY_2,
+    FFX_FSR2_RESOURCE_IDENTIFIER_AUTO_EXPOSURE,
+    FFX_FSR2_RESOURCE_IDENTIFIER_PREV_PRE_ALPHA_COLOR_1,
+    FFX_FSR2_RESOURCE_IDENTIFIER_PREV_POST_ALPHA_COLOR_1,
+    FFX_FSR2_RESOURCE_IDENTIFIER_PREV_PRE_ALPHA_COLOR_2,
+    FFX_FSR2_RESOURCE_IDENTIFIER_PREV_POST_ALPHA_COLOR_2,
+};
+FFX_STATIC_ASSERT(FFX_ARRAY_ELEMENTS(viewResourceTable) == FSR2_VIEW_RESOURCE_COUNT);
+FFX_STATIC_ASSERT(FSR2_VIEW_RESOURCE_COUNT <= FFX_FSR2_MAX_VIEW_RESOURCE_COUNT);
 
-static FfxErrorCode fsr2Create(FfxFsr2Context_Private* context, const FfxFsr2ContextDescription* contextDescription)
+static int32_t getViewResourceIndex(uint32_t resourceIdentifier)
 {
-    FFX_ASSERT(context);
-    FFX_ASSERT(contextDescription);
+    for (int32_t viewResourceIndex = 0; viewResourceIndex < FFX_ARRAY_ELEMENTS(viewResourceTable); ++viewResourceIndex) {
 
-    // Setup the data for implementation.
-    memset(context, 0, sizeof(FfxFsr2Context_Private));
-    context->device = contextDescription->device;
+        if (viewResourceTable[viewResourceIndex] == resourceIdentifier) {
+            return viewResourceIndex;
+        }
+    }
 
-    memcpy(&context->contextDescription, contextDescription, sizeof(FfxFsr2ContextDescription));
+    return -1;
+}
 
-    if ((context->contextDescription.flags & FFX_FSR2_ENABLE_DEBUG_CHECKING) == FFX_FSR2_ENABLE_DEBUG_CHECKING)
-    {
-        if (context->contextDescription.fpMessage == nullptr)
-        {
-            FFX_ASSERT(context->contextDescription.fpMessage != nullptr);
-            // remove the debug checking flag - we have no message function
-            context->contextDescription.flags &= ~FFX_FSR2_ENABLE_DEBUG_CHECKING;
-        }
+// Make a view the one dispatches work on, by exchanging its state with the one of the active view.
+static void fsr2ActivateView(FfxFsr2Context_Private* context, uint32_t viewIndex)
+{
+    FFX_ASSERT(viewIndex < context->viewCount);
+    if (viewIndex == context->activeView) {
+        return;
     }
 
-    // Create the device.
-    FfxErrorCode errorCode = context->contextDescription.callbacks.fpCreateBackendContext(&context->contextDescription.callbacks, context->device);
-    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    Fsr2ViewState* activeView = &context->views[context->activeView];
+    activeView->constants = context->constants;
+    activeView->firstExecution = context->firstExecution;
+    activeView->resourceFrameIndex = context->resourceFrameIndex;
+    activeView->previousJitterOffset[0] = context->previousJitterOffset[0];
+    activeView->previousJitterOffset[1] = context->previousJitterOffset[1];
+
+    const Fsr2ViewState* view = &context->views[viewIndex];
+    context->constants = view->constants;
+    context->firstExecution = view->firstExecution;
+    context->resourceFrameIndex = view->resourceFrameIndex;
+    context->previousJitterOffset[0] = view->previousJitterOffset[0];
+    context->previousJitterOffset[1] = view->previousJitterOffset[1];
+
+    for (uint32_t viewResourceIndex = 0; viewResourceIndex < FSR2_VIEW_RESOURCE_COUNT; ++viewResourceIndex) {
+
+        const uint32_t resourceIdentifier = viewResourceTable[viewResourceIndex];
+        activeView->resources[viewResourceIndex] = context->srvResources[resourceIdentifier];
+        context->srvResources[resourceIdentifier] = view->resources[viewResourceIndex];
+        context->uavResources[resourceIdentifier] = view->resources[viewResourceIndex];
+    }
 
-    // call out for device caps.
-    errorCode = context->contextDescription.callbacks.fpGetDeviceCapabilities(&context->contextDescription.callbacks, &context->deviceCapabilities, context->device);
-    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    context->activeView = viewIndex;
+}
 
-    // set defaults
-    context->firstExecution = true;
-    context->resourceFrameIndex = 0;
+static FfxErrorCode generateReactiveMaskInternal(FfxFsr2Context_Private* contextPrivate, const FfxFsr2DispatchDescription* params);
 
-    context->constants.displaySize[0] = contextDescription->displaySize.width;
-    context->constants.displaySize[1] = contextDescription->displaySize.height;
+#define FSR2_LANCZOS_LUT_WIDTH (128)
+
+typedef struct Fsr2LutData {
+
+    int16_t lanczos2Weights[FSR2_LANCZOS_LUT_WIDTH];
+    int16_t maximumBias[FFX_FSR2_MAXIMUM_BIAS_TEXTURE_WIDTH * FFX_FSR2_MAXIMUM_BIAS_TEXTURE_HEIGHT];
+} Fsr2LutData;
 
-    // generate the data for the LUT.
-    const uint32_t lanczos2LutWidth = 128;
-    int16_t lanczos2Weights[lanczos2LutWidth] = { };
+static Fsr2LutData generateLutData()
+{
+    Fsr2LutData lutData;
 
-    for (uint32_t currentLanczosWidthIndex = 0; currentLanczosWidthIndex < lanczos2LutWidth; currentLanczosWidthIndex++) {
+    for (uint32_t currentLanczosWidthIndex = 0; currentLanczosWidthIndex < FSR2_LANCZOS_LUT_WIDTH; currentLanczosWidthIndex++) {
 
-        const float x = 2.0f * currentLanczosWidthIndex / float(lanczos2LutWidth - 1);
+        const float x = 2.0f * currentLanczosWidthIndex / float(FSR2_LANCZOS_LUT_WIDTH - 1);
         const float y = lanczos2(x);
-        lanczos2Weights[currentLanczosWidthIndex] = int16_t(roundf(y * 32767.0f));
+        lutData.lanczos2Weights[currentLanczosWidthIndex] = int16_t(roundf(y * 32767.0f));
     }
 
     // upload path only supports R16_SNORM, let's go and convert
-    int16_t maximumBias[FFX_FSR2_MAXIMUM_BIAS_TEXTURE_WIDTH * FFX_FSR2_MAXIMUM_BIAS_TEXTURE_HEIGHT];
     for (uint32_t i = 0; i < FFX_FSR2_MAXIMUM_BIAS_TEXTURE_WIDTH * FFX_FSR2_MAXIMUM_BIAS_TEXTURE_HEIGHT; ++i) {
 
-        maximumBias[i] = int16_t(roundf(ffxFsr2MaximumBias[i] / 2.0f * 32767.0f));
+        lutData.maximumBias[i] = int16_t(roundf(ffxFsr2MaximumBias[i] / 2.0f * 32767.0f));
     }
 
-    uint8_t defaultReactiveMaskData = 0U;
-    uint32_t atomicInitData = 0U;
-    float defaultExposure[] = { 0.0f, 0.0f };
-    const FfxResourceType texture1dResourceType = (context->contextDescription.flags & FFX_FSR2_ENABLE_TEXTURE1D_USAGE) ? FFX_RESOURCE_TYPE_TEXTURE1D : FFX_RESOURCE_TYPE_TEXTURE2D;
+    return lutData;
+}
 
-    // declare internal resources needed
+static const Fsr2LutData* getLutData()
+{
+    // initialization of a local static is thread safe
+    static const Fsr2LutData lutData = generateLutData();
+    return &lutData;
+}
+
+#define FSR2_INTERNAL_SURFACE_COUNT (27)
+
+// Fills the descriptions of the internal resources of a context with the given sizes.
+static void getInternalSurfaceDescriptions(const FfxFsr2ContextDescription* contextDescription, Fsr2ResourceDescription* outDescriptions)
+{
+    // the look-up tables are the same for every context, they are generated once per process.
+    const Fsr2LutData* lutData = getLutData();
+
+    static uint8_t defaultReactiveMaskData = 0U;
+    static uint32_t atomicInitData = 0U;
+    static float defaultExposure[] = { 0.0f, 0.0f };
+
+    // declare internal resources needed, the ones flagged aliasable only hold data between the passes of a frame
     const Fsr2ResourceDescription internalSurfaceDesc[] = {
 
+        // accumulation samples past the render size, the texels there are left by earlier frames
         {   FFX_FSR2_RESOURCE_IDENTIFIER_PREPARED_INPUT_COLOR, L"FSR2_PreparedInputColor", FFX_RESOURCE_USAGE_UAV,
-            FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_ALIASABLE },
+            FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_NONE },
 
+        // the lock pass resets it for the reconstruction of the next frame
         {   FFX_FSR2_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH, L"FSR2_ReconstructedPrevNearestDepth", FFX_RESOURCE_USAGE_UAV,
-            FFX_SURFACE_FORMAT_R32_UINT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_ALIASABLE },
+            FFX_SURFACE_FORMAT_R32_UINT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_NONE },
 
         {   FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DILATED_MOTION_VECTORS_1, L"FSR2_InternalDilatedVelocity1", (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
             FFX_SURFACE_FORMAT_R16G16_FLOAT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_NONE },
@@ -506,7 +528,7 @@ static FfxErrorCode fsr2Create(FfxFsr2Context_Private* context, const FfxFsr2Con
         {   FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DILATED_MOTION_VECTORS_2, L"FSR2_InternalDilatedVelocity2", (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
             FFX_SURFACE_FORMAT_R16G16_FLOAT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_NONE },
 
-        {   FFX_FSR2_RESOURCE_IDENTIFIER_DILATED_DEPTH, L"FSR2_DilatedDepth", (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
+        {   FFX_FSR2_RESOURCE_IDENTIFIER_DILATED_DEPTH, L"FSR2_DilatedDepth", FFX_RESOURCE_USAGE_UAV,
             FFX_SURFACE_FORMAT_R32_FLOAT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_ALIASABLE },
             
         {   FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_1, L"FSR2_LockStatus1", (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
@@ -518,8 +540,9 @@ static FfxErrorCode fsr2Create(FfxFsr2Context_Private* context, const FfxFsr2Con
         {   FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_INPUT_LUMA, L"FSR2_LockInputLuma", (FfxResourceUsage)(FFX_RESOURCE_USAGE_UAV),
             FFX_SURFACE_FORMAT_R16_FLOAT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_ALIASABLE },
 
+        // accumulation clears the locks it consumes, the lock pass of the next frame expects them cleared
         {   FFX_FSR2_RESOURCE_IDENTIFIER_NEW_LOCKS, L"FSR2_NewLocks", (FfxResourceUsage)(FFX_RESOURCE_USAGE_UAV),
-            FFX_SURFACE_FORMAT_R8_UNORM, contextDescription->displaySize.width, contextDescription->displaySize.height, 1, FFX_RESOURCE_FLAGS_ALIASABLE },
+            FFX_SURFACE_FORMAT_R8_UNORM, contextDescription->displaySize.width, contextDescription->displaySize.height, 1, FFX_RESOURCE_FLAGS_NONE },
 
         {   FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_UPSCALED_COLOR_1, L"FSR2_InternalUpscaled1", (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
             FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, contextDescription->displaySize.width, contextDescription->displaySize.height, 1, FFX_RESOURCE_FLAGS_NONE },
@@ -536,20 +559,21 @@ static FfxErrorCode fsr2Create(FfxFsr2Context_Private* context, const FfxFsr2Con
         {   FFX_FSR2_RESOURCE_IDENTIFIER_LUMA_HISTORY_2, L"FSR2_LumaHistory2", (FfxResourceUsage)(FFX_RESOURCE_USAGE_RENDERTARGET | FFX_RESOURCE_USAGE_UAV),
             FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, contextDescription->displaySize.width, contextDescription->displaySize.height, 1, FFX_RESOURCE_FLAGS_NONE },
 
+        // the last group of the luminance pyramid resets the counter for the next frame
         {   FFX_FSR2_RESOURCE_IDENTIFIER_SPD_ATOMIC_COUNT, L"FSR2_SpdAtomicCounter", (FfxResourceUsage)(FFX_RESOURCE_USAGE_UAV),
-            FFX_SURFACE_FORMAT_R32_UINT, 1, 1, 1, FFX_RESOURCE_FLAGS_ALIASABLE, sizeof(atomicInitData), &atomicInitData },
+            FFX_SURFACE_FORMAT_R32_UINT, 1, 1, 1, FFX_RESOURCE_FLAGS_NONE, sizeof(atomicInitData), &atomicInitData },
 
         {   FFX_FSR2_RESOURCE_IDENTIFIER_DILATED_REACTIVE_MASKS, L"FSR2_DilatedReactiveMasks", FFX_RESOURCE_USAGE_UAV,
             FFX_SURFACE_FORMAT_R8G8_UNORM, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_ALIASABLE },
 
         {   FFX_FSR2_RESOURCE_IDENTIFIER_LANCZOS_LUT, L"FSR2_LanczosLutData", FFX_RESOURCE_USAGE_READ_ONLY,
-            FFX_SURFACE_FORMAT_R16_SNORM, lanczos2LutWidth, 1, 1, FFX_RESOURCE_FLAGS_NONE, sizeof(lanczos2Weights), lanczos2Weights },
+            FFX_SURFACE_FORMAT_R16_SNORM, FSR2_LANCZOS_LUT_WIDTH, 1, 1, FFX_RESOURCE_FLAGS_NONE, sizeof(lutData->lanczos2Weights), (void*)lutData->lanczos2Weights },
 
         {   FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DEFAULT_REACTIVITY, L"FSR2_DefaultReactiviyMask", FFX_RESOURCE_USAGE_READ_ONLY,
             FFX_SURFACE_FORMAT_R8_UNORM, 1, 1, 1, FFX_RESOURCE_FLAGS_NONE, sizeof(defaultReactiveMaskData), &defaultReactiveMaskData },
 
         {   FFX_FSR2_RESOURCE_IDENTITIER_UPSAMPLE_MAXIMUM_BIAS_LUT, L"FSR2_MaximumUpsampleBias", FFX_RESOURCE_USAGE_READ_ONLY,
-            FFX_SURFACE_FORMAT_R16_SNORM, FFX_FSR2_MAXIMUM_BIAS_TEXTURE_WIDTH, FFX_FSR2_MAXIMUM_BIAS_TEXTURE_HEIGHT, 1, FFX_RESOURCE_FLAGS_NONE, sizeof(maximumBias), maximumBias },
+            FFX_SURFACE_FORMAT_R16_SNORM, FFX_FSR2_MAXIMUM_BIAS_TEXTURE_WIDTH, FFX_FSR2_MAXIMUM_BIAS_TEXTURE_HEIGHT, 1, FFX_RESOURCE_FLAGS_NONE, sizeof(lutData->maximumBias), (void*)lutData->maximumBias },
 
         {   FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DEFAULT_EXPOSURE, L"FSR2_DefaultExposure", FFX_RESOURCE_USAGE_READ_ONLY,
             FFX_SURFACE_FORMAT_R32G32_FLOAT, 1, 1, 1, FFX_RESOURCE_FLAGS_NONE, sizeof(defaultExposure), defaultExposure },
@@ -573,6 +597,236 @@ static FfxErrorCode fsr2Create(FfxFsr2Context_Private* context, const FfxFsr2Con
             FFX_SURFACE_FORMAT_R11G11B10_FLOAT, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height, 1, FFX_RESOURCE_FLAGS_NONE },
 
     };
+    FFX_STATIC_ASSERT(FFX_ARRAY_ELEMENTS(internalSurfaceDesc) == FSR2_INTERNAL_SURFACE_COUNT);
+    memcpy(outDescriptions, internalSurfaceDesc, sizeof(internalSurfaceDesc));
+}
+
+static FfxCreateResourceDescription getCreateResourceDescription(const FfxFsr2Context_Private* context, const Fsr2ResourceDescription* surfaceDescription)
+{
+    const FfxResourceType texture1dResourceType = (context->contextDescription.flags & FFX_FSR2_ENABLE_TEXTURE1D_USAGE) ? FFX_RESOURCE_TYPE_TEXTURE1D : FFX_RESOURCE_TYPE_TEXTURE2D;
+    const FfxResourceType resourceType = surfaceDescription->height > 1 ? FFX_RESOURCE_TYPE_TEXTURE2D : texture1dResourceType;
+    const FfxResourceDescription resourceDescription = { resourceType, surfaceDescription->format, surfaceDescription->width, surfaceDescription->height, 1, surfaceDescription->mipCount, FFX_RESOURCE_FLAGS_NONE };
+    const FfxResourceStates initialState = (surfaceDescription->usage == FFX_RESOURCE_USAGE_READ_ONLY) ? FFX_RESOURCE_STATE_COMPUTE_READ : FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+    FfxCreateResourceDescription createResourceDescription = { FFX_HEAP_TYPE_DEFAULT, resourceDescription, initialState, surfaceDescription->initDataSize, surfaceDescription->initData, surfaceDescription->name, surfaceDescription->usage, surfaceDescription->id, 0 };
+
+    // resources laid out by planTransientResources are placed in the transient heap
+    if ((surfaceDescription->flags & FFX_RESOURCE_FLAGS_ALIASABLE) && context->transientHeapSize) {
+
+        createResourceDescription.resourceDescription.flags = FFX_RESOURCE_FLAGS_ALIASABLE;
+        createResourceDescription.heapOffset = context->transientHeapOffsets[surfaceDescription->id];
+    }
+
+    return createResourceDescription;
+}
+
+static FfxErrorCode createInternalResource(FfxFsr2Context_Private* context, const Fsr2ResourceDescription* surfaceDescription, FfxResourceInternal* outResource)
+{
+    const FfxCreateResourceDescription createResourceDescription = getCreateResourceDescription(context, surfaceDescription);
+
+    return context->contextDescription.callbacks.fpCreateResource(&context->contextDescription.callbacks, &createResourceDescription, outResource);
+}
+
+static void markPipelineResourceUses(const FfxPipelineState* pipeline, int32_t firstPass, int32_t lastPass, int32_t* inoutFirstPasses, int32_t* inoutLastPasses)
+{
+    for (uint32_t bindingIndex = 0; bindingIndex < pipeline->srvCount + pipeline->uavCount; ++bindingIndex) {
+
+        const FfxResourceBinding* binding = (bindingIndex < pipeline->srvCount) ? &pipeline->srvResourceBindings[bindingIndex] : &pipeline->uavResourceBindings[bindingIndex - pipeline->srvCount];
+        uint32_t resourceIdentifier = binding->resourceIdentifier;
+
+        // the mips of the scene luminance are bound on their own
+        if (resourceIdentifier >= FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_0 && resourceIdentifier <= FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_12) {
+            resourceIdentifier = FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE;
+        }
+
+        inoutFirstPasses[resourceIdentifier] = FFX_MINIMUM(inoutFirstPasses[resourceIdentifier], firstPass);
+        inoutLastPasses[resourceIdentifier] = FFX_MAXIMUM(inoutLastPasses[resourceIdentifier], lastPass);
+    }
+}
+
+// Lay out the resources flagged FFX_RESOURCE_FLAGS_ALIASABLE in the transient heap, and create it.
+// Such a resource only holds data from the first to the last pass of a frame binding it, two of them
+// whose passes do not overlap share memory. The bindings come from the pipelines, which have to be
+// created first.
+static FfxErrorCode planTransientResources(FfxFsr2Context_Private* context, const Fsr2ResourceDescription* surfaceDescriptions)
+{
+    FfxFsr2Interface* callbacks = &context->contextDescription.callbacks;
+
+    context->transientHeapSize = 0;
+    if (!callbacks->fpGetResourceMemoryRequirements || !callbacks->fpCreateTransientHeap) {
+        return FFX_OK;
+    }
+
+    // the passes of a frame in the order fsr2ScheduleDispatch schedules them, the accumulation with
+    // and without sharpening take the same place
+    const FfxPipelineState* const framePipelines[][2] = {
+        { &context->pipelineTcrAutogenerate,            nullptr },
+        { &context->pipelineComputeLuminancePyramid,    nullptr },
+        { &context->pipelineReconstructPreviousDepth,   nullptr },
+        { &context->pipelineDepthClip,                  nullptr },
+        { &context->pipelineLock,                       nullptr },
+        { &context->pipelineAccumulate,                 &context->pipelineAccumulateSharpen },
+        { &context->pipelineRCAS,                       nullptr },
+    };
+    const int32_t framePassCount = int32_t(FFX_ARRAY_ELEMENTS(framePipelines));
+
+    int32_t firstPasses[FFX_FSR2_RESOURCE_IDENTIFIER_COUNT];
+    int32_t lastPasses[FFX_FSR2_RESOURCE_IDENTIFIER_COUNT];
+    for (uint32_t resourceIdentifier = 0; resourceIdentifier < FFX_FSR2_RESOURCE_IDENTIFIER_COUNT; ++resourceIdentifier) {
+
+        firstPasses[resourceIdentifier] = framePassCount;
+        lastPasses[resourceIdentifier] = -1;
+    }
+
+    for (int32_t passIndex = 0; passIndex < framePassCount; ++passIndex) {
+
+        for (const FfxPipelineState* pipeline : framePipelines[passIndex]) {
+
+            if (pipeline) {
+                markPipelineResourceUses(pipeline, passIndex, passIndex, firstPasses, lastPasses);
+            }
+        }
+    }
+
+    // reactive mask generation is dispatched apart from the frames, what it binds is kept for all of them
+    markPipelineResourceUses(&context->pipelineGenerateReactive, 0, framePassCount - 1, firstPasses, lastPasses);
+
+    typedef struct TransientResource {
+
+        uint32_t                        id;
+        int32_t                         firstPass;
+        int32_t                         lastPass;
+        FfxResourceMemoryRequirements   requirements;
+        uint64_t                        offset;
+    } TransientResource;
+
+    TransientResource transientResources[FSR2_INTERNAL_SURFACE_COUNT];
+    uint32_t transientResourceCount = 0;
+    for (uint32_t currentSurfaceIndex = 0; currentSurfaceIndex < FSR2_INTERNAL_SURFACE_COUNT; ++currentSurfaceIndex) {
+
+        const Fsr2ResourceDescription* currentSurfaceDescription = &surfaceDescriptions[currentSurfaceIndex];
+        if (!(currentSurfaceDescription->flags & FFX_RESOURCE_FLAGS_ALIASABLE)) {
+            continue;
+        }
+
+        // history has to be kept by each view, a view resource is never transient
+        FFX_ASSERT(getViewResourceIndex(currentSurfaceDescription->id) < 0);
+
+        // a resource no pass binds keeps memory of its own
+        TransientResource* transientResource = &transientResources[transientResourceCount++];
+        transientResource->id = currentSurfaceDescription->id;
+        transientResource->firstPass = (lastPasses[transientResource->id] < 0) ? 0 : firstPasses[transientResource->id];
+        transientResource->lastPass = (lastPasses[transientResource->id] < 0) ? framePassCount - 1 : lastPasses[transientResource->id];
+        transientResource->offset = 0;
+
+        FfxCreateResourceDescription createResourceDescription = getCreateResourceDescription(context, currentSurfaceDescription);
+        createResourceDescription.resourceDescription.flags = FFX_RESOURCE_FLAGS_ALIASABLE;
+        const FfxErrorCode errorCode = callbacks->fpGetResourceMemoryRequirements(callbacks, &createResourceDescription, &transientResource->requirements);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    }
+
+    // largest first, each one at the lowest offset no resource live during its passes occupies
+    for (uint32_t transientIndex = 1; transientIndex < transientResourceCount; ++transientIndex) {
+
+        for (uint32_t sortIndex = transientIndex; sortIndex > 0 && transientResources[sortIndex - 1].requirements.size < transientResources[sortIndex].requirements.size; --sortIndex) {
+
+            const TransientResource swapped = transientResources[sortIndex];
+            transientResources[sortIndex] = transientResources[sortIndex - 1];
+            transientResources[sortIndex - 1] = swapped;
+        }
+    }
+
+    uint64_t heapSize = 0;
+    for (uint32_t transientIndex = 0; transientIndex < transientResourceCount; ++transientIndex) {
+
+        TransientResource* transientResource = &transientResources[transientIndex];
+        const uint64_t alignment = FFX_MAXIMUM(transientResource->requirements.alignment, uint64_t(1));
+
+        for (uint32_t placedIndex = 0; placedIndex < transientIndex; ) {
+
+            const TransientResource* placedResource = &transientResources[placedIndex];
+            const bool liveTogether = placedResource->firstPass <= transientResource->lastPass && transientResource->firstPass <= placedResource->lastPass;
+            const bool sameMemory = placedResource->offset < transientResource->offset + transientResource->requirements.size &&
+                                    transientResource->offset < placedResource->offset + placedResource->requirements.size;
+
+            // move past the resource, and check again against all the others
+            if (liveTogether && sameMemory) {
+
+                transientResource->offset = FFX_ALIGN_UP(placedResource->offset + placedResource->requirements.size, alignment);
+                placedIndex = 0;
+            } else {
+
+                ++placedIndex;
+            }
+        }
+
+        heapSize = FFX_MAXIMUM(heapSize, transientResource->offset + transientResource->requirements.size);
+        context->transientHeapOffsets[transientResource->id] = transientResource->offset;
+    }
+
+    // a size of zero releases the heap of an earlier plan
+    const bool shared = (context->contextDescription.flags & FFX_FSR2_ENABLE_SHARED_TRANSIENT_MEMORY) != 0;
+    const FfxErrorCode errorCode = callbacks->fpCreateTransientHeap(callbacks, heapSize, shared);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    context->transientHeapSize = heapSize;
+
+    return FFX_OK;
+}
+
+static FfxErrorCode fsr2Create(FfxFsr2Context_Private* context, const FfxFsr2ContextDescription* contextDescription)
+{
+    FFX_ASSERT(context);
+    FFX_ASSERT(contextDescription);
+
+    // Setup the data for implementation.
+    memset(context, 0, sizeof(FfxFsr2Context_Private));
+    context->device = contextDescription->device;
+
+    memcpy(&context->contextDescription, contextDescription, sizeof(FfxFsr2ContextDescription));
+
+    if ((context->contextDescription.flags & FFX_FSR2_ENABLE_DEBUG_CHECKING) == FFX_FSR2_ENABLE_DEBUG_CHECKING)
+    {
+        if (context->contextDescription.fpMessage == nullptr)
+        {
+            FFX_ASSERT(context->contextDescription.fpMessage != nullptr);
+            // remove the debug checking flag - we have no message function
+            context->contextDescription.flags &= ~FFX_FSR2_ENABLE_DEBUG_CHECKING;
+        }
+    }
+
+    // Create the device.
+    FfxErrorCode errorCode = context->contextDescription.callbacks.fpCreateBackendContext(&context->contextDescription.callbacks, context->device);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    // call out for device caps.
+    errorCode = context->contextDescription.callbacks.fpGetDeviceCapabilities(&context->contextDescription.callbacks, &context->deviceCapabilities, context->device);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    // set defaults
+    context->firstExecution = true;
+    context->resourceFrameIndex = 0;
+
+    context->constants.displaySize[0] = contextDescription->displaySize.width;
+    context->constants.displaySize[1] = contextDescription->displaySize.height;
+
+    for (uint32_t constantBufferIndex = 0; constantBufferIndex < FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_COUNT; ++constantBufferIndex) {
+
+        context->constantBuffers[constantBufferIndex].uint32Size = constantBufferSizeTable[constantBufferIndex];
+    }
+
+    // avoid compiling pipelines on first render, their bindings also lay out the transient resources
+    {
+        context->refreshPipelineStates = false;
+        errorCode = createPipelineStates(context);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    }
+
+    // declare internal resources needed
+    Fsr2ResourceDescription internalSurfaceDesc[FSR2_INTERNAL_SURFACE_COUNT];
+    getInternalSurfaceDescriptions(contextDescription, internalSurfaceDesc);
+
+    errorCode = planTransientResources(context, internalSurfaceDesc);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
 
     // clear the SRV resources to NULL.
     memset(context->srvResources, 0, sizeof(context->srvResources));
@@ -580,23 +834,33 @@ static FfxErrorCode fsr2Create(FfxFsr2Context_Private* context, const FfxFsr2Con
     for (int32_t currentSurfaceIndex = 0; currentSurfaceIndex < FFX_ARRAY_ELEMENTS(internalSurfaceDesc); ++currentSurfaceIndex) {
 
         const Fsr2ResourceDescription* currentSurfaceDescription = &internalSurfaceDesc[currentSurfaceIndex];
-        const FfxResourceType resourceType = currentSurfaceDescription->height > 1 ? FFX_RESOURCE_TYPE_TEXTURE2D : texture1dResourceType;
-        const FfxResourceDescription resourceDescription = { resourceType, currentSurfaceDescription->format, currentSurfaceDescription->width, currentSurfaceDescription->height, 1, currentSurfaceDescription->mipCount };
-        const FfxResourceStates initialState = (currentSurfaceDescription->usage == FFX_RESOURCE_USAGE_READ_ONLY) ? FFX_RESOURCE_STATE_COMPUTE_READ : FFX_RESOURCE_STATE_UNORDERED_ACCESS;
-        const FfxCreateResourceDescription createResourceDescription = { FFX_HEAP_TYPE_DEFAULT, resourceDescription, initialState, currentSurfaceDescription->initDataSize, currentSurfaceDescription->initData, currentSurfaceDescription->name, currentSurfaceDescription->usage, currentSurfaceDescription->id };
-
-        FFX_VALIDATE(context->contextDescription.callbacks.fpCreateResource(&context->contextDescription.callbacks, &createResourceDescription, &context->srvResources[currentSurfaceDescription->id]));
+        FFX_VALIDATE(createInternalResource(context, currentSurfaceDescription, &context->srvResources[currentSurfaceDescription->id]));
     }
 
     // copy resources to uavResrouces list
     memcpy(context->uavResources, context->srvResources, sizeof(context->srvResources));
 
-    // avoid compiling pipelines on first render
-    {
-        context->refreshPipelineStates = false;
-        errorCode = createPipelineStates(context);
-        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    // every other view starts out like the first one, with history resources of its own
+    context->viewCount = FFX_MAXIMUM(1u, contextDescription->viewCount);
+    for (uint32_t viewIndex = 1; viewIndex < context->viewCount; ++viewIndex) {
+
+        Fsr2ViewState* view = &context->views[viewIndex];
+        view->constants = context->constants;
+        view->firstExecution = context->firstExecution;
+        view->resourceFrameIndex = context->resourceFrameIndex;
+
+        for (int32_t currentSurfaceIndex = 0; currentSurfaceIndex < FFX_ARRAY_ELEMENTS(internalSurfaceDesc); ++currentSurfaceIndex) {
+
+            const Fsr2ResourceDescription* currentSurfaceDescription = &internalSurfaceDesc[currentSurfaceIndex];
+            const int32_t viewResourceIndex = getViewResourceIndex(currentSurfaceDescription->id);
+            if (viewResourceIndex < 0) {
+                continue;
+            }
+
+            FFX_VALIDATE(createInternalResource(context, currentSurfaceDescription, &view->resources[viewResourceIndex]));
+        }
     }
+
     return FFX_OK;
 }
 
@@ -655,6 +919,24 @@ static FfxErrorCode fsr2Release(FfxFsr2Context_Private* context)
         fsr2SafeReleaseResource(context, context->srvResources[currentResourceIndex]);
     }
 
+    for (uint32_t viewIndex = 0; viewIndex < context->viewCount; ++viewIndex) {
+
+        if (viewIndex == context->activeView) {
+            continue;
+        }
+
+        for (uint32_t viewResourceIndex = 0; viewResourceIndex < FSR2_VIEW_RESOURCE_COUNT; ++viewResourceIndex) {
+
+            fsr2SafeReleaseResource(context, context->views[viewIndex].resources[viewResourceIndex]);
+        }
+    }
+
+    if (context->transientHeapSize) {
+
+        context->contextDescription.callbacks.fpCreateTransientHeap(&context->contextDescription.callbacks, 0, false);
+        context->transientHeapSize = 0;
+    }
+
     fsr2SafeReleaseDevice(context, &context->device);
 
     return FFX_OK;
@@ -711,65 +993,241 @@ static void setupDeviceDepthToViewSpaceDepthParams(FfxFsr2Context_Private* conte
     context->constants.deviceToViewDepth[3] = (1.0f / b);
 }
 
-static void scheduleDispatch(FfxFsr2Context_Private* context, const FfxFsr2DispatchDescription* params, const FfxPipelineState* pipeline, uint32_t dispatchX, uint32_t dispatchY)
+static uint64_t getHostTime()
 {
-    FfxComputeJobDescription jobDescriptor = {};
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
 
-    for (uint32_t currentShaderResourceViewIndex = 0; currentShaderResourceViewIndex < pipeline->srvCount; ++currentShaderResourceViewIndex) {
+static uint32_t getSurfaceFormatSize(FfxSurfaceFormat format)
+{
+    switch (format) {
+
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        return 16;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        return 8;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        return 4;
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16_UINT:
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        return 2;
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        return 1;
+    default:
+        return 0;
+    }
+}
 
-        const uint32_t currentResourceId = pipeline->srvResourceBindings[currentShaderResourceViewIndex].resourceIdentifier;
-        const FfxResourceInternal currentResource = context->srvResources[currentResourceId];
-        jobDescriptor.srvs[currentShaderResourceViewIndex] = currentResource;
-        wcscpy_s(jobDescriptor.srvNames[currentShaderResourceViewIndex], pipeline->srvResourceBindings[currentShaderResourceViewIndex].name);
+// Size of a mip of a resource, 0 for the NULL resource.
+// The size of mipCount mips of a resource from firstMip on, a buffer counts as a single mip.
+static uint64_t getResourceMipsSize(FfxFsr2Context_Private* context, FfxResourceInternal resource, uint32_t firstMip, uint32_t mipCount)
+{
+    if (resource.internalIndex <= FFX_FSR2_RESOURCE_IDENTIFIER_NULL) {
+        return 0;
     }
 
-    for (uint32_t currentUnorderedAccessViewIndex = 0; currentUnorderedAccessViewIndex < pipeline->uavCount; ++currentUnorderedAccessViewIndex) {
+    const FfxResourceDescription description = context->contextDescription.callbacks.fpGetResourceDescription(&context->contextDescription.callbacks, resource);
+    if (description.type == FFX_RESOURCE_TYPE_BUFFER) {
+        return description.width;
+    }
 
-        const uint32_t currentResourceId = pipeline->uavResourceBindings[currentUnorderedAccessViewIndex].resourceIdentifier;
-        wcscpy_s(jobDescriptor.uavNames[currentUnorderedAccessViewIndex], pipeline->uavResourceBindings[currentUnorderedAccessViewIndex].name);
+    const uint32_t resourceMipCount = FFX_MAXIMUM(1u, description.mipCount);
+    uint64_t size = 0;
+    for (uint32_t mip = firstMip; mip < resourceMipCount && mip - firstMip < mipCount; ++mip) {
 
-        if (currentResourceId >= FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_0 && currentResourceId <= FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_12)
-        {
-            const FfxResourceInternal currentResource = context->uavResources[FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE];
-            jobDescriptor.uavs[currentUnorderedAccessViewIndex] = currentResource;
-            jobDescriptor.uavMip[currentUnorderedAccessViewIndex] = currentResourceId - FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_0;
-        }
-        else
-        {
-            const FfxResourceInternal currentResource = context->uavResources[currentResourceId];
-            jobDescriptor.uavs[currentUnorderedAccessViewIndex] = currentResource;
-            jobDescriptor.uavMip[currentUnorderedAccessViewIndex] = 0;
-        }
+        const uint64_t width = FFX_MAXIMUM(1u, description.width >> mip);
+        const uint64_t height = FFX_MAXIMUM(1u, description.height >> mip);
+        const uint64_t depth = FFX_MAXIMUM(1u, description.depth);
+        size += width * height * depth * getSurfaceFormatSize(description.format);
     }
-    
-    jobDescriptor.dimensions[0] = dispatchX;
-    jobDescriptor.dimensions[1] = dispatchY;
-    jobDescriptor.dimensions[2] = 1;
-    jobDescriptor.pipeline = *pipeline;
 
-    for (uint32_t currentRootConstantIndex = 0; currentRootConstantIndex < pipeline->constCount; ++currentRootConstantIndex) {
-        wcscpy_s( jobDescriptor.cbNames[currentRootConstantIndex], pipeline->cbResourceBindings[currentRootConstantIndex].name);
-        jobDescriptor.cbs[currentRootConstantIndex] = globalFsr2ConstantBuffers[pipeline->cbResourceBindings[currentRootConstantIndex].resourceIdentifier];
-        jobDescriptor.cbSlotIndex[currentRootConstantIndex] = pipeline->cbResourceBindings[currentRootConstantIndex].slotIndex;
-    }
+    return size;
+}
 
-    FfxGpuJobDescription dispatchJob = { FFX_GPU_JOB_COMPUTE };
-    dispatchJob.computeJobDescriptor = jobDescriptor;
+static FfxFsr2Pass getPipelinePass(const FfxFsr2Context_Private* context, const FfxPipelineState* pipeline)
+{
+    if (pipeline == &context->pipelineDepthClip) {
+        return FFX_FSR2_PASS_DEPTH_CLIP;
+    } else if (pipeline == &context->pipelineReconstructPreviousDepth) {
+        return FFX_FSR2_PASS_RECONSTRUCT_PREVIOUS_DEPTH;
+    } else if (pipeline == &context->pipelineLock) {
+        return FFX_FSR2_PASS_LOCK;
+    } else if (pipeline == &context->pipelineAccumulate) {
+        return FFX_FSR2_PASS_ACCUMULATE;
+    } else if (pipeline == &context->pipelineAccumulateSharpen) {
+        return FFX_FSR2_PASS_ACCUMULATE_SHARPEN;
+    } else if (pipeline == &context->pipelineRCAS) {
+        return FFX_FSR2_PASS_RCAS;
+    } else if (pipeline == &context->pipelineComputeLuminancePyramid) {
+        return FFX_FSR2_PASS_COMPUTE_LUMINANCE_PYRAMID;
+    } else if (pipeline == &context->pipelineGenerateReactive) {
+        return FFX_FSR2_PASS_GENERATE_REACTIVE;
+    } else if (pipeline == &context->pipelineTcrAutogenerate) {
+        return FFX_FSR2_PASS_TCR_AUTOGENERATE;
+    }
 
-    context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &dispatchJob);
+    return FFX_FSR2_PASS_COUNT;
 }
 
-static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2DispatchDescription* params)
+// Schedule a job of a dispatch and account for it in the statistics of the dispatch, clears and
+// copies use FFX_FSR2_PASS_COUNT as their pass.
+static void scheduleGpuJob(FfxFsr2Context_Private* context, const FfxGpuJobDescription* job, FfxFsr2Pass pass)
 {
-    if ((context->contextDescription.flags & FFX_FSR2_ENABLE_DEBUG_CHECKING) == FFX_FSR2_ENABLE_DEBUG_CHECKING)
-    {
-        fsr2DebugCheckDispatch(context, params);
+    context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, job);
+
+    // the backend reports the statistics of its jobs in schedule order
+    if (context->scheduledJobCount < FSR2_MAX_SCHEDULED_JOBS) {
+        context->scheduledJobPasses[context->scheduledJobCount] = uint8_t(pass);
     }
-    // take a short cut to the command list
-    FfxCommandList commandList = params->commandList;
+    ++context->scheduledJobCount;
 
-    // try and refresh shaders first. Early exit in case of error.
-    if (context->refreshPipelineStates) {
+    if (pass == FFX_FSR2_PASS_COUNT) {
+        return;
+    }
+
+    const FfxComputeJobDescription* computeJob = &job->computeJobDescriptor;
+    FfxFsr2PassStats* passStatistics = &context->pendingStatistics.passes[pass];
+    ++passStatistics->dispatchCount;
+    memcpy(passStatistics->dispatchDimensions, computeJob->dimensions, sizeof(passStatistics->dispatchDimensions));
+    passStatistics->descriptorCount += computeJob->pipeline.srvCount + computeJob->pipeline.uavCount + computeJob->pipeline.constCount;
+
+    // every backend binds shader resource views with all the mips of the resource
+    for (uint32_t srvIndex = 0; srvIndex < computeJob->pipeline.srvCount; ++srvIndex) {
+
+        passStatistics->bytesRead += getResourceMipsSize(context, computeJob->srvs[srvIndex], 0, UINT32_MAX);
+    }
+
+    for (uint32_t uavIndex = 0; uavIndex < computeJob->pipeline.uavCount; ++uavIndex) {
+
+        passStatistics->bytesWritten += getResourceMipsSize(context, computeJob->uavs[uavIndex], computeJob->uavMip[uavIndex], 1);
+    }
+}
+
+// Execute the scheduled jobs and merge the statistics the backend reports for them.
+static void executeGpuJobs(FfxFsr2Context_Private* context, FfxCommandList commandList)
+{
+    FfxFsr2Interface* callbacks = &context->contextDescription.callbacks;
+    callbacks->fpExecuteGpuJobs(callbacks, commandList);
+
+    FfxGpuJobStatistics jobStatistics[FSR2_MAX_SCHEDULED_JOBS];
+    uint32_t jobCount = FFX_MINIMUM(context->scheduledJobCount, uint32_t(FSR2_MAX_SCHEDULED_JOBS));
+    context->scheduledJobCount = 0;
+
+    if (!callbacks->fpGetGpuJobStatistics || callbacks->fpGetGpuJobStatistics(callbacks, jobStatistics, &jobCount) != FFX_OK) {
+        return;
+    }
+
+    for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex) {
+
+        const uint32_t pass = context->scheduledJobPasses[jobIndex];
+        if (pass == FFX_FSR2_PASS_COUNT) {
+            continue;
+        }
+
+        context->pendingStatistics.passes[pass].barrierCount += jobStatistics[jobIndex].barrierCount;
+        context->pendingStatistics.passes[pass].duration += jobStatistics[jobIndex].duration;
+        context->pendingStatistics.backendTimings |= jobStatistics[jobIndex].duration != 0;
+    }
+}
+
+// Publish the statistics of a dispatch call which completed.
+static void completeStatistics(FfxFsr2Context_Private* context, uint32_t frameCount, uint64_t dispatchStartTime)
+{
+    FfxFsr2FrameStats* statistics = &context->pendingStatistics;
+    statistics->frameCount = frameCount;
+    statistics->duration = getHostTime() - dispatchStartTime;
+
+    context->statistics = *statistics;
+    memset(statistics, 0, sizeof(*statistics));
+}
+
+static void scheduleDispatch(FfxFsr2Context_Private* context, const FfxPipelineState* pipeline, uint32_t dispatchX, uint32_t dispatchY)
+{
+    const FfxFsr2Pass pass = getPipelinePass(context, pipeline);
+    const FfxFsr2TraceScope traceScope(ffxFsr2TraceGetPassName(pass), "schedule");
+
+    FfxComputeJobDescription jobDescriptor = {};
+
+    for (uint32_t currentShaderResourceViewIndex = 0; currentShaderResourceViewIndex < pipeline->srvCount; ++currentShaderResourceViewIndex) {
+
+        const uint32_t currentResourceId = pipeline->srvResourceBindings[currentShaderResourceViewIndex].resourceIdentifier;
+        const FfxResourceInternal currentResource = context->srvResources[currentResourceId];
+        jobDescriptor.srvs[currentShaderResourceViewIndex] = currentResource;
+        wcscpy_s(jobDescriptor.srvNames[currentShaderResourceViewIndex], pipeline->srvResourceBindings[currentShaderResourceViewIndex].name);
+    }
+
+    for (uint32_t currentUnorderedAccessViewIndex = 0; currentUnorderedAccessViewIndex < pipeline->uavCount; ++currentUnorderedAccessViewIndex) {
+
+        const uint32_t currentResourceId = pipeline->uavResourceBindings[currentUnorderedAccessViewIndex].resourceIdentifier;
+        wcscpy_s(jobDescriptor.uavNames[currentUnorderedAccessViewIndex], pipeline->uavResourceBindings[currentUnorderedAccessViewIndex].name);
+
+        if (currentResourceId >= FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_0 && currentResourceId <= FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_12)
+        {
+            const FfxResourceInternal currentResource = context->uavResources[FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE];
+            jobDescriptor.uavs[currentUnorderedAccessViewIndex] = currentResource;
+            jobDescriptor.uavMip[currentUnorderedAccessViewIndex] = currentResourceId - FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE_MIPMAP_0;
+        }
+        else
+        {
+            const FfxResourceInternal currentResource = context->uavResources[currentResourceId];
+            jobDescriptor.uavs[currentUnorderedAccessViewIndex] = currentResource;
+            jobDescriptor.uavMip[currentUnorderedAccessViewIndex] = 0;
+        }
+    }
+    
+    jobDescriptor.dimensions[0] = dispatchX;
+    jobDescriptor.dimensions[1] = dispatchY;
+    jobDescriptor.dimensions[2] = 1;
+    jobDescriptor.pipeline = *pipeline;
+
+    for (uint32_t currentRootConstantIndex = 0; currentRootConstantIndex < pipeline->constCount; ++currentRootConstantIndex) {
+        wcscpy_s( jobDescriptor.cbNames[currentRootConstantIndex], pipeline->cbResourceBindings[currentRootConstantIndex].name);
+        jobDescriptor.cbs[currentRootConstantIndex] = context->constantBuffers[pipeline->cbResourceBindings[currentRootConstantIndex].resourceIdentifier];
+        jobDescriptor.cbSlotIndex[currentRootConstantIndex] = pipeline->cbResourceBindings[currentRootConstantIndex].slotIndex;
+    }
+
+    FfxGpuJobDescription dispatchJob = {};
+    dispatchJob.jobType = FFX_GPU_JOB_COMPUTE;
+    dispatchJob.computeJobDescriptor = jobDescriptor;
+
+    scheduleGpuJob(context, &dispatchJob, pass);
+}
+
+// Constants which only depend on dispatch parameters that rarely change from one frame to the next.
+// They are computed again, and copied to the constant buffers, only when those parameters change
+// within a batch of frames.
+typedef struct Fsr2DispatchSetup {
+
+    bool                valid;
+    FfxDimensions2D     renderSize;
+    float               sharpness;
+    uint32_t            dispatchThreadGroupCountXY[2];
+} Fsr2DispatchSetup;
+
+// Schedule the jobs of a frame, leaving their execution and the release of the registered resources
+// to the caller.
+static FfxErrorCode fsr2ScheduleDispatch(FfxFsr2Context_Private* context, const FfxFsr2DispatchDescription* params, Fsr2DispatchSetup* setup)
+{
+    if ((context->contextDescription.flags & FFX_FSR2_ENABLE_DEBUG_CHECKING) == FFX_FSR2_ENABLE_DEBUG_CHECKING)
+    {
+        fsr2DebugCheckDispatch(context, params);
+    }
+
+    // try and refresh shaders first. Early exit in case of error.
+    if (context->refreshPipelineStates) {
 
         context->refreshPipelineStates = false;
 
@@ -779,23 +1237,22 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
 
     if (context->firstExecution)
     {
-        FfxGpuJobDescription clearJob = { FFX_GPU_JOB_CLEAR_FLOAT };
+        FfxGpuJobDescription clearJob = {};
+        clearJob.jobType = FFX_GPU_JOB_CLEAR_FLOAT;
 
         const float clearValuesToZeroFloat[]{ 0.f, 0.f, 0.f, 0.f };
         memcpy(clearJob.clearJobDescriptor.color, clearValuesToZeroFloat, 4 * sizeof(float));
 
         clearJob.clearJobDescriptor.target = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_1];
-        context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &clearJob);
+        scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
         clearJob.clearJobDescriptor.target = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_2];
-        context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &clearJob);
+        scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
         clearJob.clearJobDescriptor.target = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_PREPARED_INPUT_COLOR];
-        context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &clearJob);
+        scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
     }
 
     // Prepare per frame descriptor tables
     const bool isOddFrame = !!(context->resourceFrameIndex & 1);
-    const uint32_t currentCpuOnlyTableBase = isOddFrame ? FFX_FSR2_RESOURCE_IDENTIFIER_COUNT : 0;
-    const uint32_t currentGpuTableBase = 2 * FFX_FSR2_RESOURCE_IDENTIFIER_COUNT * context->resourceFrameIndex;
     const uint32_t lockStatusSrvResourceIndex = isOddFrame ? FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_2 : FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_1;
     const uint32_t lockStatusUavResourceIndex = isOddFrame ? FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_1 : FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_2;
     const uint32_t upscaledColorSrvResourceIndex = isOddFrame ? FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_UPSCALED_COLOR_2 : FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_UPSCALED_COLOR_1;
@@ -868,7 +1325,6 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
     // actual resource size may differ from render/display resolution (e.g. due to Hw/API restrictions), so query the descriptor for UVs adjustment
     const FfxResourceDescription resourceDescInputColor = context->contextDescription.callbacks.fpGetResourceDescription(&context->contextDescription.callbacks, context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_INPUT_COLOR]);
     const FfxResourceDescription resourceDescLockStatus = context->contextDescription.callbacks.fpGetResourceDescription(&context->contextDescription.callbacks, context->srvResources[lockStatusSrvResourceIndex]);
-    const FfxResourceDescription resourceDescReactiveMask = context->contextDescription.callbacks.fpGetResourceDescription(&context->contextDescription.callbacks, context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_INPUT_REACTIVE_MASK]);
     FFX_ASSERT(resourceDescInputColor.type == FFX_RESOURCE_TYPE_TEXTURE2D);
     FFX_ASSERT(resourceDescLockStatus.type == FFX_RESOURCE_TYPE_TEXTURE2D);
 
@@ -953,7 +1409,8 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
     // Clear reconstructed depth for max depth store.
     if (resetAccumulation) {
 
-        FfxGpuJobDescription clearJob = { FFX_GPU_JOB_CLEAR_FLOAT };
+        FfxGpuJobDescription clearJob = {};
+        clearJob.jobType = FFX_GPU_JOB_CLEAR_FLOAT;
 
         // LockStatus resource has no sign bit, callback functions are compensating for this.
         // Clearing the resource must follow the same logic.
@@ -963,15 +1420,15 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
 
         memcpy(clearJob.clearJobDescriptor.color, clearValuesLockStatus, 4 * sizeof(float));
         clearJob.clearJobDescriptor.target = context->srvResources[lockStatusSrvResourceIndex];
-        context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &clearJob);
+        scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
 
         const float clearValuesToZeroFloat[]{ 0.f, 0.f, 0.f, 0.f };
         memcpy(clearJob.clearJobDescriptor.color, clearValuesToZeroFloat, 4 * sizeof(float));
         clearJob.clearJobDescriptor.target = context->srvResources[upscaledColorSrvResourceIndex];
-        context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &clearJob);
+        scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
 
         clearJob.clearJobDescriptor.target = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_SCENE_LUMINANCE];
-        context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &clearJob);
+        scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
 
         //if (context->contextDescription.flags & FFX_FSR2_ENABLE_AUTO_EXPOSURE)
         // Auto exposure always used to track luma changes in locking logic
@@ -979,30 +1436,42 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
             const float clearValuesExposure[]{ -1.f, 1e8f, 0.f, 0.f };
             memcpy(clearJob.clearJobDescriptor.color, clearValuesExposure, 4 * sizeof(float));
             clearJob.clearJobDescriptor.target = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_AUTO_EXPOSURE];
-            context->contextDescription.callbacks.fpScheduleGpuJob(&context->contextDescription.callbacks, &clearJob);
+            scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
         }
     }
 
     // Auto exposure
-    uint32_t dispatchThreadGroupCountXY[2];
-    uint32_t workGroupOffset[2];
-    uint32_t numWorkGroupsAndMips[2];
-    uint32_t rectInfo[4] = { 0, 0, params->renderSize.width, params->renderSize.height };
-    SpdSetup(dispatchThreadGroupCountXY, workGroupOffset, numWorkGroupsAndMips, rectInfo);
-
-    // downsample
-    Fsr2SpdConstants luminancePyramidConstants;
-    luminancePyramidConstants.numworkGroups = numWorkGroupsAndMips[0];
-    luminancePyramidConstants.mips = numWorkGroupsAndMips[1];
-    luminancePyramidConstants.workGroupOffset[0] = workGroupOffset[0];
-    luminancePyramidConstants.workGroupOffset[1] = workGroupOffset[1];
-    luminancePyramidConstants.renderSize[0] = params->renderSize.width;
-    luminancePyramidConstants.renderSize[1] = params->renderSize.height;
+    if (!setup->valid || setup->renderSize.width != params->renderSize.width || setup->renderSize.height != params->renderSize.height) {
+
+        uint32_t workGroupOffset[2];
+        uint32_t numWorkGroupsAndMips[2];
+        uint32_t rectInfo[4] = { 0, 0, params->renderSize.width, params->renderSize.height };
+        SpdSetup(setup->dispatchThreadGroupCountXY, workGroupOffset, numWorkGroupsAndMips, rectInfo);
+
+        // downsample
+        Fsr2SpdConstants luminancePyramidConstants;
+        luminancePyramidConstants.numworkGroups = numWorkGroupsAndMips[0];
+        luminancePyramidConstants.mips = numWorkGroupsAndMips[1];
+        luminancePyramidConstants.workGroupOffset[0] = workGroupOffset[0];
+        luminancePyramidConstants.workGroupOffset[1] = workGroupOffset[1];
+        luminancePyramidConstants.renderSize[0] = params->renderSize.width;
+        luminancePyramidConstants.renderSize[1] = params->renderSize.height;
+
+        memcpy(&context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_SPD].data, &luminancePyramidConstants, context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_SPD].uint32Size * sizeof(uint32_t));
+        setup->renderSize = params->renderSize;
+    }
 
     // compute the constants.
-    Fsr2RcasConstants rcasConsts = {};
-    const float sharpenessRemapped = (-2.0f * params->sharpness) + 2.0f;
-    FsrRcasCon(rcasConsts.rcasConfig, sharpenessRemapped);
+    if (!setup->valid || setup->sharpness != params->sharpness) {
+
+        Fsr2RcasConstants rcasConsts = {};
+        const float sharpenessRemapped = (-2.0f * params->sharpness) + 2.0f;
+        FsrRcasCon(rcasConsts.rcasConfig, sharpenessRemapped);
+
+        memcpy(&context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_RCAS].data, &rcasConsts, context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_RCAS].uint32Size * sizeof(uint32_t));
+        setup->sharpness = params->sharpness;
+    }
+    setup->valid = true;
 
     Fsr2GenerateReactiveConstants2 genReactiveConsts = {};
     genReactiveConsts.autoTcThreshold = params->autoTcThreshold;
@@ -1011,10 +1480,8 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
     genReactiveConsts.autoReactiveMax = params->autoReactiveMax;
 
     // initialize constantBuffers data
-    memcpy(&globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_FSR2].data,        &context->constants,        globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_FSR2].uint32Size * sizeof(uint32_t));
-    memcpy(&globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_SPD].data,         &luminancePyramidConstants, globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_SPD].uint32Size  * sizeof(uint32_t));
-    memcpy(&globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_RCAS].data,        &rcasConsts,                globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_RCAS].uint32Size * sizeof(uint32_t));
-    memcpy(&globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_GENREACTIVE].data, &genReactiveConsts,         globalFsr2ConstantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_GENREACTIVE].uint32Size * sizeof(uint32_t));
+    memcpy(&context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_FSR2].data,        &context->constants,        context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_FSR2].uint32Size * sizeof(uint32_t));
+    memcpy(&context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_GENREACTIVE].data, &genReactiveConsts,         context->constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_GENREACTIVE].uint32Size * sizeof(uint32_t));
 
     // Auto reactive
     if (params->enableAutoReactive)
@@ -1023,14 +1490,14 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
         context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_INPUT_REACTIVE_MASK] = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_AUTOREACTIVE];
         context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_INPUT_TRANSPARENCY_AND_COMPOSITION_MASK] = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_AUTOCOMPOSITION];
     }
-    scheduleDispatch(context, params, &context->pipelineComputeLuminancePyramid, dispatchThreadGroupCountXY[0], dispatchThreadGroupCountXY[1]);
-    scheduleDispatch(context, params, &context->pipelineReconstructPreviousDepth, dispatchSrcX, dispatchSrcY);
-    scheduleDispatch(context, params, &context->pipelineDepthClip, dispatchSrcX, dispatchSrcY);
+    scheduleDispatch(context, &context->pipelineComputeLuminancePyramid, setup->dispatchThreadGroupCountXY[0], setup->dispatchThreadGroupCountXY[1]);
+    scheduleDispatch(context, &context->pipelineReconstructPreviousDepth, dispatchSrcX, dispatchSrcY);
+    scheduleDispatch(context, &context->pipelineDepthClip, dispatchSrcX, dispatchSrcY);
 
     const bool sharpenEnabled = params->enableSharpening;
 
-    scheduleDispatch(context, params, &context->pipelineLock, dispatchSrcX, dispatchSrcY);
-    scheduleDispatch(context, params, sharpenEnabled ? &context->pipelineAccumulateSharpen : &context->pipelineAccumulate, dispatchDstX, dispatchDstY);
+    scheduleDispatch(context, &context->pipelineLock, dispatchSrcX, dispatchSrcY);
+    scheduleDispatch(context, sharpenEnabled ? &context->pipelineAccumulateSharpen : &context->pipelineAccumulate, dispatchDstX, dispatchDstY);
 
     // RCAS
     if (sharpenEnabled) {
@@ -1039,7 +1506,7 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
         const int32_t threadGroupWorkRegionDimRCAS = 16;
         const int32_t dispatchX = (context->contextDescription.displaySize.width + (threadGroupWorkRegionDimRCAS - 1)) / threadGroupWorkRegionDimRCAS;
         const int32_t dispatchY = (context->contextDescription.displaySize.height + (threadGroupWorkRegionDimRCAS - 1)) / threadGroupWorkRegionDimRCAS;
-        scheduleDispatch(context, params, &context->pipelineRCAS, dispatchX, dispatchY);
+        scheduleDispatch(context, &context->pipelineRCAS, dispatchX, dispatchY);
     }
 
     context->resourceFrameIndex = (context->resourceFrameIndex + 1) % FSR2_MAX_QUEUED_FRAMES;
@@ -1047,11 +1514,77 @@ static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2D
     // Fsr2MaxQueuedFrames must be an even number.
     FFX_STATIC_ASSERT((FSR2_MAX_QUEUED_FRAMES & 1) == 0);
 
-    context->contextDescription.callbacks.fpExecuteGpuJobs(&context->contextDescription.callbacks, commandList);
+    return FFX_OK;
+}
+
+static FfxErrorCode fsr2Dispatch(FfxFsr2Context_Private* context, const FfxFsr2DispatchDescription* params)
+{
+    const uint64_t dispatchStartTime = getHostTime();
+
+    Fsr2DispatchSetup setup = {};
+    const FfxErrorCode errorCode = fsr2ScheduleDispatch(context, params, &setup);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    executeGpuJobs(context, params->commandList);
 
     // release dynamic resources
     context->contextDescription.callbacks.fpUnregisterResources(&context->contextDescription.callbacks);
 
+    completeStatistics(context, 1, dispatchStartTime);
+
+    return FFX_OK;
+}
+
+// Frames are given view after view, frame i upscales view i % viewCount of the context.
+static FfxErrorCode fsr2DispatchBatch(FfxFsr2Context_Private* context, const FfxFsr2DispatchDescription* frames, uint32_t frameCount)
+{
+    const uint64_t dispatchStartTime = getHostTime();
+
+    // backends executing frames one at a time still share the setup of the batch
+    const uint32_t framesPerExecution = FFX_MAXIMUM(1u, context->deviceCapabilities.maximumBatchedFrameCount);
+
+    Fsr2DispatchSetup setup = {};
+    for (uint32_t firstFrame = 0; firstFrame < frameCount; firstFrame += framesPerExecution) {
+
+        const uint32_t lastFrame = FFX_MINIMUM(frameCount, firstFrame + framesPerExecution);
+        for (uint32_t frameIndex = firstFrame; frameIndex < lastFrame; ++frameIndex) {
+
+            const uint32_t viewIndex = frameIndex % context->viewCount;
+            fsr2ActivateView(context, viewIndex);
+
+            // the views share the prepared input color, which accumulation samples past the render size,
+            // so texels left there by a larger view of the previous frame must not leak into this one.
+            if (context->viewCount > 1) {
+
+                const Fsr2Constants& previousConstants = context->views[(viewIndex + context->viewCount - 1) % context->viewCount].constants;
+                if (uint32_t(previousConstants.renderSize[0]) > frames[frameIndex].renderSize.width ||
+                    uint32_t(previousConstants.renderSize[1]) > frames[frameIndex].renderSize.height) {
+
+                    FfxGpuJobDescription clearJob = {};
+                    clearJob.jobType = FFX_GPU_JOB_CLEAR_FLOAT;
+                    clearJob.clearJobDescriptor.target = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_PREPARED_INPUT_COLOR];
+                    scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
+                }
+            }
+
+            const FfxErrorCode errorCode = fsr2ScheduleDispatch(context, &frames[frameIndex], &setup);
+            if (errorCode != FFX_OK) {
+
+                fsr2ActivateView(context, 0);
+                return errorCode;
+            }
+        }
+
+        executeGpuJobs(context, frames[firstFrame].commandList);
+
+        // release dynamic resources
+        context->contextDescription.callbacks.fpUnregisterResources(&context->contextDescription.callbacks);
+    }
+
+    fsr2ActivateView(context, 0);
+
+    completeStatistics(context, frameCount / context->viewCount, dispatchStartTime);
+
     return FFX_OK;
 }
 
@@ -1079,6 +1612,10 @@ FfxErrorCode ffxFsr2ContextCreate(FfxFsr2Context* context, const FfxFsr2ContextD
         FFX_RETURN_ON_ERROR(contextDescription->callbacks.scratchBufferSize, FFX_ERROR_INCOMPLETE_INTERFACE);
     }
 
+    FFX_RETURN_ON_ERROR(
+        contextDescription->viewCount <= FFX_FSR2_MAX_VIEW_COUNT,
+        FFX_ERROR_INVALID_ARGUMENT);
+
     // ensure the context is large enough for the internal context.
     FFX_STATIC_ASSERT(sizeof(FfxFsr2Context) >= sizeof(FfxFsr2Context_Private));
 
@@ -1122,12 +1659,718 @@ FfxErrorCode ffxFsr2ContextDispatch(FfxFsr2Context* context, const FfxFsr2Dispat
     FFX_RETURN_ON_ERROR(
         contextPrivate->device,
         FFX_ERROR_NULL_DEVICE);
+    FFX_RETURN_ON_ERROR(
+        !contextPrivate->resizeFailed,
+        FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(
+        contextPrivate->viewCount == 1,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    const FfxFsr2TraceScope traceScope("ffxFsr2ContextDispatch", "api");
 
     // dispatch the FSR2 passes.
     const FfxErrorCode errorCode = fsr2Dispatch(contextPrivate, dispatchParams);
     return errorCode;
 }
 
+FfxErrorCode ffxFsr2ContextDispatchBatch(FfxFsr2Context* context, const FfxFsr2DispatchDescription* frames, uint32_t frameCount)
+{
+    FFX_RETURN_ON_ERROR(
+        context,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        frames || frameCount == 0,
+        FFX_ERROR_INVALID_POINTER);
+
+    FfxFsr2Context_Private* contextPrivate = (FfxFsr2Context_Private*)(context);
+
+    FFX_RETURN_ON_ERROR(
+        contextPrivate->device,
+        FFX_ERROR_NULL_DEVICE);
+    FFX_RETURN_ON_ERROR(
+        !contextPrivate->resizeFailed,
+        FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(
+        contextPrivate->viewCount == 1,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    // validate every frame before scheduling any, so a failed batch leaves the context untouched.
+    for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+
+        FFX_RETURN_ON_ERROR(
+            frames[frameIndex].renderSize.width <= contextPrivate->contextDescription.maxRenderSize.width,
+            FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(
+            frames[frameIndex].renderSize.height <= contextPrivate->contextDescription.maxRenderSize.height,
+            FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(
+            frames[frameIndex].commandList == frames[0].commandList,
+            FFX_ERROR_INVALID_ARGUMENT);
+    }
+
+    const FfxFsr2TraceScope traceScope("ffxFsr2ContextDispatchBatch", "api");
+
+    // dispatch the FSR2 passes of every frame.
+    const FfxErrorCode errorCode = fsr2DispatchBatch(contextPrivate, frames, frameCount);
+    return errorCode;
+}
+
+FfxErrorCode ffxFsr2ContextDispatchViews(FfxFsr2Context* context, const FfxFsr2DispatchDescription* views, uint32_t viewCount)
+{
+    FFX_RETURN_ON_ERROR(
+        context,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        views,
+        FFX_ERROR_INVALID_POINTER);
+
+    FfxFsr2Context_Private* contextPrivate = (FfxFsr2Context_Private*)(context);
+
+    FFX_RETURN_ON_ERROR(
+        contextPrivate->device,
+        FFX_ERROR_NULL_DEVICE);
+    FFX_RETURN_ON_ERROR(
+        !contextPrivate->resizeFailed,
+        FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(
+        viewCount == contextPrivate->viewCount,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    // validate every view before scheduling any, so a failed call leaves the context untouched.
+    for (uint32_t viewIndex = 0; viewIndex < viewCount; ++viewIndex) {
+
+        FFX_RETURN_ON_ERROR(
+            views[viewIndex].renderSize.width <= contextPrivate->contextDescription.maxRenderSize.width,
+            FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(
+            views[viewIndex].renderSize.height <= contextPrivate->contextDescription.maxRenderSize.height,
+            FFX_ERROR_OUT_OF_RANGE);
+        FFX_RETURN_ON_ERROR(
+            views[viewIndex].commandList == views[0].commandList,
+            FFX_ERROR_INVALID_ARGUMENT);
+    }
+
+    const FfxFsr2TraceScope traceScope("ffxFsr2ContextDispatchViews", "api");
+
+    // dispatch the FSR2 passes of every view.
+    const FfxErrorCode errorCode = fsr2DispatchBatch(contextPrivate, views, viewCount);
+    return errorCode;
+}
+
+// Saved temporal state, a header followed by one record and its texels per history resource.
+static const uint32_t FSR2_STATE_MAGIC = 0x54533246;   // "F2ST"
+static const uint32_t FSR2_STATE_VERSION = 2;
+
+typedef struct Fsr2StateHeader {
+
+    uint32_t                    magic;
+    uint32_t                    version;
+    uint32_t                    contextFlags;
+    uint32_t                    displaySize[2];
+    uint32_t                    maxRenderSize[2];
+    uint32_t                    resourceFrameIndex;
+    int32_t                     frameIndex;
+    float                       jitterPhaseCount;
+    float                       preExposure;
+    float                       previousJitterOffset[2];
+    uint32_t                    resourceCount;
+} Fsr2StateHeader;
+
+typedef struct Fsr2StateRecord {
+
+    uint32_t                    history;
+    uint32_t                    format;
+    uint32_t                    width;
+    uint32_t                    height;
+    uint32_t                    dataSize;
+} Fsr2StateRecord;
+
+typedef struct Fsr2StateHistory {
+
+    uint32_t                    evenResourceIndex;      // read by the next dispatch when the resource frame index is even
+    uint32_t                    oddResourceIndex;
+    FfxSurfaceFormat            format;
+    uint32_t                    texelSize;
+    FfxSurfaceFormat            quantizedFormat;        // the format of the resource description
+    uint32_t                    quantizedTexelSize;
+    bool                        displayResolution;      // resampled when the display size changes, the others keep their texels
+} Fsr2StateHistory;
+
+static const Fsr2StateHistory stateHistoryTable[] =
+{
+    { FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_UPSCALED_COLOR_1, FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_UPSCALED_COLOR_2,
+      FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT, 16, FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, 8, true },
+    { FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_1, FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS_2,
+      FFX_SURFACE_FORMAT_R32G32_FLOAT, 8, FFX_SURFACE_FORMAT_R16G16_FLOAT, 4, true },
+    { FFX_FSR2_RESOURCE_IDENTIFIER_LUMA_HISTORY_1, FFX_FSR2_RESOURCE_IDENTIFIER_LUMA_HISTORY_2,
+      FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT, 16, FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, 4, true },
+    { FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DILATED_MOTION_VECTORS_2, FFX_FSR2_RESOURCE_IDENTIFIER_INTERNAL_DILATED_MOTION_VECTORS_1,
+      FFX_SURFACE_FORMAT_R32G32_FLOAT, 8, FFX_SURFACE_FORMAT_R16G16_FLOAT, 4, false },
+    { FFX_FSR2_RESOURCE_IDENTIFIER_AUTO_EXPOSURE, FFX_FSR2_RESOURCE_IDENTIFIER_AUTO_EXPOSURE,
+      FFX_SURFACE_FORMAT_R32G32_FLOAT, 8, FFX_SURFACE_FORMAT_R32G32_FLOAT, 8, false },
+    // the lock pass resets it to the far plane for the next frame
+    { FFX_FSR2_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH, FFX_FSR2_RESOURCE_IDENTIFIER_RECONSTRUCTED_PREVIOUS_NEAREST_DEPTH,
+      FFX_SURFACE_FORMAT_R32_UINT, 4, FFX_SURFACE_FORMAT_R32_UINT, 4, false },    // the colors before and after alpha of the previous frame, read by the automatic reactive mask
+    { FFX_FSR2_RESOURCE_IDENTIFIER_PREV_PRE_ALPHA_COLOR_1, FFX_FSR2_RESOURCE_IDENTIFIER_PREV_PRE_ALPHA_COLOR_2,
+      FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT, 16, FFX_SURFACE_FORMAT_R11G11B10_FLOAT, 4, false },
+    { FFX_FSR2_RESOURCE_IDENTIFIER_PREV_POST_ALPHA_COLOR_1, FFX_FSR2_RESOURCE_IDENTIFIER_PREV_POST_ALPHA_COLOR_2,
+      FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT, 16, FFX_SURFACE_FORMAT_R11G11B10_FLOAT, 4, false },
+};
+
+static FfxResourceInternal getStateHistoryResource(const FfxFsr2Context_Private* context, const Fsr2StateHistory& history)
+{
+    const bool isOddFrame = !!(context->resourceFrameIndex & 1);
+    return context->srvResources[isOddFrame ? history.oddResourceIndex : history.evenResourceIndex];
+}
+
+// The state of a context is the one of each of its views, one after the other, each a header and its records.
+static size_t getViewStateSize(FfxFsr2Context_Private* context, bool quantize, Fsr2StateRecord* records)
+{
+    FfxFsr2Interface* callbacks = &context->contextDescription.callbacks;
+
+    size_t stateSize = sizeof(Fsr2StateHeader);
+    for (uint32_t historyIndex = 0; historyIndex < FFX_ARRAY_ELEMENTS(stateHistoryTable); ++historyIndex) {
+
+        const Fsr2StateHistory& history = stateHistoryTable[historyIndex];
+        const FfxResourceDescription description = callbacks->fpGetResourceDescription(callbacks, getStateHistoryResource(context, history));
+
+        Fsr2StateRecord& record = records[historyIndex];
+        record.history = historyIndex;
+        record.format = quantize ? history.quantizedFormat : history.format;
+        record.width = description.width;
+        record.height = description.height;
+        record.dataSize = description.width * description.height * (quantize ? history.quantizedTexelSize : history.texelSize);
+        stateSize += sizeof(Fsr2StateRecord) + record.dataSize;
+    }
+
+    return stateSize;
+}
+
+static FfxErrorCode saveViewState(FfxFsr2Context_Private* context, bool quantize, uint8_t* state)
+{
+    FfxFsr2Interface* callbacks = &context->contextDescription.callbacks;
+
+    Fsr2StateRecord records[FFX_ARRAY_ELEMENTS(stateHistoryTable)];
+    getViewStateSize(context, quantize, records);
+
+    Fsr2StateHeader header = {};
+    header.magic = FSR2_STATE_MAGIC;
+    header.version = FSR2_STATE_VERSION;
+    header.contextFlags = context->contextDescription.flags;
+    header.displaySize[0] = context->contextDescription.displaySize.width;
+    header.displaySize[1] = context->contextDescription.displaySize.height;
+    header.maxRenderSize[0] = context->contextDescription.maxRenderSize.width;
+    header.maxRenderSize[1] = context->contextDescription.maxRenderSize.height;
+    header.resourceFrameIndex = context->resourceFrameIndex;
+    header.frameIndex = context->firstExecution ? -1 : context->constants.frameIndex;
+    header.jitterPhaseCount = context->constants.jitterPhaseCount;
+    header.preExposure = context->constants.preExposure;
+    header.previousJitterOffset[0] = context->previousJitterOffset[0];
+    header.previousJitterOffset[1] = context->previousJitterOffset[1];
+    header.resourceCount = FFX_ARRAY_ELEMENTS(stateHistoryTable);
+
+    memcpy(state, &header, sizeof(header));
+    state += sizeof(header);
+
+    for (uint32_t historyIndex = 0; historyIndex < FFX_ARRAY_ELEMENTS(stateHistoryTable); ++historyIndex) {
+
+        const Fsr2StateRecord& record = records[historyIndex];
+        memcpy(state, &record, sizeof(record));
+        state += sizeof(record);
+
+        const FfxErrorCode errorCode = callbacks->fpReadResource(callbacks, getStateHistoryResource(context, stateHistoryTable[historyIndex]), FfxSurfaceFormat(record.format), state, record.dataSize);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+        state += record.dataSize;
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2ContextSaveState(FfxFsr2Context* context, uint32_t flags, void* buffer, size_t* bufferSize)
+{
+    FFX_RETURN_ON_ERROR(
+        context,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        bufferSize,
+        FFX_ERROR_INVALID_POINTER);
+
+    FfxFsr2Context_Private* contextPrivate = (FfxFsr2Context_Private*)(context);
+
+    FFX_RETURN_ON_ERROR(
+        !contextPrivate->resizeFailed,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    const bool quantize = (flags & FFX_FSR2_STATE_QUANTIZE) != 0;
+
+    Fsr2StateRecord records[FFX_ARRAY_ELEMENTS(stateHistoryTable)];
+    size_t viewStateSizes[FFX_FSR2_MAX_VIEW_COUNT];
+    size_t stateSize = 0;
+    for (uint32_t viewIndex = 0; viewIndex < contextPrivate->viewCount; ++viewIndex) {
+
+        fsr2ActivateView(contextPrivate, viewIndex);
+        viewStateSizes[viewIndex] = getViewStateSize(contextPrivate, quantize, records);
+        stateSize += viewStateSizes[viewIndex];
+    }
+    fsr2ActivateView(contextPrivate, 0);
+
+    if (buffer == nullptr) {
+
+        *bufferSize = stateSize;
+        return FFX_OK;
+    }
+
+    FFX_RETURN_ON_ERROR(
+        *bufferSize >= stateSize,
+        FFX_ERROR_INSUFFICIENT_MEMORY);
+    FFX_RETURN_ON_ERROR(
+        contextPrivate->contextDescription.callbacks.fpReadResource,
+        FFX_ERROR_INCOMPLETE_INTERFACE);
+
+    uint8_t* state = static_cast<uint8_t*>(buffer);
+    FfxErrorCode errorCode = FFX_OK;
+    for (uint32_t viewIndex = 0; viewIndex < contextPrivate->viewCount && errorCode == FFX_OK; ++viewIndex) {
+
+        fsr2ActivateView(contextPrivate, viewIndex);
+        errorCode = saveViewState(contextPrivate, quantize, state);
+        state += viewStateSizes[viewIndex];
+    }
+    fsr2ActivateView(contextPrivate, 0);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    *bufferSize = stateSize;
+    return FFX_OK;
+}
+
+// Check the state of a view starting at state, without touching the context. Receives the records and the end of the view state.
+static FfxErrorCode validateViewState(const FfxFsr2Context_Private* context, const uint8_t* state, const uint8_t* stateEnd, const uint8_t** outRecords, const uint8_t** outViewStateEnd)
+{
+    Fsr2StateHeader header = {};
+    FFX_RETURN_ON_ERROR(
+        size_t(stateEnd - state) >= sizeof(header),
+        FFX_ERROR_MALFORMED_DATA);
+    memcpy(&header, state, sizeof(header));
+    FFX_RETURN_ON_ERROR(
+        header.magic == FSR2_STATE_MAGIC && header.version == FSR2_STATE_VERSION,
+        FFX_ERROR_MALFORMED_DATA);
+    FFX_RETURN_ON_ERROR(
+        header.resourceCount == FFX_ARRAY_ELEMENTS(stateHistoryTable) && header.resourceFrameIndex < FSR2_MAX_QUEUED_FRAMES,
+        FFX_ERROR_MALFORMED_DATA);
+
+    // debug checking does not change what the history means
+    const uint32_t comparedFlags = ~uint32_t(FFX_FSR2_ENABLE_DEBUG_CHECKING);
+    FFX_RETURN_ON_ERROR(
+        (header.contextFlags & comparedFlags) == (context->contextDescription.flags & comparedFlags),
+        FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(
+        header.displaySize[0] == context->contextDescription.displaySize.width &&
+        header.displaySize[1] == context->contextDescription.displaySize.height &&
+        header.maxRenderSize[0] == context->contextDescription.maxRenderSize.width &&
+        header.maxRenderSize[1] == context->contextDescription.maxRenderSize.height,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    state += sizeof(header);
+    for (uint32_t historyIndex = 0; historyIndex < FFX_ARRAY_ELEMENTS(stateHistoryTable); ++historyIndex) {
+
+        Fsr2StateRecord record = {};
+        FFX_RETURN_ON_ERROR(
+            size_t(stateEnd - state) >= sizeof(record),
+            FFX_ERROR_MALFORMED_DATA);
+        memcpy(&record, state, sizeof(record));
+
+        const Fsr2StateHistory& history = stateHistoryTable[historyIndex];
+        const bool quantized = record.format == uint32_t(history.quantizedFormat);
+        FFX_RETURN_ON_ERROR(
+            record.history == historyIndex && (quantized || record.format == uint32_t(history.format)),
+            FFX_ERROR_MALFORMED_DATA);
+        FFX_RETURN_ON_ERROR(
+            uint64_t(record.width) * record.height * (quantized ? history.quantizedTexelSize : history.texelSize) == record.dataSize &&
+            size_t(stateEnd - state) - sizeof(record) >= record.dataSize,
+            FFX_ERROR_MALFORMED_DATA);
+
+        outRecords[historyIndex] = state;
+        state += sizeof(record) + record.dataSize;
+    }
+
+    *outViewStateEnd = state;
+    return FFX_OK;
+}
+
+static FfxErrorCode loadViewState(FfxFsr2Context_Private* context, const uint8_t* state, const uint8_t* const* records, bool* clearPreparedInputColor)
+{
+    FfxFsr2Interface* callbacks = &context->contextDescription.callbacks;
+
+    Fsr2StateHeader header = {};
+    memcpy(&header, state, sizeof(header));
+
+    // the parity decides which of the ping-ponged resources the next dispatch reads
+    context->resourceFrameIndex = header.resourceFrameIndex;
+
+    for (uint32_t historyIndex = 0; historyIndex < FFX_ARRAY_ELEMENTS(stateHistoryTable); ++historyIndex) {
+
+        Fsr2StateRecord record = {};
+        memcpy(&record, records[historyIndex], sizeof(record));
+
+        const FfxErrorCode errorCode = callbacks->fpWriteResource(callbacks, getStateHistoryResource(context, stateHistoryTable[historyIndex]), FfxSurfaceFormat(record.format), records[historyIndex] + sizeof(record), record.dataSize);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+    }
+
+    // a state saved before the first dispatch has no history, the next dispatch resets as usual
+    if (header.frameIndex < 0) {
+
+        context->firstExecution = true;
+        return FFX_OK;
+    }
+
+    // the first dispatch of a fresh context clears resources, only the ones without history must be cleared now
+    if (context->firstExecution) {
+
+        *clearPreparedInputColor = true;
+        context->firstExecution = false;
+    }
+
+    context->constants.frameIndex = header.frameIndex;
+    context->constants.jitterPhaseCount = header.jitterPhaseCount;
+    context->constants.preExposure = header.preExposure;
+    context->previousJitterOffset[0] = header.previousJitterOffset[0];
+    context->previousJitterOffset[1] = header.previousJitterOffset[1];
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2ContextLoadState(FfxFsr2Context* context, const void* buffer, size_t bufferSize)
+{
+    FFX_RETURN_ON_ERROR(
+        context,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        buffer,
+        FFX_ERROR_INVALID_POINTER);
+
+    FfxFsr2Context_Private* contextPrivate = (FfxFsr2Context_Private*)(context);
+
+    FFX_RETURN_ON_ERROR(
+        !contextPrivate->resizeFailed,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    // validate the state of every view before writing any, so a malformed state leaves the context untouched.
+    const uint8_t* viewStates[FFX_FSR2_MAX_VIEW_COUNT];
+    const uint8_t* records[FFX_FSR2_MAX_VIEW_COUNT][FFX_ARRAY_ELEMENTS(stateHistoryTable)];
+    const uint8_t* state = static_cast<const uint8_t*>(buffer);
+    const uint8_t* stateEnd = static_cast<const uint8_t*>(buffer) + bufferSize;
+    for (uint32_t viewIndex = 0; viewIndex < contextPrivate->viewCount; ++viewIndex) {
+
+        // a state with fewer views than the context was saved from another context
+        FFX_RETURN_ON_ERROR(
+            viewIndex == 0 || state != stateEnd,
+            FFX_ERROR_INVALID_ARGUMENT);
+
+        viewStates[viewIndex] = state;
+        const FfxErrorCode errorCode = validateViewState(contextPrivate, state, stateEnd, records[viewIndex], &state);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    }
+
+    // as is one with more views
+    uint32_t magic = 0;
+    if (size_t(stateEnd - state) >= sizeof(Fsr2StateHeader)) {
+        memcpy(&magic, state, sizeof(magic));
+    }
+    FFX_RETURN_ON_ERROR(
+        magic != FSR2_STATE_MAGIC,
+        FFX_ERROR_INVALID_ARGUMENT);
+    FFX_RETURN_ON_ERROR(
+        contextPrivate->contextDescription.callbacks.fpWriteResource,
+        FFX_ERROR_INCOMPLETE_INTERFACE);
+
+    bool clearPreparedInputColor = false;
+    FfxErrorCode errorCode = FFX_OK;
+    for (uint32_t viewIndex = 0; viewIndex < contextPrivate->viewCount && errorCode == FFX_OK; ++viewIndex) {
+
+        fsr2ActivateView(contextPrivate, viewIndex);
+        errorCode = loadViewState(contextPrivate, viewStates[viewIndex], records[viewIndex], &clearPreparedInputColor);
+    }
+    fsr2ActivateView(contextPrivate, 0);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    // the resource is shared by the views
+    if (clearPreparedInputColor) {
+
+        FfxGpuJobDescription clearJob = {};
+        clearJob.jobType = FFX_GPU_JOB_CLEAR_FLOAT;
+        clearJob.clearJobDescriptor.target = contextPrivate->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_PREPARED_INPUT_COLOR];
+        scheduleGpuJob(contextPrivate, &clearJob, FFX_FSR2_PASS_COUNT);
+    }
+
+    return FFX_OK;
+}
+
+// Resample a history of display resolution with a bilinear filter, its texels are 32 bit float channels.
+static void resampleHistory(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* destination, uint32_t width, uint32_t height, uint32_t texelSize)
+{
+    const uint32_t channelCount = texelSize / sizeof(float);
+    const float* sourceTexels = reinterpret_cast<const float*>(source);
+    float* destinationTexels = reinterpret_cast<float*>(destination);
+
+    for (uint32_t y = 0; y < height; ++y) {
+
+        const float sourceY = FFX_MINIMUM(FFX_MAXIMUM((y + 0.5f) * sourceHeight / height - 0.5f, 0.0f), float(sourceHeight - 1));
+        const uint32_t y0 = uint32_t(sourceY);
+        const uint32_t y1 = FFX_MINIMUM(y0 + 1, sourceHeight - 1);
+        const float weightY = sourceY - y0;
+
+        for (uint32_t x = 0; x < width; ++x) {
+
+            const float sourceX = FFX_MINIMUM(FFX_MAXIMUM((x + 0.5f) * sourceWidth / width - 0.5f, 0.0f), float(sourceWidth - 1));
+            const uint32_t x0 = uint32_t(sourceX);
+            const uint32_t x1 = FFX_MINIMUM(x0 + 1, sourceWidth - 1);
+            const float weightX = sourceX - x0;
+
+            for (uint32_t channel = 0; channel < channelCount; ++channel) {
+
+                const float top = sourceTexels[(y0 * sourceWidth + x0) * channelCount + channel] * (1.0f - weightX) + sourceTexels[(y0 * sourceWidth + x1) * channelCount + channel] * weightX;
+                const float bottom = sourceTexels[(y1 * sourceWidth + x0) * channelCount + channel] * (1.0f - weightX) + sourceTexels[(y1 * sourceWidth + x1) * channelCount + channel] * weightX;
+                destinationTexels[(y * width + x) * channelCount + channel] = top * (1.0f - weightY) + bottom * weightY;
+            }
+        }
+    }
+}
+
+// Copy a history of render resolution texel for texel, as the next dispatch would find it after a change of the render size,
+// texels beyond the previous size repeat its edge.
+static void cropHistory(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* destination, uint32_t width, uint32_t height, uint32_t texelSize)
+{
+    for (uint32_t y = 0; y < height; ++y) {
+
+        const uint32_t sourceY = FFX_MINIMUM(y, sourceHeight - 1);
+        for (uint32_t x = 0; x < width; ++x) {
+
+            const uint32_t sourceX = FFX_MINIMUM(x, sourceWidth - 1);
+            memcpy(destination + (size_t(y) * width + x) * texelSize, source + (size_t(sourceY) * sourceWidth + sourceX) * texelSize, texelSize);
+        }
+    }
+}
+
+static FfxErrorCode fsr2Resize(FfxFsr2Context_Private* context, FfxDimensions2D maxRenderSize, FfxDimensions2D displaySize, bool rescaleHistory)
+{
+    FfxFsr2Interface* callbacks = &context->contextDescription.callbacks;
+
+    FfxFsr2ContextDescription contextDescription = context->contextDescription;
+    contextDescription.maxRenderSize = maxRenderSize;
+    contextDescription.displaySize = displaySize;
+
+    Fsr2ResourceDescription previousSurfaceDesc[FSR2_INTERNAL_SURFACE_COUNT];
+    Fsr2ResourceDescription internalSurfaceDesc[FSR2_INTERNAL_SURFACE_COUNT];
+    getInternalSurfaceDescriptions(&context->contextDescription, previousSurfaceDesc);
+    getInternalSurfaceDescriptions(&contextDescription, internalSurfaceDesc);
+
+    // only the resources whose size depends on the changed sizes are created again
+    bool resized[FFX_FSR2_RESOURCE_IDENTIFIER_COUNT] = {};
+    bool anyResized = false;
+    for (uint32_t currentSurfaceIndex = 0; currentSurfaceIndex < FSR2_INTERNAL_SURFACE_COUNT; ++currentSurfaceIndex) {
+
+        resized[internalSurfaceDesc[currentSurfaceIndex].id] =
+            internalSurfaceDesc[currentSurfaceIndex].width != previousSurfaceDesc[currentSurfaceIndex].width ||
+            internalSurfaceDesc[currentSurfaceIndex].height != previousSurfaceDesc[currentSurfaceIndex].height;
+        anyResized |= resized[internalSurfaceDesc[currentSurfaceIndex].id];
+    }
+
+    // the sizes did not change, neither does the context
+    if (!anyResized) {
+        return FFX_OK;
+    }
+
+    // the transient resources are laid out again when one of them changes size
+    bool replanTransientResources = false;
+    for (uint32_t currentSurfaceIndex = 0; currentSurfaceIndex < FSR2_INTERNAL_SURFACE_COUNT && context->transientHeapSize; ++currentSurfaceIndex) {
+
+        replanTransientResources |= (internalSurfaceDesc[currentSurfaceIndex].flags & FFX_RESOURCE_FLAGS_ALIASABLE) && resized[internalSurfaceDesc[currentSurfaceIndex].id];
+    }
+
+    // read the history the next dispatch of each view would read, before its resources are released
+    std::vector<uint8_t> histories[FFX_FSR2_MAX_VIEW_COUNT][FFX_ARRAY_ELEMENTS(stateHistoryTable)];
+    FfxResourceDescription historyDescriptions[FFX_FSR2_MAX_VIEW_COUNT][FFX_ARRAY_ELEMENTS(stateHistoryTable)] = {};
+    FfxErrorCode errorCode = FFX_OK;
+    for (uint32_t viewIndex = 0; viewIndex < context->viewCount && rescaleHistory && errorCode == FFX_OK; ++viewIndex) {
+
+        fsr2ActivateView(context, viewIndex);
+        for (uint32_t historyIndex = 0; historyIndex < FFX_ARRAY_ELEMENTS(stateHistoryTable) && !context->firstExecution && errorCode == FFX_OK; ++historyIndex) {
+
+            const Fsr2StateHistory& history = stateHistoryTable[historyIndex];
+            if (!resized[history.evenResourceIndex]) {
+                continue;
+            }
+
+            const FfxResourceInternal resource = getStateHistoryResource(context, history);
+            const FfxResourceDescription description = callbacks->fpGetResourceDescription(callbacks, resource);
+            historyDescriptions[viewIndex][historyIndex] = description;
+            histories[viewIndex][historyIndex].resize(size_t(description.width) * description.height * history.texelSize);
+            errorCode = callbacks->fpReadResource(callbacks, resource, history.format, histories[viewIndex][historyIndex].data(), uint32_t(histories[viewIndex][historyIndex].size()));
+        }
+    }
+    fsr2ActivateView(context, 0);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+
+    // all of them move to the new heap, which replaces the one they are placed in
+    if (replanTransientResources) {
+
+        for (uint32_t currentSurfaceIndex = 0; currentSurfaceIndex < FSR2_INTERNAL_SURFACE_COUNT; ++currentSurfaceIndex) {
+
+            const uint32_t resourceIdentifier = internalSurfaceDesc[currentSurfaceIndex].id;
+            if (internalSurfaceDesc[currentSurfaceIndex].flags & FFX_RESOURCE_FLAGS_ALIASABLE) {
+
+                fsr2SafeReleaseResource(context, context->srvResources[resourceIdentifier]);
+                context->srvResources[resourceIdentifier] = { FFX_FSR2_RESOURCE_IDENTIFIER_NULL };
+                context->uavResources[resourceIdentifier] = { FFX_FSR2_RESOURCE_IDENTIFIER_NULL };
+            }
+        }
+
+        errorCode = planTransientResources(context, internalSurfaceDesc);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+        for (uint32_t currentSurfaceIndex = 0; currentSurfaceIndex < FSR2_INTERNAL_SURFACE_COUNT; ++currentSurfaceIndex) {
+
+            const Fsr2ResourceDescription* currentSurfaceDescription = &internalSurfaceDesc[currentSurfaceIndex];
+            if (currentSurfaceDescription->flags & FFX_RESOURCE_FLAGS_ALIASABLE) {
+
+                errorCode = createInternalResource(context, currentSurfaceDescription, &context->srvResources[currentSurfaceDescription->id]);
+                FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+                context->uavResources[currentSurfaceDescription->id] = context->srvResources[currentSurfaceDescription->id];
+
+                // nothing is left to do for it below
+                resized[currentSurfaceDescription->id] = false;
+            }
+        }
+    }
+
+    // the resources shared by the views are created again with the first one
+    for (uint32_t viewIndex = 0; viewIndex < context->viewCount; ++viewIndex) {
+
+        fsr2ActivateView(context, viewIndex);
+        context->constants.displaySize[0] = displaySize.width;
+        context->constants.displaySize[1] = displaySize.height;
+
+        for (uint32_t currentSurfaceIndex = 0; currentSurfaceIndex < FSR2_INTERNAL_SURFACE_COUNT; ++currentSurfaceIndex) {
+
+            const Fsr2ResourceDescription* currentSurfaceDescription = &internalSurfaceDesc[currentSurfaceIndex];
+            if (!resized[currentSurfaceDescription->id] || (viewIndex > 0 && getViewResourceIndex(currentSurfaceDescription->id) < 0)) {
+                continue;
+            }
+
+            fsr2SafeReleaseResource(context, context->srvResources[currentSurfaceDescription->id]);
+            context->srvResources[currentSurfaceDescription->id] = { FFX_FSR2_RESOURCE_IDENTIFIER_NULL };
+            context->uavResources[currentSurfaceDescription->id] = { FFX_FSR2_RESOURCE_IDENTIFIER_NULL };
+            errorCode = createInternalResource(context, currentSurfaceDescription, &context->srvResources[currentSurfaceDescription->id]);
+            if (errorCode != FFX_OK) {
+                break;
+            }
+            context->uavResources[currentSurfaceDescription->id] = context->srvResources[currentSurfaceDescription->id];
+        }
+
+        if (errorCode != FFX_OK) {
+            break;
+        }
+    }
+    fsr2ActivateView(context, 0);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    context->contextDescription.maxRenderSize = maxRenderSize;
+    context->contextDescription.displaySize = displaySize;
+
+    // write the history back at the new sizes, or reset it
+    bool clearPreparedInputColor = false;
+    for (uint32_t viewIndex = 0; viewIndex < context->viewCount && errorCode == FFX_OK; ++viewIndex) {
+
+        fsr2ActivateView(context, viewIndex);
+        if (!rescaleHistory) {
+
+            context->firstExecution = true;
+            continue;
+        }
+
+        for (uint32_t historyIndex = 0; historyIndex < FFX_ARRAY_ELEMENTS(stateHistoryTable) && !context->firstExecution && errorCode == FFX_OK; ++historyIndex) {
+
+            const Fsr2StateHistory& history = stateHistoryTable[historyIndex];
+            if (!resized[history.evenResourceIndex]) {
+                continue;
+            }
+
+            const FfxResourceInternal resource = getStateHistoryResource(context, history);
+            const FfxResourceDescription description = callbacks->fpGetResourceDescription(callbacks, resource);
+            const FfxResourceDescription& previousDescription = historyDescriptions[viewIndex][historyIndex];
+            std::vector<uint8_t> rescaled(size_t(description.width) * description.height * history.texelSize);
+
+            if (history.displayResolution) {
+                resampleHistory(histories[viewIndex][historyIndex].data(), previousDescription.width, previousDescription.height, rescaled.data(), description.width, description.height, history.texelSize);
+            } else {
+                cropHistory(histories[viewIndex][historyIndex].data(), previousDescription.width, previousDescription.height, rescaled.data(), description.width, description.height, history.texelSize);
+            }
+
+            errorCode = callbacks->fpWriteResource(callbacks, resource, history.format, rescaled.data(), uint32_t(rescaled.size()));
+        }
+
+        clearPreparedInputColor |= !context->firstExecution;
+    }
+    fsr2ActivateView(context, 0);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, FFX_ERROR_BACKEND_API_ERROR);
+
+    // the first dispatch of a view clears it, the ones continuing their history have to find it cleared too
+    if (clearPreparedInputColor && resized[FFX_FSR2_RESOURCE_IDENTIFIER_PREPARED_INPUT_COLOR]) {
+
+        FfxGpuJobDescription clearJob = {};
+        clearJob.jobType = FFX_GPU_JOB_CLEAR_FLOAT;
+        clearJob.clearJobDescriptor.target = context->srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_PREPARED_INPUT_COLOR];
+        scheduleGpuJob(context, &clearJob, FFX_FSR2_PASS_COUNT);
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2ContextResize(FfxFsr2Context* context, FfxDimensions2D maxRenderSize, FfxDimensions2D displaySize, uint32_t flags)
+{
+    FFX_RETURN_ON_ERROR(
+        context,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        maxRenderSize.width && maxRenderSize.height && displaySize.width && displaySize.height,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    FfxFsr2Context_Private* contextPrivate = (FfxFsr2Context_Private*)(context);
+
+    FFX_RETURN_ON_ERROR(
+        !contextPrivate->resizeFailed,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    const bool rescaleHistory = (flags & FFX_FSR2_RESIZE_RESCALE_HISTORY) != 0;
+
+    if (rescaleHistory) {
+
+        FFX_RETURN_ON_ERROR(
+            contextPrivate->contextDescription.callbacks.fpReadResource && contextPrivate->contextDescription.callbacks.fpWriteResource,
+            FFX_ERROR_INCOMPLETE_INTERFACE);
+    }
+
+    const FfxErrorCode errorCode = fsr2Resize(contextPrivate, maxRenderSize, displaySize, rescaleHistory);
+
+    // a failed resize leaves some of the resources released or sized differently from the description
+    contextPrivate->resizeFailed = errorCode != FFX_OK;
+    return errorCode;
+}
+
+FfxErrorCode ffxFsr2ContextGetStatistics(FfxFsr2Context* context, FfxFsr2FrameStats* outStatistics)
+{
+    FFX_RETURN_ON_ERROR(
+        context,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        outStatistics,
+        FFX_ERROR_INVALID_POINTER);
+
+    const FfxFsr2Context_Private* contextPrivate = (const FfxFsr2Context_Private*)(context);
+    *outStatistics = contextPrivate->statistics;
+
+    return FFX_OK;
+}
+
 float ffxFsr2GetUpscaleRatioFromQualityMode(FfxFsr2QualityMode qualityMode)
 {
     switch (qualityMode) {
@@ -1233,6 +2476,11 @@ FfxErrorCode ffxFsr2ContextGenerateReactiveMask(FfxFsr2Context* context, const F
     FFX_RETURN_ON_ERROR(
         contextPrivate->device,
         FFX_ERROR_NULL_DEVICE);
+    FFX_RETURN_ON_ERROR(
+        !contextPrivate->resizeFailed,
+        FFX_ERROR_INVALID_ARGUMENT);
+
+    const FfxFsr2TraceScope traceScope("ffxFsr2ContextGenerateReactiveMask", "api");
 
     if (contextPrivate->refreshPipelineStates) {
 
@@ -1286,13 +2534,17 @@ FfxErrorCode ffxFsr2ContextGenerateReactiveMask(FfxFsr2Context* context, const F
     memcpy(&jobDescriptor.cbs[0].data, &constants, sizeof(constants));
     wcscpy_s(jobDescriptor.cbNames[0], pipeline->cbResourceBindings[0].name);
 
-    FfxGpuJobDescription dispatchJob = { FFX_GPU_JOB_COMPUTE };
+    FfxGpuJobDescription dispatchJob = {};
+    dispatchJob.jobType = FFX_GPU_JOB_COMPUTE;
     dispatchJob.computeJobDescriptor = jobDescriptor;
 
     contextPrivate->contextDescription.callbacks.fpScheduleGpuJob(&contextPrivate->contextDescription.callbacks, &dispatchJob);
 
     contextPrivate->contextDescription.callbacks.fpExecuteGpuJobs(&contextPrivate->contextDescription.callbacks, commandList);
 
+    // jobs still pending from the context were executed as well, they are not part of a dispatch anymore
+    contextPrivate->scheduledJobCount = 0;
+
     // restore internal reactive
     contextPrivate->uavResources[FFX_FSR2_RESOURCE_IDENTIFIER_AUTOREACTIVE] = internalReactive;
 
@@ -1301,15 +2553,14 @@ FfxErrorCode ffxFsr2ContextGenerateReactiveMask(FfxFsr2Context* context, const F
 
 static FfxErrorCode generateReactiveMaskInternal(FfxFsr2Context_Private* contextPrivate, const FfxFsr2DispatchDescription* params)
 {
+    const FfxFsr2TraceScope traceScope(ffxFsr2TraceGetPassName(FFX_FSR2_PASS_TCR_AUTOGENERATE), "schedule");
+
     if (contextPrivate->refreshPipelineStates) {
 
         createPipelineStates(contextPrivate);
         contextPrivate->refreshPipelineStates = false;
     }
 
-    // take a short cut to the command list
-    FfxCommandList commandList = params->commandList;
-
     FfxPipelineState* pipeline = &contextPrivate->pipelineTcrAutogenerate;
 
     const int32_t threadGroupWorkRegionDim = 8;
@@ -1345,14 +2596,15 @@ static FfxErrorCode generateReactiveMaskInternal(FfxFsr2Context_Private* context
 
     for (uint32_t currentRootConstantIndex = 0; currentRootConstantIndex < pipeline->constCount; ++currentRootConstantIndex) {
         wcscpy_s(jobDescriptor.cbNames[currentRootConstantIndex], pipeline->cbResourceBindings[currentRootConstantIndex].name);
-        jobDescriptor.cbs[currentRootConstantIndex] = globalFsr2ConstantBuffers[pipeline->cbResourceBindings[currentRootConstantIndex].resourceIdentifier];
+        jobDescriptor.cbs[currentRootConstantIndex] = contextPrivate->constantBuffers[pipeline->cbResourceBindings[currentRootConstantIndex].resourceIdentifier];
         jobDescriptor.cbSlotIndex[currentRootConstantIndex] = pipeline->cbResourceBindings[currentRootConstantIndex].slotIndex;
     }
 
-    FfxGpuJobDescription dispatchJob = { FFX_GPU_JOB_COMPUTE };
+    FfxGpuJobDescription dispatchJob = {};
+    dispatchJob.jobType = FFX_GPU_JOB_COMPUTE;
     dispatchJob.computeJobDescriptor = jobDescriptor;
 
-    contextPrivate->contextDescription.callbacks.fpScheduleGpuJob(&contextPrivate->contextDescription.callbacks, &dispatchJob);
+    scheduleGpuJob(contextPrivate, &dispatchJob, FFX_FSR2_PASS_TCR_AUTOGENERATE);
 
     return FFX_OK;
 }
@@ -45,7 +45,12 @@
 /// The size of the context specified in 32bit values.
 ///
 /// @ingroup FSR2
-#define FFX_FSR2_CONTEXT_SIZE       (16536)
+#define FFX_FSR2_CONTEXT_SIZE       (16640)
+
+/// The maximum number of views a single context upscales.
+///
+/// @ingroup FSR2
+#define FFX_FSR2_MAX_VIEW_COUNT     (4)
 
 #if defined(__cplusplus)
 extern "C" {
@@ -94,8 +99,27 @@ typedef enum FfxFsr2InitializationFlagBits {
     FFX_FSR2_ENABLE_DYNAMIC_RESOLUTION                  = (1<<6),   ///< A bit indicating that the application uses dynamic resolution scaling.
     FFX_FSR2_ENABLE_TEXTURE1D_USAGE                     = (1<<7),   ///< A bit indicating that the backend should use 1D textures.
     FFX_FSR2_ENABLE_DEBUG_CHECKING                      = (1<<8),   ///< A bit indicating that the runtime should check some API values and report issues.
+    FFX_FSR2_ENABLE_SHARED_TRANSIENT_MEMORY             = (1<<9),   ///< A bit indicating that the transient resources may share memory with other contexts of the device created with it, whose dispatches never run at the same time.
 } FfxFsr2InitializationFlagBits;
 
+/// An enumeration of bit flags used when saving the temporal state of a
+/// context with <c><i>ffxFsr2ContextSaveState</i></c>.
+///
+/// @ingroup FSR2
+typedef enum FfxFsr2StateFlagBits {
+
+    FFX_FSR2_STATE_QUANTIZE                             = (1<<0),   ///< A bit indicating that history should be stored at the precision of the internal resources (half precision, R11G11B10 and 8 bit) instead of 32 bit floats.
+} FfxFsr2StateFlagBits;
+
+/// An enumeration of bit flags used when resizing a context with
+/// <c><i>ffxFsr2ContextResize</i></c>.
+///
+/// @ingroup FSR2
+typedef enum FfxFsr2ResizeFlagBits {
+
+    FFX_FSR2_RESIZE_RESCALE_HISTORY                     = (1<<0),   ///< A bit indicating that the history should be rescaled to the new sizes instead of being reset.
+} FfxFsr2ResizeFlagBits;
+
 /// A structure encapsulating the parameters required to initialize FidelityFX
 /// Super Resolution 2 upscaling.
 ///
@@ -109,6 +133,7 @@ typedef struct FfxFsr2ContextDescription {
     FfxDevice                   device;                             ///< The abstracted device which is passed to some callback functions.
 
     FfxFsr2Message              fpMessage;                          ///< A pointer to a function that can recieve messages from the runtime.
+    uint32_t                    viewCount;                          ///< The number of views upscaled by each dispatch, at most <c><i>FFX_FSR2_MAX_VIEW_COUNT</i></c>. 0 and 1 both create a single view context.
 } FfxFsr2ContextDescription;
 
 /// A structure encapsulating the parameters for dispatching the various passes
@@ -164,6 +189,39 @@ typedef struct FfxFsr2GenerateReactiveDescription {
     uint32_t                    flags;                              ///< Flags to determine how to generate the reactive mask
 } FfxFsr2GenerateReactiveDescription;
 
+/// A structure describing how a single FSR2 pass ran, see <c><i>FfxFsr2FrameStats</i></c>.
+///
+/// @ingroup FSR2
+typedef struct FfxFsr2PassStats {
+
+    uint32_t                    dispatchCount;                      ///< The number of times the pass was dispatched, 0 when it did not run.
+    uint32_t                    dispatchDimensions[3];              ///< The thread group counts of the last dispatch of the pass.
+    uint32_t                    descriptorCount;                    ///< The number of shader resource views, unordered access views and constant buffers bound.
+    uint32_t                    barrierCount;                       ///< The number of barriers the backend recorded for the pass.
+    uint64_t                    bytesRead;                          ///< The size of every mip of the resources bound as shader resource views, which cover all the mips of a resource.
+    uint64_t                    bytesWritten;                       ///< The size of the mip of every resource bound as an unordered access view.
+    uint64_t                    duration;                           ///< The execution time of the pass in nanoseconds, 0 when the backend does not time its jobs.
+} FfxFsr2PassStats;
+
+/// A structure describing the last completed call to
+/// <c><i>ffxFsr2ContextDispatch</i></c> or
+/// <c><i>ffxFsr2ContextDispatchBatch</i></c>, as returned by
+/// <c><i>ffxFsr2ContextGetStatistics</i></c>.
+///
+/// Pass durations come from the backend when it times its jobs, which
+/// <c><i>backendTimings</i></c> indicates. Otherwise they are unavailable and
+/// left at 0, as with the DX12 and Vulkan backends, which do not time their
+/// jobs on the device.
+///
+/// @ingroup FSR2
+typedef struct FfxFsr2FrameStats {
+
+    uint32_t                    frameCount;                         ///< The number of frames dispatched by the call, the statistics of the passes cover all of them.
+    bool                        backendTimings;                     ///< The durations of the passes were measured by the backend.
+    uint64_t                    duration;                           ///< The host time spent in the dispatch call in nanoseconds.
+    FfxFsr2PassStats            passes[FFX_FSR2_PASS_COUNT];        ///< The statistics of each <c><i>FfxFsr2Pass</i></c>.
+} FfxFsr2FrameStats;
+
 /// A structure encapsulating the FidelityFX Super Resolution 2 context.
 ///
 /// This sets up an object which contains all persistent internal data and
@@ -212,6 +270,27 @@ typedef struct FfxFsr2Context {
 /// disabled by a user. To destroy the FSR2 context you should call
 /// <c><i>ffxFsr2ContextDestroy</i></c>.
 ///
+/// A context created with a <c><i>viewCount</i></c> above 1 upscales several
+/// views of the same display size each frame, such as the eyes of a stereo headset or
+/// the players of a split screen. Each view has its own history, while the
+/// pipelines, lookup tables, default textures and the resources which do not
+/// live across frames are shared by all of them. Such a context is dispatched
+/// with <c><i>ffxFsr2ContextDispatchViews</i></c>.
+///
+/// The backends share the pipelines between all the contexts created on the
+/// same device with the same shader permutation, and the CPU backend also
+/// shares the lookup tables and default textures. Creating a context while
+/// another one with compatible flags is alive therefore only allocates the
+/// resources of the new context.
+///
+/// The resources which only hold data within a frame are placed in one
+/// transient heap, when the backend supports it, which the CPU backend does.
+/// The DX12 and Vulkan backends create them in dedicated allocations. With
+/// <c><i>FFX_FSR2_ENABLE_SHARED_TRANSIENT_MEMORY</i></c> contexts with the same
+/// sizes on the same device share that heap. Such contexts must never be
+/// dispatched at the same time, the CPU backend has to dispatch them from one
+/// thread.
+///
 /// @param [out] context                A pointer to a <c><i>FfxFsr2Context</i></c> structure to populate.
 /// @param [in]  contextDescription     A pointer to a <c><i>FfxFsr2ContextDescription</i></c> structure.
 ///
@@ -220,6 +299,8 @@ typedef struct FfxFsr2Context {
 /// @retval
 /// FFX_ERROR_CODE_NULL_POINTER         The operation failed because either <c><i>context</i></c> or <c><i>contextDescription</i></c> was <c><i>NULL</i></c>.
 /// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because <c><i>contextDescription.viewCount</i></c> was larger than <c><i>FFX_FSR2_MAX_VIEW_COUNT</i></c>.
+/// @retval
 /// FFX_ERROR_INCOMPLETE_INTERFACE      The operation failed because the <c><i>FfxFsr2ContextDescription.callbacks</i></c>  was not fully specified.
 /// @retval
 /// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
@@ -251,6 +332,12 @@ FFX_API FfxErrorCode ffxFsr2ContextCreate(FfxFsr2Context* context, const FfxFsr2
 /// documentation for <c><i>ffxFsr2GetJitterOffset</i></c> as well as the
 /// accompanying overview documentation for FSR2.
 ///
+/// Each <c><i>FfxFsr2Context</i></c> owns all of the state a dispatch
+/// writes, so distinct contexts may be dispatched concurrently from different
+/// threads, as long as each context was created with its own backend interface
+/// and records into a command list no other thread records into at the same
+/// time. Calls on the same context must not overlap.
+///
 /// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
 /// @param [in] dispatchDescription     A pointer to a <c><i>FfxFsr2DispatchDescription</i></c> structure.
 ///
@@ -261,6 +348,8 @@ FFX_API FfxErrorCode ffxFsr2ContextCreate(FfxFsr2Context* context, const FfxFsr2
 /// @retval
 /// FFX_ERROR_OUT_OF_RANGE              The operation failed because <c><i>dispatchDescription.renderSize</i></c> was larger than the maximum render resolution.
 /// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because the context upscales more than one view.
+/// @retval
 /// FFX_ERROR_NULL_DEVICE               The operation failed because the device inside the context was <c><i>NULL</i></c>.
 /// @retval
 /// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
@@ -268,6 +357,196 @@ FFX_API FfxErrorCode ffxFsr2ContextCreate(FfxFsr2Context* context, const FfxFsr2
 /// @ingroup FSR2
 FFX_API FfxErrorCode ffxFsr2ContextDispatch(FfxFsr2Context* context, const FfxFsr2DispatchDescription* dispatchDescription);
 
+/// Dispatch the passes of FidelityFX Super Resolution 2 for several consecutive frames.
+///
+/// The result is the same as calling <c><i>ffxFsr2ContextDispatch</i></c> for
+/// each element of <c><i>frames</i></c> in order, but the setup that does not
+/// change from one frame to the next is only done once, and the jobs of up to
+/// <c><i>maximumBatchedFrameCount</i></c> frames (see
+/// <c><i>FfxDeviceCapabilities</i></c>) are handed to the backend in a single
+/// execution, which lets it overlap independent work across frames. This suits
+/// offline processing, where the throughput in frames per second matters more
+/// than the latency of a single frame. Every frame must be recorded into the
+/// same command list, and its resources must stay valid until the whole batch
+/// was executed.
+///
+/// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] frames                  A pointer to <c><i>frameCount</i></c> <c><i>FfxFsr2DispatchDescription</i></c> structures, in frame order.
+/// @param [in] frameCount              The number of frames to dispatch.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>context</i></c> or <c><i>frames</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_OUT_OF_RANGE              The operation failed because the <c><i>renderSize</i></c> of a frame was larger than the maximum render resolution.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because the frames were not recorded into the same command list, or the context upscales more than one view.
+/// @retval
+/// FFX_ERROR_NULL_DEVICE               The operation failed because the device inside the context was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup FSR2
+FFX_API FfxErrorCode ffxFsr2ContextDispatchBatch(FfxFsr2Context* context, const FfxFsr2DispatchDescription* frames, uint32_t frameCount);
+
+/// Dispatch the passes of FidelityFX Super Resolution 2 for every view of a
+/// frame.
+///
+/// Each view is upscaled as by <c><i>ffxFsr2ContextDispatch</i></c> on a
+/// context of its own, with its own inputs, output, jitter and camera, and
+/// accumulates into its own history. The setup the views have in common is
+/// only done once, and the jobs of up to
+/// <c><i>maximumBatchedFrameCount</i></c> views (see
+/// <c><i>FfxDeviceCapabilities</i></c>) are handed to the backend in a single
+/// execution. Every view must be recorded into the same command list.
+///
+/// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] views                   A pointer to one <c><i>FfxFsr2DispatchDescription</i></c> structure per view of the context.
+/// @param [in] viewCount               The number of views of the context.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>context</i></c> or <c><i>views</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_OUT_OF_RANGE              The operation failed because the <c><i>renderSize</i></c> of a view was larger than the maximum render resolution.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because <c><i>viewCount</i></c> was not the view count of the context, or the views were not recorded into the same command list.
+/// @retval
+/// FFX_ERROR_NULL_DEVICE               The operation failed because the device inside the context was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup FSR2
+FFX_API FfxErrorCode ffxFsr2ContextDispatchViews(FfxFsr2Context* context, const FfxFsr2DispatchDescription* views, uint32_t viewCount);
+
+/// Save the temporal state of a FidelityFX Super Resolution 2 context.
+///
+/// The state holds everything a later dispatch reads from previous frames:
+/// the upscaled color, lock status and luma history, the dilated motion
+/// vectors and reconstructed depth, the auto exposure, the jitter sequence and
+/// the frame counters. A
+/// context restored from it with <c><i>ffxFsr2ContextLoadState</i></c>
+/// continues accumulating where this one stopped, instead of being reset. The
+/// state of a context with several views holds the history of each of them.
+///
+/// Call with a <c><i>NULL</i></c> <c><i>buffer</i></c> to query the size of
+/// the state. Every frame dispatched to the context has to be complete on the
+/// device before the state is saved, and the backend has to implement
+/// <c><i>fpReadResource</i></c>.
+///
+/// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] flags                   A combination of <c><i>FfxFsr2StateFlagBits</i></c>.
+/// @param [out] buffer                 A pointer to the memory receiving the state, or <c><i>NULL</i></c>.
+/// @param [inout] bufferSize           The size of <c><i>buffer</i></c> in bytes, receives the size of the state.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>context</i></c> or <c><i>bufferSize</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY       The operation failed because <c><i>buffer</i></c> was too small to hold the state.
+/// @retval
+/// FFX_ERROR_INCOMPLETE_INTERFACE      The operation failed because the backend cannot read its resources from the host.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup FSR2
+FFX_API FfxErrorCode ffxFsr2ContextSaveState(FfxFsr2Context* context, uint32_t flags, void* buffer, size_t* bufferSize);
+
+/// Restore the temporal state of a FidelityFX Super Resolution 2 context.
+///
+/// The state has to come from <c><i>ffxFsr2ContextSaveState</i></c> on a
+/// context created with the same display size, maximum render size, flags and
+/// view count, on any backend. The next dispatch continues the accumulation of the saved
+/// context, it should not set <c><i>reset</i></c>. The context must not be in
+/// use on the device, and the backend has to implement
+/// <c><i>fpWriteResource</i></c>.
+///
+/// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] buffer                  A pointer to the saved state.
+/// @param [in] bufferSize              The size of <c><i>buffer</i></c> in bytes.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>context</i></c> or <c><i>buffer</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_MALFORMED_DATA            The operation failed because <c><i>buffer</i></c> does not hold a state of this version.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because the state was saved from a context with a different description.
+/// @retval
+/// FFX_ERROR_INCOMPLETE_INTERFACE      The operation failed because the backend cannot write its resources from the host.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup FSR2
+FFX_API FfxErrorCode ffxFsr2ContextLoadState(FfxFsr2Context* context, const void* buffer, size_t bufferSize);
+
+/// Change the display size and maximum render size of a FidelityFX Super
+/// Resolution 2 context.
+///
+/// Only the internal resources whose size depends on one of the two sizes are
+/// created again, the pipelines, lookup tables and every other resource of the
+/// context are kept, which makes a resize much cheaper than destroying the
+/// context and creating a new one.
+///
+/// By default the history of every view is reset, as it is for a new context.
+/// A context whose sizes do not change is left as it is.
+/// With <c><i>FFX_FSR2_RESIZE_RESCALE_HISTORY</i></c> the history is kept
+/// instead: the upscaled color, lock status and luma history are resampled to
+/// the new display size, the history at render resolution keeps its texels as
+/// on a change of the render size, and the next dispatch continues the
+/// accumulation without setting <c><i>reset</i></c>. Rescaling reads and
+/// writes the history from the host, the backend has to implement
+/// <c><i>fpReadResource</i></c> and <c><i>fpWriteResource</i></c>.
+///
+/// Every frame dispatched to the context has to be complete on the device
+/// before it is resized. When the call fails after validating its arguments,
+/// the context can only be destroyed: dispatching to it, saving or loading its
+/// state and resizing it again fail with
+/// <c><i>FFX_ERROR_INVALID_ARGUMENT</i></c>.
+///
+/// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [in] maxRenderSize           The new maximum size that rendering will be performed at.
+/// @param [in] displaySize             The new size of the presentation resolution targeted by the upscaling process.
+/// @param [in] flags                   A combination of <c><i>FfxFsr2ResizeFlagBits</i></c>.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because <c><i>context</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ARGUMENT          The operation failed because one of the sizes was zero, or an earlier resize of the context failed.
+/// @retval
+/// FFX_ERROR_INCOMPLETE_INTERFACE      The operation failed because the history should be rescaled and the backend cannot read or write its resources from the host.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR         The operation failed because of an error returned from the backend.
+///
+/// @ingroup FSR2
+FFX_API FfxErrorCode ffxFsr2ContextResize(FfxFsr2Context* context, FfxDimensions2D maxRenderSize, FfxDimensions2D displaySize, uint32_t flags);
+
+/// Query how the passes of the last dispatch ran.
+///
+/// The statistics describe the last call to
+/// <c><i>ffxFsr2ContextDispatch</i></c>,
+/// <c><i>ffxFsr2ContextDispatchBatch</i></c> or
+/// <c><i>ffxFsr2ContextDispatchViews</i></c> which returned successfully. All
+/// of them are zero before the first dispatch. The passes of every view are
+/// counted together.
+///
+/// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
+/// @param [out] outStatistics          A pointer to a <c><i>FfxFsr2FrameStats</i></c> structure to populate.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>context</i></c> or <c><i>outStatistics</i></c> was <c><i>NULL</i></c>.
+///
+/// @ingroup FSR2
+FFX_API FfxErrorCode ffxFsr2ContextGetStatistics(FfxFsr2Context* context, FfxFsr2FrameStats* outStatistics);
+
 /// A helper function generate a Reactive mask from an opaque only texure and one containing translucent objects.
 ///
 /// @param [in] context                 A pointer to a <c><i>FfxFsr2Context</i></c> structure.
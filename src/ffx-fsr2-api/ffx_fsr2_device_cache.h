@@ -0,0 +1,108 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// Refcounted cache of the objects the backends share between the contexts of one device.
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "ffx_types.h"
+#include "ffx_assert.h"
+#include "ffx_error.h"
+
+// Holds one object per key, for as long as a context references it.
+//
+// The backends key the read-only objects every context creates the same way, the pipelines and
+// the look-up tables, on the device and the inputs the object is built from, so that creating a
+// context on a device that already runs another context with compatible flags reuses them
+// instead of building them again. The key type needs operator==, the value type operator== and
+// a value that is unique per created object, the values are looked up on release.
+//
+// The lock is held while an object is created, concurrent contexts asking for the same key wait
+// for the first one to build it, instead of building it twice.
+template<typename Key, typename Value>
+class Fsr2DeviceCache {
+
+public:
+    // Returns the object for the key in outValue and adds a reference to it, calling create to
+    // build the object when the cache does not hold it yet.
+    template<typename Create>
+    FfxErrorCode acquire(const Key& key, Value* outValue, Create create)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (Entry& entry : entries) {
+
+            if (entry.key == key) {
+
+                ++entry.referenceCount;
+                *outValue = entry.value;
+                return FFX_OK;
+            }
+        }
+
+        Value value = {};
+        const FfxErrorCode errorCode = create(&value);
+        FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+        entries.push_back({ key, value, 1 });
+        *outValue = value;
+        return FFX_OK;
+    }
+
+    // Drops a reference to an object returned by acquire, calling destroy on it when it was the
+    // last one.
+    template<typename Destroy>
+    void release(const Value& value, Destroy destroy)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (size_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex) {
+
+            Entry& entry = entries[entryIndex];
+            if (entry.value == value) {
+
+                if (--entry.referenceCount == 0) {
+
+                    destroy(entry.value);
+                    entries[entryIndex] = entries.back();
+                    entries.pop_back();
+                }
+                return;
+            }
+        }
+
+        FFX_ASSERT_MESSAGE(false, "FSR2: released an object the device cache does not hold.");
+    }
+
+private:
+    struct Entry {
+
+        Key         key;
+        Value       value;
+        uint32_t    referenceCount;
+    };
+
+    std::mutex          mutex;
+    std::vector<Entry>  entries;
+};
@@ -30,6 +30,13 @@
 #include "shaders/ffx_fsr2_resources.h"
 #include "shaders/ffx_fsr2_common.h"
 
+/// The maximum number of resources the runtime creates for each view of a
+/// context after the first one. Backends reserve room for them on top of the
+/// resources of a single view context.
+///
+/// @ingroup FSR2
+#define FFX_FSR2_MAX_VIEW_RESOURCE_COUNT (16)
+
 #if defined(__cplusplus)
 extern "C" {
 #endif // #if defined(__cplusplus)
@@ -319,6 +326,138 @@ typedef FfxErrorCode (*FfxFsr2ExecuteGpuJobsFunc)(
     FfxFsr2Interface* backendInterface,
     FfxCommandList commandList);
 
+/// Copy the contents of an internal resource to host memory.
+///
+/// The first mip of the resource is written to <c><i>data</i></c> as tightly
+/// packed rows of texels in <c><i>format</i></c>, which has the channels of
+/// the format of the resource, converting from whatever format the backend
+/// stores it in. Every job executed before the call has to be complete when the
+/// data is read. This callback is optional, backends which cannot access their
+/// resources from the host leave it <c><i>NULL</i></c>.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] resource                            The internal resource to read.
+/// @param [in] format                              The format of the texels written to <c><i>data</i></c>.
+/// @param [out] data                               A pointer to the host memory to write to.
+/// @param [in] dataSize                            The size (in bytes) of the memory pointed to by <c><i>data</i></c>.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FSR2
+typedef FfxErrorCode (*FfxFsr2ReadResourceFunc)(
+    FfxFsr2Interface* backendInterface,
+    FfxResourceInternal resource,
+    FfxSurfaceFormat format,
+    void* data,
+    size_t dataSize);
+
+/// Replace the contents of an internal resource with host memory.
+///
+/// The counterpart of <c><i>FfxFsr2ReadResourceFunc</i></c>, with the same
+/// layout of <c><i>data</i></c>. This callback is optional.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] resource                            The internal resource to write.
+/// @param [in] format                              The format of the texels in <c><i>data</i></c>.
+/// @param [in] data                                A pointer to the host memory to read from.
+/// @param [in] dataSize                            The size (in bytes) of the memory pointed to by <c><i>data</i></c>.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FSR2
+typedef FfxErrorCode (*FfxFsr2WriteResourceFunc)(
+    FfxFsr2Interface* backendInterface,
+    FfxResourceInternal resource,
+    FfxSurfaceFormat format,
+    const void* data,
+    size_t dataSize);
+
+/// Retrieve the statistics of the jobs run by the last call to
+/// <c><i>FfxFsr2ExecuteGpuJobsFunc</i></c>.
+///
+/// Statistics are written in the order the jobs were scheduled in, one per
+/// job. Backends which time their jobs on the device may return the
+/// statistics of the last execution that completed instead, as long as the
+/// jobs were scheduled identically. This callback is optional.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [out] outStatistics                      A pointer to an array of <c><i>FfxGpuJobStatistics</i></c> structures.
+/// @param [inout] inoutJobCount                    The number of structures in <c><i>outStatistics</i></c>, receives the number of jobs written.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FSR2
+typedef FfxErrorCode (*FfxFsr2GetGpuJobStatisticsFunc)(
+    FfxFsr2Interface* backendInterface,
+    FfxGpuJobStatistics* outStatistics,
+    uint32_t* inoutJobCount);
+
+/// Query the memory an internal resource occupies when it is placed in the
+/// transient heap.
+///
+/// The resources flagged <c><i>FFX_RESOURCE_FLAGS_ALIASABLE</i></c> only hold
+/// data from the first to the last pass of a frame which binds them. The core
+/// lays them out in one heap, resources which are never bound by the same
+/// passes sharing memory, and creates the heap with
+/// <c><i>FfxFsr2CreateTransientHeapFunc</i></c>. This callback is optional,
+/// together with that one; when either is <c><i>NULL</i></c> every resource
+/// is created on its own.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] createResourceDescription           A pointer to the <c><i>FfxCreateResourceDescription</i></c> the resource will be created from.
+/// @param [out] outRequirements                    A pointer to a <c><i>FfxResourceMemoryRequirements</i></c> structure which should be populated.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FSR2
+typedef FfxErrorCode (*FfxFsr2GetResourceMemoryRequirementsFunc)(
+    FfxFsr2Interface* backendInterface,
+    const FfxCreateResourceDescription* createResourceDescription,
+    FfxResourceMemoryRequirements* outRequirements);
+
+/// Create the heap the transient resources of a context are placed in.
+///
+/// The heap replaces the one created by an earlier call, which no resource is
+/// placed in anymore, a <c><i>heapSize</i></c> of zero only releases it.
+/// Resources created afterwards with <c><i>FFX_RESOURCE_FLAGS_ALIASABLE</i></c>
+/// in the flags of their description are placed at the
+/// <c><i>heapOffset</i></c> of their
+/// <c><i>FfxCreateResourceDescription</i></c>. Their contents do not survive
+/// from one frame to the next, and a job using one of them has to wait for
+/// the jobs which used the same memory through another resource.
+///
+/// When <c><i>shared</i></c> is set the backend may hand out the same memory
+/// to the contexts of the device which ask for a heap of the same size, so
+/// that sessions which never run at the same time do not each hold their own.
+/// This callback is optional.
+///
+/// @param [in] backendInterface                    A pointer to the backend interface.
+/// @param [in] heapSize                            The size (in bytes) of the heap.
+/// @param [in] shared                              Whether the heap may be shared with other contexts on the device.
+///
+/// @retval
+/// FFX_OK                                          The operation completed successfully.
+/// @retval
+/// Anything else                                   The operation failed.
+///
+/// @ingroup FSR2
+typedef FfxErrorCode (*FfxFsr2CreateTransientHeapFunc)(
+    FfxFsr2Interface* backendInterface,
+    uint64_t heapSize,
+    bool shared);
+
 /// Pass a string message
 ///
 /// Used for debug messages.
@@ -388,6 +527,12 @@ typedef struct FfxFsr2Interface {
 
     void*                                   scratchBuffer;                  ///< A preallocated buffer for memory utilized internally by the backend.
     size_t                                  scratchBufferSize;              ///< Size of the buffer pointed to by <c><i>scratchBuffer</i></c>.
+
+    FfxFsr2ReadResourceFunc                 fpReadResource;                 ///< An optional callback function to copy an internal resource to host memory.
+    FfxFsr2WriteResourceFunc                fpWriteResource;                ///< An optional callback function to copy host memory to an internal resource.
+    FfxFsr2GetGpuJobStatisticsFunc          fpGetGpuJobStatistics;          ///< An optional callback function to retrieve how the last executed jobs ran.
+    FfxFsr2GetResourceMemoryRequirementsFunc fpGetResourceMemoryRequirements; ///< An optional callback function to query the memory a resource occupies in the transient heap.
+    FfxFsr2CreateTransientHeapFunc          fpCreateTransientHeap;          ///< An optional callback function to create the heap the transient resources are placed in.
 } FfxFsr2Interface;
 
 #if defined(__cplusplus)
@@ -46,17 +46,76 @@ typedef struct Fsr2Constants {
     float                       viewSpaceToMetersFactor;
 } Fsr2Constants;
 
+// Constants for the secondary FSR2 dispatches. Must be kept in sync with cbRCAS, cbSPD and cbGenerateReactive in ffx_fsr2_callbacks_hlsl.h
+typedef struct Fsr2RcasConstants {
+
+    uint32_t                    rcasConfig[4];
+} FfxRcasConstants;
+
+typedef struct Fsr2SpdConstants {
+
+    uint32_t                    mips;
+    uint32_t                    numworkGroups;
+    uint32_t                    workGroupOffset[2];
+    uint32_t                    renderSize[2];
+} Fsr2SpdConstants;
+
+typedef struct Fsr2GenerateReactiveConstants
+{
+    float       scale;
+    float       threshold;
+    float       binaryValue;
+    uint32_t    flags;
+
+} Fsr2GenerateReactiveConstants;
+
+typedef struct Fsr2GenerateReactiveConstants2
+{
+    float       autoTcThreshold;
+    float       autoTcScale;
+    float       autoReactiveScale;
+    float       autoReactiveMax;
+
+} Fsr2GenerateReactiveConstants2;
+
+typedef union Fsr2SecondaryUnion {
+
+    Fsr2RcasConstants               rcas;
+    Fsr2SpdConstants                spd;
+    Fsr2GenerateReactiveConstants2  autogenReactive;
+} Fsr2SecondaryUnion;
+
+// Number of jobs scheduled between two executions whose pass is tracked for statistics.
+#define FSR2_MAX_SCHEDULED_JOBS (64)
+
 struct FfxFsr2ContextDescription;
 struct FfxDeviceCapabilities;
 struct FfxPipelineState;
 struct FfxResource;
 
+// The number of history resources each view of a context owns.
+#define FSR2_VIEW_RESOURCE_COUNT (14)
+
+// The state of a view which lives across frames. The dispatch code works on the copy of it held
+// by the context itself, the one of the active view, the state of the others is kept here.
+typedef struct Fsr2ViewState {
+
+    Fsr2Constants               constants;
+    FfxResourceInternal         resources[FSR2_VIEW_RESOURCE_COUNT];
+    bool                        firstExecution;
+    uint32_t                    resourceFrameIndex;
+    float                       previousJitterOffset[2];
+} Fsr2ViewState;
+
 // FfxFsr2Context_Private
 // The private implementation of the FSR2 context.
 typedef struct FfxFsr2Context_Private {
 
     FfxFsr2ContextDescription   contextDescription;
     Fsr2Constants               constants;
+
+    // The constant buffers of the passes, owned by the context so contexts can dispatch concurrently.
+    FfxConstantBuffer           constantBuffers[FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_COUNT];
     FfxDevice                   device;
     FfxDeviceCapabilities       deviceCapabilities;
     FfxPipelineState            pipelineDepthClip;
@@ -69,13 +128,29 @@ typedef struct FfxFsr2Context_Private {
     FfxPipelineState            pipelineGenerateReactive;
     FfxPipelineState            pipelineTcrAutogenerate;
 
+    // layout of the resources placed in the transient heap, a size of zero when the backend does not place them
+    uint64_t                    transientHeapSize;
+    uint64_t                    transientHeapOffsets[FFX_FSR2_RESOURCE_IDENTIFIER_COUNT];
+
     // 2 arrays of resources, as e.g. FFX_FSR2_RESOURCE_IDENTIFIER_LOCK_STATUS will use different resources when bound as SRV vs when bound as UAV
     FfxResourceInternal         srvResources[FFX_FSR2_RESOURCE_IDENTIFIER_COUNT];
     FfxResourceInternal         uavResources[FFX_FSR2_RESOURCE_IDENTIFIER_COUNT];
 
     bool                        firstExecution;
     bool                        refreshPipelineStates;
+    bool                        resizeFailed;           // set by a failed resize, the context can only be destroyed then
     uint32_t                    resourceFrameIndex;
     float                       previousJitterOffset[2];
     int32_t                     jitterPhaseCountRemaining;
+
+    // views of a multi-view context, view 0 is active between API calls
+    uint32_t                    viewCount;
+    uint32_t                    activeView;
+    Fsr2ViewState               views[FFX_FSR2_MAX_VIEW_COUNT];
+
+    // statistics of the jobs scheduled since the last execution, and of the last dispatch call
+    uint8_t                     scheduledJobPasses[FSR2_MAX_SCHEDULED_JOBS];
+    uint32_t                    scheduledJobCount;
+    FfxFsr2FrameStats           pendingStatistics;
+    FfxFsr2FrameStats           statistics;
 } FfxFsr2Context_Private;
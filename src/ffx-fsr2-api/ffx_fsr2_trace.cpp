@@ -0,0 +1,239 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <stdio.h>      // for snprintf
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ffx_fsr2_trace.h"
+
+// The size of the text buffered before it is passed to the write function of a flush.
+static const size_t FSR2_TRACE_FLUSH_CHUNK_SIZE = 64 * 1024;
+
+typedef struct Fsr2TraceEvent {
+
+    const char*                 name;
+    const char*                 category;
+    uint64_t                    beginTime;
+    uint64_t                    endTime;
+} Fsr2TraceEvent;
+
+// A single producer, single consumer ring. Only the thread owning it stores events and advances
+// the head, only a flush holding the registry lock reads them and advances the tail.
+typedef struct Fsr2TraceRing {
+
+    Fsr2TraceEvent              events[FFX_FSR2_TRACE_THREAD_EVENT_COUNT];
+    std::atomic<uint64_t>       head;
+    std::atomic<uint64_t>       tail;
+    std::atomic<uint64_t>       droppedEventCount;
+
+    // Cleared when the thread exits, another thread then reuses the ring.
+    std::atomic<bool>           owned;
+    uint32_t                    threadIndex;
+} Fsr2TraceRing;
+
+typedef struct Fsr2TraceRingOwner {
+
+    Fsr2TraceRing*              ring = nullptr;
+
+    ~Fsr2TraceRingOwner()
+    {
+        if (ring) {
+            ring->owned.store(false, std::memory_order_release);
+        }
+    }
+} Fsr2TraceRingOwner;
+
+static std::atomic<bool> s_traceEnabled(false);
+static std::mutex s_traceRingsMutex;
+static std::vector<std::unique_ptr<Fsr2TraceRing>> s_traceRings;
+static thread_local Fsr2TraceRingOwner s_threadTraceRing;
+
+static Fsr2TraceRing* acquireTraceRing()
+{
+    std::lock_guard<std::mutex> lock(s_traceRingsMutex);
+
+    for (const std::unique_ptr<Fsr2TraceRing>& ring : s_traceRings) {
+
+        if (!ring->owned.load(std::memory_order_acquire)) {
+            ring->owned.store(true, std::memory_order_relaxed);
+            return ring.get();
+        }
+    }
+
+    std::unique_ptr<Fsr2TraceRing> ring(new Fsr2TraceRing);
+    ring->head.store(0, std::memory_order_relaxed);
+    ring->tail.store(0, std::memory_order_relaxed);
+    ring->droppedEventCount.store(0, std::memory_order_relaxed);
+    ring->owned.store(true, std::memory_order_relaxed);
+    ring->threadIndex = uint32_t(s_traceRings.size()) + 1;
+    s_traceRings.push_back(std::move(ring));
+
+    return s_traceRings.back().get();
+}
+
+void ffxFsr2TraceSetEnabled(bool enabled)
+{
+    s_traceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool ffxFsr2TraceIsEnabled(void)
+{
+    return s_traceEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t ffxFsr2TraceGetTime(void)
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void ffxFsr2TraceEvent(const char* name, const char* category, uint64_t beginTime, uint64_t endTime)
+{
+    if (!s_traceEnabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    if (!s_threadTraceRing.ring) {
+        s_threadTraceRing.ring = acquireTraceRing();
+    }
+
+    Fsr2TraceRing* ring = s_threadTraceRing.ring;
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= FFX_FSR2_TRACE_THREAD_EVENT_COUNT) {
+        ring->droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Fsr2TraceEvent* event = &ring->events[head % FFX_FSR2_TRACE_THREAD_EVENT_COUNT];
+    event->name = name;
+    event->category = category;
+    event->beginTime = beginTime;
+    event->endTime = endTime > beginTime ? endTime : beginTime;
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+const char* ffxFsr2TraceGetPassName(FfxFsr2Pass pass)
+{
+    static const char* const passNames[] = {
+        "Depth clip",
+        "Reconstruct previous depth",
+        "Lock",
+        "Accumulate",
+        "Accumulate sharpen",
+        "RCAS",
+        "Compute luminance pyramid",
+        "Generate reactive",
+        "TCR autogenerate",
+    };
+    FFX_STATIC_ASSERT(FFX_ARRAY_ELEMENTS(passNames) == FFX_FSR2_PASS_COUNT);
+
+    return (uint32_t(pass) < FFX_FSR2_PASS_COUNT) ? passNames[pass] : "Unknown";
+}
+
+static void appendTraceString(std::string& text, const char* string)
+{
+    text += '"';
+    for (const char* character = string; *character; ++character) {
+
+        if (*character == '"' || *character == '\\') {
+            text += '\\';
+        }
+        text += (uint8_t(*character) < 0x20) ? ' ' : *character;
+    }
+    text += '"';
+}
+
+// Trace times are in microseconds, printed from integers so the text does not depend on the locale.
+static void appendTraceTime(std::string& text, const char* key, uint64_t time)
+{
+    char number[64];
+    snprintf(number, sizeof(number), ",\"%s\":%llu.%03llu", key, (unsigned long long)(time / 1000), (unsigned long long)(time % 1000));
+    text += number;
+}
+
+static void appendTraceThread(std::string& text, uint32_t threadIndex)
+{
+    char thread[64];
+    snprintf(thread, sizeof(thread), ",\"pid\":1,\"tid\":%u}", threadIndex);
+    text += thread;
+}
+
+FfxErrorCode ffxFsr2TraceFlush(FfxFsr2TraceWriteFunc writeFunction, void* userData, uint64_t* outDroppedEventCount)
+{
+    FFX_RETURN_ON_ERROR(writeFunction, FFX_ERROR_INVALID_POINTER);
+
+    std::lock_guard<std::mutex> lock(s_traceRingsMutex);
+
+    std::string text = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    uint64_t droppedEventCount = 0;
+    bool firstEvent = true;
+
+    for (const std::unique_ptr<Fsr2TraceRing>& ring : s_traceRings) {
+
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        droppedEventCount += ring->droppedEventCount.exchange(0, std::memory_order_relaxed);
+
+        char threadName[64];
+        snprintf(threadName, sizeof(threadName), "FSR2 thread %u", ring->threadIndex);
+        text += firstEvent ? "\n" : ",\n";
+        text += "{\"name\":\"thread_name\",\"ph\":\"M\",\"args\":{\"name\":";
+        appendTraceString(text, threadName);
+        text += '}';
+        appendTraceThread(text, ring->threadIndex);
+        firstEvent = false;
+
+        for (uint64_t eventIndex = tail; eventIndex < head; ++eventIndex) {
+
+            const Fsr2TraceEvent* event = &ring->events[eventIndex % FFX_FSR2_TRACE_THREAD_EVENT_COUNT];
+            text += ",\n{\"name\":";
+            appendTraceString(text, event->name);
+            text += ",\"cat\":";
+            appendTraceString(text, event->category);
+            text += ",\"ph\":\"X\"";
+            appendTraceTime(text, "ts", event->beginTime);
+            appendTraceTime(text, "dur", event->endTime - event->beginTime);
+            appendTraceThread(text, ring->threadIndex);
+
+            if (text.size() >= FSR2_TRACE_FLUSH_CHUNK_SIZE) {
+                writeFunction(text.data(), text.size(), userData);
+                text.clear();
+            }
+        }
+
+        // the events are read, the owner may overwrite them
+        ring->tail.store(head, std::memory_order_release);
+    }
+
+    text += "\n]}\n";
+    writeFunction(text.data(), text.size(), userData);
+
+    if (outDroppedEventCount) {
+        *outDroppedEventCount = droppedEventCount;
+    }
+
+    return FFX_OK;
+}
@@ -0,0 +1,136 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// @defgroup FSR2
+
+#pragma once
+
+#include "ffx_fsr2_interface.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // #if defined(__cplusplus)
+
+/// The number of events a thread holds until they are flushed, later events are dropped.
+#define FFX_FSR2_TRACE_THREAD_EVENT_COUNT   (8192)
+
+/// A typedef for the callback function receiving the text of a trace.
+///
+/// @param [in] text                    A pointer to a part of the trace, not null terminated.
+/// @param [in] textLength              The length of <c><i>text</i></c> in characters.
+/// @param [in] userData                The user data passed to <c><i>ffxFsr2TraceFlush</i></c>.
+///
+typedef void (*FfxFsr2TraceWriteFunc)(const char* text, size_t textLength, void* userData);
+
+/// Enable or disable the tracing of the FSR2 runtime and its backends.
+///
+/// While tracing is enabled, the API calls of every context, the scheduling of
+/// each pass and the execution of each job by the backends are stored as events
+/// in a ring owned by the thread making them. Storing an event takes no lock.
+/// Tracing is disabled by default and costs a single check per event then.
+///
+/// @param [in] enabled                 true to store events from now on.
+///
+FFX_API void ffxFsr2TraceSetEnabled(bool enabled);
+
+/// Query if tracing is enabled.
+///
+/// @returns
+/// true if events are stored.
+///
+FFX_API bool ffxFsr2TraceIsEnabled(void);
+
+/// Get the time events are measured in.
+///
+/// @returns
+/// The time of a steady clock, in nanoseconds.
+///
+FFX_API uint64_t ffxFsr2TraceGetTime(void);
+
+/// Store an event in the ring of the calling thread.
+///
+/// This is called by the FSR2 runtime and its backends, the event is dropped
+/// when tracing is disabled or the ring of the thread is full.
+///
+/// @param [in] name                    The name of the event, it must stay valid until the trace is flushed.
+/// @param [in] category                The category of the event, it must stay valid until the trace is flushed.
+/// @param [in] beginTime               The time the event began, as returned by <c><i>ffxFsr2TraceGetTime</i></c>.
+/// @param [in] endTime                 The time the event ended, as returned by <c><i>ffxFsr2TraceGetTime</i></c>.
+///
+FFX_API void ffxFsr2TraceEvent(const char* name, const char* category, uint64_t beginTime, uint64_t endTime);
+
+/// Get the name events of a pass are stored with.
+///
+/// @param [in] pass                    The pass.
+///
+/// @returns
+/// A static string naming the pass.
+///
+FFX_API const char* ffxFsr2TraceGetPassName(FfxFsr2Pass pass);
+
+/// Write the events stored by every thread as a trace in the JSON format of
+/// Chrome and Perfetto, and remove them from the rings.
+///
+/// Each call writes a complete trace holding the events stored since the
+/// previous one. Events may be stored by other threads while flushing, they
+/// are part of this trace or the next one.
+///
+/// @param [in] writeFunction           The function receiving the text of the trace.
+/// @param [in] userData                A pointer passed to <c><i>writeFunction</i></c>.
+/// @param [out] outDroppedEventCount   The number of events dropped because a ring was full since the previous flush, may be NULL.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           <c><i>writeFunction</i></c> was <c><i>NULL</i></c>.
+///
+FFX_API FfxErrorCode ffxFsr2TraceFlush(FfxFsr2TraceWriteFunc writeFunction, void* userData, uint64_t* outDroppedEventCount);
+
+#if defined(__cplusplus)
+}
+
+// Store the lifetime of a scope as an event.
+class FfxFsr2TraceScope {
+public:
+    FfxFsr2TraceScope(const char* name, const char* category)
+        : name(name)
+        , category(category)
+        , beginTime(ffxFsr2TraceIsEnabled() ? ffxFsr2TraceGetTime() : 0)
+    {
+    }
+
+    ~FfxFsr2TraceScope()
+    {
+        if (beginTime != 0) {
+            ffxFsr2TraceEvent(name, category, beginTime, ffxFsr2TraceGetTime());
+        }
+    }
+
+    FfxFsr2TraceScope(const FfxFsr2TraceScope&) = delete;
+    FfxFsr2TraceScope& operator=(const FfxFsr2TraceScope&) = delete;
+
+private:
+    const char*     name;
+    const char*     category;
+    uint64_t        beginTime;
+};
+#endif // #if defined(__cplusplus)
@@ -189,6 +189,7 @@ typedef struct FfxDeviceCapabilities {
     uint32_t                        waveLaneCountMax;                       ///< The maximum supported wavefront width.
     bool                            fp16Supported;                          ///< The device supports FP16 in hardware.
     bool                            raytracingSupported;                    ///< The device supports raytracing.
+    uint32_t                        maximumBatchedFrameCount;               ///< The number of frames the backend can schedule before executing them, 0 when every frame is executed on its own.
 } FfxDeviceCapabilities;
 
 /// A structure encapsulating a 2-dimensional point, using 32bit unsigned integers.
@@ -273,8 +274,17 @@ typedef struct FfxCreateResourceDescription {
     const wchar_t*                  name;                                   ///< Name of the resource.
     FfxResourceUsage                usage;                                  ///< Resource usage flags.
     uint32_t                        id;                                     ///< Internal resource ID.
+    uint64_t                        heapOffset;                             ///< Offset of the resource in the transient heap, used when the flags of <c><i>resourceDescription</i></c> have <c><i>FFX_RESOURCE_FLAGS_ALIASABLE</i></c> set.
 } FfxCreateResourceDescription;
 
+/// A structure describing the memory a resource needs when it is placed in a
+/// heap.
+typedef struct FfxResourceMemoryRequirements {
+
+    uint64_t                        size;                                   ///< The size (in bytes) of the memory the resource occupies.
+    uint64_t                        alignment;                              ///< The alignment (in bytes) of the offset of the resource in the heap.
+} FfxResourceMemoryRequirements;
+
 /// A structure containing the description used to create a
 /// <c><i>FfxPipeline</i></c> structure.
 ///
@@ -359,6 +369,13 @@ typedef struct FfxGpuJobDescription{
     };
 } FfxGpuJobDescription;
 
+/// A structure describing how a single render job executed.
+typedef struct FfxGpuJobStatistics {
+
+    uint64_t                    duration;                                   ///< The execution time of the job in nanoseconds, 0 when the backend does not time its jobs.
+    uint32_t                    barrierCount;                               ///< The number of barriers the backend recorded for the job.
+} FfxGpuJobStatistics;
+
 #ifdef __cplusplus
 }
 #endif  // #ifdef __cplusplus
@@ -0,0 +1,570 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <string.h>     // for memcpy
+#include <atomic>
+#include <chrono>
+#include <new>
+#include "../ffx_fsr2.h"
+#include "../ffx_util.h"
+#include "ffx_fsr2_record.h"
+
+// Record prototypes for functions in the backend interface
+FfxErrorCode GetDeviceCapabilitiesRecord(FfxFsr2Interface* backendInterface, FfxDeviceCapabilities* deviceCapabilities, FfxDevice device);
+FfxErrorCode CreateBackendContextRecord(FfxFsr2Interface* backendInterface, FfxDevice device);
+FfxErrorCode DestroyBackendContextRecord(FfxFsr2Interface* backendInterface);
+FfxErrorCode CreateResourceRecord(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* desc, FfxResourceInternal* outTexture);
+FfxErrorCode RegisterResourceRecord(FfxFsr2Interface* backendInterface, const FfxResource* inResource, FfxResourceInternal* outResourceInternal);
+FfxErrorCode UnregisterResourcesRecord(FfxFsr2Interface* backendInterface);
+FfxResourceDescription GetResourceDescriptorRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource);
+FfxErrorCode DestroyResourceRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource);
+FfxErrorCode CreatePipelineRecord(FfxFsr2Interface* backendInterface, FfxFsr2Pass passId, const FfxPipelineDescription*  desc, FfxPipelineState* outPass);
+FfxErrorCode DestroyPipelineRecord(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline);
+FfxErrorCode ScheduleGpuJobRecord(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job);
+FfxErrorCode ExecuteGpuJobsRecord(FfxFsr2Interface* backendInterface, FfxCommandList commandList);
+FfxErrorCode ReadResourceRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, void* data, size_t dataSize);
+FfxErrorCode WriteResourceRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, const void* data, size_t dataSize);
+FfxErrorCode GetGpuJobStatisticsRecord(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount);
+FfxErrorCode GetResourceMemoryRequirementsRecord(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* desc, FfxResourceMemoryRequirements* outRequirements);
+FfxErrorCode CreateTransientHeapRecord(FfxFsr2Interface* backendInterface, uint64_t heapSize, bool shared);
+
+#define FSR2_RECORD_MAX_PIPELINE_COUNT  (32)
+#define FSR2_RECORD_NO_PIPELINE         (~0u)
+
+typedef struct BackendContext_Record {
+
+    // the wrapped backend, called with a pointer to this copy so it finds its own scratch buffer
+    FfxFsr2Interface        backendInterface;
+
+    // live pipelines, to refer to them by index in the jobs
+    struct Pipeline
+    {
+        FfxPipeline         pipeline;
+        uint32_t            index;
+    } pipelines[FSR2_RECORD_MAX_PIPELINE_COUNT];
+    uint32_t                nextPipelineIndex;
+
+    std::atomic<uint32_t>   scheduledJobCount;
+
+    // the log follows this structure in the scratch buffer, records are appended at logOffset
+    uint8_t*                log;
+    uint64_t                logCapacity;
+    std::atomic<uint64_t>   logOffset;
+    std::atomic<uint64_t>   logEnd;
+    std::atomic<uint64_t>   droppedRecordCount;
+} BackendContext_Record;
+
+static BackendContext_Record* getRecordContext(const FfxFsr2Interface* backendInterface)
+{
+    return static_cast<BackendContext_Record*>(backendInterface->scratchBuffer);
+}
+
+static uint64_t getTimestamp()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static FfxFsr2RecordResourceDescription toRecordDescription(const FfxResourceDescription& description)
+{
+    FfxFsr2RecordResourceDescription result;
+    result.type = uint32_t(description.type);
+    result.format = uint32_t(description.format);
+    result.width = description.width;
+    result.height = description.height;
+    result.depth = description.depth;
+    result.mipCount = description.mipCount;
+    result.flags = uint32_t(description.flags);
+    return result;
+}
+
+static uint32_t getSurfaceFormatSize(FfxSurfaceFormat format)
+{
+    switch (format) {
+
+    case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+    case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+        return 16;
+    case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM:
+    case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+        return 8;
+    case FFX_SURFACE_FORMAT_R32_UINT:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+    case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+    case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16G16_UINT:
+    case FFX_SURFACE_FORMAT_R32_FLOAT:
+        return 4;
+    case FFX_SURFACE_FORMAT_R16_FLOAT:
+    case FFX_SURFACE_FORMAT_R16_UINT:
+    case FFX_SURFACE_FORMAT_R16_UNORM:
+    case FFX_SURFACE_FORMAT_R16_SNORM:
+    case FFX_SURFACE_FORMAT_R8G8_UNORM:
+        return 2;
+    case FFX_SURFACE_FORMAT_R8_UNORM:
+    case FFX_SURFACE_FORMAT_R8_UINT:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// The size of the contents recorded for a registered resource, mip 0 as tightly packed texels.
+static uint64_t getRegisteredDataSize(const BackendContext_Record* backendContext, const FfxResource* resource, FfxResourceInternal internalResource)
+{
+    const FfxResourceDescription& description = resource->description;
+    if (!backendContext->backendInterface.fpReadResource || internalResource.internalIndex <= 0 || (resource->state & FFX_RESOURCE_STATE_UNORDERED_ACCESS) ||
+        description.type == FFX_RESOURCE_TYPE_BUFFER || description.depth > 1) {
+        return 0;
+    }
+
+    const uint64_t dataSize = uint64_t(description.width) * FFX_MAXIMUM(description.height, 1u) * getSurfaceFormatSize(description.format);
+    return (dataSize <= UINT32_MAX) ? dataSize : 0;
+}
+
+// Reserve a record of payloadSize bytes and fill its header. Appending only takes an atomic add on the
+// offset of the log, so callbacks from several threads never wait on each other. Returns the payload
+// of the record, or NULL when it does not fit in the log anymore.
+static void* appendRecord(BackendContext_Record* backendContext, FfxFsr2RecordType type, size_t payloadSize, uint64_t timestamp)
+{
+    const uint64_t size = FFX_ALIGN_UP(uint64_t(sizeof(FfxFsr2RecordHeader) + payloadSize), uint64_t(FFX_FSR2_RECORD_ALIGNMENT));
+    const uint64_t offset = backendContext->logOffset.fetch_add(size, std::memory_order_relaxed);
+
+    if (offset + size > backendContext->logCapacity || size > UINT32_MAX) {
+
+        // the log ends with the first record that did not fit
+        uint64_t end = backendContext->logEnd.load(std::memory_order_relaxed);
+        while (offset < end && !backendContext->logEnd.compare_exchange_weak(end, offset, std::memory_order_relaxed)) {
+        }
+        backendContext->droppedRecordCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    FfxFsr2RecordHeader* header = reinterpret_cast<FfxFsr2RecordHeader*>(backendContext->log + offset);
+    header->type = uint32_t(type);
+    header->size = uint32_t(size);
+    header->timestamp = timestamp;
+
+    // clear the padding so logs are reproducible byte for byte
+    uint8_t* payload = reinterpret_cast<uint8_t*>(header + 1);
+    memset(payload + payloadSize, 0, size_t(size - sizeof(FfxFsr2RecordHeader) - payloadSize));
+    return payload;
+}
+
+static uint32_t findPipelineIndex(const BackendContext_Record* backendContext, FfxPipeline pipeline)
+{
+    for (uint32_t i = 0; i < FSR2_RECORD_MAX_PIPELINE_COUNT; ++i) {
+        if (backendContext->pipelines[i].pipeline == pipeline) {
+            return backendContext->pipelines[i].index;
+        }
+    }
+
+    return FSR2_RECORD_NO_PIPELINE;
+}
+
+size_t ffxFsr2GetScratchMemorySizeRecord(size_t logCapacity)
+{
+    return FFX_ALIGN_UP(sizeof(BackendContext_Record), size_t(FFX_FSR2_RECORD_ALIGNMENT)) + logCapacity;
+}
+
+FfxErrorCode ffxFsr2GetInterfaceRecord(
+    FfxFsr2Interface* outInterface,
+    const FfxFsr2Interface* backendInterface,
+    void* scratchBuffer,
+    size_t scratchBufferSize) {
+
+    FFX_RETURN_ON_ERROR(
+        outInterface,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        backendInterface,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        scratchBufferSize >= ffxFsr2GetScratchMemorySizeRecord(sizeof(FfxFsr2RecordHeader) + sizeof(FfxFsr2RecordBeginLog)),
+        FFX_ERROR_INSUFFICIENT_MEMORY);
+    FFX_RETURN_ON_ERROR(
+        (reinterpret_cast<uintptr_t>(scratchBuffer) % alignof(BackendContext_Record)) == 0,
+        FFX_ERROR_INVALID_ALIGNMENT);
+
+    outInterface->fpGetDeviceCapabilities = GetDeviceCapabilitiesRecord;
+    outInterface->fpCreateBackendContext = CreateBackendContextRecord;
+    outInterface->fpDestroyBackendContext = DestroyBackendContextRecord;
+    outInterface->fpCreateResource = CreateResourceRecord;
+    outInterface->fpRegisterResource = RegisterResourceRecord;
+    outInterface->fpUnregisterResources = UnregisterResourcesRecord;
+    outInterface->fpGetResourceDescription = GetResourceDescriptorRecord;
+    outInterface->fpDestroyResource = DestroyResourceRecord;
+    outInterface->fpCreatePipeline = CreatePipelineRecord;
+    outInterface->fpDestroyPipeline = DestroyPipelineRecord;
+    outInterface->fpScheduleGpuJob = ScheduleGpuJobRecord;
+    outInterface->fpExecuteGpuJobs = ExecuteGpuJobsRecord;
+    outInterface->fpReadResource = backendInterface->fpReadResource ? ReadResourceRecord : NULL;
+    outInterface->fpWriteResource = backendInterface->fpWriteResource ? WriteResourceRecord : NULL;
+    outInterface->fpGetGpuJobStatistics = backendInterface->fpGetGpuJobStatistics ? GetGpuJobStatisticsRecord : NULL;
+    outInterface->fpGetResourceMemoryRequirements = backendInterface->fpGetResourceMemoryRequirements ? GetResourceMemoryRequirementsRecord : NULL;
+    outInterface->fpCreateTransientHeap = backendInterface->fpCreateTransientHeap ? CreateTransientHeapRecord : NULL;
+    outInterface->scratchBuffer = scratchBuffer;
+    outInterface->scratchBufferSize = scratchBufferSize;
+
+    BackendContext_Record* backendContext = new (scratchBuffer) BackendContext_Record();
+    backendContext->backendInterface = *backendInterface;
+
+    const size_t contextSize = FFX_ALIGN_UP(sizeof(BackendContext_Record), size_t(FFX_FSR2_RECORD_ALIGNMENT));
+    backendContext->log = static_cast<uint8_t*>(scratchBuffer) + contextSize;
+    backendContext->logCapacity = scratchBufferSize - contextSize;
+    backendContext->logEnd = UINT64_MAX;
+
+    FfxFsr2RecordBeginLog* beginLog = static_cast<FfxFsr2RecordBeginLog*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_BEGIN_LOG, sizeof(FfxFsr2RecordBeginLog), getTimestamp()));
+    beginLog->magic = FFX_FSR2_RECORD_MAGIC;
+    beginLog->version = FFX_FSR2_RECORD_VERSION;
+    beginLog->reserved = 0;
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2GetRecordLog(const FfxFsr2Interface* recordInterface, const void** log, size_t* logSize, uint64_t* droppedRecordCount)
+{
+    FFX_RETURN_ON_ERROR(
+        recordInterface && recordInterface->scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(
+        log && logSize,
+        FFX_ERROR_INVALID_POINTER);
+
+    const BackendContext_Record* backendContext = getRecordContext(recordInterface);
+
+    *log = backendContext->log;
+    *logSize = size_t(FFX_MINIMUM(backendContext->logOffset.load(), backendContext->logEnd.load()));
+    if (droppedRecordCount) {
+        *droppedRecordCount = backendContext->droppedRecordCount.load();
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode GetDeviceCapabilitiesRecord(FfxFsr2Interface* backendInterface, FfxDeviceCapabilities* deviceCapabilities, FfxDevice device)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    return backendContext->backendInterface.fpGetDeviceCapabilities(&backendContext->backendInterface, deviceCapabilities, device);
+}
+
+FfxErrorCode CreateBackendContextRecord(FfxFsr2Interface* backendInterface, FfxDevice device)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_CREATE_BACKEND_CONTEXT, 0, getTimestamp());
+
+    memset(backendContext->pipelines, 0, sizeof(backendContext->pipelines));
+    backendContext->nextPipelineIndex = 0;
+    backendContext->scheduledJobCount = 0;
+
+    return backendContext->backendInterface.fpCreateBackendContext(&backendContext->backendInterface, device);
+}
+
+FfxErrorCode DestroyBackendContextRecord(FfxFsr2Interface* backendInterface)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_DESTROY_BACKEND_CONTEXT, 0, getTimestamp());
+
+    return backendContext->backendInterface.fpDestroyBackendContext(&backendContext->backendInterface);
+}
+
+FfxErrorCode CreateResourceRecord(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxResourceInternal* outTexture)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    const uint64_t timestamp = getTimestamp();
+    FFX_VALIDATE(backendContext->backendInterface.fpCreateResource(&backendContext->backendInterface, createResourceDescription, outTexture));
+
+    // initial data is part of the record, replaying it needs the lookup tables
+    const uint32_t initDataSize = createResourceDescription->initData ? createResourceDescription->initDataSize : 0;
+    FfxFsr2RecordCreateResource* record = static_cast<FfxFsr2RecordCreateResource*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_CREATE_RESOURCE, sizeof(FfxFsr2RecordCreateResource) + initDataSize, timestamp));
+    if (record) {
+        record->internalIndex = outTexture->internalIndex;
+        record->id = createResourceDescription->id;
+        record->heapType = uint32_t(createResourceDescription->heapType);
+        record->initialState = uint32_t(createResourceDescription->initalState);
+        record->usage = uint32_t(createResourceDescription->usage);
+        record->initDataSize = initDataSize;
+        record->description = toRecordDescription(createResourceDescription->resourceDescription);
+        record->reserved = 0;
+        if (initDataSize) {
+            memcpy(record + 1, createResourceDescription->initData, initDataSize);
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode RegisterResourceRecord(FfxFsr2Interface* backendInterface, const FfxResource* inResource, FfxResourceInternal* outResourceInternal)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    const uint64_t timestamp = getTimestamp();
+    FFX_VALIDATE(backendContext->backendInterface.fpRegisterResource(&backendContext->backendInterface, inResource, outResourceInternal));
+
+    // the inputs are complete when they are registered, their contents let a replay run on the same data
+    const uint64_t dataSize = getRegisteredDataSize(backendContext, inResource, *outResourceInternal);
+    FfxFsr2RecordRegisterResource* record = static_cast<FfxFsr2RecordRegisterResource*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_REGISTER_RESOURCE, sizeof(FfxFsr2RecordRegisterResource) + size_t(dataSize), timestamp));
+    if (record) {
+        record->internalIndex = outResourceInternal->internalIndex;
+        record->state = uint32_t(inResource->state);
+        record->isDepth = inResource->isDepth ? 1 : 0;
+        record->description = toRecordDescription(inResource->description);
+        record->dataSize = uint32_t(dataSize);
+        record->reserved = 0;
+
+        // contents the wrapped backend fails to read are left out, the record keeps its zeroed space
+        if (dataSize && backendContext->backendInterface.fpReadResource(&backendContext->backendInterface, *outResourceInternal, inResource->description.format, record + 1, size_t(dataSize)) != FFX_OK) {
+            memset(record + 1, 0, size_t(dataSize));
+            record->dataSize = 0;
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode UnregisterResourcesRecord(FfxFsr2Interface* backendInterface)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_UNREGISTER_RESOURCES, 0, getTimestamp());
+
+    return backendContext->backendInterface.fpUnregisterResources(&backendContext->backendInterface);
+}
+
+FfxResourceDescription GetResourceDescriptorRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    return backendContext->backendInterface.fpGetResourceDescription(&backendContext->backendInterface, resource);
+}
+
+FfxErrorCode DestroyResourceRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    FfxFsr2RecordDestroyResource* record = static_cast<FfxFsr2RecordDestroyResource*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_DESTROY_RESOURCE, sizeof(FfxFsr2RecordDestroyResource), getTimestamp()));
+    if (record) {
+        record->internalIndex = resource.internalIndex;
+        record->reserved = 0;
+    }
+
+    return backendContext->backendInterface.fpDestroyResource(&backendContext->backendInterface, resource);
+}
+
+FfxErrorCode CreatePipelineRecord(FfxFsr2Interface* backendInterface, FfxFsr2Pass passId, const FfxPipelineDescription* desc, FfxPipelineState* outPipeline)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    const uint64_t timestamp = getTimestamp();
+    FFX_VALIDATE(backendContext->backendInterface.fpCreatePipeline(&backendContext->backendInterface, passId, desc, outPipeline));
+
+    const uint32_t pipelineIndex = backendContext->nextPipelineIndex++;
+    for (uint32_t i = 0; i < FSR2_RECORD_MAX_PIPELINE_COUNT; ++i) {
+        if (backendContext->pipelines[i].pipeline == nullptr) {
+            backendContext->pipelines[i].pipeline = outPipeline->pipeline;
+            backendContext->pipelines[i].index = pipelineIndex;
+            break;
+        }
+    }
+
+    const size_t payloadSize = sizeof(FfxFsr2RecordCreatePipeline) + (desc->samplerCount + desc->rootConstantBufferCount) * sizeof(uint32_t);
+    FfxFsr2RecordCreatePipeline* record = static_cast<FfxFsr2RecordCreatePipeline*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_CREATE_PIPELINE, payloadSize, timestamp));
+    if (record) {
+        record->pipelineIndex = pipelineIndex;
+        record->pass = uint32_t(passId);
+        record->contextFlags = desc->contextFlags;
+        record->samplerCount = uint32_t(desc->samplerCount);
+        record->rootConstantBufferCount = desc->rootConstantBufferCount;
+        record->srvCount = outPipeline->srvCount;
+        record->uavCount = outPipeline->uavCount;
+        record->constCount = outPipeline->constCount;
+
+        uint32_t* values = reinterpret_cast<uint32_t*>(record + 1);
+        for (size_t i = 0; i < desc->samplerCount; ++i) {
+            *values++ = uint32_t(desc->samplers[i]);
+        }
+        for (uint32_t i = 0; i < desc->rootConstantBufferCount; ++i) {
+            *values++ = desc->rootConstantBufferSizes[i];
+        }
+    }
+
+    return FFX_OK;
+}
+
+FfxErrorCode DestroyPipelineRecord(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    for (uint32_t i = 0; pipeline->pipeline && i < FSR2_RECORD_MAX_PIPELINE_COUNT; ++i) {
+        if (backendContext->pipelines[i].pipeline == pipeline->pipeline) {
+
+            FfxFsr2RecordDestroyPipeline* record = static_cast<FfxFsr2RecordDestroyPipeline*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_DESTROY_PIPELINE, sizeof(FfxFsr2RecordDestroyPipeline), getTimestamp()));
+            if (record) {
+                record->pipelineIndex = backendContext->pipelines[i].index;
+                record->reserved = 0;
+            }
+
+            backendContext->pipelines[i].pipeline = nullptr;
+            break;
+        }
+    }
+
+    return backendContext->backendInterface.fpDestroyPipeline(&backendContext->backendInterface, pipeline);
+}
+
+FfxErrorCode ScheduleGpuJobRecord(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    const uint64_t timestamp = getTimestamp();
+
+    // only the bindings the pipeline uses are stored, which keeps compute jobs to a few hundred bytes
+    size_t payloadSize = sizeof(FfxFsr2RecordScheduleJob);
+    if (job->jobType == FFX_GPU_JOB_COMPUTE) {
+
+        const FfxComputeJobDescription& compute = job->computeJobDescriptor;
+        payloadSize += (compute.pipeline.srvCount + 2 * compute.pipeline.uavCount) * sizeof(uint32_t);
+        for (uint32_t i = 0; i < compute.pipeline.constCount; ++i) {
+            payloadSize += (2 + compute.cbs[i].uint32Size) * sizeof(uint32_t);
+        }
+    }
+
+    FfxFsr2RecordScheduleJob* record = static_cast<FfxFsr2RecordScheduleJob*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_SCHEDULE_JOB, payloadSize, timestamp));
+    if (record) {
+
+        memset(record, 0, sizeof(FfxFsr2RecordScheduleJob));
+        record->jobType = uint32_t(job->jobType);
+
+        switch (job->jobType) {
+
+        case FFX_GPU_JOB_CLEAR_FLOAT:
+            memcpy(record->clear.color, job->clearJobDescriptor.color, sizeof(record->clear.color));
+            record->clear.target = job->clearJobDescriptor.target.internalIndex;
+            break;
+
+        case FFX_GPU_JOB_COPY:
+            record->copy.src = job->copyJobDescriptor.src.internalIndex;
+            record->copy.dst = job->copyJobDescriptor.dst.internalIndex;
+            break;
+
+        case FFX_GPU_JOB_COMPUTE: {
+
+            const FfxComputeJobDescription& compute = job->computeJobDescriptor;
+            record->compute.pipelineIndex = findPipelineIndex(backendContext, compute.pipeline.pipeline);
+            memcpy(record->compute.dimensions, compute.dimensions, sizeof(record->compute.dimensions));
+            record->compute.srvCount = compute.pipeline.srvCount;
+            record->compute.uavCount = compute.pipeline.uavCount;
+            record->compute.cbCount = compute.pipeline.constCount;
+
+            uint32_t* values = reinterpret_cast<uint32_t*>(record + 1);
+            for (uint32_t i = 0; i < compute.pipeline.srvCount; ++i) {
+                *values++ = uint32_t(compute.srvs[i].internalIndex);
+            }
+            for (uint32_t i = 0; i < compute.pipeline.uavCount; ++i) {
+                *values++ = uint32_t(compute.uavs[i].internalIndex);
+            }
+            for (uint32_t i = 0; i < compute.pipeline.uavCount; ++i) {
+                *values++ = compute.uavMip[i];
+            }
+            for (uint32_t i = 0; i < compute.pipeline.constCount; ++i) {
+                *values++ = compute.cbSlotIndex[i];
+                *values++ = compute.cbs[i].uint32Size;
+                memcpy(values, compute.cbs[i].data, compute.cbs[i].uint32Size * sizeof(uint32_t));
+                values += compute.cbs[i].uint32Size;
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    backendContext->scheduledJobCount.fetch_add(1, std::memory_order_relaxed);
+
+    return backendContext->backendInterface.fpScheduleGpuJob(&backendContext->backendInterface, job);
+}
+
+FfxErrorCode ExecuteGpuJobsRecord(FfxFsr2Interface* backendInterface, FfxCommandList commandList)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    const uint64_t timestamp = getTimestamp();
+    const FfxErrorCode errorCode = backendContext->backendInterface.fpExecuteGpuJobs(&backendContext->backendInterface, commandList);
+    const uint64_t duration = getTimestamp() - timestamp;
+
+    FfxFsr2RecordExecuteJobs* record = static_cast<FfxFsr2RecordExecuteJobs*>(appendRecord(backendContext, FFX_FSR2_RECORD_TYPE_EXECUTE_JOBS, sizeof(FfxFsr2RecordExecuteJobs), timestamp));
+    if (record) {
+        record->jobCount = backendContext->scheduledJobCount.exchange(0, std::memory_order_relaxed);
+        record->reserved = 0;
+        record->duration = duration;
+    }
+
+    return errorCode;
+}
+
+// Host reads and writes of internal resources and statistics queries are forwarded without being
+// logged, they do not change which jobs a replay runs.
+FfxErrorCode ReadResourceRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, void* data, size_t dataSize)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    return backendContext->backendInterface.fpReadResource(&backendContext->backendInterface, resource, format, data, dataSize);
+}
+
+FfxErrorCode WriteResourceRecord(FfxFsr2Interface* backendInterface, FfxResourceInternal resource, FfxSurfaceFormat format, const void* data, size_t dataSize)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    return backendContext->backendInterface.fpWriteResource(&backendContext->backendInterface, resource, format, data, dataSize);
+}
+
+FfxErrorCode GetGpuJobStatisticsRecord(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    return backendContext->backendInterface.fpGetGpuJobStatistics(&backendContext->backendInterface, outStatistics, inoutJobCount);
+}
+
+// The placement of the transient resources is not logged either, a replay creates every resource on its own.
+FfxErrorCode GetResourceMemoryRequirementsRecord(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxResourceMemoryRequirements* outRequirements)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    return backendContext->backendInterface.fpGetResourceMemoryRequirements(&backendContext->backendInterface, createResourceDescription, outRequirements);
+}
+
+FfxErrorCode CreateTransientHeapRecord(FfxFsr2Interface* backendInterface, uint64_t heapSize, bool shared)
+{
+    BackendContext_Record* backendContext = getRecordContext(backendInterface);
+
+    return backendContext->backendInterface.fpCreateTransientHeap(&backendContext->backendInterface, heapSize, shared);
+}
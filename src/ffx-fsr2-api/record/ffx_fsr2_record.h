@@ -0,0 +1,252 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (c) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+// This file contains the declarations of the recording backend, which wraps any other backend and
+// logs the stream of callbacks the FSR2 runtime makes into it, so the work of real frames can be
+// inspected and replayed offline.
+
+// @defgroup Record
+
+#pragma once
+
+#include "../ffx_fsr2_interface.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // #if defined(__cplusplus)
+
+/// The identifier written at the start of every recorded log.
+#define FFX_FSR2_RECORD_MAGIC           0x474F4C3252534646ull   // "FFSR2LOG"
+
+/// The version of the record layouts below.
+#define FFX_FSR2_RECORD_VERSION         2
+
+/// The alignment (in bytes) of every record in a log.
+#define FFX_FSR2_RECORD_ALIGNMENT       8
+
+/// An enumeration of the records of a log, one per callback of <c><i>FfxFsr2Interface</i></c>.
+typedef enum FfxFsr2RecordType {
+
+    FFX_FSR2_RECORD_TYPE_BEGIN_LOG,                     ///< Payload: <c><i>FfxFsr2RecordBeginLog</i></c>.
+    FFX_FSR2_RECORD_TYPE_CREATE_BACKEND_CONTEXT,        ///< No payload.
+    FFX_FSR2_RECORD_TYPE_DESTROY_BACKEND_CONTEXT,       ///< No payload.
+    FFX_FSR2_RECORD_TYPE_CREATE_RESOURCE,               ///< Payload: <c><i>FfxFsr2RecordCreateResource</i></c> followed by <c><i>initDataSize</i></c> bytes of initial data.
+    FFX_FSR2_RECORD_TYPE_REGISTER_RESOURCE,             ///< Payload: <c><i>FfxFsr2RecordRegisterResource</i></c> followed by <c><i>dataSize</i></c> bytes of contents.
+    FFX_FSR2_RECORD_TYPE_UNREGISTER_RESOURCES,          ///< No payload.
+    FFX_FSR2_RECORD_TYPE_DESTROY_RESOURCE,              ///< Payload: <c><i>FfxFsr2RecordDestroyResource</i></c>.
+    FFX_FSR2_RECORD_TYPE_CREATE_PIPELINE,               ///< Payload: <c><i>FfxFsr2RecordCreatePipeline</i></c> followed by the samplers and the root constant buffer sizes, one uint32_t each.
+    FFX_FSR2_RECORD_TYPE_DESTROY_PIPELINE,              ///< Payload: <c><i>FfxFsr2RecordDestroyPipeline</i></c>.
+    FFX_FSR2_RECORD_TYPE_SCHEDULE_JOB,                  ///< Payload: <c><i>FfxFsr2RecordScheduleJob</i></c>, followed for compute jobs by its bindings.
+    FFX_FSR2_RECORD_TYPE_EXECUTE_JOBS,                  ///< Payload: <c><i>FfxFsr2RecordExecuteJobs</i></c>.
+
+    FFX_FSR2_RECORD_TYPE_COUNT
+} FfxFsr2RecordType;
+
+/// The header of every record. Records follow each other, each <c><i>size</i></c> bytes long.
+typedef struct FfxFsr2RecordHeader {
+
+    uint32_t                        type;                                   ///< A <c><i>FfxFsr2RecordType</i></c>.
+    uint32_t                        size;                                   ///< The size (in bytes) of the record including this header, a multiple of <c><i>FFX_FSR2_RECORD_ALIGNMENT</i></c>.
+    uint64_t                        timestamp;                              ///< The time (in nanoseconds) the callback was made, from an arbitrary origin.
+} FfxFsr2RecordHeader;
+
+/// A <c><i>FfxResourceDescription</i></c> with a layout independent of the compiler.
+typedef struct FfxFsr2RecordResourceDescription {
+
+    uint32_t                        type;                                   ///< A <c><i>FfxResourceType</i></c>.
+    uint32_t                        format;                                 ///< A <c><i>FfxSurfaceFormat</i></c>.
+    uint32_t                        width;
+    uint32_t                        height;
+    uint32_t                        depth;
+    uint32_t                        mipCount;
+    uint32_t                        flags;                                  ///< A set of <c><i>FfxResourceFlags</i></c>.
+} FfxFsr2RecordResourceDescription;
+
+/// The first record of a log.
+typedef struct FfxFsr2RecordBeginLog {
+
+    uint64_t                        magic;                                  ///< <c><i>FFX_FSR2_RECORD_MAGIC</i></c>.
+    uint32_t                        version;                                ///< <c><i>FFX_FSR2_RECORD_VERSION</i></c>.
+    uint32_t                        reserved;
+} FfxFsr2RecordBeginLog;
+
+/// A call to <c><i>fpCreateResource</i></c>.
+typedef struct FfxFsr2RecordCreateResource {
+
+    int32_t                         internalIndex;                          ///< The index the wrapped backend returned for the resource.
+    uint32_t                        id;                                     ///< The <c><i>FfxFsr2ResourceIdentifier</i></c> of the resource.
+    uint32_t                        heapType;                               ///< A <c><i>FfxHeapType</i></c>.
+    uint32_t                        initialState;                           ///< A <c><i>FfxResourceStates</i></c>.
+    uint32_t                        usage;                                  ///< A set of <c><i>FfxResourceUsage</i></c> flags.
+    uint32_t                        initDataSize;                           ///< The size (in bytes) of the initial data following this structure.
+    FfxFsr2RecordResourceDescription description;
+    uint32_t                        reserved;
+} FfxFsr2RecordCreateResource;
+
+/// A call to <c><i>fpRegisterResource</i></c>.
+///
+/// The contents of a registered texture are read through <c><i>fpReadResource</i></c> of the wrapped
+/// backend right after it is registered, as <c><i>FfxFsr2ReadResourceFunc</i></c> lays them out in
+/// the format of the description. They are not recorded for resources registered as unordered access
+/// views, which FSR2 only writes, or when the wrapped backend cannot read its resources from the host.
+typedef struct FfxFsr2RecordRegisterResource {
+
+    int32_t                         internalIndex;                          ///< The index the wrapped backend returned for the resource.
+    uint32_t                        state;                                  ///< A <c><i>FfxResourceStates</i></c>.
+    uint32_t                        isDepth;
+    FfxFsr2RecordResourceDescription description;
+    uint32_t                        dataSize;                               ///< The size (in bytes) of the contents following this structure, 0 when they were not recorded.
+    uint32_t                        reserved;
+} FfxFsr2RecordRegisterResource;
+
+/// A call to <c><i>fpDestroyResource</i></c>.
+typedef struct FfxFsr2RecordDestroyResource {
+
+    int32_t                         internalIndex;
+    uint32_t                        reserved;
+} FfxFsr2RecordDestroyResource;
+
+/// A call to <c><i>fpCreatePipeline</i></c>. Pipelines are numbered in the order they are created.
+typedef struct FfxFsr2RecordCreatePipeline {
+
+    uint32_t                        pipelineIndex;                          ///< The index later jobs refer to the pipeline by.
+    uint32_t                        pass;                                   ///< A <c><i>FfxFsr2Pass</i></c>.
+    uint32_t                        contextFlags;                           ///< A set of <c><i>FfxFsr2InitializationFlagBits</i></c>.
+    uint32_t                        samplerCount;
+    uint32_t                        rootConstantBufferCount;
+    uint32_t                        srvCount;                               ///< The number of SRVs the wrapped backend bound.
+    uint32_t                        uavCount;                               ///< The number of UAVs the wrapped backend bound.
+    uint32_t                        constCount;                             ///< The number of constant buffers the wrapped backend bound.
+} FfxFsr2RecordCreatePipeline;
+
+/// A call to <c><i>fpDestroyPipeline</i></c>.
+typedef struct FfxFsr2RecordDestroyPipeline {
+
+    uint32_t                        pipelineIndex;
+    uint32_t                        reserved;
+} FfxFsr2RecordDestroyPipeline;
+
+/// A call to <c><i>fpScheduleGpuJob</i></c>.
+///
+/// Compute jobs are followed by <c><i>srvCount</i></c> int32_t SRV indices, <c><i>uavCount</i></c>
+/// int32_t UAV indices, <c><i>uavCount</i></c> uint32_t UAV mips and, for each of the
+/// <c><i>cbCount</i></c> constant buffers, its uint32_t slot index, its uint32_t size and as many
+/// uint32_t of data.
+typedef struct FfxFsr2RecordScheduleJob {
+
+    uint32_t                        jobType;                                ///< A <c><i>FfxGpuJobType</i></c>.
+    union {
+        struct {
+            float                   color[4];
+            int32_t                 target;
+        } clear;                                                            ///< Valid for <c><i>FFX_GPU_JOB_CLEAR_FLOAT</i></c>.
+        struct {
+            int32_t                 src;
+            int32_t                 dst;
+        } copy;                                                             ///< Valid for <c><i>FFX_GPU_JOB_COPY</i></c>.
+        struct {
+            uint32_t                pipelineIndex;                          ///< The index of the pipeline, or ~0u when it was not created through the recording backend.
+            uint32_t                dimensions[3];
+            uint32_t                srvCount;
+            uint32_t                uavCount;
+            uint32_t                cbCount;
+        } compute;                                                          ///< Valid for <c><i>FFX_GPU_JOB_COMPUTE</i></c>.
+    };
+} FfxFsr2RecordScheduleJob;
+
+/// A call to <c><i>fpExecuteGpuJobs</i></c>, which ends a frame. The timestamp of the header is taken
+/// before calling the wrapped backend.
+typedef struct FfxFsr2RecordExecuteJobs {
+
+    uint32_t                        jobCount;                               ///< The number of jobs scheduled since the previous execution.
+    uint32_t                        reserved;
+    uint64_t                        duration;                               ///< The time (in nanoseconds) the wrapped backend took to execute or record the jobs.
+} FfxFsr2RecordExecuteJobs;
+
+/// Query how much memory is required for the scratch buffer of the recording backend.
+///
+/// @param [in] logCapacity                 The size (in bytes) of the log to hold the records in.
+///
+/// @returns
+/// The size (in bytes) of the required scratch memory buffer for the recording backend.
+///
+/// @ingroup FSR2 Record
+FFX_API size_t ffxFsr2GetScratchMemorySizeRecord(size_t logCapacity);
+
+/// Populate an interface with pointers for the recording backend, which forwards every callback to
+/// <c><i>backendInterface</i></c> and appends a record of it to a log.
+///
+/// The log lives in the scratch buffer after the state of the recording backend, appending to it
+/// only reserves space with an atomic increment and never allocates or locks. Once the log is full,
+/// further records are dropped and counted, and the callbacks are still forwarded.
+///
+/// <c><i>backendInterface</i></c> is copied, it must have been populated by its own backend and keep
+/// its scratch buffer alive as long as <c><i>recordInterface</i></c> is used. Functions of a backend
+/// which read the scratch buffer through a <c><i>FfxFsr2Context</i></c>, such as
+/// <c><i>ffxGetCPUResourcePtr</i></c>, do not work on contexts created with the recording backend.
+///
+/// @param [out] recordInterface            A pointer to a <c><i>FfxFsr2Interface</i></c> structure to populate with pointers.
+/// @param [in] backendInterface            A pointer to the <c><i>FfxFsr2Interface</i></c> of the backend to wrap.
+/// @param [in] scratchBuffer               A pointer to a buffer of memory which can be used by the recording backend.
+/// @param [in] scratchBufferSize           The size (in bytes) of the buffer pointed to by <c><i>scratchBuffer</i></c>.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               A pointer was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INSUFFICIENT_MEMORY           The scratch buffer is too small to hold the state of the recording backend and the first record.
+///
+/// @ingroup FSR2 Record
+FFX_API FfxErrorCode ffxFsr2GetInterfaceRecord(
+    FfxFsr2Interface* recordInterface,
+    const FfxFsr2Interface* backendInterface,
+    void* scratchBuffer,
+    size_t scratchBufferSize);
+
+/// Retrieve the log of a recording backend.
+///
+/// The log is a sequence of records, starting with a <c><i>FFX_FSR2_RECORD_TYPE_BEGIN_LOG</i></c>
+/// record, and can be written to a file as is. It is only complete while no callback is running,
+/// for instance between two calls to <c><i>ffxFsr2ContextDispatch</i></c>.
+///
+/// @param [in] recordInterface             A pointer to a <c><i>FfxFsr2Interface</i></c> populated by <c><i>ffxFsr2GetInterfaceRecord</i></c>.
+/// @param [out] log                        Receives a pointer to the first record.
+/// @param [out] logSize                    Receives the size (in bytes) of the records in the log.
+/// @param [out] droppedRecordCount         (optional) Receives the number of records dropped because the log was full.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               A pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup FSR2 Record
+FFX_API FfxErrorCode ffxFsr2GetRecordLog(
+    const FfxFsr2Interface* recordInterface,
+    const void** log,
+    size_t* logSize,
+    uint64_t* droppedRecordCount);
+
+#if defined(__cplusplus)
+}
+#endif // #if defined(__cplusplus)
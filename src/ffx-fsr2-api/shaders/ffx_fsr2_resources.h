@@ -95,6 +95,8 @@
 #define FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_RCAS                                     2
 #define FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_GENREACTIVE                              3
 
+#define FFX_FSR2_CONSTANTBUFFER_IDENTIFIER_COUNT                                    4
+
 #define FFX_FSR2_AUTOREACTIVEFLAGS_APPLY_TONEMAP                                    1
 #define FFX_FSR2_AUTOREACTIVEFLAGS_APPLY_INVERSETONEMAP                             2
 #define FFX_FSR2_AUTOREACTIVEFLAGS_APPLY_THRESHOLD                                  4
@@ -20,6 +20,8 @@
 // THE SOFTWARE.
 
 #include "../ffx_fsr2.h"
+#include "../ffx_fsr2_device_cache.h"
+#include "../ffx_fsr2_trace.h"
 #include "ffx_fsr2_vk.h"
 #include "shaders/ffx_fsr2_shaders_vk.h"  // include all the precompiled VK shaders for the FSR2 passes
 #include "../ffx_fsr2_private.h"
@@ -41,9 +43,10 @@ FfxErrorCode CreatePipelineVK(FfxFsr2Interface* backendInterface, FfxFsr2Pass pa
 FfxErrorCode DestroyPipelineVK(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline);
 FfxErrorCode ScheduleGpuJobVK(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job);
 FfxErrorCode ExecuteGpuJobsVK(FfxFsr2Interface* backendInterface, FfxCommandList commandList);
+FfxErrorCode GetGpuJobStatisticsVK(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount);
 
 #define FSR2_MAX_QUEUED_FRAMES              ( 4)
-#define FSR2_MAX_RESOURCE_COUNT             (64)
+#define FSR2_MAX_RESOURCE_COUNT             (64 + FFX_FSR2_MAX_VIEW_RESOURCE_COUNT * (FFX_FSR2_MAX_VIEW_COUNT - 1))
 #define FSR2_MAX_STAGING_RESOURCE_COUNT     ( 8)
 #define FSR2_MAX_BARRIERS                   (16)
 #define FSR2_MAX_GPU_JOBS                   (32)
@@ -165,6 +168,11 @@ typedef struct BackendContext_VK {
     VkPipelineStageFlags    srcStageMask = 0;
     VkPipelineStageFlags    dstStageMask = 0;
 
+    // barriers added since the backend context was created, and per job of the last execute call
+    uint32_t                addedBarrierCount = 0;
+    FfxGpuJobStatistics     jobStatistics[FSR2_MAX_GPU_JOBS] = {};
+    uint32_t                jobStatisticsCount = 0;
+
     uint32_t                numDeviceExtensions = 0;
     VkExtensionProperties*  extensionProperties = nullptr;
 
@@ -209,6 +217,11 @@ FfxErrorCode ffxFsr2GetInterfaceVK(
     outInterface->fpDestroyPipeline = DestroyPipelineVK;
     outInterface->fpScheduleGpuJob = ScheduleGpuJobVK;
     outInterface->fpExecuteGpuJobs = ExecuteGpuJobsVK;
+    outInterface->fpReadResource = NULL;    // internal resources are not accessed from the host
+    outInterface->fpWriteResource = NULL;
+    outInterface->fpGetGpuJobStatistics = GetGpuJobStatisticsVK;
+    outInterface->fpGetResourceMemoryRequirements = NULL;   // transient resources are created in dedicated allocations
+    outInterface->fpCreateTransientHeap = NULL;
     outInterface->scratchBuffer = scratchBuffer;
     outInterface->scratchBufferSize = scratchBufferSize;
 
@@ -723,6 +736,9 @@ FfxErrorCode GetDeviceCapabilitiesVK(FfxFsr2Interface* backendInterface, FfxDevi
     deviceCapabilities->fp16Supported = false;
     deviceCapabilities->raytracingSupported = false;
 
+    // the job list and the descriptor sets are sized for a single frame per execution
+    deviceCapabilities->maximumBatchedFrameCount = 0;
+
     // check if extensions are enabled
 
     for (uint32_t i = 0; i < backendContext->numDeviceExtensions; i++)
@@ -1012,6 +1028,28 @@ FfxErrorCode DestroyBackendContextVK(FfxFsr2Interface* backendInterface)
     return FFX_OK;
 }
 
+// Take the slot of a destroyed internal resource, or a new one below the dynamic resources of a frame,
+// so that resizing a context does not use up the store.
+static FfxErrorCode allocateStaticResourceVK(BackendContext_VK* backendContext, int32_t* outIndex)
+{
+    uint32_t resourceIndex = 0;
+    while (resourceIndex < backendContext->nextStaticResource && backendContext->resources[resourceIndex].deviceMemory) {
+        ++resourceIndex;
+    }
+
+    if (resourceIndex == backendContext->nextStaticResource) {
+
+        FFX_RETURN_ON_ERROR(
+            backendContext->nextStaticResource + 1 < backendContext->nextDynamicResource,
+            FFX_ERROR_OUT_OF_MEMORY);
+        ++backendContext->nextStaticResource;
+    }
+
+    backendContext->resources[resourceIndex] = {};
+    *outIndex = int32_t(resourceIndex);
+    return FFX_OK;
+}
+
 // create a internal resource that will stay alive until effect gets shut down
 FfxErrorCode CreateResourceVK(
     FfxFsr2Interface* backendInterface, 
@@ -1025,8 +1063,9 @@ FfxErrorCode CreateResourceVK(
     BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
     VkDevice vkDevice = reinterpret_cast<VkDevice>(backendContext->device);
 
-    FFX_ASSERT(backendContext->nextStaticResource + 1 < backendContext->nextDynamicResource);
-    outResource->internalIndex = backendContext->nextStaticResource++;
+    const FfxErrorCode slotErrorCode = allocateStaticResourceVK(backendContext, &outResource->internalIndex);
+    FFX_RETURN_ON_ERROR(slotErrorCode == FFX_OK, slotErrorCode);
+
     BackendContext_VK::Resource* res = &backendContext->resources[outResource->internalIndex];
     res->resourceDescription = createResourceDescription->resourceDescription;
     res->resourceDescription.mipCount = createResourceDescription->resourceDescription.mipCount;
@@ -1223,7 +1262,12 @@ FfxErrorCode CreateResourceVK(
             uploadDesc.initData = createResourceDescription->initData;
             uploadDesc.initDataSize = createResourceDescription->initDataSize;
 
-            backendInterface->fpCreateResource(backendInterface, &uploadDesc, &copySrc);
+            FFX_RETURN_ON_ERROR(
+                backendContext->stagingResourceCount + 1 < FSR2_MAX_STAGING_RESOURCE_COUNT,
+                FFX_ERROR_OUT_OF_MEMORY);
+
+            const FfxErrorCode uploadErrorCode = backendInterface->fpCreateResource(backendInterface, &uploadDesc, &copySrc);
+            FFX_RETURN_ON_ERROR(uploadErrorCode == FFX_OK, uploadErrorCode);
 
             // setup the upload job
             FfxGpuJobDescription copyJob =
@@ -1237,9 +1281,6 @@ FfxErrorCode CreateResourceVK(
 
             // add to the list of staging resources to delete later 
             uint32_t stagingResIdx = backendContext->stagingResourceCount++;
-
-            FFX_ASSERT(backendContext->stagingResourceCount < FSR2_MAX_STAGING_RESOURCE_COUNT);
-
             backendContext->stagingResources[stagingResIdx] = copySrc;
         }
     }
@@ -1265,6 +1306,17 @@ FfxResourceDescription GetResourceDescriptorVK(FfxFsr2Interface* backendInterfac
     }
 }
 
+typedef struct PipelineKeyVK {
+
+    VkDevice        device;
+    FfxFsr2Pass     pass;
+    uint32_t        permutationFlags;
+
+    bool operator==(const PipelineKeyVK& other) const { return device == other.device && pass == other.pass && permutationFlags == other.permutationFlags; }
+} PipelineKeyVK;
+
+static Fsr2DeviceCache<PipelineKeyVK, VkPipeline> pipelineCacheVK;
+
 FfxErrorCode CreatePipelineVK(FfxFsr2Interface* backendInterface, FfxFsr2Pass pass, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline)
 {
     FFX_ASSERT(NULL != backendInterface);
@@ -1415,48 +1467,55 @@ FfxErrorCode CreatePipelineVK(FfxFsr2Interface* backendInterface, FfxFsr2Pass pa
         return FFX_ERROR_BACKEND_API_ERROR;
     }
 
-    // create the shader module 
-    VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
-    shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    shaderModuleCreateInfo.pCode = (uint32_t*)shaderBlob.data;
-    shaderModuleCreateInfo.codeSize = shaderBlob.size;
+    // the compute pipelines are shared by all contexts on the device that use the same permutation.
+    // The descriptor set and pipeline layouts stay with the context, they are defined the same way
+    // by every context, which makes them compatible with the pipeline created with another one.
+    const PipelineKeyVK key = { backendContext->device, pass, flags };
+    VkPipeline computePipeline = nullptr;
+    const FfxErrorCode errorCode = pipelineCacheVK.acquire(key, &computePipeline, [&](VkPipeline* outComputePipeline) {
+
+        // create the shader module 
+        VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
+        shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        shaderModuleCreateInfo.pCode = (uint32_t*)shaderBlob.data;
+        shaderModuleCreateInfo.codeSize = shaderBlob.size;
 
-    VkShaderModule shaderModule = nullptr;
+        VkShaderModule shaderModule = nullptr;
 
-    if (backendContext->vkFunctionTable.vkCreateShaderModule(backendContext->device, &shaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-        return FFX_ERROR_BACKEND_API_ERROR;
-    }
+        if (backendContext->vkFunctionTable.vkCreateShaderModule(backendContext->device, &shaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+            return FFX_ERROR_BACKEND_API_ERROR;
+        }
 
-    // fill out shader stage create info
-    VkPipelineShaderStageCreateInfo shaderStageCreateInfo = {};
-    shaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-    shaderStageCreateInfo.pName = "main";
-    shaderStageCreateInfo.module = shaderModule;
+        // fill out shader stage create info
+        VkPipelineShaderStageCreateInfo shaderStageCreateInfo = {};
+        shaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        shaderStageCreateInfo.pName = "main";
+        shaderStageCreateInfo.module = shaderModule;
 
-    // set wave64 if possible
-    VkPipelineShaderStageRequiredSubgroupSizeCreateInfo subgroupSizeCreateInfo = {};
+        // set wave64 if possible
+        VkPipelineShaderStageRequiredSubgroupSizeCreateInfo subgroupSizeCreateInfo = {};
 
-    if (canForceWave64) {
+        if (canForceWave64) {
 
-        subgroupSizeCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO;
-        subgroupSizeCreateInfo.requiredSubgroupSize = 64;
+            subgroupSizeCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO;
+            subgroupSizeCreateInfo.requiredSubgroupSize = 64;
 
-        shaderStageCreateInfo.pNext = &subgroupSizeCreateInfo;
-    }
+            shaderStageCreateInfo.pNext = &subgroupSizeCreateInfo;
+        }
 
-    // create the compute pipeline
-    VkComputePipelineCreateInfo pipelineCreateInfo = {};
-    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-    pipelineCreateInfo.stage = shaderStageCreateInfo;
-    pipelineCreateInfo.layout = pipelineLayout.pipelineLayout;
+        // create the compute pipeline
+        VkComputePipelineCreateInfo pipelineCreateInfo = {};
+        pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineCreateInfo.stage = shaderStageCreateInfo;
+        pipelineCreateInfo.layout = pipelineLayout.pipelineLayout;
 
-    VkPipeline computePipeline = nullptr;
-    if (backendContext->vkFunctionTable.vkCreateComputePipelines(backendContext->device, nullptr, 1, &pipelineCreateInfo, nullptr, &computePipeline) != VK_SUCCESS) {
-        return FFX_ERROR_BACKEND_API_ERROR;
-    }
+        const VkResult result = backendContext->vkFunctionTable.vkCreateComputePipelines(backendContext->device, nullptr, 1, &pipelineCreateInfo, nullptr, outComputePipeline);
+        backendContext->vkFunctionTable.vkDestroyShaderModule(backendContext->device, shaderModule, nullptr);
 
-    backendContext->vkFunctionTable.vkDestroyShaderModule(backendContext->device, shaderModule, nullptr);
+        return result == VK_SUCCESS ? FFX_OK : FFX_ERROR_BACKEND_API_ERROR;
+    });
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
 
     outPipeline->pipeline = reinterpret_cast<FfxPipeline>(computePipeline);
     outPipeline->rootSignature = reinterpret_cast<FfxRootSignature>(&pipelineLayout);
@@ -1522,6 +1581,7 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
         curState = newState;
 
         ++backendContext->scheduledBufferBarrierCount;
+        ++backendContext->addedBarrierCount;
     }
     else
     {
@@ -1554,6 +1614,7 @@ void addBarrier(BackendContext_VK* backendContext, FfxResourceInternal* resource
         curState = newState;
 
         ++backendContext->scheduledImageBarrierCount;
+        ++backendContext->addedBarrierCount;
     }
 
     if (ffxResource.undefined)
@@ -1817,34 +1878,46 @@ FfxErrorCode ExecuteGpuJobsVK(FfxFsr2Interface* backendInterface, FfxCommandList
     FFX_ASSERT(NULL != backendInterface);
 
     BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    const FfxFsr2TraceScope traceScope("ExecuteGpuJobsVK", "backend");
 
     FfxErrorCode errorCode = FFX_OK;
 
+    // jobs are not timed, only their barriers are counted
+    memset(backendContext->jobStatistics, 0, sizeof(backendContext->jobStatistics));
+    backendContext->jobStatisticsCount = backendContext->gpuJobCount;
+
     // execute all renderjobs
     for (uint32_t i = 0; i < backendContext->gpuJobCount; ++i)
     {
         FfxGpuJobDescription* gpuJob = &backendContext->gpuJobs[i];
         VkCommandBuffer vkCommandBuffer = reinterpret_cast<VkCommandBuffer>(commandList);
+        const uint32_t firstBarrier = backendContext->addedBarrierCount;
 
+        // the trace holds the time spent recording each job, the device executes it later
         switch (gpuJob->jobType)
         {
         case FFX_GPU_JOB_CLEAR_FLOAT:
         {
+            const FfxFsr2TraceScope jobTraceScope("Clear", "record");
             errorCode = executeGpuJobClearFloat(backendContext, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_COPY:
         {
+            const FfxFsr2TraceScope jobTraceScope("Copy", "record");
             errorCode = executeGpuJobCopy(backendContext, gpuJob, vkCommandBuffer);
             break;
         }
         case FFX_GPU_JOB_COMPUTE:
         {
+            const FfxFsr2TraceScope jobTraceScope("Dispatch", "record");
             errorCode = executeGpuJobCompute(backendContext, gpuJob, vkCommandBuffer);
             break;
         }
         default:;
         }
+
+        backendContext->jobStatistics[i].barrierCount = backendContext->addedBarrierCount - firstBarrier;
     }
 
     // check the execute function returned cleanly.
@@ -1857,6 +1930,18 @@ FfxErrorCode ExecuteGpuJobsVK(FfxFsr2Interface* backendInterface, FfxCommandList
     return FFX_OK;
 }
 
+FfxErrorCode GetGpuJobStatisticsVK(FfxFsr2Interface* backendInterface, FfxGpuJobStatistics* outStatistics, uint32_t* inoutJobCount)
+{
+    FFX_ASSERT(NULL != backendInterface);
+    FFX_RETURN_ON_ERROR(outStatistics && inoutJobCount, FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    *inoutJobCount = FFX_MINIMUM(*inoutJobCount, backendContext->jobStatisticsCount);
+    memcpy(outStatistics, backendContext->jobStatistics, *inoutJobCount * sizeof(FfxGpuJobStatistics));
+
+    return FFX_OK;
+}
+
 FfxErrorCode DestroyResourceVK(FfxFsr2Interface* backendInterface, FfxResourceInternal resource)
 {
     FFX_ASSERT(backendInterface != nullptr);
@@ -1917,10 +2002,12 @@ FfxErrorCode DestroyPipelineVK(FfxFsr2Interface* backendInterface, FfxPipelineSt
 
     BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
 
-    // destroy pipeline 
+    // destroy pipeline with the last context using it
     VkPipeline computePipeline = reinterpret_cast<VkPipeline>(pipeline->pipeline);
     if (computePipeline) {
-        backendContext->vkFunctionTable.vkDestroyPipeline(backendContext->device, computePipeline, nullptr);
+        pipelineCacheVK.release(computePipeline, [backendContext](VkPipeline sharedPipeline) {
+            backendContext->vkFunctionTable.vkDestroyPipeline(backendContext->device, sharedPipeline, nullptr);
+        });
         pipeline->pipeline = nullptr;
     }
 